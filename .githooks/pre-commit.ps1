@@ -4,7 +4,9 @@
 
 # 1
 # Initialize build/test variables with defaults (can be overridden via environment variables)
-$Config       = if ($env:GIT_TEST_CONFIG)   { $env:GIT_TEST_CONFIG }   else { "Debug" }
+# Debug and Release both run: optimization changes floating-point code
+# generation (e.g. FMA contraction), which -O0 / /Od builds hide
+$Configs      = if ($env:GIT_TEST_CONFIG)   { $env:GIT_TEST_CONFIG -split "," } else { @("Debug", "Release") }
 $Platform     = if ($env:GIT_TEST_PLATFORM) { $env:GIT_TEST_PLATFORM } else { "x64" }
 $SolutionName = if ($env:GIT_TEST_SOLUTION) { $env:GIT_TEST_SOLUTION } else { "DiscreteTimeSystem.sln" }
 $TimeoutSec   = 300
@@ -41,54 +43,58 @@ if (-not $msbuildPath) {
 # 5
 # Print debug information
 Write-Host "[pre-commit] SolutionDir = $solutionDir"
-Write-Host "[pre-commit] Configuration = $Config, Platform = $Platform"
+Write-Host "[pre-commit] Configurations = $($Configs -join ', '), Platform = $Platform"
 Write-Host "[pre-commit] MSBuild: $msbuildPath"
 Write-Host "[pre-commit] Solution: $solutionPath"
 
-# 6
-# Set MSBuild arguments
-$msbuildArgs = @(
-    "$solutionPath",
-    "/m",
-    "/v:m",
-    "/p:Configuration=$Config",
-    "/p:Platform=$Platform"
-)
-# Check for null or empty arguments
-if (-not $msbuildArgs -or ($msbuildArgs | Where-Object { $_ -eq $null -or "$_".Trim() -eq "" }).Count) {
-    Write-Error "msbuild args are empty or contain null: $($msbuildArgs -join ' | ')"
-    exit 1
-}
+# 6 - 9
+# Build and test every configuration; the first failure aborts the commit
+foreach ($Config in $Configs) {
+    # 6
+    # Set MSBuild arguments
+    $msbuildArgs = @(
+        "$solutionPath",
+        "/m",
+        "/v:m",
+        "/p:Configuration=$Config",
+        "/p:Platform=$Platform"
+    )
+    # Check for null or empty arguments
+    if (-not $msbuildArgs -or ($msbuildArgs | Where-Object { $_ -eq $null -or "$_".Trim() -eq "" }).Count) {
+        Write-Error "msbuild args are empty or contain null: $($msbuildArgs -join ' | ')"
+        exit 1
+    }
 
-# 7
-Write-Host "[pre-commit] Building solution..."
-Push-Location $solutionDir
-try {
-    & $msbuildPath @msbuildArgs
-    $buildExit = $LASTEXITCODE
-} finally {
-    Pop-Location
-}
-if ($buildExit -ne 0) {
-    Write-Error "[pre-commit] Build failed with exit code $buildExit"
-    exit 1
-}
+    # 7
+    Write-Host "[pre-commit] Building solution ($Config)..."
+    Push-Location $solutionDir
+    try {
+        & $msbuildPath @msbuildArgs
+        $buildExit = $LASTEXITCODE
+    } finally {
+        Pop-Location
+    }
+    if ($buildExit -ne 0) {
+        Write-Error "[pre-commit] Build failed with exit code $buildExit"
+        exit 1
+    }
 
-# 8
-# Check for unit test executable
-$unitTestExe = Join-Path $solutionDir "x64\$Config\UnitTest.exe"
-if (-not (Test-Path -LiteralPath $unitTestExe)) {
-    Write-Error "[pre-commit] UnitTest.exe not found: $unitTestExe"
-    exit 1
-}
+    # 8
+    # Check for unit test executable
+    $unitTestExe = Join-Path $solutionDir "x64\$Config\UnitTest.exe"
+    if (-not (Test-Path -LiteralPath $unitTestExe)) {
+        Write-Error "[pre-commit] UnitTest.exe not found: $unitTestExe"
+        exit 1
+    }
 
-# 9
-# Run unit tests
-Write-Host "[pre-commit] Running unit tests..."
-$test = Start-Process -FilePath $unitTestExe -ArgumentList "--gtest_color=yes" -Wait -PassThru -NoNewWindow
-if ($test.ExitCode -ne 0) {
-    Write-Error "[pre-commit] Unit tests failed with exit code $($test.ExitCode)"
-    exit 1
+    # 9
+    # Run unit tests
+    Write-Host "[pre-commit] Running unit tests ($Config)..."
+    $test = Start-Process -FilePath $unitTestExe -ArgumentList "--gtest_color=yes" -Wait -PassThru -NoNewWindow
+    if ($test.ExitCode -ne 0) {
+        Write-Error "[pre-commit] Unit tests failed with exit code $($test.ExitCode)"
+        exit 1
+    }
 }
 
 # All tests passed
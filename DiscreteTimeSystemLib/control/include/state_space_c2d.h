@@ -7,6 +7,7 @@ extern "C" {
 #include "core_matrix.h"
 #include "core_error.h"
 #include "state_space.h"
+#include "pade.h"
 
 /*
  * =============================================================================
@@ -22,12 +23,36 @@ extern "C" {
 //------------------------------------------------
 //  Macro definitions
 //------------------------------------------------
-/* None */
+
+/** Largest n + m for which the augmented (n+m) x (n+m) matrix is exponentiated
+    as a whole: up to it pade_expm() uses its closed form. Larger systems
+    take the block-triangular path (pade_expm_block_ws_inplace()), which
+    never multiplies the zero rows of M. */
+#define STATE_SPACE_C2D_AUGMENTED_MAX 3
 
 //------------------------------------------------
 //  Type definitions
 //------------------------------------------------
-/* None */
+
+/**
+ * @brief Reusable scratch storage for state_space_c2d_ws().
+ *
+ * Sized once for n states and m inputs; holds the exponential workspace and
+ * the block exponential E. For n + m > STATE_SPACE_C2D_AUGMENTED_MAX (and
+ * m > 0) these are order-n buffers and E keeps only the top block row
+ * [A_d, B_d]. Not shareable between concurrent calls.
+ * Either owns its storage (state_space_c2d_workspace_init()) or lives in a
+ * caller's arena (state_space_c2d_workspace_init_in()).
+ */
+typedef struct {
+    int n;               ///< Number of states the workspace was sized for
+    int m;               ///< Number of inputs the workspace was sized for
+    ExpmWorkspace expm;  ///< Workspace of the (n+m) x (n+m) or, block path, n x n exponential
+    Matrix* E;           ///< exp(M * Ts), or its top n rows on the block path
+    Matrix* G;           ///< n x m: B * Ts, consumed by the exponential (block path only)
+    Matrix* W;           ///< n x m: ping-pong partner of B_d (block path only)
+    MatrixArena own;     ///< Backing storage when created by state_space_c2d_workspace_init()
+} C2DWorkspace;
 
 //------------------------------------------------
 //  Function Prototypes
@@ -48,6 +73,9 @@ extern "C" {
  *   then extract:
  *     A_d = E(0:n-1, 0:n-1),
  *     B_d = E(0:n-1, n:n+m-1).
+ *   Beyond STATE_SPACE_C2D_AUGMENTED_MAX, E is evaluated block by block
+ *   (A_d = exp(A Ts), B_d = phi_1(A Ts) Ts B by one shared Pade / squaring
+ *   pass), which costs about n^2 (n + m) per product instead of (n + m)^3.
  *
  * @param[in]  sys  Continuous-time system (A: n~n, B: n~m). C,D͖gpB
  * @param[in]  Ts   Sampling period. If Ts == 0, returns A_d=I, B_d=0.
@@ -61,7 +89,8 @@ extern "C" {
  * @return Error propagated from underlying routines (e.g., matrix ops, pade_expm)
  *
  * @note
- * - This routine allocates temporaries internally and frees them before return.
+ * - This routine takes its temporaries from a single per-call arena block;
+ *   use state_space_c2d_ws() to reuse them across calls.
  * - Requires a working pade_expm(M, E). For Ts==0, no exponential is required.
  */
 CoreErrorStatus state_space_c2d(const StateSpaceModel* sys,
@@ -69,6 +98,54 @@ CoreErrorStatus state_space_c2d(const StateSpaceModel* sys,
     Matrix* Ad,
     Matrix* Bd);
 
+/**
+ * @brief Allocate a C2DWorkspace for systems with n states and m inputs.
+ *
+ * @param[out] ws  Workspace to initialize (left empty on failure).
+ * @param[in]  n   Number of states (> 0).
+ * @param[in]  m   Number of inputs (>= 0).
+ *
+ * @return CORE_ERROR_SUCCESS on success
+ * @return CORE_ERROR_NULL if ws is NULL
+ * @return CORE_ERROR_INVALID_ARG if n or m is out of range
+ * @return Allocation errors from matrix_core_create()
+ */
+CoreErrorStatus state_space_c2d_workspace_init(C2DWorkspace* ws, int n, int m);
+
+/**
+ * @brief Carve a C2DWorkspace out of an existing arena.
+ *
+ * Needs state_space_c2d_workspace_bytes(n, m) bytes of the arena and is
+ * released with it; state_space_c2d_workspace_free() only clears it.
+ */
+CoreErrorStatus state_space_c2d_workspace_init_in(C2DWorkspace* ws, int n, int m, MatrixArena* arena);
+
+/**
+ * @brief Arena bytes needed by state_space_c2d_workspace_init_in().
+ */
+size_t state_space_c2d_workspace_bytes(int n, int m);
+
+/**
+ * @brief Release a C2DWorkspace and reset it to empty.
+ */
+CoreErrorStatus state_space_c2d_workspace_free(C2DWorkspace* ws);
+
+/**
+ * @brief state_space_c2d() without heap allocation.
+ *
+ * Same contract and bit-identical results as state_space_c2d(); all
+ * temporaries come from ws, which must be sized for the model's (n, m).
+ * On return the top n rows of ws->E hold [A_d, B_d], so callers that only
+ * read A_d / B_d can take MatrixViews of it instead of using Ad and Bd.
+ *
+ * @return CORE_ERROR_DIMENSION additionally if ws was sized for another (n, m)
+ */
+CoreErrorStatus state_space_c2d_ws(const StateSpaceModel* sys,
+    double Ts,
+    C2DWorkspace* ws,
+    Matrix* Ad,
+    Matrix* Bd);
+
 
 #ifdef __cplusplus
 }
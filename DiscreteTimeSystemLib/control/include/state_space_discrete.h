@@ -146,8 +146,12 @@ CoreErrorStatus ss_discrete_step(const SSDiscrete* dsys,
  * @param[in]  x_now   n~1 current state.
  * @param[in]  u_now   m~1 current input.
  * @param[out] x_next  n~1 next state.
- * @param[in]  Ax_ws   n~1 workspace for Ad*x_now.
- * @param[in]  Bu_ws   n~1 workspace for Bd*u_now.
+ * @param[in]  Ax_ws   n~1 workspace; only used when x_next aliases x_now or u_now.
+ * @param[in]  Bu_ws   n~1 workspace; kept for API compatibility (not written).
+ *
+ * @note Ad*x_now and Bd*u_now are accumulated directly into x_next by
+ *       matrix_ops_gemv() (beta = 1 for the input term), so no intermediate
+ *       vectors are written in the common non-aliased case.
  *
  * @return CORE_ERROR_SUCCESS on success, or an error code.
  */
@@ -0,0 +1,193 @@
+#pragma once
+
+#ifndef __cplusplus
+#error "state_space_discrete_fixed.h is a C++ header; C code uses state_space_discrete.h"
+#endif
+
+#include "matrix_fixed.h"
+
+extern "C" {
+#include "state_space.h"
+#include "state_space_discrete.h"
+}
+
+/*
+ * =============================================================================
+ *  state_space_discrete_fixed.h
+ * =============================================================================
+ *
+ *  Description:
+ *      Fixed-size counterpart of SSDiscrete for plants whose dimensions are
+ *      known at compile time (e.g. the 2-state DC motor). All matrices are
+ *      held inline as dts::SMatrix, so a step is a few unrolled products with
+ *      no allocation and no runtime dimension checks.
+ *
+ *  Features:
+ *      - dts::SSDiscreteFixed<N, M, P>: Ad, Bd, C, D held by value
+ *      - Promotion from an SSDiscrete or a continuous StateSpaceModel (ZOH)
+ *      - Demotion back to a heap SSDiscrete for the generic C API
+ *      - Unrolled step() and output()
+ *
+ *  Notes:
+ *      - P may be 0 for models without an output equation.
+ *      - A NULL D in the source model is promoted as the zero matrix.
+ *
+ * =============================================================================
+ */
+
+ //------------------------------------------------
+ //  Macro definitions
+ //------------------------------------------------
+ /* None */
+
+ //------------------------------------------------
+ //  Type definitions
+ //------------------------------------------------
+
+namespace dts {
+
+    /**
+     * @brief ZOH-discretized model with compile-time dimensions (no internal state).
+     *
+     * Members mirror SSDiscrete:
+     *   Ts      : sampling time (seconds)
+     *   Ad, Bd  : discrete-time state and input matrices
+     *   C, D    : output matrices (D is zero when the source model had none)
+     */
+    template <int N, int M, int P>
+    struct SSDiscreteFixed {
+        static_assert(N >= 1 && M >= 1 && P >= 0, "invalid state-space dimensions");
+        static_assert(N <= DTS_FIXED_MAX_DIM && M <= DTS_FIXED_MAX_DIM && P <= DTS_FIXED_MAX_DIM,
+            "SSDiscreteFixed is meant for small plants; use SSDiscrete instead");
+
+        using State = SMatrix<N, 1>;
+        using Input = SMatrix<M, 1>;
+        using Output = SMatrix<P, 1>;
+
+        double Ts = 0.0;
+        SMatrix<N, N> Ad;
+        SMatrix<N, M> Bd;
+        SMatrix<P, N> C;
+        SMatrix<P, M> D;
+
+        /** x_next = Ad * x + Bd * u */
+        State step(const State& x, const Input& u) const {
+            State r;
+            detail::unroll<0, N>([&](auto i) {
+                double s = 0.0;
+                detail::unroll<0, N>([&](auto k) { s += Ad(i, k) * x.a[k]; });
+                detail::unroll<0, M>([&](auto k) { s += Bd(i, k) * u.a[k]; });
+                r.a[i] = s;
+            });
+            return r;
+        }
+
+        /** y = C * x + D * u */
+        Output output(const State& x, const Input& u) const {
+            Output y;
+            detail::unroll<0, P>([&](auto i) {
+                double s = 0.0;
+                detail::unroll<0, N>([&](auto k) { s += C(i, k) * x.a[k]; });
+                detail::unroll<0, M>([&](auto k) { s += D(i, k) * u.a[k]; });
+                y.a[i] = s;
+            });
+            return y;
+        }
+
+        /**
+         * @brief Promote an existing discrete model.
+         *
+         * @return CORE_ERROR_SUCCESS
+         * @return CORE_ERROR_NULL if dsys, Ad or Bd is NULL
+         * @return CORE_ERROR_DIMENSION if (n, m, p) differ from (N, M, P), or
+         *         C is missing while P > 0
+         */
+        CoreErrorStatus from_discrete(const SSDiscrete* dsys) {
+            if (!dsys || !dsys->Ad || !dsys->Bd) CORE_ERROR_RETURN(CORE_ERROR_NULL);
+            if (dsys->n != N || dsys->m != M || dsys->p != P) CORE_ERROR_RETURN(CORE_ERROR_DIMENSION);
+
+            CoreErrorStatus status;
+            status = smatrix_from(Ad, dsys->Ad); if (status) CORE_ERROR_RETURN(status);
+            status = smatrix_from(Bd, dsys->Bd); if (status) CORE_ERROR_RETURN(status);
+            status = load_output(dsys->C, dsys->D); if (status) CORE_ERROR_RETURN(status);
+            Ts = dsys->Ts;
+            CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
+        }
+
+        /**
+         * @brief Discretize a continuous model with ZOH: exp([[A, B], [0, 0]] * Ts).
+         *
+         * Same construction as state_space_c2d(), evaluated with the unrolled
+         * fixed-size expm on the (N+M) x (N+M) block matrix.
+         *
+         * @return CORE_ERROR_SUCCESS
+         * @return CORE_ERROR_NULL if sys, A or B is NULL
+         * @return CORE_ERROR_INVALID_ARG if Ts < 0
+         * @return CORE_ERROR_DIMENSION on size mismatch with (N, M, P)
+         */
+        CoreErrorStatus from_csys(const StateSpaceModel* sys, double ts) {
+            if (!sys || !sys->A || !sys->B) CORE_ERROR_RETURN(CORE_ERROR_NULL);
+            if (ts < 0.0) CORE_ERROR_RETURN(CORE_ERROR_INVALID_ARG);
+
+            SMatrix<N, N> A;
+            SMatrix<N, M> B;
+            CoreErrorStatus status;
+            status = smatrix_from(A, sys->A); if (status) CORE_ERROR_RETURN(status);
+            status = smatrix_from(B, sys->B); if (status) CORE_ERROR_RETURN(status);
+            if (P == 0 && sys->C) CORE_ERROR_RETURN(CORE_ERROR_DIMENSION);
+            status = load_output(sys->C, sys->D); if (status) CORE_ERROR_RETURN(status);
+
+            if (ts == 0.0) {
+                Ad = SMatrix<N, N>::identity();
+                Bd = SMatrix<N, M>::zero();
+            }
+            else {
+                SMatrix<N + M, N + M> Mx{};
+                detail::unroll<0, N>([&](auto i) {
+                    detail::unroll<0, N>([&](auto j) { Mx(i, j) = A(i, j) * ts; });
+                    detail::unroll<0, M>([&](auto j) { Mx(i, N + j) = B(i, j) * ts; });
+                });
+                SMatrix<N + M, N + M> E;
+                status = expm(Mx, E); if (status) CORE_ERROR_RETURN(status);
+                detail::unroll<0, N>([&](auto i) {
+                    detail::unroll<0, N>([&](auto j) { Ad(i, j) = E(i, j); });
+                    detail::unroll<0, M>([&](auto j) { Bd(i, j) = E(i, N + j); });
+                });
+            }
+            Ts = ts;
+            CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
+        }
+
+        /**
+         * @brief Copy into a heap SSDiscrete (allocates; release with ss_discrete_free()).
+         *
+         * C and D are omitted when P == 0.
+         */
+        CoreErrorStatus to_discrete(SSDiscrete* out) const {
+            if (!out) CORE_ERROR_RETURN(CORE_ERROR_NULL);
+            SSDiscreteFixed tmp = *this;   // views need mutable storage
+            MatrixView vAd = tmp.Ad.view(), vBd = tmp.Bd.view(), vC{}, vD{};
+            if constexpr (P > 0) { vC = tmp.C.view(); vD = tmp.D.view(); }
+            CoreErrorStatus status = ss_discrete_init_from_mats(out, Ts, &vAd, &vBd,
+                P > 0 ? &vC : NULL, P > 0 ? &vD : NULL);
+            CORE_ERROR_RETURN(status);
+        }
+
+    private:
+        CoreErrorStatus load_output(const Matrix* Cm, const Matrix* Dm) {
+            CoreErrorStatus status;
+            if constexpr (P > 0) {
+                if (!Cm) CORE_ERROR_RETURN(CORE_ERROR_DIMENSION);
+                status = smatrix_from(C, Cm); if (status) CORE_ERROR_RETURN(status);
+            }
+            if (Dm) {
+                status = smatrix_from(D, Dm); if (status) CORE_ERROR_RETURN(status);
+            }
+            else {
+                D = SMatrix<P, M>::zero();
+            }
+            CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
+        }
+    };
+
+} // namespace dts
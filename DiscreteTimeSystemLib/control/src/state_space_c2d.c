@@ -3,9 +3,77 @@
 #include "matrix_ops.h"
 #include "matrix_exp.h"
 #include "pade.h"
+#include "core_memo.h"
 
-CoreErrorStatus state_space_c2d(const StateSpaceModel* sys, double Ts, Matrix* Ad, Matrix* Bd) {
-	if (!sys || !sys->A || !sys->B || !Ad || !Bd)
+// Block-triangular path: exponential of order n, E = [A_d, B_d] only.
+static int c2d_block_path(int n, int m) {
+	return m > 0 && n + m > STATE_SPACE_C2D_AUGMENTED_MAX;
+}
+
+size_t state_space_c2d_workspace_bytes(int n, int m) {
+	if (n <= 0 || m < 0) return 0;
+	if (c2d_block_path(n, m)) {
+		return pade_expm_workspace_bytes(n) + matrix_core_bytes_in(n, n + m)
+			+ 2 * matrix_core_bytes_in(n, m);
+	}
+	return pade_expm_workspace_bytes(n + m) + matrix_core_bytes_in(n + m, n + m);
+}
+
+CoreErrorStatus state_space_c2d_workspace_init_in(C2DWorkspace* ws, int n, int m, MatrixArena* arena) {
+	if (!ws) CORE_ERROR_RETURN(CORE_ERROR_NULL);
+	*ws = (C2DWorkspace){ 0 };
+	if (!arena) CORE_ERROR_RETURN(CORE_ERROR_NULL);
+	if (n <= 0 || m < 0) CORE_ERROR_RETURN(CORE_ERROR_INVALID_ARG);
+
+	const int block = c2d_block_path(n, m);
+	CoreErrorStatus status = pade_expm_workspace_init_in(&ws->expm, block ? n : n + m, arena);
+	if (status) CORE_ERROR_RETURN(status);
+
+	ws->E = matrix_core_create_in(arena, block ? n : n + m, n + m, &status);
+	if (status) goto FAIL;
+	if (block) {
+		ws->G = matrix_core_create_in(arena, n, m, &status);
+		if (status) goto FAIL;
+		ws->W = matrix_core_create_in(arena, n, m, &status);
+		if (status) goto FAIL;
+	}
+	ws->n = n;
+	ws->m = m;
+	CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
+
+FAIL:
+	*ws = (C2DWorkspace){ 0 };
+	CORE_ERROR_RETURN(status);
+}
+
+CoreErrorStatus state_space_c2d_workspace_init(C2DWorkspace* ws, int n, int m) {
+	if (!ws) CORE_ERROR_RETURN(CORE_ERROR_NULL);
+	*ws = (C2DWorkspace){ 0 };
+	if (n <= 0 || m < 0) CORE_ERROR_RETURN(CORE_ERROR_INVALID_ARG);
+
+	// Everything comes from one exactly-sized block.
+	MatrixArena arena;
+	CoreErrorStatus status = matrix_arena_init(&arena, state_space_c2d_workspace_bytes(n, m));
+	if (status) CORE_ERROR_RETURN(status);
+
+	status = state_space_c2d_workspace_init_in(ws, n, m, &arena);
+	if (status) {
+		matrix_arena_destroy(&arena);
+		CORE_ERROR_RETURN(status);
+	}
+	ws->own = arena;
+	CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
+}
+
+CoreErrorStatus state_space_c2d_workspace_free(C2DWorkspace* ws) {
+	if (!ws) CORE_ERROR_RETURN(CORE_ERROR_NULL);
+	matrix_arena_destroy(&ws->own);
+	*ws = (C2DWorkspace){ 0 };
+	CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
+}
+
+CoreErrorStatus state_space_c2d_ws(const StateSpaceModel* sys, double Ts, C2DWorkspace* ws, Matrix* Ad, Matrix* Bd) {
+	if (!sys || !sys->A || !sys->B || !ws || !Ad || !Bd)
 		CORE_ERROR_RETURN(CORE_ERROR_NULL);
 
 	const int n = sys->A->rows;
@@ -14,6 +82,7 @@ CoreErrorStatus state_space_c2d(const StateSpaceModel* sys, double Ts, Matrix* A
 	if (sys->A->cols != n || sys->B->rows != n) CORE_ERROR_RETURN(CORE_ERROR_DIMENSION);
 	if (Ad->rows != n || Ad->cols != n) CORE_ERROR_RETURN(CORE_ERROR_DIMENSION);
 	if (Bd->rows != n || Bd->cols != m) CORE_ERROR_RETURN(CORE_ERROR_DIMENSION);
+	if (ws->n != n || ws->m != m || !ws->E) CORE_ERROR_RETURN(CORE_ERROR_DIMENSION);
 
 	CoreErrorStatus status;
 
@@ -23,32 +92,102 @@ CoreErrorStatus state_space_c2d(const StateSpaceModel* sys, double Ts, Matrix* A
 		CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
 	}
 
-	Matrix* M = NULL, * E = NULL;
-	
-	// M: (n+m) x (n+m)
-	M = matrix_core_create(n + m, n + m, &status);
-	if (status) CORE_ERROR_RETURN(status);
+	if (c2d_block_path(n, m)) {
+		if (!ws->G || !ws->W) CORE_ERROR_RETURN(CORE_ERROR_DIMENSION);
 
-	status = matrix_ops_set_zero(M);                                            if (status) goto FAIL;
-	status = matrix_ops_set_block(M, 0, 0, sys->A);                      if (status) goto FAIL;
-	status = matrix_ops_set_block(M, 0, sys->A->cols, sys->B);   if (status) goto FAIL;
+		// A*Ts and B*Ts go straight into the order-n workspace; the zero rows
+		// of M are never formed.
+		status = matrix_ops_copy(ws->expm.As, sys->A);                         if (status) CORE_ERROR_RETURN(status);
+		status = matrix_ops_scale(ws->expm.As, Ts);                             if (status) CORE_ERROR_RETURN(status);
+		status = matrix_ops_copy(ws->G, sys->B);                                 if (status) CORE_ERROR_RETURN(status);
+		status = matrix_ops_scale(ws->G, Ts);                                     if (status) CORE_ERROR_RETURN(status);
 
-	// E = exp(M)
-	E = matrix_core_create(M->rows, M->cols, &status);             if (status) goto FAIL;
-	status = matrix_exp_exponential(M, Ts, E);                              if (status) goto FAIL;
+		// E = [exp(A*Ts), phi_1(A*Ts) B*Ts]
+		MatrixView EA, EB;
+		status = matrix_view_block(&EA, ws->E, 0, 0, n, n);                      if (status) CORE_ERROR_RETURN(status);
+		status = matrix_view_block(&EB, ws->E, 0, n, n, m);                      if (status) CORE_ERROR_RETURN(status);
+		status = pade_expm_block_ws_inplace(&ws->expm, ws->G, ws->W, &EA, &EB); if (status) CORE_ERROR_RETURN(status);
+
+		status = matrix_ops_copy(Ad, &EA);                                           if (status) CORE_ERROR_RETURN(status);
+		status = matrix_ops_copy(Bd, &EB);                                           if (status) CORE_ERROR_RETURN(status);
+		CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
+	}
 
-	// Ad = E(0:n-1, 0:n-1)
-	status = matrix_ops_get_block(E, 0, 0, Ad);                              if (status) goto FAIL;
+	// M = [[A*Ts, B*Ts], [0, 0]], assembled in place in the exponential's input
+	// buffer through views: only the top n rows are written and scaled.
+	Matrix* M = ws->expm.As;
+	MatrixView top, MA, MB, bottom;
+	status = matrix_view_block(&top, M, 0, 0, n, n + m);                  if (status) CORE_ERROR_RETURN(status);
+	status = matrix_view_block(&MA, M, 0, 0, n, n);                          if (status) CORE_ERROR_RETURN(status);
+	status = matrix_ops_copy(&MA, sys->A);                                     if (status) CORE_ERROR_RETURN(status);
+	if (m > 0) {
+		status = matrix_view_block(&MB, M, 0, n, n, m);                      if (status) CORE_ERROR_RETURN(status);
+		status = matrix_ops_copy(&MB, sys->B);                                 if (status) CORE_ERROR_RETURN(status);
+		status = matrix_view_block(&bottom, M, n, 0, m, n + m);           if (status) CORE_ERROR_RETURN(status);
+		status = matrix_ops_set_zero(&bottom);                                 if (status) CORE_ERROR_RETURN(status);
+	}
+	status = matrix_ops_scale(&top, Ts);                                        if (status) CORE_ERROR_RETURN(status);
+
+	// E = exp(M)
+	status = pade_expm_ws_inplace(&ws->expm, ws->E);                 if (status) CORE_ERROR_RETURN(status);
 
-	// Bd = E(0:n-1, n:n+m-1)
-	status = matrix_ops_get_block(E, 0, sys->A->cols, Bd);           if (status) goto FAIL;
+	// Ad = E(0:n-1, 0:n-1), Bd = E(0:n-1, n:n+m-1), read through views
+	MatrixView EA, EB;
+	status = matrix_view_block(&EA, ws->E, 0, 0, n, n);                      if (status) CORE_ERROR_RETURN(status);
+	status = matrix_ops_copy(Ad, &EA);                                           if (status) CORE_ERROR_RETURN(status);
+	if (m > 0) {
+		status = matrix_view_block(&EB, ws->E, 0, n, n, m);                  if (status) CORE_ERROR_RETURN(status);
+		status = matrix_ops_copy(Bd, &EB);                                       if (status) CORE_ERROR_RETURN(status);
+	}
 
-	status = matrix_core_free(M);
-	status = matrix_core_free(E);
 	CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
+}
 
-FAIL:
-	if (E) matrix_core_free(E);
-	if (M) matrix_core_free(M);
+CoreErrorStatus state_space_c2d(const StateSpaceModel* sys, double Ts, Matrix* Ad, Matrix* Bd) {
+	if (!sys || !sys->A || !sys->B || !Ad || !Bd)
+		CORE_ERROR_RETURN(CORE_ERROR_NULL);
+
+	const int n = sys->A->rows;
+	const int m = sys->B->cols;
+
+	if (sys->A->cols != n || sys->B->rows != n) CORE_ERROR_RETURN(CORE_ERROR_DIMENSION);
+	if (Ad->rows != n || Ad->cols != n) CORE_ERROR_RETURN(CORE_ERROR_DIMENSION);
+	if (Bd->rows != n || Bd->cols != m) CORE_ERROR_RETURN(CORE_ERROR_DIMENSION);
+
+	CoreErrorStatus status;
+
+	if (Ts == 0.0) {
+		status = matrix_ops_set_identity(Ad); if (status) CORE_ERROR_RETURN(status);
+		status = matrix_ops_set_zero(Bd); if (status) CORE_ERROR_RETURN(status);
+		CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
+	}
+
+	// Process-wide memo cache, if installed, there are inputs and no output
+	// overwrites an argument
+	const int cacheable = m > 0
+		&& Ad->data != sys->A->data && Ad->data != sys->B->data
+		&& Bd->data != sys->A->data && Bd->data != sys->B->data;
+	CoreMemoCache* memo = cacheable ? core_memo_get_default() : NULL;
+	const CoreMemoKey key = { CORE_MEMO_TAG_C2D, Ts, 2, { sys->A, sys->B } };
+	Matrix* const out[2] = { Ad, Bd };
+	if (memo) {
+		int hit = 0;
+		status = core_memo_lookup(memo, &key, out, 2, &hit);
+		if (status) CORE_ERROR_RETURN(status);
+		if (hit) CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
+	}
+
+	C2DWorkspace ws;
+	status = state_space_c2d_workspace_init(&ws, n, m);
+	if (status) CORE_ERROR_RETURN(status);
+
+	status = state_space_c2d_ws(sys, Ts, &ws, Ad, Bd);
+
+	state_space_c2d_workspace_free(&ws);
+
+	// A full cache is not an error of the discretization
+	if (memo && status == CORE_ERROR_SUCCESS) {
+		(void)core_memo_store(memo, &key, (const Matrix* const*)out, 2);
+	}
 	CORE_ERROR_RETURN(status);
 }
@@ -115,14 +115,21 @@ CoreErrorStatus ss_discrete_step_ws(const SSDiscrete* dsys,
 
     CoreErrorStatus status = CORE_ERROR_SUCCESS;
 
-    // Ax_ws = Ad * x_now
-    status = matrix_ops_multiply(Ax_ws, dsys->Ad, x_now); if (status) CORE_ERROR_RETURN(status);
+    // x_next = Ad * x_now + Bd * u_now, accumulated in place by two GEMVs.
+    // If x_next aliases an input, accumulate in Ax_ws and copy out instead.
+    Matrix* acc = (x_next == x_now || x_next == u_now) ? Ax_ws : x_next;
 
-    // Bu_ws = Bd * u_now   (n~m) * (m~1) = (n~1)
-    status = matrix_ops_multiply(Bu_ws, dsys->Bd, u_now); if (status) CORE_ERROR_RETURN(status);
+    // acc = Ad * x_now
+    status = matrix_ops_gemv(acc, 1.0, dsys->Ad, MATRIX_NO_TRANS, x_now, 0.0);
+    if (status) CORE_ERROR_RETURN(status);
+
+    // acc += Bd * u_now   (n~m) * (m~1) = (n~1)
+    status = matrix_ops_gemv(acc, 1.0, dsys->Bd, MATRIX_NO_TRANS, u_now, 1.0);
+    if (status) CORE_ERROR_RETURN(status);
 
-    // x_next = Ax_ws + Bu_ws
-    status = matrix_ops_add(x_next, Ax_ws, Bu_ws); if (status) CORE_ERROR_RETURN(status);
+    if (acc != x_next) {
+        status = matrix_ops_copy(x_next, acc); if (status) CORE_ERROR_RETURN(status);
+    }
 
     CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
 }
@@ -166,16 +173,8 @@ CoreErrorStatus ss_discrete_step_scalar_u(const SSDiscrete* dsys,
     // x_next = Ad * x_now
     status = matrix_ops_multiply(x_next, dsys->Ad, x_now); if (status) CORE_ERROR_RETURN(status);
 
-    // x_next += u * Bd(:,0)
-    // Use temporary copy of Bd(:,0)
-    Matrix* Bu = matrix_core_create(n, 1, &status); if (status) CORE_ERROR_RETURN(status);
-
-    // Bu = Bd(:,0)
-    for (int r = 0; r < n; ++r) Bu->data[r] = dsys->Bd->data[r * dsys->m + 0];
-
-    status = matrix_ops_scale(Bu, u_now); if (status) { matrix_core_free(Bu); CORE_ERROR_RETURN(status); }
-    status = matrix_ops_add(x_next, x_next, Bu);
-    matrix_core_free(Bu);
+    // x_next += u * Bd   (Bd is n~1 when m == 1)
+    status = matrix_ops_axpy(x_next, u_now, dsys->Bd);
 
     CORE_ERROR_RETURN(status);
 }
@@ -201,14 +200,12 @@ CoreErrorStatus ss_discrete_output(const SSDiscrete* dsys,
     CoreErrorStatus st = CORE_ERROR_SUCCESS;
 
     // y_out = C * x_now
-    st = matrix_ops_multiply(y_out, dsys->C, x_now); if (st) return st;
+    st = matrix_ops_gemv(y_out, 1.0, dsys->C, MATRIX_NO_TRANS, x_now, 0.0);
+    if (st) return st;
 
-    // + D * u_now iD ΁j
+    // y_out += D * u_now (if D is present), accumulated in place
     if (dsys->D) {
-        Matrix* Du = matrix_core_create(p, 1, &st); if (st) return st;
-        st = matrix_ops_multiply(Du, dsys->D, u_now);
-        if (!st) st = matrix_ops_add(y_out, y_out, Du);
-        matrix_core_free(Du);
+        st = matrix_ops_gemv(y_out, 1.0, dsys->D, MATRIX_NO_TRANS, u_now, 1.0);
         if (st) return st;
     }
     return CORE_ERROR_SUCCESS;
@@ -0,0 +1,125 @@
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include "core_error.h"
+
+/*
+ * =============================================================================
+ *  core_arena.h
+ * =============================================================================
+ *
+ *  Description:
+ *      Bump allocator for short-lived matrix temporaries. Memory is carved
+ *      from large blocks and handed back all at once, either entirely or
+ *      down to a previously taken mark, in O(1).
+ *
+ *  Features:
+ *      - 64-byte aligned allocations
+ *      - Mark / reset for scoped (stack-like) lifetimes
+ *      - Grows by chaining blocks; blocks are kept and reused after a reset
+ *      - A single up-front block when the total size is known
+ *
+ * =============================================================================
+ */
+
+//------------------------------------------------
+//  Macro definitions
+//------------------------------------------------
+
+/** Alignment (bytes) of every pointer returned by the arena. */
+#define MATRIX_ARENA_ALIGNMENT 64
+
+/** Block size used when matrix_arena_init() is given 0. */
+#define MATRIX_ARENA_DEFAULT_BLOCK_BYTES ((size_t)64 * 1024)
+
+//------------------------------------------------
+//  Type definitions
+//------------------------------------------------
+
+typedef struct MatrixArenaBlock MatrixArenaBlock;
+
+/**
+ * @brief Bump allocator. Zero-initialize or call matrix_arena_init() before use.
+ *
+ * Not thread-safe; use one arena per thread or per request.
+ */
+typedef struct {
+    MatrixArenaBlock* head;     ///< First block of the chain
+    MatrixArenaBlock* current;  ///< Block allocations are served from
+    size_t block_bytes;         ///< Minimum size of newly chained blocks
+} MatrixArena;
+
+/**
+ * @brief Allocation position returned by matrix_arena_mark().
+ */
+typedef struct {
+    MatrixArenaBlock* block;
+    size_t used;
+} MatrixArenaMark;
+
+//------------------------------------------------
+//  Function Prototypes
+//------------------------------------------------
+
+/**
+ * @brief Initialize an arena and allocate its first block.
+ *
+ * @param arena        Arena to initialize.
+ * @param block_bytes  Size of the first block and minimum size of later ones
+ *                     (0 selects MATRIX_ARENA_DEFAULT_BLOCK_BYTES). Pass the
+ *                     exact total from matrix_arena_bytes_for() sums to get
+ *                     a single allocation.
+ * @return CORE_ERROR_SUCCESS on success
+ * @return CORE_ERROR_NULL if arena is NULL
+ * @return CORE_ERROR_ALLOCATION_FAILED if the first block cannot be allocated
+ */
+CoreErrorStatus matrix_arena_init(MatrixArena* arena, size_t block_bytes);
+
+/**
+ * @brief Free every block of the arena and reset it to empty.
+ *
+ * Everything allocated from the arena becomes invalid.
+ */
+CoreErrorStatus matrix_arena_destroy(MatrixArena* arena);
+
+/**
+ * @brief Allocate bytes from the arena (64-byte aligned, uninitialized).
+ *
+ * @param arena  Arena to allocate from.
+ * @param bytes  Requested size; 0 is treated as 1.
+ * @param err    Receives the status (can be NULL).
+ * @return Pointer to the memory, or NULL on failure.
+ */
+void* matrix_arena_alloc(MatrixArena* arena, size_t bytes, CoreErrorStatus* err);
+
+/**
+ * @brief Record the current allocation position.
+ */
+MatrixArenaMark matrix_arena_mark(const MatrixArena* arena);
+
+/**
+ * @brief Release everything allocated after mark was taken, in O(1).
+ *
+ * The mark must come from this arena and must not predate an earlier reset
+ * below it. Blocks are kept for reuse.
+ */
+CoreErrorStatus matrix_arena_reset(MatrixArena* arena, MatrixArenaMark mark);
+
+/**
+ * @brief Release every allocation of the arena, in O(1). Blocks are kept.
+ */
+CoreErrorStatus matrix_arena_clear(MatrixArena* arena);
+
+/**
+ * @brief Arena footprint of one allocation of the given size (including
+ *        alignment padding); sum these to size an arena up front.
+ */
+size_t matrix_arena_bytes_for(size_t bytes);
+
+#ifdef __cplusplus
+}
+#endif
@@ -7,6 +7,7 @@ extern "C" {
 #include <stdlib.h>
 #include <stdio.h> // For fprintf in macros
 #include "core_error.h"
+#include "core_arena.h"
 
 /*
  * =============================================================================
@@ -18,7 +19,10 @@ extern "C" {
  *      for matrix operations in C.
  *
  *  Features:
- *      - Creation and deletion of matrices
+ *      - Creation and deletion of matrices (header and data in one
+ *        cache-line-aligned block, optional row padding)
+ *      - Creation of temporaries inside a MatrixArena
+ *      - Non-owning strided views of sub-blocks and external buffers
  *      - Matrix addition, subtraction, and multiplication
  *      - Matrix transposition
  *      - Scalar operations on matrices
@@ -30,6 +34,13 @@ extern "C" {
 //  Macro definitions
 //------------------------------------------------
 
+/** Alignment (bytes) of the data buffer of every heap-allocated matrix. */
+#define MATRIX_CORE_ALIGNMENT 64
+
+/** Row padding granularity (doubles) of matrix_core_create_padded(): one
+    cache line, i.e. one AVX-512 register. */
+#define MATRIX_CORE_PAD_DOUBLES (MATRIX_CORE_ALIGNMENT / (int)sizeof(double))
+
 //------------------------------------------------
 //  Type definitions
 //------------------------------------------------
@@ -37,15 +48,28 @@ extern "C" {
 /**
  * @brief Structure representing a 2D matrix.
  *
- * The matrix is stored in row-major order as a 1D array:
- * element at (i, j) is located at data[i * cols + j].
+ * The matrix is stored in row-major order as a 1D array with leading
+ * dimension (row stride) ld >= cols: element at (i, j) is located at
+ * data[i * ld + j]. ld == cols unless the matrix was created padded.
  */
 typedef struct {
     int rows;
     int cols;
-    double* data;  // Row-major: data[i * cols + j]
+    int ld;        // Row stride in elements (>= cols)
+    double* data;  // Row-major: data[i * ld + j]
 } Matrix;
 
+/**
+ * @brief Non-owning view of a sub-block of a matrix or of an external buffer.
+ *
+ * A view has exactly the layout of a Matrix (data pointer, rows, cols and
+ * row stride ld), so it can be passed to every routine that takes a Matrix*
+ * and reads/writes the parent's storage in place. Views are plain values:
+ * they own nothing and must never be passed to matrix_core_free(). A view
+ * is valid only as long as the storage it refers to.
+ */
+typedef Matrix MatrixView;
+
 //------------------------------------------------
 //  Function Prototypes
 //------------------------------------------------
@@ -69,6 +93,55 @@ Matrix* matrix_core_create(int rows, int cols, CoreErrorStatus* err);
  */
 Matrix* matrix_core_create_square(int size, CoreErrorStatus* err);
 
+/**
+ * @brief Create a matrix whose rows are padded to MATRIX_CORE_PAD_DOUBLES.
+ *
+ * ld is cols rounded up to a multiple of MATRIX_CORE_PAD_DOUBLES (column
+ * vectors are not padded), so every row starts on a cache-line boundary
+ * and no two rows share a cache line. The padding is never read.
+ *
+ * @param rows Number of rows.
+ * @param cols Number of columns.
+ * @param err Pointer to CoreErrorStatus for storing error code (can be NULL).
+ * @return Pointer to allocated Matrix, or NULL on failure.
+ */
+Matrix* matrix_core_create_padded(int rows, int cols, CoreErrorStatus* err);
+
+/**
+ * @brief Whether the elements of mat are stored without gaps (ld == cols,
+ *        or a single row).
+ */
+int matrix_core_is_contiguous(const Matrix* mat);
+
+/**
+ * @brief View the rows x cols block of parent starting at (row, col).
+ *
+ * @param view    Receives the view (stride = parent->ld).
+ * @param parent  Matrix (or view) the block is taken from.
+ * @param row     First row of the block.
+ * @param col     First column of the block.
+ * @param rows    Number of rows of the block (> 0).
+ * @param cols    Number of columns of the block (> 0).
+ * @return CORE_ERROR_SUCCESS on success
+ * @return CORE_ERROR_NULL if view, parent or its data is NULL
+ * @return CORE_ERROR_INVALID_ARG if an offset is negative or a size is not positive
+ * @return CORE_ERROR_OUT_OF_BOUNDS if the block does not fit inside parent
+ */
+CoreErrorStatus matrix_view_block(MatrixView* view, const Matrix* parent,
+    int row, int col, int rows, int cols);
+
+/**
+ * @brief View an external row-major buffer as a rows x cols matrix.
+ *
+ * @param view    Receives the view.
+ * @param data    First element of the buffer.
+ * @param rows    Number of rows (> 0).
+ * @param cols    Number of columns (> 0).
+ * @param stride  Distance in elements between consecutive rows (>= cols).
+ * @return CORE_ERROR_SUCCESS, CORE_ERROR_NULL or CORE_ERROR_INVALID_ARG
+ */
+CoreErrorStatus matrix_view_of(MatrixView* view, double* data, int rows, int cols, int stride);
+
 /**
  * @brief Free the memory associated with a matrix.
  *
@@ -77,6 +150,29 @@ Matrix* matrix_core_create_square(int size, CoreErrorStatus* err);
  */
 CoreErrorStatus matrix_core_free(Matrix* mat);
 
+/**
+ * @brief Create a matrix whose header and data live in an arena.
+ *
+ * The matrix is released together with the arena (reset/clear/destroy) and
+ * must NOT be passed to matrix_core_free(). The data pointer is
+ * MATRIX_ARENA_ALIGNMENT-aligned.
+ *
+ * @param arena Arena to allocate from.
+ * @param rows Number of rows.
+ * @param cols Number of columns.
+ * @param err Pointer to CoreErrorStatus for storing error code (can be NULL).
+ * @return Pointer to the matrix, or NULL on failure.
+ */
+Matrix* matrix_core_create_in(MatrixArena* arena, int rows, int cols, CoreErrorStatus* err);
+
+/**
+ * @brief Arena footprint of matrix_core_create_in(arena, rows, cols, ...).
+ *
+ * Sum these (plus matrix_arena_bytes_for() for other buffers) to size an
+ * arena that serves a whole computation from a single block.
+ */
+size_t matrix_core_bytes_in(int rows, int cols);
+
 #ifdef __cplusplus
 }
 #endif
\ No newline at end of file
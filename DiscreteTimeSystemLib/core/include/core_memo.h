@@ -0,0 +1,172 @@
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+#include "core_error.h"
+#include "core_matrix.h"
+
+/*
+ * =============================================================================
+ *  core_memo.h
+ * =============================================================================
+ *
+ *  Description:
+ *      Content-addressed memoization of matrix functions. A result is filed
+ *      under a 64-bit hash of the argument bytes (matrix entries, shapes, a
+ *      scalar such as t and a per-function tag) and served again when the
+ *      same arguments come back, e.g. when a sweep rediscretizes the same
+ *      (A, B, Ts) many times.
+ *
+ *  Features:
+ *      - Bounded by entry count and by bytes; least recently used entries go first
+ *      - Thread-safe: one cache may be shared by any number of threads
+ *      - Hits are verified against the stored arguments (no false hits on a
+ *        hash collision), copy the stored result and never allocate
+ *      - Hit / miss / eviction counters
+ *      - Opt-in process-wide cache (core_memo_set_default()) consulted by
+ *        matrix_exp_exponential() and state_space_c2d()
+ *
+ *  Notes:
+ *      - A cached result is the bytes the uncached call produced, so results
+ *        are bit-identical with and without a cache.
+ *      - Arguments are compared bit for bit: -0.0 and 0.0 are different keys.
+ * =============================================================================
+ */
+
+//------------------------------------------------
+//  Macro definitions
+//------------------------------------------------
+
+/** Most matrices a key or a cached result may hold. */
+#define CORE_MEMO_MAX_MATRICES 2
+
+/** Tags of the memoized library functions (callers may use others). */
+#define CORE_MEMO_TAG_EXPM 1    ///< matrix_exp_exponential(A, t)
+#define CORE_MEMO_TAG_C2D  2    ///< state_space_c2d(A, B, Ts)
+
+//------------------------------------------------
+//  Type definitions
+//------------------------------------------------
+
+/** Opaque cache; create with core_memo_create(). */
+typedef struct CoreMemoCache CoreMemoCache;
+
+/**
+ * @brief Arguments of one call, as the cache sees them.
+ */
+typedef struct {
+    int tag;                                        ///< Which function
+    double t;                                       ///< Scalar argument
+    int count;                                      ///< Matrices used in m (0 .. CORE_MEMO_MAX_MATRICES)
+    const Matrix* m[CORE_MEMO_MAX_MATRICES];        ///< Matrix arguments (any leading dimension)
+} CoreMemoKey;
+
+/**
+ * @brief Counters of a cache since creation or core_memo_reset_stats().
+ */
+typedef struct {
+    uint64_t hits;          ///< Lookups served from the cache
+    uint64_t misses;        ///< Lookups that found nothing
+    uint64_t evictions;     ///< Entries dropped to respect the bounds
+    int entries;            ///< Entries currently held
+    size_t bytes;           ///< Bytes currently held (arguments, results and bookkeeping)
+} CoreMemoStats;
+
+//------------------------------------------------
+//  Function Prototypes
+//------------------------------------------------
+
+/**
+ * @brief Create a cache holding at most max_entries results and max_bytes bytes.
+ *
+ * @param[out] out          New cache (NULL on failure).
+ * @param[in]  max_entries  Entry bound (> 0).
+ * @param[in]  max_bytes    Byte bound (0: entry bound only).
+ *
+ * @return CORE_ERROR_SUCCESS, CORE_ERROR_NULL, CORE_ERROR_INVALID_ARG or
+ *         CORE_ERROR_ALLOCATION_FAILED.
+ */
+CoreErrorStatus core_memo_create(CoreMemoCache** out, int max_entries, size_t max_bytes);
+
+/**
+ * @brief Free a cache and its entries. It must not be in use.
+ *
+ * If the cache is installed as the default cache it is uninstalled first,
+ * so later memoized calls run unmemoized instead of touching freed memory.
+ */
+void core_memo_destroy(CoreMemoCache* cache);
+
+/**
+ * @brief Drop every entry (counted as neither misses nor evictions).
+ */
+CoreErrorStatus core_memo_clear(CoreMemoCache* cache);
+
+/**
+ * @brief Copy the counters.
+ */
+CoreErrorStatus core_memo_get_stats(CoreMemoCache* cache, CoreMemoStats* stats);
+
+/**
+ * @brief Zero the hit, miss and eviction counters.
+ */
+CoreErrorStatus core_memo_reset_stats(CoreMemoCache* cache);
+
+/**
+ * @brief 64-bit hash of a key: tag, bits of t, shapes and matrix entries.
+ *
+ * Streams the rows of each matrix, so views hash like contiguous copies.
+ */
+uint64_t core_memo_hash(const CoreMemoKey* key);
+
+/**
+ * @brief Look a key up and copy the cached result into out.
+ *
+ * On a hit the entry becomes the most recently used one. Nothing is
+ * allocated and out is left untouched on a miss.
+ *
+ * @param[in]  cache  Cache.
+ * @param[in]  key    Arguments.
+ * @param[out] out    count result matrices, shaped as when stored.
+ * @param[in]  count  Number of result matrices (1 .. CORE_MEMO_MAX_MATRICES).
+ * @param[out] hit    1 on a hit, 0 on a miss.
+ *
+ * @return CORE_ERROR_SUCCESS (hit or miss), CORE_ERROR_NULL or
+ *         CORE_ERROR_INVALID_ARG for a malformed key.
+ */
+CoreErrorStatus core_memo_lookup(CoreMemoCache* cache, const CoreMemoKey* key,
+    Matrix* const* out, int count, int* hit);
+
+/**
+ * @brief File a result under a key, evicting least recently used entries
+ *        as needed.
+ *
+ * A key already present is left as it is (its result is the same bytes).
+ * A result that alone exceeds max_bytes is not stored.
+ *
+ * @return CORE_ERROR_SUCCESS, CORE_ERROR_NULL, CORE_ERROR_INVALID_ARG or
+ *         CORE_ERROR_ALLOCATION_FAILED (the cache is unchanged).
+ */
+CoreErrorStatus core_memo_store(CoreMemoCache* cache, const CoreMemoKey* key,
+    const Matrix* const* results, int count);
+
+/**
+ * @brief Install the process-wide cache consulted by the memoized library
+ *        functions (NULL disables memoization, the initial state).
+ *
+ * The pointer is published atomically; calls already running keep using
+ * the cache they started with, so only destroy a cache once they are done.
+ */
+void core_memo_set_default(CoreMemoCache* cache);
+
+/**
+ * @brief Currently installed process-wide cache, or NULL.
+ */
+CoreMemoCache* core_memo_get_default(void);
+
+#ifdef __cplusplus
+}
+#endif
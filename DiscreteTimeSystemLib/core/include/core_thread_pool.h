@@ -0,0 +1,132 @@
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "core_error.h"
+
+/*
+ * =============================================================================
+ *  core_thread_pool.h
+ * =============================================================================
+ *
+ *  Description:
+ *      Process-wide pool of worker threads used by the numerics layer to
+ *      split large kernels (GEMM, element-wise ops) into independent ranges.
+ *      The pool starts with a single worker, i.e. everything runs on the
+ *      calling thread until the application opts in.
+ *
+ *  Features:
+ *      - Configurable worker count (1 = serial, 0 = one per online CPU)
+ *      - parallel_for over [0, count) with a caller-chosen grain
+ *      - Static (deterministic) or dynamic (first-come) range assignment
+ *      - Persistent workers; the calling thread takes part in every loop
+ *      - pthreads on POSIX, Win32 threads on Windows
+ *
+ *  Notes:
+ *      - One parallel_for runs at a time. A call made while the pool is busy
+ *        (from a worker body or another application thread) runs the whole
+ *        range serially on the calling thread instead of waiting.
+ *
+ * =============================================================================
+ */
+
+//------------------------------------------------
+//  Macro definitions
+//------------------------------------------------
+
+/** Upper bound accepted by core_thread_pool_set_workers(). */
+#define CORE_THREAD_POOL_MAX_WORKERS 256
+
+//------------------------------------------------
+//  Type definitions
+//------------------------------------------------
+
+/**
+ * @brief How parallel_for hands ranges to threads.
+ */
+typedef enum {
+    /** One contiguous range per thread; the split depends only on
+        (count, grain, workers), and range i always runs on thread i. */
+    CORE_THREAD_POOL_STATIC = 0,
+    /** Ranges of about count / (4 * workers) are claimed first-come, which
+        balances uneven work at the cost of a run-dependent assignment. */
+    CORE_THREAD_POOL_DYNAMIC = 1
+} CoreThreadPoolSchedule;
+
+/**
+ * @brief Loop body: process indices [begin, end).
+ *
+ * Bodies run concurrently and must only write data owned by their range.
+ * The first non-success status returned by any range is reported by
+ * core_thread_pool_parallel_for(); the other ranges still run.
+ */
+typedef CoreErrorStatus (*CoreParallelFn)(void* ctx, int begin, int end);
+
+//------------------------------------------------
+//  Function Prototypes
+//------------------------------------------------
+
+/**
+ * @brief Resize the pool.
+ *
+ * Waits for a running parallel_for to finish, joins the current workers and
+ * starts workers - 1 new ones.
+ *
+ * @param workers  Total threads including the caller; 1 disables threading,
+ *                 0 selects core_thread_pool_hardware_concurrency().
+ * @return CORE_ERROR_SUCCESS on success
+ * @return CORE_ERROR_INVALID_ARG if workers < 0 or > CORE_THREAD_POOL_MAX_WORKERS
+ * @return CORE_ERROR_ALLOCATION_FAILED if a thread cannot be created (the
+ *         pool keeps the threads that did start)
+ */
+CoreErrorStatus core_thread_pool_set_workers(int workers);
+
+/**
+ * @brief Current worker count (>= 1, including the calling thread).
+ */
+int core_thread_pool_get_workers(void);
+
+/**
+ * @brief Number of online CPUs (>= 1).
+ */
+int core_thread_pool_hardware_concurrency(void);
+
+/**
+ * @brief Select the range assignment (default CORE_THREAD_POOL_STATIC).
+ *
+ * @return CORE_ERROR_SUCCESS, or CORE_ERROR_INVALID_ARG for an unknown value.
+ */
+CoreErrorStatus core_thread_pool_set_schedule(CoreThreadPoolSchedule schedule);
+
+/**
+ * @brief Current range assignment.
+ */
+CoreThreadPoolSchedule core_thread_pool_get_schedule(void);
+
+/**
+ * @brief Run fn over [0, count) split into ranges across the pool.
+ *
+ * Range boundaries are multiples of grain (the last range ends at count),
+ * so callers can keep ranges aligned to their own blocking. Returns after
+ * every range has finished.
+ *
+ * @param count  Number of indices (0 is a no-op).
+ * @param grain  Smallest range size and boundary alignment (0 is treated as 1).
+ * @param fn     Loop body.
+ * @param ctx    Passed to every fn call.
+ * @return CORE_ERROR_SUCCESS, or the first failure returned by fn
+ * @return CORE_ERROR_NULL if fn is NULL
+ * @return CORE_ERROR_INVALID_ARG if count or grain is negative
+ */
+CoreErrorStatus core_thread_pool_parallel_for(int count, int grain, CoreParallelFn fn, void* ctx);
+
+/**
+ * @brief Join all workers (equivalent to core_thread_pool_set_workers(1)).
+ */
+void core_thread_pool_shutdown(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,139 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include "core_arena.h"
+
+struct MatrixArenaBlock {
+    MatrixArenaBlock* next;
+    size_t capacity;     /* usable bytes starting at base */
+    size_t used;
+    unsigned char* base; /* MATRIX_ARENA_ALIGNMENT-aligned start of the payload */
+};
+
+static size_t align_up(size_t v) {
+    return (v + (MATRIX_ARENA_ALIGNMENT - 1)) & ~(size_t)(MATRIX_ARENA_ALIGNMENT - 1);
+}
+
+/* Header and payload share one malloc; the payload is aligned inside it. */
+static MatrixArenaBlock* block_create(size_t capacity) {
+    const size_t total = sizeof(MatrixArenaBlock) + MATRIX_ARENA_ALIGNMENT - 1 + capacity;
+    if (total < capacity) return NULL;
+
+    MatrixArenaBlock* b = (MatrixArenaBlock*)malloc(total);
+    if (!b) return NULL;
+
+    uintptr_t p = (uintptr_t)(b + 1);
+    p = (p + (MATRIX_ARENA_ALIGNMENT - 1)) & ~(uintptr_t)(MATRIX_ARENA_ALIGNMENT - 1);
+    b->next = NULL;
+    b->capacity = capacity;
+    b->used = 0;
+    b->base = (unsigned char*)p;
+    return b;
+}
+
+size_t matrix_arena_bytes_for(size_t bytes) {
+    return align_up(bytes ? bytes : 1);
+}
+
+CoreErrorStatus matrix_arena_init(MatrixArena* arena, size_t block_bytes) {
+    if (!arena) CORE_ERROR_RETURN(CORE_ERROR_NULL);
+
+    arena->block_bytes = block_bytes ? align_up(block_bytes) : MATRIX_ARENA_DEFAULT_BLOCK_BYTES;
+    arena->head = block_create(arena->block_bytes);
+    arena->current = arena->head;
+    if (!arena->head) CORE_ERROR_RETURN(CORE_ERROR_ALLOCATION_FAILED);
+
+    CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
+}
+
+CoreErrorStatus matrix_arena_destroy(MatrixArena* arena) {
+    if (!arena) CORE_ERROR_RETURN(CORE_ERROR_NULL);
+
+    MatrixArenaBlock* b = arena->head;
+    while (b) {
+        MatrixArenaBlock* next = b->next;
+        free(b);
+        b = next;
+    }
+    arena->head = NULL;
+    arena->current = NULL;
+    CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
+}
+
+void* matrix_arena_alloc(MatrixArena* arena, size_t bytes, CoreErrorStatus* err) {
+    CoreErrorStatus dummy;
+    if (!err) err = &dummy;
+    if (!arena) {
+        *err = CORE_ERROR_NULL;
+        CORE_ERROR_SET(CORE_ERROR_NULL);
+        return NULL;
+    }
+
+    const size_t need = matrix_arena_bytes_for(bytes);
+    if (need < bytes) {
+        *err = CORE_ERROR_ALLOCATION_FAILED;
+        CORE_ERROR_SET(CORE_ERROR_ALLOCATION_FAILED);
+        return NULL;
+    }
+
+    MatrixArenaBlock* b = arena->current;
+    if (!b || b->capacity - b->used < need) {
+        /* Move on to the next kept block if it fits, otherwise chain a new one
+           right after the current block. */
+        MatrixArenaBlock* next = b ? b->next : arena->head;
+        if (next && next->capacity >= need) {
+            b = next;
+        }
+        else {
+            if (arena->block_bytes == 0) arena->block_bytes = MATRIX_ARENA_DEFAULT_BLOCK_BYTES;
+            MatrixArenaBlock* nb = block_create(need > arena->block_bytes ? need : arena->block_bytes);
+            if (!nb) {
+                *err = CORE_ERROR_ALLOCATION_FAILED;
+                CORE_ERROR_SET(CORE_ERROR_ALLOCATION_FAILED);
+                return NULL;
+            }
+            nb->next = next;
+            if (b) b->next = nb;
+            else   arena->head = nb;
+            b = nb;
+        }
+        b->used = 0;
+        arena->current = b;
+    }
+
+    void* p = b->base + b->used;
+    b->used += need;
+    *err = CORE_ERROR_SUCCESS;
+    return p;
+}
+
+MatrixArenaMark matrix_arena_mark(const MatrixArena* arena) {
+    MatrixArenaMark mark = { NULL, 0 };
+    if (arena && arena->current) {
+        mark.block = arena->current;
+        mark.used = arena->current->used;
+    }
+    return mark;
+}
+
+CoreErrorStatus matrix_arena_reset(MatrixArena* arena, MatrixArenaMark mark) {
+    if (!arena) CORE_ERROR_RETURN(CORE_ERROR_NULL);
+
+    if (!mark.block) {
+        /* Mark taken on an empty arena: release everything. */
+        arena->current = arena->head;
+        if (arena->head) arena->head->used = 0;
+    }
+    else {
+        if (mark.used > mark.block->capacity) CORE_ERROR_RETURN(CORE_ERROR_INVALID_ARG);
+        arena->current = mark.block;
+        mark.block->used = mark.used;
+    }
+    CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
+}
+
+CoreErrorStatus matrix_arena_clear(MatrixArena* arena) {
+    if (!arena) CORE_ERROR_RETURN(CORE_ERROR_NULL);
+
+    MatrixArenaMark empty = { NULL, 0 };
+    CORE_ERROR_RETURN(matrix_arena_reset(arena, empty));
+}
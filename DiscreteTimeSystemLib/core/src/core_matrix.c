@@ -2,37 +2,87 @@
 #include <stdio.h>
 #include "core_matrix.h"
 
-Matrix* matrix_core_create(int rows, int cols, CoreErrorStatus* err)
+/* Bytes reserved in front of the data for the header (keeps data aligned). */
+#define MATRIX_HEADER_BYTES \
+    (((sizeof(Matrix) + MATRIX_CORE_ALIGNMENT - 1) / MATRIX_CORE_ALIGNMENT) * MATRIX_CORE_ALIGNMENT)
+
+static void* aligned_block_alloc(size_t bytes)
+{
+    /* aligned_alloc requires a size that is a multiple of the alignment */
+    bytes = ((bytes + MATRIX_CORE_ALIGNMENT - 1) / MATRIX_CORE_ALIGNMENT) * MATRIX_CORE_ALIGNMENT;
+#if defined(_MSC_VER)
+    return _aligned_malloc(bytes, MATRIX_CORE_ALIGNMENT);
+#else
+    return aligned_alloc(MATRIX_CORE_ALIGNMENT, bytes);
+#endif
+}
+
+static void aligned_block_free(void* p)
+{
+#if defined(_MSC_VER)
+    _aligned_free(p);
+#else
+    free(p);
+#endif
+}
+
+/* Header and data share one aligned block: [Matrix | pad][rows * ld doubles] */
+static Matrix* create_with_ld(int rows, int cols, int ld, CoreErrorStatus* err)
 {
-    if(rows <= 0 || cols <= 0)
+    CoreErrorStatus dummy;
+    if (!err) err = &dummy;
+    if(rows <= 0 || cols <= 0 || ld < cols)
     {
         *err = CORE_ERROR_OUT_OF_BOUNDS;
         CORE_ERROR_SET(CORE_ERROR_OUT_OF_BOUNDS);
         return NULL;
     }
-    Matrix* mat = (Matrix*)malloc(sizeof(Matrix));
-    if (mat == NULL)
+    const size_t data_bytes = (size_t)rows * (size_t)ld * sizeof(double);
+    if (data_bytes / sizeof(double) / (size_t)rows != (size_t)ld)
     {
         *err = CORE_ERROR_ALLOCATION_FAILED;
         CORE_ERROR_SET(CORE_ERROR_ALLOCATION_FAILED);
         return NULL;
     }
 
-    mat->rows = rows;
-    mat->cols = cols;
-    mat->data = (double*) malloc(rows * cols * sizeof(double));
-    if (mat->data == NULL)
+    unsigned char* block = (unsigned char*)aligned_block_alloc(MATRIX_HEADER_BYTES + data_bytes);
+    if (block == NULL)
     {
-        free(mat);
         *err = CORE_ERROR_ALLOCATION_FAILED;
         CORE_ERROR_SET(CORE_ERROR_ALLOCATION_FAILED);
         return NULL;
     }
 
+    Matrix* mat = (Matrix*)block;
+    mat->rows = rows;
+    mat->cols = cols;
+    mat->ld = ld;
+    mat->data = (double*)(block + MATRIX_HEADER_BYTES);
+
     *err = CORE_ERROR_SUCCESS;
     return mat;
 }
 
+Matrix* matrix_core_create(int rows, int cols, CoreErrorStatus* err)
+{
+    return create_with_ld(rows, cols, cols, err);
+}
+
+Matrix* matrix_core_create_padded(int rows, int cols, CoreErrorStatus* err)
+{
+    int ld = cols;
+    if (cols > 1)
+    {
+        ld = ((cols + MATRIX_CORE_PAD_DOUBLES - 1) / MATRIX_CORE_PAD_DOUBLES) * MATRIX_CORE_PAD_DOUBLES;
+    }
+    return create_with_ld(rows, cols, ld, err);
+}
+
+int matrix_core_is_contiguous(const Matrix* mat)
+{
+    return mat != NULL && (mat->ld == mat->cols || mat->rows == 1);
+}
+
 Matrix* matrix_core_create_square(int size, CoreErrorStatus* err)
 {
     // size must be positive to form a valid square matrix
@@ -52,11 +102,79 @@ CoreErrorStatus matrix_core_free(Matrix* mat)
     {
         CORE_ERROR_RETURN(CORE_ERROR_NULL);
     }
-    free(mat->data);
+    /* The data lives in the same block as the header. */
     mat->data = NULL;
-    free(mat);
-    mat = NULL;
+    aligned_block_free(mat);
 
     CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
 }
 
+size_t matrix_core_bytes_in(int rows, int cols)
+{
+    if (rows <= 0 || cols <= 0) return 0;
+    return matrix_arena_bytes_for(sizeof(Matrix))
+        + matrix_arena_bytes_for((size_t)rows * (size_t)cols * sizeof(double));
+}
+
+Matrix* matrix_core_create_in(MatrixArena* arena, int rows, int cols, CoreErrorStatus* err)
+{
+    CoreErrorStatus dummy;
+    if (!err) err = &dummy;
+    if (arena == NULL)
+    {
+        *err = CORE_ERROR_NULL;
+        CORE_ERROR_SET(CORE_ERROR_NULL);
+        return NULL;
+    }
+    if (rows <= 0 || cols <= 0)
+    {
+        *err = CORE_ERROR_OUT_OF_BOUNDS;
+        CORE_ERROR_SET(CORE_ERROR_OUT_OF_BOUNDS);
+        return NULL;
+    }
+    const size_t data_bytes = (size_t)rows * (size_t)cols * sizeof(double);
+    if (data_bytes / sizeof(double) / (size_t)rows != (size_t)cols)
+    {
+        *err = CORE_ERROR_ALLOCATION_FAILED;
+        CORE_ERROR_SET(CORE_ERROR_ALLOCATION_FAILED);
+        return NULL;
+    }
+
+    Matrix* mat = (Matrix*)matrix_arena_alloc(arena, sizeof(Matrix), err);
+    if (mat == NULL) return NULL;
+
+    mat->rows = rows;
+    mat->cols = cols;
+    mat->ld = cols;
+    mat->data = (double*)matrix_arena_alloc(arena, data_bytes, err);
+    if (mat->data == NULL) return NULL;
+
+    *err = CORE_ERROR_SUCCESS;
+    return mat;
+}
+
+CoreErrorStatus matrix_view_block(MatrixView* view, const Matrix* parent,
+    int row, int col, int rows, int cols)
+{
+    if (!view || !parent || !parent->data) CORE_ERROR_RETURN(CORE_ERROR_NULL);
+    if (row < 0 || col < 0 || rows <= 0 || cols <= 0) CORE_ERROR_RETURN(CORE_ERROR_INVALID_ARG);
+    if (row + rows > parent->rows || col + cols > parent->cols) CORE_ERROR_RETURN(CORE_ERROR_OUT_OF_BOUNDS);
+
+    view->rows = rows;
+    view->cols = cols;
+    view->ld = parent->ld;
+    view->data = parent->data + (size_t)row * (size_t)parent->ld + (size_t)col;
+    CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
+}
+
+CoreErrorStatus matrix_view_of(MatrixView* view, double* data, int rows, int cols, int stride)
+{
+    if (!view || !data) CORE_ERROR_RETURN(CORE_ERROR_NULL);
+    if (rows <= 0 || cols <= 0 || stride < cols) CORE_ERROR_RETURN(CORE_ERROR_INVALID_ARG);
+
+    view->rows = rows;
+    view->cols = cols;
+    view->ld = stride;
+    view->data = data;
+    CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
+}
@@ -0,0 +1,372 @@
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include <stdlib.h>
+#include <string.h>
+#include "core_memo.h"
+
+/* ---------- Platform layer ---------- */
+
+#if defined(_WIN32)
+#include <windows.h>
+
+typedef SRWLOCK MemoMutex;
+
+static void mutex_init(MemoMutex* m) { InitializeSRWLock(m); }
+static void mutex_destroy(MemoMutex* m) { (void)m; }
+static void mutex_lock(MemoMutex* m) { AcquireSRWLockExclusive(m); }
+static void mutex_unlock(MemoMutex* m) { ReleaseSRWLockExclusive(m); }
+
+static void* ptr_load(void* volatile* p) { return InterlockedCompareExchangePointer(p, NULL, NULL); }
+static void ptr_store(void* volatile* p, void* v) { InterlockedExchangePointer(p, v); }
+static void ptr_clear_if(void* volatile* p, void* expected) {
+    InterlockedCompareExchangePointer(p, NULL, expected);
+}
+
+#else
+#include <pthread.h>
+
+typedef pthread_mutex_t MemoMutex;
+
+static void mutex_init(MemoMutex* m) { pthread_mutex_init(m, NULL); }
+static void mutex_destroy(MemoMutex* m) { pthread_mutex_destroy(m); }
+static void mutex_lock(MemoMutex* m) { pthread_mutex_lock(m); }
+static void mutex_unlock(MemoMutex* m) { pthread_mutex_unlock(m); }
+
+static void* ptr_load(void* volatile* p) { return __atomic_load_n(p, __ATOMIC_ACQUIRE); }
+static void ptr_store(void* volatile* p, void* v) { __atomic_store_n(p, v, __ATOMIC_RELEASE); }
+static void ptr_clear_if(void* volatile* p, void* expected) {
+    __atomic_compare_exchange_n(p, &expected, NULL, 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+}
+#endif
+
+/* ---------- Cache state ---------- */
+
+/* One cached call: the argument matrices, then the results, stored as
+   contiguous rows right after the header (one allocation per entry). */
+typedef struct MemoEntry {
+    struct MemoEntry* chain;    /* next entry in the same bucket */
+    struct MemoEntry* newer;    /* LRU list, towards the most recent */
+    struct MemoEntry* older;
+    uint64_t hash;
+    int tag;
+    double t;
+    int nkey;
+    int nres;
+    int shape[2 * CORE_MEMO_MAX_MATRICES][2];   /* rows, cols: keys, then results */
+    size_t bytes;
+    double data[];
+} MemoEntry;
+
+struct CoreMemoCache {
+    MemoMutex lock;             /* guards everything below */
+    MemoEntry** buckets;
+    size_t mask;                /* bucket count - 1 (a power of two) */
+    MemoEntry* newest;
+    MemoEntry* oldest;
+    int max_entries;
+    size_t max_bytes;
+    CoreMemoStats stats;
+};
+
+/* Process-wide default, read on every memoized call: accessed atomically. */
+static void* volatile s_default = NULL;
+
+/* ---------- Hashing ---------- */
+
+static uint64_t hash_word(uint64_t h, uint64_t w) {
+    h ^= w;
+    h *= 0x9E3779B97F4A7C15ull;
+    return h ^ (h >> 29);
+}
+
+/* Final avalanche (MurmurHash3 fmix64). */
+static uint64_t hash_finish(uint64_t h) {
+    h ^= h >> 33;
+    h *= 0xFF51AFD7ED558CCDull;
+    h ^= h >> 33;
+    h *= 0xC4CEB9FE1A85EC53ull;
+    return h ^ (h >> 33);
+}
+
+static uint64_t double_bits(double x) {
+    uint64_t w;
+    memcpy(&w, &x, sizeof w);
+    return w;
+}
+
+uint64_t core_memo_hash(const CoreMemoKey* key) {
+    if (!key) return 0;
+    uint64_t h = hash_word(0x243F6A8885A308D3ull, (uint64_t)(int64_t)key->tag);
+    h = hash_word(h, double_bits(key->t));
+    for (int k = 0; k < key->count && k < CORE_MEMO_MAX_MATRICES; ++k) {
+        const Matrix* M = key->m[k];
+        if (!M || !M->data) continue;
+        h = hash_word(h, ((uint64_t)(uint32_t)M->rows << 32) | (uint32_t)M->cols);
+        for (int i = 0; i < M->rows; ++i) {
+            const double* row = M->data + (size_t)i * M->ld;
+            for (int j = 0; j < M->cols; ++j) h = hash_word(h, double_bits(row[j]));
+        }
+    }
+    return hash_finish(h);
+}
+
+/* ---------- Internal helpers ---------- */
+
+static CoreErrorStatus check_matrices(const Matrix* const* m, int count) {
+    if (count < 0 || count > CORE_MEMO_MAX_MATRICES) return CORE_ERROR_INVALID_ARG;
+    for (int k = 0; k < count; ++k) {
+        if (!m[k] || !m[k]->data) return CORE_ERROR_NULL;
+        if (m[k]->rows < 0 || m[k]->cols < 0) return CORE_ERROR_INVALID_ARG;
+    }
+    return CORE_ERROR_SUCCESS;
+}
+
+static size_t matrices_doubles(const Matrix* const* m, int count) {
+    size_t total = 0;
+    for (int k = 0; k < count; ++k) total += (size_t)m[k]->rows * (size_t)m[k]->cols;
+    return total;
+}
+
+/* Bitwise comparison of the arguments with an entry's copy of them. */
+static int entry_matches(const MemoEntry* e, uint64_t hash, const CoreMemoKey* key) {
+    if (e->hash != hash || e->tag != key->tag || e->nkey != key->count) return 0;
+    if (double_bits(e->t) != double_bits(key->t)) return 0;
+
+    const double* p = e->data;
+    for (int k = 0; k < key->count; ++k) {
+        const Matrix* M = key->m[k];
+        if (e->shape[k][0] != M->rows || e->shape[k][1] != M->cols) return 0;
+        const size_t row_bytes = (size_t)M->cols * sizeof(double);
+        for (int i = 0; i < M->rows; ++i) {
+            if (memcmp(p, M->data + (size_t)i * M->ld, row_bytes) != 0) return 0;
+            p += M->cols;
+        }
+    }
+    return 1;
+}
+
+static MemoEntry* find_locked(const CoreMemoCache* c, uint64_t hash, const CoreMemoKey* key) {
+    for (MemoEntry* e = c->buckets[hash & c->mask]; e; e = e->chain) {
+        if (entry_matches(e, hash, key)) return e;
+    }
+    return NULL;
+}
+
+/* The caller's result buffers have the shapes the entry was stored with. */
+static int results_fit(const MemoEntry* e, Matrix* const* out, int count) {
+    if (e->nres != count) return 0;
+    for (int k = 0; k < count; ++k) {
+        const int* shape = e->shape[e->nkey + k];
+        if (shape[0] != out[k]->rows || shape[1] != out[k]->cols) return 0;
+    }
+    return 1;
+}
+
+static void lru_unlink(CoreMemoCache* c, MemoEntry* e) {
+    if (e->newer) e->newer->older = e->older; else c->newest = e->older;
+    if (e->older) e->older->newer = e->newer; else c->oldest = e->newer;
+    e->newer = e->older = NULL;
+}
+
+static void lru_push_newest(CoreMemoCache* c, MemoEntry* e) {
+    e->newer = NULL;
+    e->older = c->newest;
+    if (c->newest) c->newest->newer = e; else c->oldest = e;
+    c->newest = e;
+}
+
+static void remove_locked(CoreMemoCache* c, MemoEntry* e) {
+    MemoEntry** link = &c->buckets[e->hash & c->mask];
+    while (*link != e) link = &(*link)->chain;
+    *link = e->chain;
+    lru_unlink(c, e);
+    c->stats.entries -= 1;
+    c->stats.bytes -= e->bytes;
+    free(e);
+}
+
+static int over_bounds(const CoreMemoCache* c) {
+    return c->stats.entries > c->max_entries
+        || (c->max_bytes > 0 && c->stats.bytes > c->max_bytes);
+}
+
+static void copy_out(const double* p, Matrix* M) {
+    const size_t row_bytes = (size_t)M->cols * sizeof(double);
+    for (int i = 0; i < M->rows; ++i) {
+        memcpy(M->data + (size_t)i * M->ld, p, row_bytes);
+        p += M->cols;
+    }
+}
+
+static double* copy_in(double* p, const Matrix* M) {
+    const size_t row_bytes = (size_t)M->cols * sizeof(double);
+    for (int i = 0; i < M->rows; ++i) {
+        memcpy(p, M->data + (size_t)i * M->ld, row_bytes);
+        p += M->cols;
+    }
+    return p;
+}
+
+/* ---------- Public API ---------- */
+
+CoreErrorStatus core_memo_create(CoreMemoCache** out, int max_entries, size_t max_bytes) {
+    if (!out) CORE_ERROR_RETURN(CORE_ERROR_NULL);
+    *out = NULL;
+    if (max_entries <= 0) CORE_ERROR_RETURN(CORE_ERROR_INVALID_ARG);
+
+    size_t nbuckets = 16;
+    while (nbuckets < (size_t)max_entries) nbuckets *= 2;
+
+    CoreMemoCache* c = (CoreMemoCache*)calloc(1, sizeof *c);
+    if (!c) CORE_ERROR_RETURN(CORE_ERROR_ALLOCATION_FAILED);
+    c->buckets = (MemoEntry**)calloc(nbuckets, sizeof *c->buckets);
+    if (!c->buckets) {
+        free(c);
+        CORE_ERROR_RETURN(CORE_ERROR_ALLOCATION_FAILED);
+    }
+    mutex_init(&c->lock);
+    c->mask = nbuckets - 1;
+    c->max_entries = max_entries;
+    c->max_bytes = max_bytes;
+    *out = c;
+    CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
+}
+
+void core_memo_destroy(CoreMemoCache* cache) {
+    if (!cache) return;
+    ptr_clear_if(&s_default, cache);    /* never leave a dangling default */
+    core_memo_clear(cache);
+    mutex_destroy(&cache->lock);
+    free(cache->buckets);
+    free(cache);
+}
+
+CoreErrorStatus core_memo_clear(CoreMemoCache* cache) {
+    if (!cache) CORE_ERROR_RETURN(CORE_ERROR_NULL);
+    mutex_lock(&cache->lock);
+    while (cache->oldest) remove_locked(cache, cache->oldest);
+    mutex_unlock(&cache->lock);
+    CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
+}
+
+CoreErrorStatus core_memo_get_stats(CoreMemoCache* cache, CoreMemoStats* stats) {
+    if (!cache || !stats) CORE_ERROR_RETURN(CORE_ERROR_NULL);
+    mutex_lock(&cache->lock);
+    *stats = cache->stats;
+    mutex_unlock(&cache->lock);
+    CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
+}
+
+CoreErrorStatus core_memo_reset_stats(CoreMemoCache* cache) {
+    if (!cache) CORE_ERROR_RETURN(CORE_ERROR_NULL);
+    mutex_lock(&cache->lock);
+    cache->stats.hits = 0;
+    cache->stats.misses = 0;
+    cache->stats.evictions = 0;
+    mutex_unlock(&cache->lock);
+    CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
+}
+
+CoreErrorStatus core_memo_lookup(CoreMemoCache* cache, const CoreMemoKey* key,
+    Matrix* const* out, int count, int* hit)
+{
+    if (hit) *hit = 0;
+    if (!cache || !key || !out || !hit) CORE_ERROR_RETURN(CORE_ERROR_NULL);
+    CoreErrorStatus status = check_matrices(key->m, key->count);
+    if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+    if (count < 1) CORE_ERROR_RETURN(CORE_ERROR_INVALID_ARG);
+    status = check_matrices((const Matrix* const*)out, count);
+    if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+
+    /* Hashing reads only the caller's data: done before taking the lock */
+    const uint64_t hash = core_memo_hash(key);
+
+    mutex_lock(&cache->lock);
+    MemoEntry* e = find_locked(cache, hash, key);
+    if (!e || !results_fit(e, out, count)) {
+        cache->stats.misses += 1;
+        mutex_unlock(&cache->lock);
+        CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
+    }
+
+    const double* p = e->data;
+    for (int k = 0; k < e->nkey; ++k) p += (size_t)e->shape[k][0] * e->shape[k][1];
+    for (int k = 0; k < count; ++k) {
+        copy_out(p, out[k]);
+        p += (size_t)out[k]->rows * out[k]->cols;
+    }
+    lru_unlink(cache, e);
+    lru_push_newest(cache, e);
+    cache->stats.hits += 1;
+    mutex_unlock(&cache->lock);
+
+    *hit = 1;
+    CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
+}
+
+CoreErrorStatus core_memo_store(CoreMemoCache* cache, const CoreMemoKey* key,
+    const Matrix* const* results, int count)
+{
+    if (!cache || !key || !results) CORE_ERROR_RETURN(CORE_ERROR_NULL);
+    CoreErrorStatus status = check_matrices(key->m, key->count);
+    if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+    if (count < 1) CORE_ERROR_RETURN(CORE_ERROR_INVALID_ARG);
+    status = check_matrices(results, count);
+    if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+
+    const size_t doubles = matrices_doubles(key->m, key->count) + matrices_doubles(results, count);
+    const size_t bytes = sizeof(MemoEntry) + doubles * sizeof(double);
+    if (cache->max_bytes > 0 && bytes > cache->max_bytes) CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
+
+    /* Built outside the lock; dropped again if another thread got there first */
+    MemoEntry* e = (MemoEntry*)malloc(bytes);
+    if (!e) CORE_ERROR_RETURN(CORE_ERROR_ALLOCATION_FAILED);
+    memset(e, 0, sizeof *e);
+    e->hash = core_memo_hash(key);
+    e->tag = key->tag;
+    e->t = key->t;
+    e->nkey = key->count;
+    e->nres = count;
+    e->bytes = bytes;
+    double* p = e->data;
+    for (int k = 0; k < key->count; ++k) {
+        e->shape[k][0] = key->m[k]->rows;
+        e->shape[k][1] = key->m[k]->cols;
+        p = copy_in(p, key->m[k]);
+    }
+    for (int k = 0; k < count; ++k) {
+        e->shape[key->count + k][0] = results[k]->rows;
+        e->shape[key->count + k][1] = results[k]->cols;
+        p = copy_in(p, results[k]);
+    }
+
+    mutex_lock(&cache->lock);
+    if (find_locked(cache, e->hash, key)) {
+        mutex_unlock(&cache->lock);
+        free(e);
+        CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
+    }
+    MemoEntry** bucket = &cache->buckets[e->hash & cache->mask];
+    e->chain = *bucket;
+    *bucket = e;
+    lru_push_newest(cache, e);
+    cache->stats.entries += 1;
+    cache->stats.bytes += bytes;
+
+    while (over_bounds(cache) && cache->oldest != e) {
+        remove_locked(cache, cache->oldest);
+        cache->stats.evictions += 1;
+    }
+    mutex_unlock(&cache->lock);
+    CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
+}
+
+void core_memo_set_default(CoreMemoCache* cache) {
+    ptr_store(&s_default, cache);
+}
+
+CoreMemoCache* core_memo_get_default(void) {
+    return (CoreMemoCache*)ptr_load(&s_default);
+}
@@ -0,0 +1,300 @@
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include <stdint.h>
+#include "core_thread_pool.h"
+
+/* ---------- Platform layer ---------- */
+
+#if defined(_WIN32)
+#include <windows.h>
+#include <process.h>
+
+typedef HANDLE PoolThread;
+typedef SRWLOCK PoolMutex;
+typedef CONDITION_VARIABLE PoolCond;
+#define POOL_MUTEX_INIT SRWLOCK_INIT
+#define POOL_COND_INIT CONDITION_VARIABLE_INIT
+
+static void mutex_lock(PoolMutex* m) { AcquireSRWLockExclusive(m); }
+static int mutex_trylock(PoolMutex* m) { return TryAcquireSRWLockExclusive(m) != 0; }
+static void mutex_unlock(PoolMutex* m) { ReleaseSRWLockExclusive(m); }
+static void cond_wait(PoolCond* c, PoolMutex* m) { SleepConditionVariableSRW(c, m, INFINITE, 0); }
+static void cond_broadcast(PoolCond* c) { WakeAllConditionVariable(c); }
+
+static void worker_main(int id);
+static unsigned __stdcall thread_entry(void* arg) {
+    worker_main((int)(intptr_t)arg);
+    return 0;
+}
+static int thread_start(PoolThread* t, int id) {
+    uintptr_t h = _beginthreadex(NULL, 0, thread_entry, (void*)(intptr_t)id, 0, NULL);
+    if (h == 0) return 0;
+    *t = (HANDLE)h;
+    return 1;
+}
+static void thread_join(PoolThread t) {
+    WaitForSingleObject(t, INFINITE);
+    CloseHandle(t);
+}
+static int cpu_count(void) {
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return (int)info.dwNumberOfProcessors;
+}
+
+#else
+#include <pthread.h>
+#include <unistd.h>
+
+typedef pthread_t PoolThread;
+typedef pthread_mutex_t PoolMutex;
+typedef pthread_cond_t PoolCond;
+#define POOL_MUTEX_INIT PTHREAD_MUTEX_INITIALIZER
+#define POOL_COND_INIT PTHREAD_COND_INITIALIZER
+
+static void mutex_lock(PoolMutex* m) { pthread_mutex_lock(m); }
+static int mutex_trylock(PoolMutex* m) { return pthread_mutex_trylock(m) == 0; }
+static void mutex_unlock(PoolMutex* m) { pthread_mutex_unlock(m); }
+static void cond_wait(PoolCond* c, PoolMutex* m) { pthread_cond_wait(c, m); }
+static void cond_broadcast(PoolCond* c) { pthread_cond_broadcast(c); }
+
+static void worker_main(int id);
+static void* thread_entry(void* arg) {
+    worker_main((int)(intptr_t)arg);
+    return NULL;
+}
+static int thread_start(PoolThread* t, int id) {
+    return pthread_create(t, NULL, thread_entry, (void*)(intptr_t)id) == 0;
+}
+static void thread_join(PoolThread t) {
+    pthread_join(t, NULL);
+}
+static int cpu_count(void) {
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return n > 0 ? (int)n : 1;
+}
+#endif
+
+/* ---------- Pool state ---------- */
+
+typedef struct {
+    CoreParallelFn fn;
+    void* ctx;
+    int count;
+    int grain;
+    int blocks;          /* ceil(count / grain) */
+    int ranges;          /* number of ranges the blocks are split into */
+    CoreThreadPoolSchedule schedule;
+    int next;            /* dynamic: next unclaimed range */
+    int active;          /* threads (caller included) still working on the job */
+    CoreErrorStatus status;
+} PoolJob;
+
+/* Held for the whole of a parallel_for or a resize, so jobs never overlap. */
+static PoolMutex s_call_lock = POOL_MUTEX_INIT;
+
+/* Guards everything below. */
+static PoolMutex s_lock = POOL_MUTEX_INIT;
+static PoolCond s_wake = POOL_COND_INIT;
+static PoolCond s_done = POOL_COND_INIT;
+static PoolThread s_threads[CORE_THREAD_POOL_MAX_WORKERS];
+static int s_workers = 1;
+static CoreThreadPoolSchedule s_schedule = CORE_THREAD_POOL_STATIC;
+static unsigned s_generation = 0;        /* bumped once per posted job */
+static unsigned s_start_generation = 0;  /* generation seen by freshly started workers */
+static int s_stop = 0;
+static PoolJob s_job;
+
+/* ---------- Internal helpers ---------- */
+
+/* Range r covers blocks [r * blocks / ranges, (r + 1) * blocks / ranges). */
+static void range_bounds(const PoolJob* job, int r, int* begin, int* end) {
+    const long long b0 = (long long)r * job->blocks / job->ranges;
+    const long long b1 = (long long)(r + 1) * job->blocks / job->ranges;
+    const long long e = b1 * job->grain;
+    *begin = (int)(b0 * job->grain);
+    *end = e < job->count ? (int)e : job->count;
+}
+
+static void run_range(int r) {
+    int begin, end;
+    range_bounds(&s_job, r, &begin, &end);
+    if (begin >= end) return;
+
+    CoreErrorStatus status = s_job.fn(s_job.ctx, begin, end);
+    if (status != CORE_ERROR_SUCCESS) {
+        mutex_lock(&s_lock);
+        if (s_job.status == CORE_ERROR_SUCCESS) s_job.status = status;
+        mutex_unlock(&s_lock);
+    }
+}
+
+/* Job fields are published under s_lock before the generation bump, so they
+   can be read here without the lock. */
+static void run_share(int id) {
+    if (s_job.schedule == CORE_THREAD_POOL_STATIC) {
+        if (id < s_job.ranges) run_range(id);
+        return;
+    }
+    for (;;) {
+        mutex_lock(&s_lock);
+        const int r = s_job.next++;
+        mutex_unlock(&s_lock);
+        if (r >= s_job.ranges) break;
+        run_range(r);
+    }
+}
+
+static void worker_main(int id) {
+    mutex_lock(&s_lock);
+    unsigned seen = s_start_generation;
+    for (;;) {
+        while (!s_stop && s_generation == seen) cond_wait(&s_wake, &s_lock);
+        if (s_stop) break;
+        seen = s_generation;
+        mutex_unlock(&s_lock);
+
+        run_share(id);
+
+        mutex_lock(&s_lock);
+        if (--s_job.active == 0) cond_broadcast(&s_done);
+    }
+    mutex_unlock(&s_lock);
+}
+
+/* Caller holds s_call_lock. */
+static void stop_workers(void) {
+    mutex_lock(&s_lock);
+    s_stop = 1;
+    cond_broadcast(&s_wake);
+    const int workers = s_workers;
+    mutex_unlock(&s_lock);
+
+    for (int i = 1; i < workers; ++i) thread_join(s_threads[i]);
+
+    mutex_lock(&s_lock);
+    s_stop = 0;
+    s_workers = 1;
+    mutex_unlock(&s_lock);
+}
+
+/* Caller holds s_call_lock and the pool is stopped. */
+static int start_workers(int workers) {
+    mutex_lock(&s_lock);
+    s_start_generation = s_generation;
+    mutex_unlock(&s_lock);
+
+    int started = 1;
+    while (started < workers && thread_start(&s_threads[started], started)) ++started;
+
+    mutex_lock(&s_lock);
+    s_workers = started;
+    mutex_unlock(&s_lock);
+    return started;
+}
+
+/* ---------- Public API ---------- */
+
+int core_thread_pool_hardware_concurrency(void) {
+    const int n = cpu_count();
+    if (n < 1) return 1;
+    return n > CORE_THREAD_POOL_MAX_WORKERS ? CORE_THREAD_POOL_MAX_WORKERS : n;
+}
+
+CoreErrorStatus core_thread_pool_set_workers(int workers) {
+    if (workers < 0 || workers > CORE_THREAD_POOL_MAX_WORKERS) CORE_ERROR_RETURN(CORE_ERROR_INVALID_ARG);
+    if (workers == 0) workers = core_thread_pool_hardware_concurrency();
+
+    mutex_lock(&s_call_lock);
+    CoreErrorStatus status = CORE_ERROR_SUCCESS;
+    if (workers != s_workers) {
+        stop_workers();
+        if (start_workers(workers) != workers) status = CORE_ERROR_ALLOCATION_FAILED;
+    }
+    mutex_unlock(&s_call_lock);
+    CORE_ERROR_RETURN(status);
+}
+
+int core_thread_pool_get_workers(void) {
+    mutex_lock(&s_lock);
+    const int workers = s_workers;
+    mutex_unlock(&s_lock);
+    return workers;
+}
+
+CoreErrorStatus core_thread_pool_set_schedule(CoreThreadPoolSchedule schedule) {
+    if (schedule != CORE_THREAD_POOL_STATIC && schedule != CORE_THREAD_POOL_DYNAMIC) {
+        CORE_ERROR_RETURN(CORE_ERROR_INVALID_ARG);
+    }
+    mutex_lock(&s_lock);
+    s_schedule = schedule;
+    mutex_unlock(&s_lock);
+    CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
+}
+
+CoreThreadPoolSchedule core_thread_pool_get_schedule(void) {
+    mutex_lock(&s_lock);
+    const CoreThreadPoolSchedule schedule = s_schedule;
+    mutex_unlock(&s_lock);
+    return schedule;
+}
+
+CoreErrorStatus core_thread_pool_parallel_for(int count, int grain, CoreParallelFn fn, void* ctx) {
+    if (!fn) CORE_ERROR_RETURN(CORE_ERROR_NULL);
+    if (count < 0 || grain < 0) CORE_ERROR_RETURN(CORE_ERROR_INVALID_ARG);
+    if (grain == 0) grain = 1;
+    if (count == 0) CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
+
+    /* Busy (nested call or another application thread): run inline. */
+    if (!mutex_trylock(&s_call_lock)) {
+        CoreErrorStatus status = fn(ctx, 0, count);
+        CORE_ERROR_RETURN(status);
+    }
+
+    mutex_lock(&s_lock);
+    const int workers = s_workers;
+    const CoreThreadPoolSchedule schedule = s_schedule;
+    const int blocks = count / grain + (count % grain != 0);
+    const int want = (schedule == CORE_THREAD_POOL_STATIC) ? workers : 4 * workers;
+    const int ranges = blocks < want ? blocks : want;
+
+    if (workers == 1 || ranges == 1) {
+        mutex_unlock(&s_lock);
+        mutex_unlock(&s_call_lock);
+        CoreErrorStatus status = fn(ctx, 0, count);
+        CORE_ERROR_RETURN(status);
+    }
+
+    s_job.fn = fn;
+    s_job.ctx = ctx;
+    s_job.count = count;
+    s_job.grain = grain;
+    s_job.blocks = blocks;
+    s_job.ranges = ranges;
+    s_job.schedule = schedule;
+    s_job.next = 0;
+    s_job.active = workers;
+    s_job.status = CORE_ERROR_SUCCESS;
+    ++s_generation;
+    cond_broadcast(&s_wake);
+    mutex_unlock(&s_lock);
+
+    run_share(0);
+
+    mutex_lock(&s_lock);
+    --s_job.active;
+    while (s_job.active > 0) cond_wait(&s_done, &s_lock);
+    const CoreErrorStatus status = s_job.status;
+    mutex_unlock(&s_lock);
+
+    mutex_unlock(&s_call_lock);
+    CORE_ERROR_RETURN(status);
+}
+
+void core_thread_pool_shutdown(void) {
+    mutex_lock(&s_call_lock);
+    stop_workers();
+    mutex_unlock(&s_call_lock);
+}
@@ -0,0 +1,134 @@
+#pragma once
+
+#include "core_matrix.h"
+#include "core_error.h"
+#include "core_arena.h"
+#include "matrix_linop.h"
+#include "pade.h"
+
+/*
+ * =============================================================================
+ *  krylov.h
+ * =============================================================================
+ *
+ *  Description:
+ *      Krylov-subspace propagator w = exp(tA) v for large (sparse or
+ *      matrix-free) A, after Sidje's Expokit expv. Each step builds an
+ *      m-dimensional Arnoldi basis of A and v, exponentiates only the small
+ *      (m+2) x (m+2) Hessenberg matrix with pade_expm(), and restarts from
+ *      the propagated vector until t is reached.
+ *
+ *  Features:
+ *      - Matrix-free: A enters only through a MatrixLinearOperator
+ *        (matrix_linop_dense() for dense A, or a sparse / stencil callback)
+ *      - Arnoldi with classical Gram-Schmidt applied twice, as GEMVs over
+ *        the row-stored basis
+ *      - Step-size control from an a-posteriori error estimate (Saad's
+ *        corrected scheme); a rejected step only re-exponentiates H
+ *      - Happy-breakdown detection (invariant Krylov subspace: one exact step)
+ *      - Caller-owned KrylovWorkspace, O(n m) memory, no allocation per call
+ *
+ *  Notes:
+ *      - The initial step size is derived from ||H||, not ||A||, so A^T is
+ *        never needed.
+ * =============================================================================
+ */
+
+ //------------------------------------------------
+ //  Macro definitions
+ //------------------------------------------------
+
+/** Default Krylov dimension (Expokit's choice). */
+#define KRYLOV_DEFAULT_M 30
+/** Rejected step sizes allowed per step before giving up. */
+#define KRYLOV_MAX_REJECT 10
+/** Arnoldi stops (happy breakdown) once the new direction is below this
+    fraction of ||A v_j||: the basis then spans an invariant subspace. */
+#define KRYLOV_BREAKDOWN_TOL 1e-12
+
+ //------------------------------------------------
+ //  Type definitions
+ //------------------------------------------------
+
+/**
+ * @brief What the last krylov_expv() call did.
+ */
+typedef struct {
+    int steps;          ///< Accepted steps (one Arnoldi process each)
+    int rejected;       ///< Rejected step sizes (no new Arnoldi process)
+    int applies;        ///< Operator applications
+    double error;       ///< Sum of the local error estimates, relative to ||v||
+    double hump;        ///< max over the steps of ||w(t)|| / ||v||
+} KrylovStats;
+
+/**
+ * @brief Scratch storage for krylov_expv(), sized once for order n and
+ *        Krylov dimension m. Not shareable between concurrent calls.
+ */
+typedef struct {
+    int n;              ///< Order of the operator
+    int m;              ///< Krylov dimension (min(requested m, n))
+    Matrix* V;          ///< (m + 1) x n Arnoldi basis, one vector per row
+    Matrix* H;          ///< (m + 2) x (m + 2) augmented Hessenberg matrix
+    Matrix* F;          ///< exp(t H)
+    double* p;          ///< n doubles: new direction, then the propagated vector
+    double* h;          ///< 2 (m + 1) doubles: Gram-Schmidt coefficients
+    ExpmWorkspace expm; ///< Workspace of the (m + 2) x (m + 2) exponential
+    KrylovStats stats;  ///< Filled by every krylov_expv() call
+    MatrixArena own;    ///< Backing storage when created by krylov_workspace_init()
+} KrylovWorkspace;
+
+//------------------------------------------------
+//  Function Prototypes
+//------------------------------------------------
+
+/**
+ * @brief Allocate a workspace for order n and Krylov dimension m.
+ *
+ * @param[out] ws  Workspace to initialize; left empty on failure.
+ * @param[in]  n   Order of the operator (> 0).
+ * @param[in]  m   Krylov dimension (> 0), e.g. KRYLOV_DEFAULT_M; capped at n.
+ *
+ * @return CORE_ERROR_SUCCESS, CORE_ERROR_NULL, CORE_ERROR_INVALID_ARG or an
+ *         allocation error.
+ */
+CoreErrorStatus krylov_workspace_init(KrylovWorkspace* ws, int n, int m);
+
+/**
+ * @brief Carve a workspace out of an existing arena (released with it).
+ *
+ * Needs krylov_workspace_bytes(n, m) bytes of the arena.
+ */
+CoreErrorStatus krylov_workspace_init_in(KrylovWorkspace* ws, int n, int m, MatrixArena* arena);
+
+/**
+ * @brief Arena bytes needed by krylov_workspace_init_in().
+ */
+size_t krylov_workspace_bytes(int n, int m);
+
+/**
+ * @brief Release the buffers of a workspace and reset it to empty.
+ */
+CoreErrorStatus krylov_workspace_free(KrylovWorkspace* ws);
+
+/**
+ * @brief w = exp(t A) v by restarted Krylov steps.
+ *
+ * Each step of length tau keeps its local error estimate below
+ * tau * tol * ||v||, so the error on w is about |t| * tol * ||v||
+ * (reported in ws->stats.error).
+ *
+ * @param[in]     op   n x n operator; only op(A) = A is applied.
+ * @param[in]     t    Time (any sign).
+ * @param[in]     v    n x 1 start vector.
+ * @param[in]     tol  Error tolerance per unit time, relative to ||v|| (> 0).
+ * @param[in,out] ws   Workspace for the same n.
+ * @param[out]    w    n x 1 result. May alias v.
+ *
+ * @return CORE_ERROR_SUCCESS, CORE_ERROR_NULL, CORE_ERROR_DIMENSION,
+ *         CORE_ERROR_INVALID_ARG (tol <= 0, non-finite t), CORE_ERROR_NUMERIC
+ *         (no step size met tol after KRYLOV_MAX_REJECT tries), or the
+ *         status of the operator or of pade_expm_ws_inplace().
+ */
+CoreErrorStatus krylov_expv(const MatrixLinearOperator* op, double t, const Matrix* v,
+    double tol, KrylovWorkspace* ws, Matrix* w);
@@ -110,6 +110,10 @@ CoreErrorStatus rk4_lin_step(
 /**
  * @brief Workspace variant for linear case (no allocations).
  *        Workspaces: k1..k4 (n×1), tmp (n×1), Ax (n×1), Bu (n×1).
+ *
+ * @note Stages use linearity (k_{i+1} = k1 + c h A k_i), so each stage is one
+ *       GEMV and B*u is formed once per step. Ax and Bu are still validated
+ *       for API compatibility but are no longer written.
  */
 CoreErrorStatus rk4_lin_step_ws(
     const Matrix*    A,
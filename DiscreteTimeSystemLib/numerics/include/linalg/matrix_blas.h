@@ -0,0 +1,148 @@
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "core_error.h"
+#include "matrix_gemm.h"
+
+/*
+ * =============================================================================
+ *  matrix_blas.h
+ * =============================================================================
+ *
+ *  Description:
+ *      Row-major adapters over an external BLAS/LAPACK (OpenBLAS, MKL, BLIS
+ *      + libflame, or any library exporting the Fortran symbols). Enabled by
+ *      building with DTS_USE_BLAS (CMake: -DDTS_BLAS=openblas|mkl|blis);
+ *      otherwise MATRIX_BLAS_ENABLED is 0 and the built-in kernels are used.
+ *      The GEMM, TRSM and LU kernels call into this module themselves,
+ *      so callers normally never use it directly.
+ *
+ *  Features:
+ *      - dgemm with row-major operands and op(X) transforms
+ *      - dgetrf producing the same row-major L\U + pivot layout as the
+ *        built-in LU
+ *      - sgetrf with the same layout in single precision (mixed-precision LU)
+ *      - dtrsm for row-major triangular solves with multiple RHS, with the
+ *        triangle on either side
+ *
+ * =============================================================================
+ */
+
+//------------------------------------------------
+//  Macro definitions
+//------------------------------------------------
+
+/** 1 when the library is linked against an external BLAS/LAPACK. */
+#if defined(DTS_USE_BLAS)
+#define MATRIX_BLAS_ENABLED 1
+#else
+#define MATRIX_BLAS_ENABLED 0
+#endif
+
+/** Backend name reported by matrix_blas_backend() (set by the build). */
+#ifndef DTS_BLAS_NAME
+#if MATRIX_BLAS_ENABLED
+#define DTS_BLAS_NAME "blas"
+#else
+#define DTS_BLAS_NAME "builtin"
+#endif
+#endif
+
+//------------------------------------------------
+//  Type definitions
+//------------------------------------------------
+/* None */
+
+//------------------------------------------------
+//  Function Prototypes
+//------------------------------------------------
+
+/**
+ * @brief Name of the active backend ("builtin", "openblas", "mkl", "blis").
+ */
+const char* matrix_blas_backend(void);
+
+/**
+ * @brief C = alpha * op(A) * op(B) + beta * C on row-major buffers via dgemm.
+ *
+ * Same contract as matrix_gemm_compute_op(); arguments are not re-validated.
+ *
+ * @return CORE_ERROR_SUCCESS, or CORE_ERROR_INVALID_ARG when built without BLAS.
+ */
+CoreErrorStatus matrix_blas_gemm(MatrixTranspose trans_a, MatrixTranspose trans_b,
+    int m, int n, int k,
+    double alpha,
+    const double* A, int lda,
+    const double* B, int ldb,
+    double beta,
+    double* C, int ldc);
+
+/**
+ * @brief In-place LU with partial pivoting of a row-major n x n matrix via dgetrf.
+ *
+ * On return A holds L (unit diagonal, below) and U (on and above), and piv
+ * the swap sequence: at step k, row k was swapped with row piv[k] (0-based).
+ *
+ * @return CORE_ERROR_SUCCESS
+ * @return CORE_ERROR_NUMERIC if U has an exact zero on its diagonal
+ * @return CORE_ERROR_INVALID_ARG when built without BLAS
+ */
+CoreErrorStatus matrix_blas_getrf(int n, double* A, int lda, int* piv);
+
+/**
+ * @brief Single-precision matrix_blas_getrf() via sgetrf (same layout and pivots).
+ *
+ * @return CORE_ERROR_SUCCESS
+ * @return CORE_ERROR_NUMERIC if U has an exact zero on its diagonal
+ * @return CORE_ERROR_INVALID_ARG when built without BLAS
+ */
+CoreErrorStatus matrix_blas_sgetrf(int n, float* A, int lda, int* piv);
+
+/**
+ * @brief Solve op(T) * X = alpha * B in place (B <- X) via dtrsm.
+ *
+ * @param[in]     lower      Nonzero: T is lower triangular, else upper.
+ * @param[in]     trans      Transform applied to T.
+ * @param[in]     unit_diag  Nonzero: the diagonal of T is taken as 1.
+ * @param[in]     n          Order of T and rows of B.
+ * @param[in]     nrhs       Columns of B.
+ * @param[in]     alpha      Scalar applied to B.
+ * @param[in]     T          Row-major n x n buffer (only the triangle is read).
+ * @param[in]     ldt        Leading dimension of T, >= n.
+ * @param[in,out] B          Row-major n x nrhs buffer.
+ * @param[in]     ldb        Leading dimension of B, >= nrhs.
+ *
+ * @return CORE_ERROR_SUCCESS, or CORE_ERROR_INVALID_ARG when built without BLAS.
+ */
+CoreErrorStatus matrix_blas_trsm_left(int lower, MatrixTranspose trans, int unit_diag,
+    int n, int nrhs, double alpha,
+    const double* T, int ldt,
+    double* B, int ldb);
+
+/**
+ * @brief Solve X * op(T) = alpha * B in place (B <- X) via dtrsm.
+ *
+ * @param[in]     lower      Nonzero: T is lower triangular, else upper.
+ * @param[in]     trans      Transform applied to T.
+ * @param[in]     unit_diag  Nonzero: the diagonal of T is taken as 1.
+ * @param[in]     m          Rows of B.
+ * @param[in]     n          Order of T and columns of B.
+ * @param[in]     alpha      Scalar applied to B.
+ * @param[in]     T          Row-major n x n buffer (only the triangle is read).
+ * @param[in]     ldt        Leading dimension of T, >= n.
+ * @param[in,out] B          Row-major m x n buffer.
+ * @param[in]     ldb        Leading dimension of B, >= n.
+ *
+ * @return CORE_ERROR_SUCCESS, or CORE_ERROR_INVALID_ARG when built without BLAS.
+ */
+CoreErrorStatus matrix_blas_trsm_right(int lower, MatrixTranspose trans, int unit_diag,
+    int m, int n, double alpha,
+    const double* T, int ldt,
+    double* B, int ldb);
+
+#ifdef __cplusplus
+}
+#endif
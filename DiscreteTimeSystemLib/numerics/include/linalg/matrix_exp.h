@@ -2,6 +2,9 @@
 
 #include "core_error.h"
 #include "core_matrix.h"
+#include "pade.h"
+#include "matrix_linop.h"
+#include "matrix_norm.h"
 
 /*
  * =============================================================================
@@ -17,6 +20,15 @@
  *        (e.g., Taylor or Padé approximations)
  *      - Diagonalization-based exponential computation (if applicable)
  *      - Matrix power functions for discrete-time system solutions
+ *      - Workspace variant for allocation-free repeated evaluation
+ *      - Action exp(tA) * V on a block of vectors, over a grid of t, without
+ *        forming exp(tA) (Al-Mohy & Higham 2011): truncated Taylor series
+ *        with adaptive scaling, matrix-block products only, O(n k) memory,
+ *        for dense matrices or matrix-free operators
+ *      - Batched exponentials sharing work across items: exp(t_i A) for many
+ *        t from one set of powers and norms of A, exp(k_i Ts A) by squaring
+ *        exp(Ts A), and exp(t A_j) for many matrices of one order; items are
+ *        spread over the thread pool
  *
  * =============================================================================
  */
@@ -24,7 +36,14 @@
  //------------------------------------------------
 //  Macro definitions
 //------------------------------------------------
-/* None */
+
+/** Largest Taylor degree matrix_exp_multiply() truncates at. */
+#define MATRIX_EXPMV_M_MAX 55
+/** Largest p whose ||A^p||_1^(1/p) enters the choice of degree and steps. */
+#define MATRIX_EXPMV_P_MAX 8
+/** Doubles of workspace needed by matrix_exp_multiply() for order n and k vectors. */
+#define MATRIX_EXPMV_WORK(n, k) \
+    ((size_t)(n) * (2 * (size_t)(k) + MATRIX_NORMEST_T) + MATRIX_NORMEST_WORK(n, MATRIX_NORMEST_T))
 
 //------------------------------------------------
 //  Type definitions
@@ -51,4 +70,133 @@
  */
 CoreErrorStatus matrix_exp_exponential(const Matrix* A, double t, Matrix* result);
 
+/**
+ * @brief Compute \f$e^{tA}\f$ like matrix_exp_exponential() without allocating.
+ *
+ * All scratch storage comes from \p ws, which must have been initialized with
+ * pade_expm_workspace_init() for the order of \p A. The result is
+ * bit-identical to matrix_exp_exponential().
+ *
+ * @param A      Pointer to the square matrix to exponentiate.
+ * @param t      Scalar multiplier applied to \p A prior to exponentiation.
+ * @param ws     Workspace sized for \p A.
+ * @param result Output matrix receiving the value of \f$e^{tA}\f$.
+ *
+ * @return ::CORE_ERROR_SUCCESS on success or an appropriate error code on
+ *         failure (::CORE_ERROR_DIMENSION if \p ws was sized for another order).
+ */
+CoreErrorStatus matrix_exp_exponential_ws(const Matrix* A, double t, ExpmWorkspace* ws, Matrix* result);
+
+/**
+ * @brief Compute exp(t_i A) * V for each t in a grid without forming exp(tA).
+ *
+ * Al-Mohy & Higham's expmv: A is shifted by trace(A)/n, and each step
+ * t_{i-1} -> t_i (from t = 0) is split into s substeps, each a Taylor series
+ * of degree at most m truncated as soon as two consecutive terms are
+ * negligible. (m, s) minimize m * s subject to the backward-error bound
+ * for unit roundoff, from ||A||_1 or, when that is large, from estimates of
+ * ||A^p||_1^(1/p) (matrix_norm_1_est() on matrix-free powers, computed once
+ * per call). Cost: about m * s products A * (n x k block) per step, plus the
+ * norm estimates; nothing n x n is formed or factored.
+ *
+ * @param[in]  A      n x n matrix.
+ * @param[in]  V      n x k block of vectors.
+ * @param[in]  t      Grid of nt finite times in any order (ascending is cheapest).
+ * @param[in]  nt     Number of grid points (>= 1).
+ * @param[out] work   Workspace of MATRIX_EXPMV_WORK(n, k) doubles.
+ * @param[out] out    nt n x k results, out[i] = exp(t[i] A) * V. out[0] may be V.
+ *
+ * @return CORE_ERROR_SUCCESS, CORE_ERROR_NULL, CORE_ERROR_DIMENSION, or
+ *         CORE_ERROR_INVALID_ARG (nt < 1, non-finite t or A).
+ */
+CoreErrorStatus matrix_exp_multiply(const Matrix* A, const Matrix* V,
+    const double* t, int nt, double* work, Matrix* const* out);
 
+/**
+ * @brief matrix_exp_multiply() for an operator given only by its action.
+ *
+ * The operator is applied as A - shift * I, and the results are scaled back
+ * by exp(t shift); pass trace(A)/n when known (it usually shrinks the norms
+ * and so the number of products), or 0. ||A - shift I||_1 is estimated.
+ *
+ * @param[in]  op     n x n operator (matrix_linop_dense(), a sparse callback, ...).
+ * @param[in]  shift  Scalar shift, see above.
+ * @param[in]  V      n x k block of vectors.
+ * @param[in]  t      Grid of nt finite times.
+ * @param[in]  nt     Number of grid points (>= 1).
+ * @param[out] work   Workspace of MATRIX_EXPMV_WORK(n, k) doubles.
+ * @param[out] out    nt n x k results. out[0] may be V.
+ *
+ * @return As matrix_exp_multiply(), or the status of the operator.
+ */
+CoreErrorStatus matrix_exp_multiply_op(const MatrixLinearOperator* op, double shift,
+    const Matrix* V, const double* t, int nt, double* work, Matrix* const* out);
+
+/**
+ * @brief exp(t_i A) for count values of t, sharing the work that depends on A alone.
+ *
+ * A^2, A^4, A^6 and the norms that choose the Pade order and scaling
+ * (pade_norm_profile()) are computed once; for each t the powers of
+ * 2^-s t A are those of A rescaled, so an item costs the Pade terms, one LU
+ * solve and its squarings (m = 13: three products fewer than
+ * matrix_exp_exponential()). Items run concurrently on the thread pool when
+ * there are enough of them to occupy it, or when they are too small for the
+ * products to be threaded. Results agree with matrix_exp_exponential() to
+ * rounding, not bit for bit. For n <= 3, count = 1, or a power of A that
+ * overflows, every item is evaluated like matrix_exp_exponential_ws().
+ *
+ * @param[in]  A        n x n matrix.
+ * @param[in]  t        count finite scalars, in any order.
+ * @param[in]  count    Number of items (>= 1).
+ * @param[out] results  count n x n matrices, results[i] = exp(t[i] A);
+ *                      distinct from A and from each other.
+ *
+ * @return CORE_ERROR_SUCCESS, CORE_ERROR_NULL, CORE_ERROR_DIMENSION,
+ *         CORE_ERROR_INVALID_ARG (count < 1, non-finite t or A), or the
+ *         first error of an item (the other results are then unspecified).
+ */
+CoreErrorStatus matrix_exp_exponential_times(const Matrix* A, const double* t, int count,
+    Matrix* const* results);
+
+/**
+ * @brief exp(k_i Ts A) for count non-negative integer multiples of a step Ts.
+ *
+ * One exponential E = exp(Ts A), then E^(2^j) by repeated squaring up to the
+ * highest bit of max k_i; each result is the product of the squares at the
+ * set bits of its k_i (popcount(k_i) - 1 products, spread over the thread
+ * pool like matrix_exp_exponential_times()). The squarings are those of the
+ * scaling-and-squaring algorithm itself, so the error grows like that of
+ * exp(k Ts A) computed with log2(k) more squarings.
+ *
+ * @param[in]  A        n x n matrix.
+ * @param[in]  Ts       Finite step.
+ * @param[in]  k        count multiples (>= 0; 0 gives the identity).
+ * @param[in]  count    Number of items (>= 1).
+ * @param[out] results  count n x n matrices, results[i] = exp(k[i] Ts A);
+ *                      distinct from A and from each other.
+ *
+ * @return As matrix_exp_exponential_times(); CORE_ERROR_INVALID_ARG also
+ *         for a negative k.
+ */
+CoreErrorStatus matrix_exp_exponential_multiples(const Matrix* A, double Ts, const int* k,
+    int count, Matrix* const* results);
+
+/**
+ * @brief exp(t A_j) for count matrices of one order.
+ *
+ * Each result is bit-identical to matrix_exp_exponential(A[j], t); one
+ * ExpmWorkspace is allocated per thread-pool range instead of one per item,
+ * and items are spread over the pool like matrix_exp_exponential_times().
+ * The memo cache is not consulted.
+ *
+ * @param[in]  A        count n x n matrices.
+ * @param[in]  t        Scalar applied to every A[j].
+ * @param[in]  count    Number of items (>= 1).
+ * @param[out] results  count n x n matrices; results[j] may be A[j].
+ *
+ * @return CORE_ERROR_SUCCESS, CORE_ERROR_NULL, CORE_ERROR_DIMENSION (orders
+ *         differ), CORE_ERROR_INVALID_ARG (count < 1), or the first error of
+ *         an item.
+ */
+CoreErrorStatus matrix_exp_exponential_batch(const Matrix* const* A, double t, int count,
+    Matrix* const* results);
@@ -0,0 +1,372 @@
+#pragma once
+
+#ifndef __cplusplus
+#error "matrix_fixed.h is a C++ header; C code uses matrix_ops.h"
+#endif
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <utility>
+
+extern "C" {
+#include "core_error.h"
+#include "core_matrix.h"
+#include "pade_exp_coeffs.h"
+#include "pade_scaling.h"
+}
+
+/*
+ * =============================================================================
+ *  matrix_fixed.h
+ * =============================================================================
+ *
+ *  Description:
+ *      Header-only C++ layer for small matrices whose dimensions are known at
+ *      compile time. Storage lives inline (no heap), dimensions are checked by
+ *      the compiler, and every loop is unrolled through index sequences, so a
+ *      2x2 multiply compiles to a handful of FMAs.
+ *
+ *  Features:
+ *      - dts::SMatrix<R, C>: row-major, inline storage, constexpr dimensions
+ *      - Unrolled add / sub / scale / multiply / transpose
+ *      - Unrolled LU solve with partial pivoting at every size
+ *      - Pade scaling-and-squaring expm (same order/scaling choice and even
+ *        powers as the Pade path of pade_expm)
+ *      - Interop with Matrix: copy in/out, or wrap as a MatrixView
+ *
+ *  Notes:
+ *      - Intended for dimensions up to DTS_FIXED_MAX_DIM; larger sizes compile
+ *        but the unrolled code grows as R*C*K.
+ *      - Errors are reported as CoreErrorStatus, as in the C layers.
+ *
+ * =============================================================================
+ */
+
+ //------------------------------------------------
+ //  Macro definitions
+ //------------------------------------------------
+
+/** Largest dimension the fixed-size layer is tuned for. */
+#define DTS_FIXED_MAX_DIM 8
+
+//------------------------------------------------
+//  Type definitions
+//------------------------------------------------
+
+namespace dts {
+
+    namespace detail {
+
+        /* Call f(std::integral_constant<int, B>{}) ... f(integral_constant<int, E-1>{}). */
+        template <int B, class F, int... I>
+        inline void unroll_impl(F&& f, std::integer_sequence<int, I...>) {
+            (f(std::integral_constant<int, B + I>{}), ...);
+        }
+
+        template <int B, int E, class F>
+        inline void unroll(F&& f) {
+            if constexpr (E > B) {
+                unroll_impl<B>(f, std::make_integer_sequence<int, E - B>{});
+            }
+        }
+
+    } // namespace detail
+
+    /**
+     * @brief Fixed-size row-major matrix with inline storage.
+     *
+     * Element (i, j) is a[i * C + j]; the layout matches a contiguous Matrix,
+     * so view() can hand the storage to any C routine without copying.
+     */
+    template <int R, int C>
+    struct SMatrix {
+        static_assert(R >= 0 && C >= 0, "SMatrix dimensions must be non-negative");
+        static constexpr int rows = R;
+        static constexpr int cols = C;
+
+        std::array<double, (size_t)R * C> a{};
+
+        double& operator()(int i, int j) { return a[(size_t)i * C + j]; }
+        const double& operator()(int i, int j) const { return a[(size_t)i * C + j]; }
+
+        static SMatrix zero() { return SMatrix{}; }
+
+        static SMatrix identity() {
+            static_assert(R == C, "identity() requires a square matrix");
+            SMatrix I{};
+            detail::unroll<0, R>([&](auto i) { I(i, i) = 1.0; });
+            return I;
+        }
+
+        /** Non-owning MatrixView over this storage (valid while *this lives). */
+        MatrixView view() {
+            MatrixView v{};
+            matrix_view_of(&v, a.data(), R, C, C);
+            return v;
+        }
+    };
+
+    //------------------------------------------------
+    //  Element-wise operations
+    //------------------------------------------------
+
+    template <int R, int C>
+    inline SMatrix<R, C> operator+(const SMatrix<R, C>& x, const SMatrix<R, C>& y) {
+        SMatrix<R, C> r;
+        detail::unroll<0, R * C>([&](auto k) { r.a[k] = x.a[k] + y.a[k]; });
+        return r;
+    }
+
+    template <int R, int C>
+    inline SMatrix<R, C> operator-(const SMatrix<R, C>& x, const SMatrix<R, C>& y) {
+        SMatrix<R, C> r;
+        detail::unroll<0, R * C>([&](auto k) { r.a[k] = x.a[k] - y.a[k]; });
+        return r;
+    }
+
+    template <int R, int C>
+    inline SMatrix<R, C> operator*(double s, const SMatrix<R, C>& x) {
+        SMatrix<R, C> r;
+        detail::unroll<0, R * C>([&](auto k) { r.a[k] = s * x.a[k]; });
+        return r;
+    }
+
+    /** y += alpha * x */
+    template <int R, int C>
+    inline void axpy(SMatrix<R, C>& y, double alpha, const SMatrix<R, C>& x) {
+        detail::unroll<0, R * C>([&](auto k) { y.a[k] += alpha * x.a[k]; });
+    }
+
+    //------------------------------------------------
+    //  Products
+    //------------------------------------------------
+
+    /** r = x * y, inner products accumulated in ascending k like matrix_ops_multiply. */
+    template <int R, int K, int C>
+    inline SMatrix<R, C> operator*(const SMatrix<R, K>& x, const SMatrix<K, C>& y) {
+        SMatrix<R, C> r;
+        detail::unroll<0, R>([&](auto i) {
+            detail::unroll<0, C>([&](auto j) {
+                double s = 0.0;
+                detail::unroll<0, K>([&](auto k) { s += x(i, k) * y(k, j); });
+                r(i, j) = s;
+            });
+        });
+        return r;
+    }
+
+    template <int R, int C>
+    inline SMatrix<C, R> transpose(const SMatrix<R, C>& x) {
+        SMatrix<C, R> r;
+        detail::unroll<0, R>([&](auto i) {
+            detail::unroll<0, C>([&](auto j) { r(j, i) = x(i, j); });
+        });
+        return r;
+    }
+
+    /** Maximum absolute column sum (matches matrix_norm_1). */
+    template <int R, int C>
+    inline double norm_1(const SMatrix<R, C>& x) {
+        double best = 0.0;
+        detail::unroll<0, C>([&](auto j) {
+            double s = 0.0;
+            detail::unroll<0, R>([&](auto i) { s += std::fabs(x(i, j)); });
+            if (s > best) best = s;
+        });
+        return best;
+    }
+
+    //------------------------------------------------
+    //  Function Prototypes
+    //------------------------------------------------
+
+    /**
+     * @brief Copy a Matrix (or MatrixView) into a fixed-size matrix.
+     *
+     * @return CORE_ERROR_SUCCESS, CORE_ERROR_NULL, or CORE_ERROR_DIMENSION if
+     *         src is not R x C.
+     */
+    template <int R, int C>
+    inline CoreErrorStatus smatrix_from(SMatrix<R, C>& dst, const Matrix* src) {
+        if (!src || !src->data) CORE_ERROR_RETURN(CORE_ERROR_NULL);
+        if (src->rows != R || src->cols != C) CORE_ERROR_RETURN(CORE_ERROR_DIMENSION);
+        detail::unroll<0, R>([&](auto i) {
+            const double* s = src->data + (size_t)i * src->ld;
+            detail::unroll<0, C>([&](auto j) { dst(i, j) = s[j]; });
+        });
+        CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
+    }
+
+    /**
+     * @brief Copy a fixed-size matrix into a preallocated R x C Matrix (or MatrixView).
+     */
+    template <int R, int C>
+    inline CoreErrorStatus smatrix_to(Matrix* dst, const SMatrix<R, C>& src) {
+        if (!dst || !dst->data) CORE_ERROR_RETURN(CORE_ERROR_NULL);
+        if (dst->rows != R || dst->cols != C) CORE_ERROR_RETURN(CORE_ERROR_DIMENSION);
+        detail::unroll<0, R>([&](auto i) {
+            double* d = dst->data + (size_t)i * dst->ld;
+            detail::unroll<0, C>([&](auto j) { d[j] = src(i, j); });
+        });
+        CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
+    }
+
+    /**
+     * @brief Solve A * X = B by LU with partial pivoting, fully unrolled.
+     *
+     * Every N takes the same path: right-looking elimination with the first
+     * largest |pivot| in each column, then back substitution. It is backward
+     * stable like any partial-pivoting LU (residual of order N * eps * |A| |X|
+     * barring pivot growth). matrix_solve_LU() is not the same computation:
+     * it uses Cramer's rule for well-conditioned N <= 3 and a recursive LU
+     * with GEMM updates above 16 columns, so the two agree to rounding, not
+     * bit for bit.
+     *
+     * @param[in]  A  N x N coefficient matrix.
+     * @param[in]  B  N x K right-hand sides.
+     * @param[out] X  N x K solution (may alias B).
+     * @return CORE_ERROR_SUCCESS, or CORE_ERROR_NUMERIC if A is singular.
+     */
+    template <int N, int K>
+    inline CoreErrorStatus solve(const SMatrix<N, N>& A, const SMatrix<N, K>& B, SMatrix<N, K>& X) {
+        SMatrix<N, N> LU = A;
+        SMatrix<N, K> Y = B;
+        bool singular = false;
+
+        detail::unroll<0, N>([&](auto kc) {
+            constexpr int k = decltype(kc)::value;
+            if (singular) return;
+
+            int p = k;
+            double amax = std::fabs(LU(k, k));
+            detail::unroll<k + 1, N>([&](auto r) {
+                const double v = std::fabs(LU(r, k));
+                if (v > amax) { amax = v; p = r; }
+            });
+            if (amax == 0.0) { singular = true; return; }
+
+            if (p != k) {
+                detail::unroll<0, N>([&](auto j) { std::swap(LU(k, j), LU(p, j)); });
+                detail::unroll<0, K>([&](auto j) { std::swap(Y(k, j), Y(p, j)); });
+            }
+
+            const double Akk = LU(k, k);
+            detail::unroll<k + 1, N>([&](auto i) {
+                const double Lik = (LU(i, k) /= Akk);
+                detail::unroll<k + 1, N>([&](auto j) { LU(i, j) -= Lik * LU(k, j); });
+                detail::unroll<0, K>([&](auto c) { Y(i, c) -= Lik * Y(k, c); });
+            });
+        });
+        if (singular) CORE_ERROR_RETURN(CORE_ERROR_NUMERIC);
+
+        // Back substitution, column-oriented like back_subst_U().
+        detail::unroll<0, N>([&](auto ic) {
+            constexpr int i = N - 1 - decltype(ic)::value;
+            const double Uii = LU(i, i);
+            detail::unroll<0, K>([&](auto c) { Y(i, c) /= Uii; });
+            detail::unroll<0, i>([&](auto r) {
+                const double Uri = LU(r, i);
+                detail::unroll<0, K>([&](auto c) { Y(r, c) -= Uri * Y(i, c); });
+            });
+        });
+
+        X = Y;
+        CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
+    }
+
+    namespace detail {
+
+        /* Even powers P[j] = As^(2j) for j = 1..4 (P[0] unused). */
+        template <int N>
+        using EvenPowers = std::array<SMatrix<N, N>, 5>;
+
+        /* [m/m] Pade quotient of an already-scaled As: (V - U) \ (V + U).
+           P[1..min(EvenLen - 1, 3)] come from pade_select_scaling(). */
+        template <int N, int EvenLen>
+        inline CoreErrorStatus pade_quotient(const SMatrix<N, N>& As, EvenPowers<N>& P,
+            const PadeExpTable* t, SMatrix<N, N>& X) {
+
+            SMatrix<N, N> U, V;
+            if constexpr (EvenLen == 7) {
+                // m = 13: higher terms factored through A^6, as build_UV_m13()
+                const SMatrix<N, N> I = SMatrix<N, N>::identity();
+                const double* be = t->even;
+                const double* bo = t->odd;
+                SMatrix<N, N> W = bo[6] * P[3];
+                axpy(W, bo[5], P[2]);
+                axpy(W, bo[4], P[1]);
+                SMatrix<N, N> S = bo[0] * I;
+                axpy(S, bo[1], P[1]);
+                axpy(S, bo[2], P[2]);
+                axpy(S, bo[3], P[3]);
+                U = As * (S + P[3] * W);
+
+                W = be[6] * P[3];
+                axpy(W, be[5], P[2]);
+                axpy(W, be[4], P[1]);
+                V = be[0] * I;
+                axpy(V, be[1], P[1]);
+                axpy(V, be[2], P[2]);
+                axpy(V, be[3], P[3]);
+                V = V + P[3] * W;
+            }
+            else {
+                if constexpr (EvenLen > 4) P[4] = P[2] * P[2];
+
+                V = t->even[0] * SMatrix<N, N>::identity();
+                SMatrix<N, N> S = t->odd[0] * SMatrix<N, N>::identity();
+                unroll<1, EvenLen>([&](auto j) {
+                    axpy(V, t->even[j], P[j]);
+                    axpy(S, t->odd[j], P[j]);
+                });
+                U = As * S;
+            }
+            return solve(V - U, V + U, X);
+        }
+
+    } // namespace detail
+
+    /**
+     * @brief Matrix exponential exp(A) by Pade scaling and squaring.
+     *
+     * The order m, scaling s and the even powers come from
+     * pade_select_scaling(), exactly as in pade_expm(); only the Pade
+     * evaluation and the squarings are unrolled.
+     *
+     * @param[in]  A       N x N input.
+     * @param[out] result  exp(A) (may alias A).
+     * @return CORE_ERROR_SUCCESS, or an error from the order selection / solve.
+     */
+    template <int N>
+    inline CoreErrorStatus expm(const SMatrix<N, N>& A, SMatrix<N, N>& result) {
+        SMatrix<N, N> As = A;
+        detail::EvenPowers<N> P;
+        MatrixView a = As.view(), p2 = P[1].view(), p4 = P[2].view(), p6 = P[3].view();
+        double work[PADE_SCALING_WORK(N)];
+        PadeScaling sel;
+        CoreErrorStatus status = pade_select_scaling(&a, &p2, &p4, &p6, work, &sel);
+        if (status) CORE_ERROR_RETURN(status);
+        const int s = sel.s;
+
+        const PadeExpTable* t = pade_exp_get_table(sel.m);
+        if (!t) CORE_ERROR_RETURN(CORE_ERROR_INVALID_ARG);
+
+        As = std::ldexp(1.0, -s) * As;
+        SMatrix<N, N> X;
+        switch (sel.m) {
+        case 3:  status = detail::pade_quotient<N, 2>(As, P, t, X); break;
+        case 5:  status = detail::pade_quotient<N, 3>(As, P, t, X); break;
+        case 7:  status = detail::pade_quotient<N, 4>(As, P, t, X); break;
+        case 9:  status = detail::pade_quotient<N, 5>(As, P, t, X); break;
+        case 13: status = detail::pade_quotient<N, 7>(As, P, t, X); break;
+        default: status = CORE_ERROR_INVALID_ARG; break;
+        }
+        if (status) CORE_ERROR_RETURN(status);
+
+        for (int i = 0; i < s; ++i) X = X * X;
+        result = X;
+        CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
+    }
+
+} // namespace dts
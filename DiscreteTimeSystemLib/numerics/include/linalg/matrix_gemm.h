@@ -0,0 +1,158 @@
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include "core_error.h"
+
+/*
+ * =============================================================================
+ *  matrix_gemm.h
+ * =============================================================================
+ *
+ *  Description:
+ *      Cache-blocked general matrix-matrix multiply (GEMM) engine used by the
+ *      matrix_ops layer. Operates on raw row-major buffers with explicit
+ *      leading dimensions so it can be reused for sub-blocks.
+ *
+ *  Features:
+ *      - C = alpha * op(A) * op(B) + beta * C on row-major storage,
+ *        op(X) = X or X^T (transposes are folded into packing)
+ *      - B-panel and A-block packing into contiguous, zero-padded buffers
+ *      - L1/L2 cache blocking (MC x KC blocks of A, KC x NC panels of B)
+ *      - Register-tiled MR x NR micro-kernel
+ *      - Direct (unpacked) path for tiny products where packing does not pay
+ *      - GEMV for matrix-vector products (register-blocked dot products)
+ *      - Large products split into MC-aligned bands of C across the core
+ *        thread pool (bitwise identical to the single-threaded result)
+ *
+ * =============================================================================
+ */
+
+//------------------------------------------------
+//  Macro definitions
+//------------------------------------------------
+
+/** Rows of C computed by one micro-kernel call (register tile height). */
+#define MATRIX_GEMM_MR 4
+/** Columns of C computed by one micro-kernel call (register tile width). */
+#define MATRIX_GEMM_NR 8
+/** Rows of A packed per block (sized for L2). */
+#define MATRIX_GEMM_MC 96
+/** Depth of the packed A block / B panel (sized for L1). */
+#define MATRIX_GEMM_KC 256
+/** Columns of B packed per panel (sized for L3). */
+#define MATRIX_GEMM_NC 2048
+/** m * n * k at or above which a product is split across the core thread pool. */
+#define MATRIX_GEMM_PARALLEL_MIN_VOLUME ((size_t)1 << 21)
+
+//------------------------------------------------
+//  Type definitions
+//------------------------------------------------
+
+/**
+ * @brief Operand transform applied by GEMM: op(X) = X or X^T.
+ */
+typedef enum {
+    MATRIX_NO_TRANS = 0,
+    MATRIX_TRANS = 1
+} MatrixTranspose;
+
+//------------------------------------------------
+//  Function Prototypes
+//------------------------------------------------
+
+/**
+ * @brief Row-major GEMM: C = alpha * A * B + beta * C.
+ *
+ * @param[in]     m     Rows of A and C.
+ * @param[in]     n     Columns of B and C.
+ * @param[in]     k     Columns of A / rows of B.
+ * @param[in]     alpha Scalar applied to A * B.
+ * @param[in]     A     Row-major m x k buffer.
+ * @param[in]     lda   Leading dimension (row stride) of A, >= k.
+ * @param[in]     B     Row-major k x n buffer.
+ * @param[in]     ldb   Leading dimension (row stride) of B, >= n.
+ * @param[in]     beta  Scalar applied to C before accumulation. If beta == 0,
+ *                      C is overwritten (its previous contents are ignored).
+ * @param[in,out] C     Row-major m x n buffer.
+ * @param[in]     ldc   Leading dimension (row stride) of C, >= n.
+ *
+ * @return CORE_ERROR_SUCCESS on success
+ * @return CORE_ERROR_NULL if a buffer is NULL
+ * @return CORE_ERROR_INVALID_ARG on negative sizes or too small leading dimensions
+ * @return CORE_ERROR_ALLOCATION_FAILED if the packing buffers cannot be allocated
+ *
+ * @note
+ * - C must not overlap A or B.
+ * - Packing buffers are allocated once per thread and reused across calls,
+ *   so steady-state calls do not allocate.
+ * - When core_thread_pool_get_workers() > 1 and m * n * k is at least
+ *   MATRIX_GEMM_PARALLEL_MIN_VOLUME, bands of C are computed concurrently.
+ */
+CoreErrorStatus matrix_gemm_compute(int m, int n, int k,
+    double alpha,
+    const double* A, int lda,
+    const double* B, int ldb,
+    double beta,
+    double* C, int ldc);
+
+/**
+ * @brief Row-major GEMM with operand transforms: C = alpha * op(A) * op(B) + beta * C.
+ *
+ * @param[in]     trans_a Transform of A. op(A) is m x k, so A is stored m x k
+ *                        (MATRIX_NO_TRANS, lda >= k) or k x m (MATRIX_TRANS, lda >= m).
+ * @param[in]     trans_b Transform of B. op(B) is k x n, so B is stored k x n
+ *                        (MATRIX_NO_TRANS, ldb >= n) or n x k (MATRIX_TRANS, ldb >= k).
+ *
+ * Remaining parameters, return values and notes are as for matrix_gemm_compute().
+ */
+CoreErrorStatus matrix_gemm_compute_op(MatrixTranspose trans_a, MatrixTranspose trans_b,
+    int m, int n, int k,
+    double alpha,
+    const double* A, int lda,
+    const double* B, int ldb,
+    double beta,
+    double* C, int ldc);
+
+/**
+ * @brief Row-major GEMV: y = alpha * op(A) * x + beta * y.
+ *
+ * @param[in]     trans_a MATRIX_NO_TRANS: y (length m) = alpha * A * x (length n) + beta * y.
+ *                        MATRIX_TRANS:    y (length n) = alpha * A^T * x (length m) + beta * y.
+ * @param[in]     m       Rows of the stored A.
+ * @param[in]     n       Columns of the stored A.
+ * @param[in]     alpha   Scalar applied to op(A) * x. If alpha == 0, A and x are not read.
+ * @param[in]     A       Row-major m x n buffer.
+ * @param[in]     lda     Leading dimension (row stride) of A, >= n.
+ * @param[in]     x       Contiguous input vector.
+ * @param[in]     beta    Scalar applied to y. If beta == 0, y is overwritten.
+ * @param[in,out] y       Contiguous output vector; must not overlap A or x.
+ *
+ * @return CORE_ERROR_SUCCESS on success
+ * @return CORE_ERROR_NULL if a buffer is NULL
+ * @return CORE_ERROR_INVALID_ARG on negative sizes, too small lda or a bad transpose flag
+ *
+ * @note Never allocates. The non-transposed form runs four dot products per
+ *       pass so each load of x is shared by four rows of A.
+ */
+CoreErrorStatus matrix_gemv_compute(MatrixTranspose trans_a, int m, int n,
+    double alpha,
+    const double* A, int lda,
+    const double* x,
+    double beta,
+    double* y);
+
+/**
+ * @brief Release the calling thread's packing buffers.
+ *
+ * Optional; the buffers are otherwise kept for reuse by later calls and
+ * freed automatically when the thread exits.
+ */
+void matrix_gemm_release_buffers(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,130 @@
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include "core_matrix.h"
+#include "core_error.h"
+#include "matrix_gemm.h"
+
+/*
+ * =============================================================================
+ *  matrix_linop.h
+ * =============================================================================
+ *
+ *  Description:
+ *      Matrix-free square linear operators. Algorithms that only need
+ *      products op(A) * X with a block of vectors (norm estimation, Krylov
+ *      methods, the action of exp(tA)) take a MatrixLinearOperator, so the
+ *      same code drives dense matrices, products and powers that are never
+ *      formed, and caller-defined sparse or structured operators.
+ *
+ *  Features:
+ *      - Callback interface Y = op(A) * X for n x k blocks X
+ *      - Dense operator over a Matrix / MatrixView (one GEMM per apply)
+ *      - Product operator F_0 * F_1 * ... * F_{c-1} (e.g. A^k, A^4 * A^6)
+ *        applied factor by factor in O(c n^2 k), nothing n x n is formed
+ *      - Power operator B^p of another operator (matrix-free powers)
+ *
+ * =============================================================================
+ */
+
+//------------------------------------------------
+//  Macro definitions
+//------------------------------------------------
+/* None */
+
+//------------------------------------------------
+//  Type definitions
+//------------------------------------------------
+
+/**
+ * @brief Apply an operator to a block: Y = op(A) * X.
+ *
+ * @param[in]  ctx    Operator state (MatrixLinearOperator::ctx).
+ * @param[in]  trans  MATRIX_NO_TRANS for A * X, MATRIX_TRANS for A^T * X.
+ * @param[in]  X      n x k block (k >= 1).
+ * @param[out] Y      n x k block; never aliases X.
+ */
+typedef CoreErrorStatus (*MatrixLinOpFn)(void* ctx, MatrixTranspose trans,
+    const Matrix* X, Matrix* Y);
+
+/**
+ * @brief Square n x n operator given only by its action on blocks of vectors.
+ */
+typedef struct {
+    int n;                  ///< Order of the operator
+    MatrixLinOpFn apply;    ///< Y = op(A) * X
+    void* ctx;              ///< Passed to apply()
+} MatrixLinearOperator;
+
+/**
+ * @brief State of the product operator F_0 * F_1 * ... * F_{count-1}.
+ */
+typedef struct {
+    const Matrix* const* factors;   ///< count n x n factors (may repeat for powers)
+    int count;                      ///< Number of factors (>= 1)
+    double* work;                   ///< n * kmax doubles for the intermediate block
+    int kmax;                       ///< Widest block the operator will be applied to
+} MatrixProductOp;
+
+/**
+ * @brief State of the power operator base^power.
+ */
+typedef struct {
+    const MatrixLinearOperator* base;   ///< Operator being raised to a power
+    int power;                          ///< Exponent (>= 1)
+    double* work;                       ///< n * kmax doubles for the intermediate block
+    int kmax;                           ///< Widest block the operator will be applied to
+} MatrixPowerOp;
+
+//------------------------------------------------
+//  Function Prototypes
+//------------------------------------------------
+
+/**
+ * @brief Wrap a square Matrix (or MatrixView) as an operator.
+ *
+ * @param[out] op  Operator; valid while A lives.
+ * @param[in]  A   n x n matrix.
+ *
+ * @return CORE_ERROR_SUCCESS, CORE_ERROR_NULL or CORE_ERROR_DIMENSION (not square).
+ */
+CoreErrorStatus matrix_linop_dense(MatrixLinearOperator* op, const Matrix* A);
+
+/**
+ * @brief Wrap the product of prod->count factors as an operator.
+ *
+ * @param[out] op    Operator; valid while prod and its factors live.
+ * @param[in]  prod  Factors and scratch. Factors must all be n x n.
+ *
+ * @return CORE_ERROR_SUCCESS, CORE_ERROR_NULL, CORE_ERROR_INVALID_ARG
+ *         (count < 1 or kmax < 1) or CORE_ERROR_DIMENSION.
+ */
+CoreErrorStatus matrix_linop_product(MatrixLinearOperator* op, MatrixProductOp* prod);
+
+/**
+ * @brief Wrap pw->base raised to pw->power as an operator.
+ *
+ * @param[out] op  Operator; valid while pw and its base live.
+ * @param[in]  pw  Base operator, exponent and scratch.
+ *
+ * @return CORE_ERROR_SUCCESS, CORE_ERROR_NULL or CORE_ERROR_INVALID_ARG
+ *         (power < 1 or kmax < 1).
+ */
+CoreErrorStatus matrix_linop_power(MatrixLinearOperator* op, MatrixPowerOp* pw);
+
+/**
+ * @brief Y = op(A) * X through op->apply, after checking the block shapes.
+ *
+ * @return CORE_ERROR_SUCCESS, CORE_ERROR_NULL, CORE_ERROR_DIMENSION, or the
+ *         status of the callback.
+ */
+CoreErrorStatus matrix_linop_apply(const MatrixLinearOperator* op, MatrixTranspose trans,
+    const Matrix* X, Matrix* Y);
+
+#ifdef __cplusplus
+}
+#endif
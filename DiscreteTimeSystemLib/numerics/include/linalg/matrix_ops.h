@@ -6,6 +6,7 @@ extern "C" {
 
 #include "core_matrix.h"
 #include "core_error.h"
+#include "matrix_gemm.h"
 
 /*
  * =============================================================================
@@ -18,11 +19,16 @@ extern "C" {
  *  Features:
  *      - Matrix addition and subtraction
  *      - Matrix multiplication
+ *      - Fused GEMM: C = alpha * op(A) * op(B) + beta * C
+ *      - Matrix-vector product (GEMV): y = alpha * op(A) * x + beta * y
  *      - Scalar multiplication
  *      - Matrix transposition
  *      - Identity and zero matrix generation
  *      - Matrix copy
  *      - Printing matrix contents
+ *      - Accepts MatrixView operands (strided sub-blocks, no copies)
+ *      - Large products and element-wise ops are split across the core
+ *        thread pool (core_thread_pool.h) when it has more than one worker
  *
  * =============================================================================
  */
@@ -30,7 +36,9 @@ extern "C" {
  //------------------------------------------------
 //  Macro definitions
 //------------------------------------------------
-/* None */
+
+/** Element count at or above which fill/add/scale/axpy/copy use the thread pool. */
+#define MATRIX_OPS_PARALLEL_MIN_ELEMENTS ((size_t)1 << 17)
 
 //------------------------------------------------
 //  Type definitions
@@ -129,6 +137,55 @@ CoreErrorStatus matrix_ops_add(Matrix* result, const Matrix* a, const Matrix* b)
  */
 CoreErrorStatus matrix_ops_multiply(Matrix* result, const Matrix* a, const Matrix* b);
 
+/**
+ * @brief General matrix multiply-accumulate: C = alpha * op(A) * op(B) + beta * C
+ *
+ * op(X) is X or its transpose as selected by the transpose flag, so products
+ * such as A^T * B or scaled accumulations into an existing matrix need neither
+ * an explicit transpose nor a separate scale/add pass.
+ *
+ * @param[in,out] C        Output matrix (size m x n, preallocated)
+ * @param[in]     alpha    Scalar applied to op(A) * op(B)
+ * @param[in]     A        Left operand; op(A) is m x k
+ * @param[in]     trans_a  MATRIX_NO_TRANS or MATRIX_TRANS
+ * @param[in]     B        Right operand; op(B) is k x n
+ * @param[in]     trans_b  MATRIX_NO_TRANS or MATRIX_TRANS
+ * @param[in]     beta     Scalar applied to C. If beta == 0, C is overwritten
+ *                         (its previous contents, even NaN, are ignored).
+ * @return CORE_ERROR_SUCCESS if the operation completes successfully,
+ *         CORE_ERROR_DIMENSION on shape mismatch,
+ *         CORE_ERROR_INVALID_ARG if C overlaps A or B in memory (including
+ *         overlapping views of one parent),
+ *         otherwise an appropriate error code.
+ */
+CoreErrorStatus matrix_ops_gemm(Matrix* C, double alpha,
+    const Matrix* A, MatrixTranspose trans_a,
+    const Matrix* B, MatrixTranspose trans_b,
+    double beta);
+
+/**
+ * @brief Matrix-vector multiply-accumulate: y = alpha * op(A) * x + beta * y
+ *
+ * Dedicated path for column-vector operands (state updates, outputs).
+ * matrix_ops_multiply() and matrix_ops_gemm() dispatch here automatically
+ * when the right-hand operand has a single column.
+ *
+ * @param[in,out] y        Output column vector (size m x 1, preallocated)
+ * @param[in]     alpha    Scalar applied to op(A) * x
+ * @param[in]     A        Matrix; op(A) is m x k
+ * @param[in]     trans_a  MATRIX_NO_TRANS or MATRIX_TRANS
+ * @param[in]     x        Input column vector (size k x 1)
+ * @param[in]     beta     Scalar applied to y. If beta == 0, y is overwritten.
+ * @return CORE_ERROR_SUCCESS if the operation completes successfully,
+ *         CORE_ERROR_DIMENSION on shape mismatch,
+ *         CORE_ERROR_INVALID_ARG if y overlaps A or x in memory,
+ *         otherwise an appropriate error code.
+ */
+CoreErrorStatus matrix_ops_gemv(Matrix* y, double alpha,
+    const Matrix* A, MatrixTranspose trans_a,
+    const Matrix* x,
+    double beta);
+
 /**
  * @brief Compute the integer power of a square matrix (A^n)
  *
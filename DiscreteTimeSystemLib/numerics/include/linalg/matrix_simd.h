@@ -0,0 +1,127 @@
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "core_error.h"
+
+/*
+ * =============================================================================
+ *  matrix_simd.h
+ * =============================================================================
+ *
+ *  Description:
+ *      Runtime-dispatched SIMD kernels for the element-wise and product
+ *      routines of the matrix_ops layer. The widest instruction set supported
+ *      by both the CPU and the OS is selected on first use (CPUID/XGETBV), so
+ *      a single binary runs the best available path on every machine.
+ *
+ *  Features:
+ *      - Dispatch levels: scalar, SSE2, AVX2+FMA, AVX-512F
+ *      - Kernels: fill, add, scale, axpy, the GEMM micro-kernel and GEMV
+ *      - Single-precision GEMM for float32 factorizations (mixed-precision LU)
+ *      - Element-wise kernels are bit-identical across levels
+ *      - Level can be forced (e.g. for testing or reproducibility)
+ *      - Non-x86 builds fall back to the scalar table
+ *
+ * =============================================================================
+ */
+
+//------------------------------------------------
+//  Macro definitions
+//------------------------------------------------
+/* None */
+
+//------------------------------------------------
+//  Type definitions
+//------------------------------------------------
+
+/**
+ * @brief Instruction-set levels, ordered from narrowest to widest.
+ */
+typedef enum {
+    MATRIX_SIMD_SCALAR = 0,
+    MATRIX_SIMD_SSE2 = 1,
+    MATRIX_SIMD_AVX2 = 2,    ///< AVX2 + FMA3
+    MATRIX_SIMD_AVX512 = 3,  ///< AVX-512F
+    MATRIX_SIMD_LEVEL_COUNT
+} MatrixSimdLevel;
+
+/**
+ * @brief Kernel table for one dispatch level. All buffers are contiguous
+ *        doubles (floats for sgemm); no alignment is required.
+ */
+typedef struct {
+    MatrixSimdLevel level;
+    const char* name;
+
+    /** x[i] = value, i in [0, n) */
+    void (*fill)(int n, double value, double* x);
+    /** out[i] = a[i] + b[i] (out may alias a or b) */
+    void (*add)(int n, const double* a, const double* b, double* out);
+    /** x[i] *= alpha */
+    void (*scale)(int n, double alpha, double* x);
+    /** y[i] += alpha * x[i] */
+    void (*axpy)(int n, double alpha, const double* x, double* y);
+    /**
+     * Full MATRIX_GEMM_MR x MATRIX_GEMM_NR tile: C += alpha * Ap * Bp, where Ap/Bp
+     * are packed slivers of depth kc (see matrix_gemm.c) and C has row stride ldc.
+     */
+    void (*gemm_micro)(int kc, double alpha, const double* ap, const double* bp, double* C, int ldc);
+    /**
+     * Row-major GEMV: y = alpha * A * x + beta * y for an m x n A with row stride
+     * lda. Four rows share each load of x; beta == 0 overwrites y.
+     */
+    void (*gemv)(int m, int n, double alpha, const double* A, int lda,
+        const double* x, double beta, double* y);
+    /**
+     * Row-major single-precision C += alpha * A * B, A m x k, B k x n, no
+     * packing. C must not overlap A or B.
+     */
+    void (*sgemm)(int m, int n, int k, float alpha, const float* A, int lda,
+        const float* B, int ldb, float* C, int ldc);
+} MatrixSimdKernels;
+
+//------------------------------------------------
+//  Function Prototypes
+//------------------------------------------------
+
+/**
+ * @brief Detect the widest level supported by this CPU/OS and compiled in.
+ */
+MatrixSimdLevel matrix_simd_detect(void);
+
+/**
+ * @brief Get the currently active level (detects on first use).
+ */
+MatrixSimdLevel matrix_simd_get_level(void);
+
+/**
+ * @brief Force the active level.
+ *
+ * The switch is published atomically and is safe to call from any thread;
+ * kernel calls already in flight finish on the table they started with.
+ *
+ * @param level Requested level.
+ * @return CORE_ERROR_SUCCESS on success
+ * @return CORE_ERROR_INVALID_ARG if the level is out of range or not supported
+ *         on this machine (the active level is left unchanged).
+ */
+CoreErrorStatus matrix_simd_set_level(MatrixSimdLevel level);
+
+/**
+ * @brief Get the active kernel table (detects on first use). Never NULL.
+ */
+const MatrixSimdKernels* matrix_simd_kernels(void);
+
+/**
+ * @brief Get the kernel table of a specific level.
+ *
+ * @return Table pointer, or NULL if the level is not supported on this machine.
+ */
+const MatrixSimdKernels* matrix_simd_kernels_for(MatrixSimdLevel level);
+
+#ifdef __cplusplus
+}
+#endif
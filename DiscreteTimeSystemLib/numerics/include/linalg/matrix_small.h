@@ -0,0 +1,88 @@
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "core_matrix.h"
+#include "core_error.h"
+
+/*
+ * =============================================================================
+ *  matrix_small.h
+ * =============================================================================
+ *
+ *  Description:
+ *      Closed-form fast paths for 1x1, 2x2 and 3x3 matrices. pade_expm() and
+ *      matrix_solve_LU() try these first and fall back to the general
+ *      pipelines whenever an accuracy guard fails, so callers normally never
+ *      call this module directly.
+ *
+ *  Features:
+ *      - exp(A) via Cayley-Hamilton: A = mu*I + N with N traceless, so
+ *        N^3 = p*N + q*I and exp(N) = c0*I + c1*N + c2*N^2
+ *      - A * X = B via adjugate / Cramer's rule, any number of RHS
+ *      - Guards: ||N||_1 bound (after at most a few squarings) for exp,
+ *        1-norm condition number bound for solve; results are left
+ *        untouched when a guard rejects the input
+ *
+ * =============================================================================
+ */
+
+ //------------------------------------------------
+ //  Macro definitions
+ //------------------------------------------------
+
+/** Largest dimension handled by the closed-form paths. */
+#define MATRIX_SMALL_MAX_N 3
+
+/** ||N||_1 bound for the Cayley-Hamilton series (18 terms reach double precision). */
+#define MATRIX_SMALL_EXPM_THETA 1.0
+
+/** Squarings allowed to bring ||N||_1 under the bound before falling back to Pade. */
+#define MATRIX_SMALL_EXPM_MAX_SQUARINGS 4
+
+/** Largest 1-norm condition number accepted by the Cramer solve. */
+#define MATRIX_SMALL_SOLVE_COND_MAX 1.0e4
+
+//------------------------------------------------
+//  Type definitions
+//------------------------------------------------
+/* None */
+
+//------------------------------------------------
+//  Function Prototypes
+//------------------------------------------------
+
+/**
+ * @brief Closed-form exp(A) for n <= MATRIX_SMALL_MAX_N.
+ *
+ * @param[in]  A       Square input (1x1, 2x2 or 3x3).
+ * @param[out] result  exp(A), same size as A (may alias A). Written only when
+ *                     *done is set.
+ * @param[out] done    1 if the closed form was applied, 0 if the caller must
+ *                     use the general algorithm (size too large, ||N|| too
+ *                     large, or a non-finite result).
+ * @return CORE_ERROR_SUCCESS (also when *done == 0),
+ *         CORE_ERROR_NULL / CORE_ERROR_DIMENSION on invalid arguments.
+ */
+CoreErrorStatus matrix_small_expm(const Matrix* A, Matrix* result, int* done);
+
+/**
+ * @brief Solve A * X = B by Cramer's rule for n <= MATRIX_SMALL_MAX_N.
+ *
+ * @param[in]  A     Square coefficient matrix.
+ * @param[out] X     Solution (n x nrhs); may alias A or B. Written only when
+ *                   *done is set.
+ * @param[in]  B     Right-hand sides (n x nrhs).
+ * @param[out] done  1 if solved, 0 if the caller must use LU (size too large,
+ *                   singular, or condition number above
+ *                   MATRIX_SMALL_SOLVE_COND_MAX).
+ * @return CORE_ERROR_SUCCESS (also when *done == 0),
+ *         CORE_ERROR_NULL / CORE_ERROR_DIMENSION on invalid arguments.
+ */
+CoreErrorStatus matrix_small_solve(const Matrix* A, Matrix* X, const Matrix* B, int* done);
+
+#ifdef __cplusplus
+}
+#endif
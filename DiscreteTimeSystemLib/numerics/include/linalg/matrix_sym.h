@@ -0,0 +1,136 @@
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stddef.h>
+#include "core_matrix.h"
+#include "core_error.h"
+#include "matrix_gemm.h"
+#include "matrix_trsm.h"
+
+/*
+ * =============================================================================
+ *  matrix_sym.h
+ * =============================================================================
+ *
+ *  Description:
+ *      Kernels and factorizations for symmetric matrices. Only one triangle
+ *      is read or written, so covariance propagation, Gramians and Riccati
+ *      iterations can solve their systems with about half the flops of the
+ *      general pivoted LU (matrix_solve_LU()).
+ *
+ *  Features:
+ *      - SYRK: C = alpha * op(A) * op(A)^T + beta * C on one triangle of C
+ *      - Cholesky A = L * L^T for symmetric positive definite A
+ *      - Bunch-Kaufman A = P * L * D * L^T * P^T for symmetric indefinite A
+ *        (1x1 and 2x2 pivots, LAPACK dsytrf layout)
+ *      - In-place factorizations of the lower triangle; the upper triangle
+ *        is never read or written
+ *      - Recursive / panel-blocked so the O(n^3) work runs in GEMM and SYRK
+ *      - Caller-provided workspace, no allocation
+ *
+ * =============================================================================
+ */
+
+//------------------------------------------------
+//  Macro definitions
+//------------------------------------------------
+
+/** Order at or below which SYRK and Cholesky switch to plain loops. */
+#define MATRIX_SYM_LEAF 32
+/** Panel width of the blocked LDL^T factorization. */
+#define MATRIX_LDLT_NB 64
+/** Doubles of workspace needed by matrix_ldlt_factor() for order n. */
+#define MATRIX_LDLT_WORK(n) ((size_t)(n) * MATRIX_LDLT_NB)
+
+//------------------------------------------------
+//  Type definitions
+//------------------------------------------------
+/* None */
+
+//------------------------------------------------
+//  Function Prototypes
+//------------------------------------------------
+
+/**
+ * @brief Row-major SYRK on one triangle: C = alpha * op(A) * op(A)^T + beta * C.
+ *
+ * @param[in]     uplo   Triangle of C that is updated; the other one is not touched.
+ * @param[in]     trans  MATRIX_NO_TRANS: A is n x k (C = A A^T).
+ *                       MATRIX_TRANS:    A is k x n (C = A^T A).
+ * @param[in]     n      Order of C.
+ * @param[in]     k      Inner dimension.
+ * @param[in]     alpha  Scalar applied to the product.
+ * @param[in]     A      Row-major buffer.
+ * @param[in]     lda    Leading dimension of A (>= k, or >= n when transposed).
+ * @param[in]     beta   Scalar applied to C. If beta == 0, C is overwritten.
+ * @param[in,out] C      Row-major n x n buffer; must not overlap A.
+ * @param[in]     ldc    Leading dimension of C, >= n.
+ *
+ * @return CORE_ERROR_SUCCESS, CORE_ERROR_NULL, CORE_ERROR_INVALID_ARG
+ *         or CORE_ERROR_ALLOCATION_FAILED (GEMM packing buffers).
+ *
+ * @note Halves C recursively: the off-diagonal blocks are GEMMs, only the
+ *       diagonal leaves are computed in full and merged by triangle.
+ */
+CoreErrorStatus matrix_syrk_compute(MatrixUplo uplo, MatrixTranspose trans,
+    int n, int k, double alpha,
+    const double* A, int lda,
+    double beta,
+    double* C, int ldc);
+
+/**
+ * @brief In-place Cholesky factorization A = L * L^T.
+ *
+ * @param[in,out] A  n x n symmetric positive definite matrix. Only the lower
+ *                   triangle is read; on return it holds L.
+ *
+ * @return CORE_ERROR_SUCCESS, CORE_ERROR_NULL, CORE_ERROR_INVALID_ARG (not square),
+ *         or CORE_ERROR_NUMERIC if A is not positive definite (A is then partly overwritten).
+ */
+CoreErrorStatus matrix_chol_factor(Matrix* A);
+
+/**
+ * @brief Solve A * X = B from the Cholesky factor of A.
+ *
+ * @param[in]  L  Output of matrix_chol_factor() (lower triangle read).
+ * @param[out] X  n x nrhs solution. May be B itself (solved in place).
+ * @param[in]  B  n x nrhs right-hand side.
+ *
+ * @return CORE_ERROR_SUCCESS, CORE_ERROR_NULL or CORE_ERROR_DIMENSION.
+ */
+CoreErrorStatus matrix_chol_solve(const Matrix* L, Matrix* X, const Matrix* B);
+
+/**
+ * @brief In-place Bunch-Kaufman factorization A = P * L * D * L^T * P^T.
+ *
+ * @param[in,out] A     n x n symmetric matrix. Only the lower triangle is read;
+ *                      on return it holds D (1x1 and 2x2 diagonal blocks) and
+ *                      the multipliers of L below them.
+ * @param[out]    piv   n ints. piv[k] >= 0: 1x1 block, rows k and piv[k] were
+ *                      swapped. piv[k] = piv[k+1] = ~p < 0: 2x2 block at k, k+1,
+ *                      rows k+1 and p were swapped (LAPACK dsytrf, 0-based).
+ * @param[out]    work  Workspace of MATRIX_LDLT_WORK(n) doubles.
+ *
+ * @return CORE_ERROR_SUCCESS, CORE_ERROR_NULL, CORE_ERROR_INVALID_ARG (not square),
+ *         or CORE_ERROR_NUMERIC if A is exactly singular.
+ */
+CoreErrorStatus matrix_ldlt_factor(Matrix* A, int* piv, double* work);
+
+/**
+ * @brief Solve A * X = B from the Bunch-Kaufman factorization of A.
+ *
+ * @param[in]  LD   Output of matrix_ldlt_factor() (lower triangle read).
+ * @param[in]  piv  Pivots from matrix_ldlt_factor().
+ * @param[out] X    n x nrhs solution. May be B itself (solved in place).
+ * @param[in]  B    n x nrhs right-hand side.
+ *
+ * @return CORE_ERROR_SUCCESS, CORE_ERROR_NULL or CORE_ERROR_DIMENSION.
+ */
+CoreErrorStatus matrix_ldlt_solve(const Matrix* LD, const int* piv, Matrix* X, const Matrix* B);
+
+#ifdef __cplusplus
+}
+#endif
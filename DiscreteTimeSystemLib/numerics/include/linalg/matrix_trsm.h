@@ -0,0 +1,103 @@
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "core_error.h"
+#include "matrix_gemm.h"
+
+/*
+ * =============================================================================
+ *  matrix_trsm.h
+ * =============================================================================
+ *
+ *  Description:
+ *      Triangular solve with multiple right-hand sides (TRSM) on raw row-major
+ *      buffers. Used by the LU solver for both the factorization updates and
+ *      the substitution phase, so solves with many right-hand sides (e.g. the
+ *      n x n Pade system of expm) run at GEMM speed.
+ *
+ *  Features:
+ *      - Left (op(T) * X = alpha * B) and right (X * op(T) = alpha * B) solves
+ *      - Lower/upper triangles, unit/non-unit diagonal, op(T) = T or T^T
+ *      - Recursive halving of T: all but O(leaf^2 * nrhs) of the work is done
+ *        by matrix_gemm_compute_op() on the off-diagonal blocks
+ *      - Routed to dtrsm when built with an external BLAS
+ *
+ * =============================================================================
+ */
+
+//------------------------------------------------
+//  Macro definitions
+//------------------------------------------------
+
+/** Order of the diagonal blocks of T solved by the scalar leaf kernel. */
+#define MATRIX_TRSM_LEAF 32
+
+//------------------------------------------------
+//  Type definitions
+//------------------------------------------------
+
+/**
+ * @brief Side of X on which the triangular matrix appears.
+ */
+typedef enum {
+    MATRIX_SIDE_LEFT = 0,   ///< op(T) * X = alpha * B
+    MATRIX_SIDE_RIGHT = 1   ///< X * op(T) = alpha * B
+} MatrixSide;
+
+/**
+ * @brief Triangle of T that is referenced (the other one is never read).
+ */
+typedef enum {
+    MATRIX_UPPER = 0,
+    MATRIX_LOWER = 1
+} MatrixUplo;
+
+/**
+ * @brief Whether the diagonal of T is read or taken as all ones.
+ */
+typedef enum {
+    MATRIX_NON_UNIT = 0,
+    MATRIX_UNIT = 1
+} MatrixDiag;
+
+//------------------------------------------------
+//  Function Prototypes
+//------------------------------------------------
+
+/**
+ * @brief Row-major TRSM: solve op(T) * X = alpha * B or X * op(T) = alpha * B in place.
+ *
+ * @param[in]     side   MATRIX_SIDE_LEFT (T is m x m) or MATRIX_SIDE_RIGHT (T is n x n).
+ * @param[in]     uplo   Triangle of T to use.
+ * @param[in]     trans  Transform applied to T.
+ * @param[in]     diag   MATRIX_UNIT to treat the diagonal of T as ones.
+ * @param[in]     m      Rows of B.
+ * @param[in]     n      Columns of B.
+ * @param[in]     alpha  Scalar applied to B. If alpha == 0, B is zeroed and T is not read.
+ * @param[in]     T      Row-major triangular buffer.
+ * @param[in]     ldt    Leading dimension of T, >= its order.
+ * @param[in,out] B      Row-major m x n buffer; overwritten with X.
+ * @param[in]     ldb    Leading dimension of B, >= n.
+ *
+ * @return CORE_ERROR_SUCCESS on success
+ * @return CORE_ERROR_NULL if a buffer is NULL
+ * @return CORE_ERROR_INVALID_ARG on negative sizes, too small leading dimensions or bad flags
+ * @return CORE_ERROR_NUMERIC if diag is MATRIX_NON_UNIT and T has a zero on its diagonal
+ *         (B is left untouched)
+ * @return CORE_ERROR_ALLOCATION_FAILED if the GEMM packing buffers cannot be allocated
+ *
+ * @note B must not overlap T. Never allocates beyond the GEMM engine's
+ *       per-thread packing buffers.
+ */
+CoreErrorStatus matrix_trsm_compute(MatrixSide side, MatrixUplo uplo,
+    MatrixTranspose trans, MatrixDiag diag,
+    int m, int n, double alpha,
+    const double* T, int ldt,
+    double* B, int ldb);
+
+#ifdef __cplusplus
+}
+#endif
@@ -1,5 +1,6 @@
-#pragma once
+﻿#pragma once
 #include "core_matrix.h"
+#include "pade_scaling.h"
 
 /*
  * =============================================================================
@@ -14,7 +15,16 @@
  *  Features:
  *      - Supports arbitrary n x n real matrices
  *      - Numerically stable using scaling & squaring and (m=3,5,7,9,13) Pade
+ *      - (m, s) chosen by Al-Mohy & Higham (2009) from the norms of the even
+ *        powers it builds anyway (pade_select_scaling()); the choice and the
+ *        product count of every call are reported in ExpmWorkspace.stats
+ *      - Minimal matrix-product counts per order (m=13: 6 products, with the
+ *        high-order terms factored through A^6 as in Higham 2005)
+ *      - Closed-form (Cayley-Hamilton) fast path for n <= 3 (matrix_small.h)
+ *      - Block-triangular exponential exp([[A, B], [0, 0]]) at order n cost
+ *        (pade_expm_block_ws_inplace()), e.g. for ZOH discretization
  *      - Zero-allocation interface for the output (caller allocates result)
+ *      - Reusable ExpmWorkspace: pade_expm_ws() performs no heap allocation
  *      - Propagates well-defined error codes on invalid inputs or singularities
  *
  * =============================================================================
@@ -28,10 +38,154 @@
 //------------------------------------------------
 //  Type definitions
 //------------------------------------------------
-/* None */
+
+/**
+ * @brief What the last pade_expm_ws() call did.
+ */
+typedef struct {
+    int m;          ///< Pade order (0: closed form of matrix_small_expm(), no Pade)
+    int s;          ///< Number of squarings
+    int ell;        ///< Squarings added by the backward-error correction
+    int products;   ///< n x n matrix products: powers, Pade terms and squarings
+                    ///< (the LU solve of the quotient is not counted)
+} ExpmStats;
+
+/**
+ * @brief Scratch storage for pade_expm_ws(), sized once for n x n inputs.
+ *
+ * Create with pade_expm_workspace_init() (one allocation, released with
+ * pade_expm_workspace_free()) or carve it from a caller's arena with
+ * pade_expm_workspace_init_in() (released with that arena). A workspace may
+ * be reused for any number of calls with the same n, but must not be shared
+ * between concurrent calls.
+ */
+typedef struct {
+    int n;          ///< Matrix order the workspace was sized for
+    Matrix* As;     ///< Scaled input A / 2^s
+    Matrix* U;      ///< Odd Pade terms, then V + U
+    Matrix* V;      ///< Even Pade terms, then V - U
+    Matrix* S;      ///< Inner odd polynomial, then squaring ping-pong buffer
+    Matrix* A2;     ///< Even powers of As (A^8 for m = 9 is staged in U;
+    Matrix* A4;     ///< m = 13 never forms powers above A^6)
+    Matrix* A6;
+    Matrix* LU;     ///< LU factors of V - U
+    int* piv;       ///< Pivot sequence (n entries)
+    double* work;   ///< PADE_SCALING_WORK(n) doubles for the order selection
+    ExpmStats stats;  ///< Filled by every pade_expm_ws() / pade_expm_ws_inplace() call
+    MatrixArena own;  ///< Backing storage when created by pade_expm_workspace_init()
+} ExpmWorkspace;
 
 //------------------------------------------------
 //  Function Prototypes
 //------------------------------------------------
 
 CoreErrorStatus pade_expm(const Matrix* A, Matrix* result);
+
+/**
+ * @brief Allocate every buffer pade_expm_ws() needs for n x n inputs.
+ *
+ * @param[out] ws  Workspace to initialize. On failure it is left empty
+ *                 (safe to pass to pade_expm_workspace_free()).
+ * @param[in]  n   Matrix order (> 0).
+ *
+ * @return CORE_ERROR_SUCCESS on success
+ * @return CORE_ERROR_NULL if ws is NULL
+ * @return CORE_ERROR_INVALID_ARG if n <= 0
+ * @return CORE_ERROR_ALLOCATION_FAILED / CORE_ERROR_NOMEM on allocation failure
+ */
+CoreErrorStatus pade_expm_workspace_init(ExpmWorkspace* ws, int n);
+
+/**
+ * @brief Carve a workspace for n x n inputs out of an existing arena.
+ *
+ * Needs pade_expm_workspace_bytes(n) bytes of the arena. The workspace is
+ * released with the arena; pade_expm_workspace_free() only clears it.
+ *
+ * @return Same as pade_expm_workspace_init(), plus CORE_ERROR_NULL if arena is NULL.
+ */
+CoreErrorStatus pade_expm_workspace_init_in(ExpmWorkspace* ws, int n, MatrixArena* arena);
+
+/**
+ * @brief Arena bytes needed by pade_expm_workspace_init_in() for order n.
+ */
+size_t pade_expm_workspace_bytes(int n);
+
+/**
+ * @brief Release the buffers of a workspace and reset it to empty.
+ *
+ * @return CORE_ERROR_SUCCESS, or CORE_ERROR_NULL if ws is NULL.
+ */
+CoreErrorStatus pade_expm_workspace_free(ExpmWorkspace* ws);
+
+/**
+ * @brief Compute exp(A) like pade_expm(), using only the buffers in ws.
+ *
+ * No heap allocation takes place. The result is bit-identical to pade_expm().
+ *
+ * @param[in]     A       Square input matrix (n x n).
+ * @param[in,out] ws      Workspace initialized for the same n.
+ * @param[out]    result  Output matrix (n x n). May alias A.
+ *
+ * @return CORE_ERROR_SUCCESS on success
+ * @return CORE_ERROR_NULL if any argument is NULL
+ * @return CORE_ERROR_DIMENSION if A is not square or its size differs from
+ *         result or ws->n
+ * @return CORE_ERROR_NUMERIC if the Pade denominator is singular
+ */
+CoreErrorStatus pade_expm_ws(const Matrix* A, ExpmWorkspace* ws, Matrix* result);
+
+/**
+ * @brief pade_expm_ws() for an input already copied into ws->As.
+ *
+ * Lets callers that have to transform A first (e.g. scale it by t) do so
+ * directly in the workspace instead of in a separate buffer.
+ */
+CoreErrorStatus pade_expm_ws_inplace(ExpmWorkspace* ws, Matrix* result);
+
+/**
+ * @brief The Pade evaluation and squarings of pade_expm_ws_inplace() for an
+ *        order and scaling chosen by the caller.
+ *
+ * For callers that derive (m, s) and the powers of the scaled input more
+ * cheaply than pade_select_scaling() would, e.g. from powers of A shared by
+ * many multiples tA (pade_select_scaling_for_step()).
+ *
+ * @param[in,out] ws      Workspace for order n: ws->As holds 2^-s A, and
+ *                        ws->A2 .. its even powers up to sel->max_power.
+ *                        ws->stats counts sel->products plus the products
+ *                        done here.
+ * @param[in]     sel     Order m, squarings s, ell and max_power.
+ * @param[out]    result  n x n: exp(A).
+ *
+ * @return CORE_ERROR_SUCCESS, CORE_ERROR_NULL, CORE_ERROR_DIMENSION,
+ *         CORE_ERROR_INVALID_ARG for an unsupported order, or
+ *         CORE_ERROR_NUMERIC if the Pade denominator is singular
+ */
+CoreErrorStatus pade_expm_ws_selected(ExpmWorkspace* ws, const PadeScaling* sel, Matrix* result);
+
+/**
+ * @brief exp(A) and the coupling block of exp([[A, B], [0, 0]]) without
+ *        forming the (n + k) x (n + k) matrix.
+ *
+ *   exp([[A, B], [0, 0]]) = [[exp(A), F], [0, I]],  F = phi_1(A) B,
+ *   phi_1(x) = (e^x - 1) / x.
+ *
+ * The same [m/m] Pade approximant and scaling-and-squaring as
+ * pade_expm_ws_inplace(), carried out on the block structure: every power
+ * and squaring is an n x n product plus an n x k one, and the zero block
+ * is never stored. (m, s) are chosen from A alone. There is no closed-form
+ * path for small n.
+ *
+ * @param[in,out] ws      Workspace for order n; ws->As holds A and is
+ *                        overwritten. ws->stats counts the n x n products.
+ * @param[in,out] B       n x k coupling block (k >= 1), overwritten (scaled).
+ * @param[out]    W       n x k scratch block.
+ * @param[out]    result  n x n: exp(A).
+ * @param[out]    F       n x k: phi_1(A) B. Distinct from B and W.
+ *
+ * @return CORE_ERROR_SUCCESS, CORE_ERROR_NULL, CORE_ERROR_DIMENSION,
+ *         CORE_ERROR_INVALID_ARG if A contains NaN or Inf, or
+ *         CORE_ERROR_NUMERIC if the Pade denominator is singular
+ */
+CoreErrorStatus pade_expm_block_ws_inplace(ExpmWorkspace* ws, Matrix* B, Matrix* W,
+    Matrix* result, Matrix* F);
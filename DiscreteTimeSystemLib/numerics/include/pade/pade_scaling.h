@@ -13,32 +13,72 @@
  *      in the scaling-and-squaring algorithm for the matrix exponential.
  *
  *  Features:
- *      - Chooses (s, m) so that ||A||_1 * t / 2^s <= theta_m
+ *      - Al-Mohy & Higham (2009) selection: (m, s) from d_k = ||A^k||_1^(1/k)
+ *        of the even powers the Pade evaluation needs anyway, so non-normal
+ *        matrices are not over-scaled, plus the ell backward-error correction
+ *      - Norm-only selection (Higham 2005): ||A||_1 * t / 2^s <= theta_m
+ *      - Norm profile of A (pade_norm_profile()) from which the selection for
+ *        any tA follows without further products, for many t sharing one A
  *      - Candidate orders: m ∈ {3, 5, 7, 9, 13}
- *      - Cost-based selection (minimize multiplication count + squarings)
  *      - Helper to apply down-scaling by powers of two
  *
  * =============================================================================
  */
 
 #include "core_error.h"
+#include "matrix_norm.h"
 
  //------------------------------------------------
 //  Macro definitions
 //------------------------------------------------
-/* None */
+
+/** Order from which pade_select_scaling() sharpens its bounds on ||A^k||_1
+    with norm estimates; below it an estimate costs more than a product. */
+#define PADE_NORMEST_MIN_N 128
+/** Doubles of workspace needed by pade_select_scaling() for order n. */
+#define PADE_SCALING_WORK(n) \
+    (MATRIX_NORMEST_WORK(n, MATRIX_NORMEST_T) + (size_t)(n) * MATRIX_NORMEST_T)
 
 //------------------------------------------------
 //  Type definitions
 //------------------------------------------------
-/* None */
+
+/**
+ * @brief Outcome of pade_select_scaling().
+ */
+typedef struct {
+    int m;          ///< Pade order in {3, 5, 7, 9, 13}
+    int s;          ///< Number of squarings
+    int ell;        ///< Part of s added by the backward-error correction
+    int max_power;  ///< Highest even power of A left in the power buffers (2, 4 or 6)
+    int products;   ///< Matrix products spent forming those powers
+} PadeScaling;
+
+/**
+ * @brief Norms of A from which pade_select_scaling_for_step() picks (m, s)
+ *        for any multiple tA.
+ *
+ * d_k(tA) = |t| d_k(A) and || |tA|^p ||_1 = |t|^p || |A|^p ||_1, so one
+ * profile serves every t.
+ */
+typedef struct {
+    double norm1;           ///< ||A||_1
+    double d4;              ///< ||A^4||_1^(1/4)
+    double d6;              ///< ||A^6||_1^(1/6)
+    double d8;              ///< Bound (or estimate) of ||A^8||_1^(1/8)
+    double d10;             ///< Bound (or estimate) of ||A^10||_1^(1/10)
+    double log2_abs[5];     ///< log2 || |A|^(2m+1) ||_1 for m = 3, 5, 7, 9, 13
+} PadeNormProfile;
 
 //------------------------------------------------
 //  Function Prototypes
 //------------------------------------------------
 
 /**
- * @brief Choose scaling s and Pade order m for exp(A*t) via scaling & squaring.
+ * @brief Choose scaling s and Pade order m for exp(A*t) from ||A||_1 alone.
+ *
+ * The Higham (2005) criterion; pade_select_scaling() needs fewer squarings
+ * for non-normal A and is what pade_expm() uses.
  *
  * Given anorm = ||A||_1 * t (already multiplied by the step t),
  * this picks (s, m) so that anorm / 2^s <= theta_m.
@@ -56,6 +96,75 @@
  */
 CoreErrorStatus pade_choose_scaling_and_order(double anorm, int* out_s, int* out_m);
 
+/**
+ * @brief Choose (m, s) for exp(A) by the Al-Mohy & Higham (2009) algorithm.
+ *
+ * Forms A^2, A^4 and A^6 only as far as the order tests need them, and
+ * bounds the unformed powers by products of the formed ones; for
+ * n >= PADE_NORMEST_MIN_N a bound that fails a test is replaced by a block
+ * 1-norm estimate of the power (matrix_norm_1_est(), O(n^2) per probe):
+ *
+ *  - m = 3, 5, 7, 9 is taken (with s = 0) as soon as
+ *    max(d_2k, d_2k+2) <= theta_m and ell(A, m) = 0;
+ *  - otherwise m = 13 and s = max(ceil(log2(eta / theta_13)), 0) + ell(2^-s A, 13),
+ *    where eta = min(max(d6, d8), max(d8, d10)).
+ *
+ * ell(A, m) is the number of extra squarings that keeps the relative backward
+ * error of the [m/m] approximant below the unit roundoff; it uses the exact
+ * ||  |A|^(2m+1) ||_1 from 2m+1 vector products with |A| (O(m n^2)).
+ *
+ * On return the power buffers up to A^{max_power} hold the even powers of
+ * 2^-s * A, ready for the Pade evaluation; the caller scales A itself.
+ *
+ * @param[in]  A     n x n input (already multiplied by the step).
+ * @param[out] A2    n x n buffer for A^2.
+ * @param[out] A4    n x n buffer for A^4.
+ * @param[out] A6    n x n buffer for A^6.
+ * @param[out] work  PADE_SCALING_WORK(n) doubles.
+ * @param[out] out   Selected order, scaling and product count.
+ *
+ * @return CORE_ERROR_SUCCESS, CORE_ERROR_NULL, CORE_ERROR_DIMENSION,
+ *         CORE_ERROR_INVALID_ARG if A contains NaN or Inf, or an error from the products.
+ */
+CoreErrorStatus pade_select_scaling(const Matrix* A, Matrix* A2, Matrix* A4, Matrix* A6,
+    double* work, PadeScaling* out);
+
+/**
+ * @brief Profile of A for pade_select_scaling_for_step(), from A^2, A^4 and
+ *        A^6 formed by the caller.
+ *
+ * ||A^8||_1 and ||A^10||_1 are bounded by products of the formed powers and,
+ * for n >= PADE_NORMEST_MIN_N, sharpened by norm estimates. The five
+ * || |A|^(2m+1) ||_1 come from a single pass of 27 vector products with |A|.
+ *
+ * @param[in]  A     n x n matrix.
+ * @param[in]  A2    A^2.
+ * @param[in]  A4    A^4.
+ * @param[in]  A6    A^6.
+ * @param[out] work  PADE_SCALING_WORK(n) doubles.
+ * @param[out] out   Profile.
+ *
+ * @return CORE_ERROR_SUCCESS, CORE_ERROR_NULL, CORE_ERROR_DIMENSION, or
+ *         CORE_ERROR_INVALID_ARG if A or one of its powers is not finite.
+ */
+CoreErrorStatus pade_norm_profile(const Matrix* A, const Matrix* A2, const Matrix* A4,
+    const Matrix* A6, double* work, PadeNormProfile* out);
+
+/**
+ * @brief Choose (m, s) for exp(tA) from a profile of A, without products.
+ *
+ * The tests of pade_select_scaling() applied to the scaled profile; as every
+ * d_k is already at hand, the choice may differ from pade_select_scaling(tA)
+ * only where that used a looser bound. max_power is the highest even power
+ * the order reads (2, 4 or 6) and products is 0: the caller provides the
+ * powers of 2^-s tA.
+ *
+ * @return CORE_ERROR_SUCCESS, CORE_ERROR_NULL, or CORE_ERROR_INVALID_ARG
+ *         if t is not finite.
+ */
+CoreErrorStatus pade_select_scaling_for_step(const PadeNormProfile* profile, double t,
+    PadeScaling* out);
+
 /**
  * @brief Convenience wrapper when you have ||A||_1 and step t separately.
  *
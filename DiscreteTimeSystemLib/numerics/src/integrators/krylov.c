@@ -0,0 +1,273 @@
+#include <float.h>
+#include <math.h>
+#include "integrators/krylov.h"
+#include "matrix_gemm.h"
+
+/* Expokit's step-size control: safety factor on a new step, and slack on
+   the error test. */
+#define KRYLOV_GAMMA 0.9
+#define KRYLOV_DELTA 1.2
+
+static double vec_norm2(int n, const double* x) {
+    double s = 0.0;
+    for (int i = 0; i < n; ++i) s += x[i] * x[i];
+    return sqrt(s);
+}
+
+/* Round up to two significant digits, as Expokit does, so step sizes do not
+   drift by roundoff from one step to the next. */
+static double round_step(double dt) {
+    const double unit = pow(10.0, floor(log10(dt)) - 1.0);
+    return ceil(dt / unit) * unit;
+}
+
+/* Step that would bring the error estimate of this one to tol: err ~ tau^(1/xm). */
+static double next_step(double tau, double tol, double err, double xm, double remaining) {
+    const double dt = KRYLOV_GAMMA * tau * pow(tau * tol / err, xm);
+    return isfinite(dt) ? round_step(dt) : remaining;
+}
+
+size_t krylov_workspace_bytes(int n, int m) {
+    if (n <= 0 || m <= 0) return 0;
+    if (m > n) m = n;
+    return matrix_core_bytes_in(m + 1, n)
+        + 2 * matrix_core_bytes_in(m + 2, m + 2)
+        + matrix_arena_bytes_for((size_t)n * sizeof(double))
+        + matrix_arena_bytes_for(2 * (size_t)(m + 1) * sizeof(double))
+        + pade_expm_workspace_bytes(m + 2);
+}
+
+CoreErrorStatus krylov_workspace_init_in(KrylovWorkspace* ws, int n, int m, MatrixArena* arena) {
+    if (!ws) CORE_ERROR_RETURN(CORE_ERROR_NULL);
+    *ws = (KrylovWorkspace){ 0 };
+    if (!arena) CORE_ERROR_RETURN(CORE_ERROR_NULL);
+    if (n <= 0 || m <= 0) CORE_ERROR_RETURN(CORE_ERROR_INVALID_ARG);
+    if (m > n) m = n;
+
+    CoreErrorStatus status = CORE_ERROR_SUCCESS;
+    ws->V = matrix_core_create_in(arena, m + 1, n, &status);
+    if (status != CORE_ERROR_SUCCESS) goto FAIL;
+    ws->H = matrix_core_create_in(arena, m + 2, m + 2, &status);
+    if (status != CORE_ERROR_SUCCESS) goto FAIL;
+    ws->F = matrix_core_create_in(arena, m + 2, m + 2, &status);
+    if (status != CORE_ERROR_SUCCESS) goto FAIL;
+    ws->p = (double*)matrix_arena_alloc(arena, (size_t)n * sizeof(double), &status);
+    if (status != CORE_ERROR_SUCCESS) goto FAIL;
+    ws->h = (double*)matrix_arena_alloc(arena, 2 * (size_t)(m + 1) * sizeof(double), &status);
+    if (status != CORE_ERROR_SUCCESS) goto FAIL;
+    status = pade_expm_workspace_init_in(&ws->expm, m + 2, arena);
+    if (status != CORE_ERROR_SUCCESS) goto FAIL;
+
+    ws->n = n;
+    ws->m = m;
+    CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
+
+FAIL:
+    *ws = (KrylovWorkspace){ 0 };
+    CORE_ERROR_RETURN(status);
+}
+
+CoreErrorStatus krylov_workspace_init(KrylovWorkspace* ws, int n, int m) {
+    if (!ws) CORE_ERROR_RETURN(CORE_ERROR_NULL);
+    *ws = (KrylovWorkspace){ 0 };
+    if (n <= 0 || m <= 0) CORE_ERROR_RETURN(CORE_ERROR_INVALID_ARG);
+
+    MatrixArena arena;
+    CoreErrorStatus status = matrix_arena_init(&arena, krylov_workspace_bytes(n, m));
+    if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+
+    status = krylov_workspace_init_in(ws, n, m, &arena);
+    if (status != CORE_ERROR_SUCCESS) {
+        matrix_arena_destroy(&arena);
+        CORE_ERROR_RETURN(status);
+    }
+    ws->own = arena;
+    CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
+}
+
+CoreErrorStatus krylov_workspace_free(KrylovWorkspace* ws) {
+    if (!ws) CORE_ERROR_RETURN(CORE_ERROR_NULL);
+    matrix_arena_destroy(&ws->own);
+    *ws = (KrylovWorkspace){ 0 };
+    CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
+}
+
+/*
+ * Arnoldi process on the unit vector in row 0 of V: fills V rows 1..mb and
+ * the Hessenberg block H(0..mb, 0..mb-1), each new direction orthogonalized
+ * twice against the whole basis (two GEMV pairs). *mb < m on breakdown.
+ */
+static CoreErrorStatus arnoldi(const MatrixLinearOperator* op, KrylovWorkspace* ws, int* mb, int* breakdown) {
+    const int n = ws->n, m = ws->m;
+    Matrix* V = ws->V;
+    Matrix* H = ws->H;
+    double* h1 = ws->h;
+    double* h2 = ws->h + (m + 1);
+    MatrixView vj, P;
+    CoreErrorStatus status = matrix_view_of(&P, ws->p, n, 1, 1);
+    if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+
+    *mb = m;
+    *breakdown = 0;
+    for (int j = 0; j < m; ++j) {
+        status = matrix_view_of(&vj, V->data + (size_t)j * V->ld, n, 1, 1);
+        if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+        status = matrix_linop_apply(op, MATRIX_NO_TRANS, &vj, &P);
+        if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+        ws->stats.applies++;
+        const double a = vec_norm2(n, ws->p);
+
+        for (int pass = 0; pass < 2; ++pass) {
+            double* hc = pass ? h2 : h1;
+            status = matrix_gemv_compute(MATRIX_NO_TRANS, j + 1, n, 1.0, V->data, V->ld, ws->p, 0.0, hc);
+            if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+            status = matrix_gemv_compute(MATRIX_TRANS, j + 1, n, -1.0, V->data, V->ld, hc, 1.0, ws->p);
+            if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+        }
+        for (int i = 0; i <= j; ++i) H->data[(size_t)i * H->ld + j] = h1[i] + h2[i];
+
+        const double s = vec_norm2(n, ws->p);
+        if (s <= KRYLOV_BREAKDOWN_TOL * a) {
+            *mb = j + 1;
+            *breakdown = 1;
+            break;
+        }
+        H->data[(size_t)(j + 1) * H->ld + j] = s;
+        double* next = V->data + (size_t)(j + 1) * V->ld;
+        for (int i = 0; i < n; ++i) next[i] = ws->p[i] / s;
+    }
+    CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
+}
+
+CoreErrorStatus krylov_expv(const MatrixLinearOperator* op, double t, const Matrix* v,
+    double tol, KrylovWorkspace* ws, Matrix* w)
+{
+    if (!op || !op->apply || !v || !ws || !w) CORE_ERROR_RETURN(CORE_ERROR_NULL);
+    if (!ws->V || !ws->H || !ws->F || !ws->p || !ws->h) CORE_ERROR_RETURN(CORE_ERROR_NULL);
+    const int n = ws->n, m = ws->m;
+    if (op->n != n || v->rows != n || v->cols != 1 || w->rows != n || w->cols != 1) {
+        CORE_ERROR_RETURN(CORE_ERROR_DIMENSION);
+    }
+    if (!(tol > 0.0) || !isfinite(t)) CORE_ERROR_RETURN(CORE_ERROR_INVALID_ARG);
+
+    ws->stats = (KrylovStats){ 0 };
+    Matrix* V = ws->V;
+    Matrix* H = ws->H;
+    Matrix* F = ws->F;
+    const int M = m + 2;
+
+    double* v0 = V->data;
+    for (int i = 0; i < n; ++i) v0[i] = v->data[(size_t)i * v->ld];
+    const double normv = vec_norm2(n, v0);
+    double beta = normv;
+    ws->stats.hump = 1.0;
+    if (t == 0.0 || beta == 0.0) {
+        for (int i = 0; i < n; ++i) w->data[(size_t)i * w->ld] = v0[i];
+        CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
+    }
+    for (int i = 0; i < n; ++i) v0[i] /= beta;
+
+    /* Tolerances are absolute from here on */
+    const double tol_abs = tol * normv;
+    const double sgn = (t < 0.0) ? -1.0 : 1.0;
+    const double t_out = fabs(t);
+    /* log of Expokit's ((m+1)/e)^(m+1) sqrt(2 pi (m+1)) */
+    const double log_fact = (m + 1) * (log(m + 1.0) - 1.0) + 0.5 * log(2.0 * 3.14159265358979323846 * (m + 1));
+    double t_now = 0.0, t_new = 0.0, s_error = 0.0;
+    CoreErrorStatus status;
+
+    while (t_now < t_out) {
+        for (int i = 0; i < M * M; ++i) H->data[(size_t)(i / M) * H->ld + i % M] = 0.0;
+        int mb = 0, breakdown = 0;
+        status = arnoldi(op, ws, &mb, &breakdown);
+        if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+
+        /* ||H||_inf of the filled block stands in for ||A|| */
+        double hnorm = 0.0;
+        for (int i = 0; i <= mb && i < M; ++i) {
+            double r = 0.0;
+            for (int j = 0; j < mb; ++j) r += fabs(H->data[(size_t)i * H->ld + j]);
+            hnorm = fmax(hnorm, r);
+        }
+        if (ws->stats.steps == 0) {
+            t_new = (hnorm > 0.0)
+                ? round_step(exp((log_fact + log(tol_abs / (4.0 * beta * hnorm))) / m) / hnorm)
+                : t_out;
+            if (!isfinite(t_new) || t_new <= 0.0) t_new = t_out;
+        }
+
+        double avnorm = 0.0;
+        if (!breakdown) {
+            /* augmented row for the corrected scheme, and ||A v_{m+1}|| for the estimate */
+            H->data[(size_t)(m + 1) * H->ld + m] = 1.0;
+            MatrixView vm, P;
+            status = matrix_view_of(&vm, V->data + (size_t)m * V->ld, n, 1, 1);
+            if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+            status = matrix_view_of(&P, ws->p, n, 1, 1);
+            if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+            status = matrix_linop_apply(op, MATRIX_NO_TRANS, &vm, &P);
+            if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+            ws->stats.applies++;
+            avnorm = vec_norm2(n, ws->p);
+        }
+
+        double t_step = breakdown ? t_out - t_now : fmin(t_out - t_now, t_new);
+        double err_loc = 0.0, xm = 1.0 / m;
+        for (int reject = 0; ; ++reject) {
+            /* exp of the (zero-padded) H: the unused trailing block only adds an identity */
+            Matrix* As = ws->expm.As;
+            for (int i = 0; i < M; ++i) {
+                for (int j = 0; j < M; ++j) {
+                    As->data[(size_t)i * As->ld + j] = sgn * t_step * H->data[(size_t)i * H->ld + j];
+                }
+            }
+            status = pade_expm_ws_inplace(&ws->expm, F);
+            if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+            if (breakdown) break;
+
+            const double phi1 = fabs(beta * F->data[(size_t)m * F->ld]);
+            const double phi2 = fabs(beta * F->data[(size_t)(m + 1) * F->ld] * avnorm);
+            if (phi1 > 10.0 * phi2) {
+                err_loc = phi2;
+                xm = 1.0 / m;
+            }
+            else if (phi1 > phi2) {
+                err_loc = (phi1 * phi2) / (phi1 - phi2);
+                xm = 1.0 / m;
+            }
+            else {
+                err_loc = phi1;
+                xm = (m > 1) ? 1.0 / (m - 1) : 1.0;
+            }
+            if (err_loc <= KRYLOV_DELTA * t_step * tol_abs) break;
+            if (reject == KRYLOV_MAX_REJECT) CORE_ERROR_RETURN(CORE_ERROR_NUMERIC);
+            t_step = next_step(t_step, tol_abs, err_loc, xm, t_out - t_now);
+            if (!(t_step > 0.0)) CORE_ERROR_RETURN(CORE_ERROR_NUMERIC);
+            ws->stats.rejected++;
+        }
+
+        /* w = beta V^T F(:, 0) over the basis (plus v_{m+1} for the corrected scheme) */
+        const int mx = breakdown ? mb : m + 1;
+        double* coef = ws->h;
+        for (int i = 0; i < mx; ++i) coef[i] = beta * F->data[(size_t)i * F->ld];
+        status = matrix_gemv_compute(MATRIX_TRANS, mx, n, 1.0, V->data, V->ld, coef, 0.0, ws->p);
+        if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+
+        beta = vec_norm2(n, ws->p);
+        ws->stats.hump = fmax(ws->stats.hump, beta / normv);
+        ws->stats.steps++;
+        t_now = (breakdown || t_step >= t_out - t_now) ? t_out : t_now + t_step;
+        s_error += fmax(err_loc, hnorm * DBL_EPSILON * beta);
+        if (err_loc > 0.0) t_new = next_step(t_step, tol_abs, err_loc, xm, t_out - t_now);
+        else t_new = t_out;
+
+        if (t_now < t_out) {
+            if (beta == 0.0) break;
+            for (int i = 0; i < n; ++i) v0[i] = ws->p[i] / beta;
+        }
+    }
+
+    ws->stats.error = s_error / normv;
+    for (int i = 0; i < n; ++i) w->data[(size_t)i * w->ld] = ws->p[i];
+    CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
+}
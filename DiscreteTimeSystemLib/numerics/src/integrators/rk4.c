@@ -8,6 +8,23 @@ static CoreErrorStatus _check_vec(const Matrix* v, int n) {
     return CORE_ERROR_SUCCESS;
 }
 
+/* x_next = x + h/6 * (k1 + 2*k2 + 2*k3 + k4), accumulated in tmp so that
+   x_next may alias x_now. */
+static CoreErrorStatus _rk4_combine(const Matrix* x_now, double h,
+    const Matrix* k1, const Matrix* k2, const Matrix* k3, const Matrix* k4,
+    Matrix* tmp, Matrix* x_next)
+{
+    CoreErrorStatus st = matrix_ops_copy(tmp, k1);   if (st) return st;
+    st = matrix_ops_axpy(tmp, 2.0, k2);              if (st) return st;
+    st = matrix_ops_axpy(tmp, 2.0, k3);              if (st) return st;
+    st = matrix_ops_add(tmp, tmp, k4);               if (st) return st;
+
+    if (x_next != x_now) {
+        st = matrix_ops_copy(x_next, x_now);         if (st) return st;
+    }
+    return matrix_ops_axpy(x_next, h / 6.0, tmp);
+}
+
 CoreErrorStatus rk4_step_ws(RkOdeFunc f,
     double t,
     const Matrix* x_now,
@@ -33,47 +50,23 @@ CoreErrorStatus rk4_step_ws(RkOdeFunc f,
     st = f(t, x_now, u_now, params, k1);                  if (st) return st;
 
     // k2 = f(t + h/2, x + h/2 * k1, u)
-    // tmp = x + (h/2) * k1
+    // tmp = x + (h/2) * k1  (k1 itself is left untouched)
     st = matrix_ops_copy(tmp, x_now);                   if (st) return st;
-    st = matrix_ops_scale(k1, h * 0.5);                     if (st) return st;
-    st = matrix_ops_add(tmp, tmp, k1);                  if (st) return st;
-    st = f(t + h * 0.5, tmp, u_now, params, k2);       if (st) return st;
-    st = matrix_ops_scale(k1, 1.0 / (h * 0.5));           if (st) return st; // restore k1 if scale is in-place (optional)
+    st = matrix_ops_axpy(tmp, h * 0.5, k1);             if (st) return st;
+    st = f(t + h * 0.5, tmp, u_now, params, k2);        if (st) return st;
 
     // k3 = f(t + h/2, x + h/2 * k2, u)
-    st = matrix_ops_copy(tmp, x_now);                  if (st) return st;
-    st = matrix_ops_scale(k2, h * 0.5);                    if (st) return st;
-    st = matrix_ops_add(tmp, tmp, k2);                 if (st) return st;
-    st = f(t + h * 0.5, tmp, u_now, params, k3);      if (st) return st;
-    st = matrix_ops_scale(k2, 1.0 / (h * 0.5));          if (st) return st;
+    st = matrix_ops_copy(tmp, x_now);                   if (st) return st;
+    st = matrix_ops_axpy(tmp, h * 0.5, k2);             if (st) return st;
+    st = f(t + h * 0.5, tmp, u_now, params, k3);        if (st) return st;
 
     // k4 = f(t + h, x + h*k3, u)
-    st = matrix_ops_copy(tmp, x_now);                 if (st) return st;
-    st = matrix_ops_scale(k3, h);                            if (st) return st;
-    st = matrix_ops_add(tmp, tmp, k3);                 if (st) return st;
+    st = matrix_ops_copy(tmp, x_now);                   if (st) return st;
+    st = matrix_ops_axpy(tmp, h, k3);                   if (st) return st;
     st = f(t + h, tmp, u_now, params, k4);              if (st) return st;
-    st = matrix_ops_scale(k3, 1.0 / h);                    if (st) return st;
 
     // x_next = x + h/6 * (k1 + 2*k2 + 2*k3 + k4)
-    // tmp = k1 + 2*k2
-    st = matrix_ops_scale(k2, 2.0);                         if (st) return st;
-    st = matrix_ops_add(tmp, k1, k2);                   if (st) return st;
-
-    // tmp = tmp + 2*k3
-    st = matrix_ops_scale(k3, 2.0);                         if (st) return st;
-    st = matrix_ops_add(tmp, tmp, k3);                 if (st) return st;
-
-    // tmp = tmp + k4
-    st = matrix_ops_add(tmp, tmp, k4);                 if (st) return st;
-
-    // tmp = (h/6) * tmp
-    st = matrix_ops_scale(tmp, h / 6.0);                 if (st) return st;
-
-    // x_next = x + tmp
-    st = matrix_ops_add(x_next, x_now, tmp);       if (st) return st;
-
-    // iCӁjXP[ k2/k3 ɖ߂ꍇ͂Ŗ߂
-    return CORE_ERROR_SUCCESS;
+    return _rk4_combine(x_now, h, k1, k2, k3, k4, tmp, x_next);
 }
 
 CoreErrorStatus rk4_step(RkOdeFunc f,
@@ -108,21 +101,28 @@ DONE:
 
 /* ---------- Linear specialization: x' = A x + B u (ZOH) ---------- */
 
+/* out_dx = A x + B u, accumulated in place by GEMV (beta = 1 for the input term). */
 static CoreErrorStatus _lin_rhs(const Matrix* A, const Matrix* B,
-    const Matrix* x, const Matrix* u,
-    Matrix* Ax, Matrix* Bu, Matrix* out_dx)
+    const Matrix* x, const Matrix* u, Matrix* out_dx)
 {
-    CoreErrorStatus st = matrix_ops_multiply(Ax, A, x); if (st) return st;
+    CoreErrorStatus st = matrix_ops_gemv(out_dx, 1.0, A, MATRIX_NO_TRANS, x, 0.0);
+    if (st) return st;
     if (B && u) {
-        st = matrix_ops_multiply(Bu, B, u); if (st) return st;
-        st = matrix_ops_add(out_dx, Ax, Bu);
-    }
-    else {
-        st = matrix_ops_copy(out_dx, Ax);
+        st = matrix_ops_gemv(out_dx, 1.0, B, MATRIX_NO_TRANS, u, 1.0);
     }
     return st;
 }
 
+/* k_next = k1 + c * A * k_prev. For a linear right-hand side
+   f(x + c k_prev) = A x + B u + c A k_prev = k1 + c A k_prev, so each stage
+   is a single GEMV accumulating onto a copy of k1 and B u is formed once. */
+static CoreErrorStatus _lin_stage(const Matrix* A, double c,
+    const Matrix* k1, const Matrix* k_prev, Matrix* k_next)
+{
+    CoreErrorStatus st = matrix_ops_copy(k_next, k1); if (st) return st;
+    return matrix_ops_gemv(k_next, c, A, MATRIX_NO_TRANS, k_prev, 1.0);
+}
+
 CoreErrorStatus rk4_lin_step_ws(const Matrix* A,
     const Matrix* B,
     double t,
@@ -150,43 +150,20 @@ CoreErrorStatus rk4_lin_step_ws(const Matrix* A,
 
     CoreErrorStatus st = CORE_ERROR_SUCCESS;
 
-    // k1 = f(x)
-    st = _lin_rhs(A, B, x_now, u_now, Ax, Bu, k1); if (st) return st;
-
-    // k2: tmp = x + h/2 * k1
-    st = matrix_ops_copy(tmp, x_now);           if (st) return st;
-    st = matrix_ops_scale(k1, h * 0.5);           if (st) return st;
-    st = matrix_ops_add(tmp, tmp, k1);          if (st) return st;
-    st = _lin_rhs(A, B, tmp, u_now, Ax, Bu, k2);      if (st) return st;
-    st = matrix_ops_scale(k1, 1.0 / (h * 0.5));     if (st) return st;
-
-    // k3
-    st = matrix_ops_copy(tmp, x_now);           if (st) return st;
-    st = matrix_ops_scale(k2, h * 0.5);           if (st) return st;
-    st = matrix_ops_add(tmp, tmp, k2);          if (st) return st;
-    st = _lin_rhs(A, B, tmp, u_now, Ax, Bu, k3);      if (st) return st;
-    st = matrix_ops_scale(k2, 1.0 / (h * 0.5));     if (st) return st;
-
-    // k4
-    st = matrix_ops_copy(tmp, x_now);           if (st) return st;
-    st = matrix_ops_scale(k3, h);               if (st) return st;
-    st = matrix_ops_add(tmp, tmp, k3);          if (st) return st;
-    st = _lin_rhs(A, B, tmp, u_now, Ax, Bu, k4);      if (st) return st;
-    st = matrix_ops_scale(k3, 1.0 / h);           if (st) return st;
-
-    // x_next = x + h/6 (k1 + 2k2 + 2k3 + k4)
-    st = matrix_ops_scale(k2, 2.0);             if (st) return st;
-    st = matrix_ops_add(tmp, k1, k2);           if (st) return st;
+    // k1 = A x + B u
+    st = _lin_rhs(A, B, x_now, u_now, k1);      if (st) return st;
 
-    st = matrix_ops_scale(k3, 2.0);             if (st) return st;
-    st = matrix_ops_add(tmp, tmp, k3);          if (st) return st;
+    // k2 = f(x + h/2 k1) = k1 + h/2 A k1
+    st = _lin_stage(A, h * 0.5, k1, k1, k2);    if (st) return st;
 
-    st = matrix_ops_add(tmp, tmp, k4);          if (st) return st;
+    // k3 = k1 + h/2 A k2
+    st = _lin_stage(A, h * 0.5, k1, k2, k3);    if (st) return st;
 
-    st = matrix_ops_scale(tmp, h / 6.0);          if (st) return st;
-    st = matrix_ops_add(x_next, x_now, tmp);    if (st) return st;
+    // k4 = k1 + h A k3
+    st = _lin_stage(A, h, k1, k3, k4);          if (st) return st;
 
-    return CORE_ERROR_SUCCESS;
+    // x_next = x + h/6 (k1 + 2k2 + 2k3 + k4)
+    return _rk4_combine(x_now, h, k1, k2, k3, k4, tmp, x_next);
 }
 
 CoreErrorStatus rk4_lin_step(const Matrix* A,
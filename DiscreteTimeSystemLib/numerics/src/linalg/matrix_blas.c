@@ -0,0 +1,182 @@
+#include "matrix_blas.h"
+
+/*
+ * BLAS/LAPACK are column-major. A row-major buffer with leading dimension ld
+ * is, read column-major, the transpose of the matrix it holds, so every
+ * adapter below either solves the transposed problem or transposes in place.
+ */
+
+#if MATRIX_BLAS_ENABLED
+
+/* Fortran interfaces (LP64 integers), exported with a trailing underscore by
+   OpenBLAS, MKL, BLIS and the reference implementation alike. */
+typedef int blas_int;
+
+extern void dgemm_(const char* transa, const char* transb,
+    const blas_int* m, const blas_int* n, const blas_int* k,
+    const double* alpha, const double* a, const blas_int* lda,
+    const double* b, const blas_int* ldb,
+    const double* beta, double* c, const blas_int* ldc);
+
+extern void dtrsm_(const char* side, const char* uplo, const char* transa, const char* diag,
+    const blas_int* m, const blas_int* n, const double* alpha,
+    const double* a, const blas_int* lda, double* b, const blas_int* ldb);
+
+extern void dgetrf_(const blas_int* m, const blas_int* n, double* a, const blas_int* lda,
+    blas_int* ipiv, blas_int* info);
+
+extern void sgetrf_(const blas_int* m, const blas_int* n, float* a, const blas_int* lda,
+    blas_int* ipiv, blas_int* info);
+
+/* Square in-place transpose of the leading n x n block. */
+static void transpose_square(int n, double* A, int lda) {
+    for (int i = 0; i < n; ++i) {
+        for (int j = i + 1; j < n; ++j) {
+            double t = A[(size_t)i * lda + j];
+            A[(size_t)i * lda + j] = A[(size_t)j * lda + i];
+            A[(size_t)j * lda + i] = t;
+        }
+    }
+}
+
+static void transpose_square_f(int n, float* A, int lda) {
+    for (int i = 0; i < n; ++i) {
+        for (int j = i + 1; j < n; ++j) {
+            float t = A[(size_t)i * lda + j];
+            A[(size_t)i * lda + j] = A[(size_t)j * lda + i];
+            A[(size_t)j * lda + i] = t;
+        }
+    }
+}
+
+const char* matrix_blas_backend(void) {
+    return DTS_BLAS_NAME;
+}
+
+CoreErrorStatus matrix_blas_gemm(MatrixTranspose trans_a, MatrixTranspose trans_b,
+    int m, int n, int k,
+    double alpha,
+    const double* A, int lda,
+    const double* B, int ldb,
+    double beta,
+    double* C, int ldc)
+{
+    /* Row-major C = op(A) op(B)  <=>  column-major C^T = op(B)^T op(A)^T,
+       and the buffers already read as A^T, B^T, C^T. */
+    const char ta = trans_a ? 'T' : 'N';
+    const char tb = trans_b ? 'T' : 'N';
+    const blas_int bm = n, bn = m, bk = k, blda = lda, bldb = ldb, bldc = ldc;
+    dgemm_(&tb, &ta, &bm, &bn, &bk, &alpha, B, &bldb, A, &blda, &beta, C, &bldc);
+    CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
+}
+
+CoreErrorStatus matrix_blas_getrf(int n, double* A, int lda, int* piv) {
+    /* dgetrf must see A itself (row pivoting of A, not of A^T), so factor the
+       transposed buffer and transpose the L\U result back. */
+    transpose_square(n, A, lda);
+    const blas_int bn = n, blda = lda;
+    blas_int info = 0;
+    dgetrf_(&bn, &bn, A, &blda, piv, &info);
+    transpose_square(n, A, lda);
+
+    for (int k = 0; k < n; ++k) piv[k] -= 1;   /* 1-based -> 0-based */
+    if (info > 0) CORE_ERROR_RETURN(CORE_ERROR_NUMERIC);
+    if (info < 0) CORE_ERROR_RETURN(CORE_ERROR_INVALID_ARG);
+    CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
+}
+
+CoreErrorStatus matrix_blas_sgetrf(int n, float* A, int lda, int* piv) {
+    transpose_square_f(n, A, lda);
+    const blas_int bn = n, blda = lda;
+    blas_int info = 0;
+    sgetrf_(&bn, &bn, A, &blda, piv, &info);
+    transpose_square_f(n, A, lda);
+
+    for (int k = 0; k < n; ++k) piv[k] -= 1;
+    if (info > 0) CORE_ERROR_RETURN(CORE_ERROR_NUMERIC);
+    if (info < 0) CORE_ERROR_RETURN(CORE_ERROR_INVALID_ARG);
+    CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
+}
+
+CoreErrorStatus matrix_blas_trsm_left(int lower, MatrixTranspose trans, int unit_diag,
+    int n, int nrhs, double alpha,
+    const double* T, int ldt,
+    double* B, int ldb)
+{
+    /* op(T) X = B  <=>  X^T op(T)^T = B^T: a right-side solve on the buffer,
+       which reads as T^T, so the triangle flips and the transform is kept. */
+    const char side = 'R';
+    const char uplo = lower ? 'U' : 'L';
+    const char ta = trans ? 'T' : 'N';
+    const char diag = unit_diag ? 'U' : 'N';
+    const blas_int bm = nrhs, bn = n, bldt = ldt, bldb = ldb;
+    dtrsm_(&side, &uplo, &ta, &diag, &bm, &bn, &alpha, T, &bldt, B, &bldb);
+    CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
+}
+
+CoreErrorStatus matrix_blas_trsm_right(int lower, MatrixTranspose trans, int unit_diag,
+    int m, int n, double alpha,
+    const double* T, int ldt,
+    double* B, int ldb)
+{
+    /* X op(T) = B  <=>  op(T)^T X^T = B^T: a left-side solve on the buffers,
+       again with the triangle flipped and the transform kept. */
+    const char side = 'L';
+    const char uplo = lower ? 'U' : 'L';
+    const char ta = trans ? 'T' : 'N';
+    const char diag = unit_diag ? 'U' : 'N';
+    const blas_int bm = n, bn = m, bldt = ldt, bldb = ldb;
+    dtrsm_(&side, &uplo, &ta, &diag, &bm, &bn, &alpha, T, &bldt, B, &bldb);
+    CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
+}
+
+#else /* !MATRIX_BLAS_ENABLED */
+
+const char* matrix_blas_backend(void) {
+    return DTS_BLAS_NAME;
+}
+
+CoreErrorStatus matrix_blas_gemm(MatrixTranspose trans_a, MatrixTranspose trans_b,
+    int m, int n, int k,
+    double alpha,
+    const double* A, int lda,
+    const double* B, int ldb,
+    double beta,
+    double* C, int ldc)
+{
+    (void)trans_a; (void)trans_b; (void)m; (void)n; (void)k; (void)alpha;
+    (void)A; (void)lda; (void)B; (void)ldb; (void)beta; (void)C; (void)ldc;
+    CORE_ERROR_RETURN(CORE_ERROR_INVALID_ARG);
+}
+
+CoreErrorStatus matrix_blas_getrf(int n, double* A, int lda, int* piv) {
+    (void)n; (void)A; (void)lda; (void)piv;
+    CORE_ERROR_RETURN(CORE_ERROR_INVALID_ARG);
+}
+
+CoreErrorStatus matrix_blas_sgetrf(int n, float* A, int lda, int* piv) {
+    (void)n; (void)A; (void)lda; (void)piv;
+    CORE_ERROR_RETURN(CORE_ERROR_INVALID_ARG);
+}
+
+CoreErrorStatus matrix_blas_trsm_left(int lower, MatrixTranspose trans, int unit_diag,
+    int n, int nrhs, double alpha,
+    const double* T, int ldt,
+    double* B, int ldb)
+{
+    (void)lower; (void)trans; (void)unit_diag; (void)n; (void)nrhs; (void)alpha;
+    (void)T; (void)ldt; (void)B; (void)ldb;
+    CORE_ERROR_RETURN(CORE_ERROR_INVALID_ARG);
+}
+
+CoreErrorStatus matrix_blas_trsm_right(int lower, MatrixTranspose trans, int unit_diag,
+    int m, int n, double alpha,
+    const double* T, int ldt,
+    double* B, int ldb)
+{
+    (void)lower; (void)trans; (void)unit_diag; (void)m; (void)n; (void)alpha;
+    (void)T; (void)ldt; (void)B; (void)ldb;
+    CORE_ERROR_RETURN(CORE_ERROR_INVALID_ARG);
+}
+
+#endif
@@ -1,8 +1,40 @@
 ﻿#pragma once
 
+#include <limits.h>
+#include <math.h>
 #include "matrix_exp.h"
 #include "matrix_ops.h"
+#include "matrix_norm.h"
 #include "pade.h"
+#include "pade_scaling.h"
+#include "matrix_gemm.h"
+#include "matrix_small.h"
+#include "core_arena.h"
+#include "core_memo.h"
+#include "core_thread_pool.h"
+
+/* Unit roundoff the Taylor truncation is tuned for. */
+#define EXPMV_TOL 1.1102230246251565e-16
+
+/*
+ * theta_m for EXPMV_TOL: ||tA||_1 <= theta_m makes the backward error of the
+ * degree-m Taylor polynomial at most EXPMV_TOL. Degrees 1..30 are from
+ * Higham, "Functions of Matrices", Table A.3; 35..55 from Al-Mohy & Higham
+ * (2011), Table 3.1.
+ */
+static const int s_expmv_m[] = {
+    1, 2, 3, 4, 5, 6, 7, 8, 9, 10,
+    11, 12, 13, 14, 15, 16, 17, 18, 19, 20,
+    21, 22, 23, 24, 25, 26, 27, 28, 29, 30,
+    35, 40, 45, 50, 55
+};
+static const double s_expmv_theta[] = {
+    2.29e-16, 2.58e-8, 1.39e-5, 3.40e-4, 2.40e-3, 9.07e-3, 2.38e-2, 5.00e-2, 8.96e-2, 1.44e-1,
+    2.14e-1, 3.00e-1, 4.00e-1, 5.14e-1, 6.41e-1, 7.81e-1, 9.31e-1, 1.09, 1.26, 1.44,
+    1.62, 1.82, 2.01, 2.22, 2.43, 2.64, 2.86, 3.08, 3.31, 3.54,
+    4.7, 6.0, 7.2, 8.5, 9.9
+};
+#define EXPMV_NTHETA ((int)(sizeof(s_expmv_m) / sizeof(s_expmv_m[0])))
 
 CoreErrorStatus matrix_exp_exponential(const Matrix* A, double t, Matrix* result)
 {
@@ -13,17 +45,532 @@ CoreErrorStatus matrix_exp_exponential(const Matrix* A, double t, Matrix* result
         CORE_ERROR_RETURN(CORE_ERROR_DIMENSION);
     }
 
-    CoreErrorStatus status = CORE_ERROR_SUCCESS;
-    Matrix* At = matrix_core_create(A->rows, A->cols, &status);
+    /* Process-wide memo cache, if installed; skipped when the result
+       overwrites A, which is then no longer the key. */
+    CoreMemoCache* memo = (result->data != A->data) ? core_memo_get_default() : NULL;
+    const CoreMemoKey key = { CORE_MEMO_TAG_EXPM, t, 1, { A, NULL } };
+    CoreErrorStatus status;
+    if (memo) {
+        int hit = 0;
+        status = core_memo_lookup(memo, &key, &result, 1, &hit);
+        if (status) CORE_ERROR_RETURN(status);
+        if (hit) CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
+    }
+
+    ExpmWorkspace ws;
+    status = pade_expm_workspace_init(&ws, A->rows);
     if (status) CORE_ERROR_RETURN(status);
 
-    status = matrix_ops_copy(At, A);  if (status) goto cleanup;
-    status = matrix_ops_scale(At, t);   if (status) goto cleanup;
-    status = pade_expm(At, result);    if (status) goto cleanup;
+    status = matrix_exp_exponential_ws(A, t, &ws, result);
+
+    pade_expm_workspace_free(&ws);
+
+    /* A full cache is not an error of the exponential */
+    if (memo && status == CORE_ERROR_SUCCESS) {
+        (void)core_memo_store(memo, &key, (const Matrix* const*)&result, 1);
+    }
+    CORE_ERROR_RETURN(status);
+}
+
+CoreErrorStatus matrix_exp_exponential_ws(const Matrix* A, double t, ExpmWorkspace* ws, Matrix* result)
+{
+    if (!A || !ws || !result) {
+        CORE_ERROR_RETURN(CORE_ERROR_NULL);
+    }
+    if (A->rows != A->cols || result->rows != A->rows || result->cols != A->cols) {
+        CORE_ERROR_RETURN(CORE_ERROR_DIMENSION);
+    }
+    if (!ws->As || ws->n != A->rows) {
+        CORE_ERROR_RETURN(CORE_ERROR_DIMENSION);
+    }
+
+    /* tA is formed directly in the workspace's input buffer. */
+    CoreErrorStatus status = CORE_ERROR_SUCCESS;
+    status = matrix_ops_copy(ws->As, A);  if (status) CORE_ERROR_RETURN(status);
+    status = matrix_ops_scale(ws->As, t); if (status) CORE_ERROR_RETURN(status);
+    status = pade_expm_ws_inplace(ws, result);
+    CORE_ERROR_RETURN(status);
+}
+
+/* ---- Batched exp(tA) ---- */
+
+/*
+ * Items go to the pool when they can occupy it, or when each is too small
+ * for its own products to be threaded; otherwise they run one after another
+ * and every product uses the whole pool.
+ */
+static CoreErrorStatus expm_batch_run(int n, int count, CoreParallelFn fn, void* ctx) {
+    const int workers = core_thread_pool_get_workers();
+    const size_t volume = (size_t)n * (size_t)n * (size_t)n;
+    if (count > 1 && workers > 1
+        && (count >= workers || volume < MATRIX_GEMM_PARALLEL_MIN_VOLUME)) {
+        CORE_ERROR_RETURN(core_thread_pool_parallel_for(count, 1, fn, ctx));
+    }
+    CORE_ERROR_RETURN(fn(ctx, 0, count));
+}
+
+/* Every result is n x n, and none is A. */
+static CoreErrorStatus expm_batch_check(const Matrix* A, int count, Matrix* const* results) {
+    if (!A || !A->data || !results) CORE_ERROR_RETURN(CORE_ERROR_NULL);
+    if (A->rows != A->cols) CORE_ERROR_RETURN(CORE_ERROR_DIMENSION);
+    if (count < 1) CORE_ERROR_RETURN(CORE_ERROR_INVALID_ARG);
+    for (int i = 0; i < count; ++i) {
+        if (!results[i] || !results[i]->data) CORE_ERROR_RETURN(CORE_ERROR_NULL);
+        if (results[i]->rows != A->rows || results[i]->cols != A->rows) {
+            CORE_ERROR_RETURN(CORE_ERROR_DIMENSION);
+        }
+        if (results[i]->data == A->data) CORE_ERROR_RETURN(CORE_ERROR_INVALID_ARG);
+    }
+    CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
+}
+
+static CoreErrorStatus copy_scaled(Matrix* dst, const Matrix* src, double c) {
+    CoreErrorStatus status = matrix_ops_copy(dst, src);
+    if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+    CORE_ERROR_RETURN(matrix_ops_scale(dst, c));
+}
+
+/* exp(t_i A); powers and profile are NULL when items are evaluated alone. */
+typedef struct {
+    const Matrix* A;
+    const double* t;
+    Matrix* const* results;
+    const Matrix* A2;
+    const Matrix* A4;
+    const Matrix* A6;
+    const PadeNormProfile* profile;
+} ExpmTimesJob;
+
+static CoreErrorStatus expm_times_item(const ExpmTimesJob* job, double t, ExpmWorkspace* ws,
+    Matrix* result)
+{
+    PadeScaling sel;
+    CoreErrorStatus status = pade_select_scaling_for_step(job->profile, t, &sel);
+    if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+
+    /* (cA)^2k = c^2k A^2k with c = 2^-s t: only the powers the order reads */
+    const double c = ldexp(t, -sel.s);
+    const double c2 = c * c;
+    status = copy_scaled(ws->As, job->A, c);
+    if (status == CORE_ERROR_SUCCESS) status = copy_scaled(ws->A2, job->A2, c2);
+    if (status == CORE_ERROR_SUCCESS && sel.max_power >= 4) {
+        status = copy_scaled(ws->A4, job->A4, c2 * c2);
+    }
+    if (status == CORE_ERROR_SUCCESS && sel.max_power >= 6) {
+        status = copy_scaled(ws->A6, job->A6, c2 * c2 * c2);
+    }
+    if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+    CORE_ERROR_RETURN(pade_expm_ws_selected(ws, &sel, result));
+}
+
+static CoreErrorStatus expm_times_range(void* ctx, int begin, int end) {
+    const ExpmTimesJob* job = (const ExpmTimesJob*)ctx;
+    ExpmWorkspace ws;
+    CoreErrorStatus status = pade_expm_workspace_init(&ws, job->A->rows);
+    if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+
+    for (int i = begin; i < end && status == CORE_ERROR_SUCCESS; ++i) {
+        status = job->profile
+            ? expm_times_item(job, job->t[i], &ws, job->results[i])
+            : matrix_exp_exponential_ws(job->A, job->t[i], &ws, job->results[i]);
+    }
+    pade_expm_workspace_free(&ws);
+    CORE_ERROR_RETURN(status);
+}
+
+CoreErrorStatus matrix_exp_exponential_times(const Matrix* A, const double* t, int count,
+    Matrix* const* results)
+{
+    if (!t) CORE_ERROR_RETURN(CORE_ERROR_NULL);
+    CoreErrorStatus status = expm_batch_check(A, count, results);
+    if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+    for (int i = 0; i < count; ++i) {
+        if (!isfinite(t[i])) CORE_ERROR_RETURN(CORE_ERROR_INVALID_ARG);
+    }
+
+    const int n = A->rows;
+    ExpmTimesJob job = { A, t, results, NULL, NULL, NULL, NULL };
+    if (n <= MATRIX_SMALL_MAX_N || count == 1) {
+        CORE_ERROR_RETURN(expm_batch_run(n, count, expm_times_range, &job));
+    }
+
+    /* The powers and norms of A, shared by every item */
+    ExpmWorkspace shared;
+    status = pade_expm_workspace_init(&shared, n);
+    if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+    PadeNormProfile profile;
+    status = matrix_ops_multiply(shared.A2, A, A);
+    if (status == CORE_ERROR_SUCCESS) status = matrix_ops_multiply(shared.A4, shared.A2, shared.A2);
+    if (status == CORE_ERROR_SUCCESS) status = matrix_ops_multiply(shared.A6, shared.A4, shared.A2);
+    if (status == CORE_ERROR_SUCCESS) {
+        status = pade_norm_profile(A, shared.A2, shared.A4, shared.A6, shared.work, &profile);
+        if (status == CORE_ERROR_SUCCESS) {
+            job.A2 = shared.A2;
+            job.A4 = shared.A4;
+            job.A6 = shared.A6;
+            job.profile = &profile;
+        }
+        else if (status == CORE_ERROR_INVALID_ARG) {
+            /* a power overflows: each item scales before it squares */
+            status = CORE_ERROR_SUCCESS;
+        }
+    }
+    if (status == CORE_ERROR_SUCCESS) status = expm_batch_run(n, count, expm_times_range, &job);
+
+    pade_expm_workspace_free(&shared);
+    CORE_ERROR_RETURN(status);
+}
+
+/* exp(k_i Ts A) from Q[j] = exp(2^j Ts A). */
+typedef struct {
+    const int* k;
+    Matrix* const* results;
+    Matrix* const* Q;
+} ExpmMultiplesJob;
+
+/* result = product of Q[j] over the set bits j of k, ping-ponging with tmp
+   from the side that makes the last product land in result. */
+static CoreErrorStatus expm_multiples_item(Matrix* const* Q, int k, Matrix* tmp, Matrix* result) {
+    if (k == 0) CORE_ERROR_RETURN(matrix_ops_set_identity(result));
+
+    int bits = 0;
+    for (int r = k; r != 0; r &= r - 1) ++bits;
+    Matrix* cur = (bits % 2 == 1) ? result : tmp;
+    Matrix* next = (cur == result) ? tmp : result;
+
+    int j = 0;
+    while (!((k >> j) & 1)) ++j;
+    CoreErrorStatus status = matrix_ops_copy(cur, Q[j]);
+    for (++j; status == CORE_ERROR_SUCCESS && (k >> j) != 0; ++j) {
+        if (!((k >> j) & 1)) continue;
+        status = matrix_ops_multiply(next, cur, Q[j]);
+        Matrix* sw = cur; cur = next; next = sw;
+    }
+    CORE_ERROR_RETURN(status);
+}
+
+static CoreErrorStatus expm_multiples_range(void* ctx, int begin, int end) {
+    const ExpmMultiplesJob* job = (const ExpmMultiplesJob*)ctx;
+    const int n = job->results[0]->rows;
+    CoreErrorStatus status = CORE_ERROR_SUCCESS;
+    Matrix* tmp = matrix_core_create(n, n, &status);
+    if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+
+    for (int i = begin; i < end && status == CORE_ERROR_SUCCESS; ++i) {
+        status = expm_multiples_item(job->Q, job->k[i], tmp, job->results[i]);
+    }
+    matrix_core_free(tmp);
+    CORE_ERROR_RETURN(status);
+}
+
+CoreErrorStatus matrix_exp_exponential_multiples(const Matrix* A, double Ts, const int* k,
+    int count, Matrix* const* results)
+{
+    if (!k) CORE_ERROR_RETURN(CORE_ERROR_NULL);
+    CoreErrorStatus status = expm_batch_check(A, count, results);
+    if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+    if (!isfinite(Ts)) CORE_ERROR_RETURN(CORE_ERROR_INVALID_ARG);
+    int k_max = 0;
+    for (int i = 0; i < count; ++i) {
+        if (k[i] < 0) CORE_ERROR_RETURN(CORE_ERROR_INVALID_ARG);
+        if (k[i] > k_max) k_max = k[i];
+    }
 
-cleanup:
-    if (At) matrix_core_free(At);
+    /* Q[j] = exp(2^j Ts A) for every bit j of k_max */
+    const int n = A->rows;
+    int levels = 0;
+    while (levels < 31 && (k_max >> levels) != 0) ++levels;
+    Matrix* Q[31] = { NULL };
+    MatrixArena arena = { 0 };
+    if (levels > 0) {
+        status = matrix_arena_init(&arena, (size_t)levels * matrix_core_bytes_in(n, n));
+        if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+    }
+    for (int j = 0; j < levels && status == CORE_ERROR_SUCCESS; ++j) {
+        Q[j] = matrix_core_create_in(&arena, n, n, &status);
+        if (status != CORE_ERROR_SUCCESS) break;
+        status = (j == 0)
+            ? matrix_exp_exponential(A, Ts, Q[0])
+            : matrix_ops_multiply(Q[j], Q[j - 1], Q[j - 1]);
+    }
+
+    if (status == CORE_ERROR_SUCCESS) {
+        ExpmMultiplesJob job = { k, results, Q };
+        status = expm_batch_run(n, count, expm_multiples_range, &job);
+    }
+    matrix_arena_destroy(&arena);
     CORE_ERROR_RETURN(status);
 }
 
+/* exp(t A_j) for matrices of one order. */
+typedef struct {
+    const Matrix* const* A;
+    double t;
+    Matrix* const* results;
+} ExpmBatchJob;
+
+static CoreErrorStatus expm_batch_range(void* ctx, int begin, int end) {
+    const ExpmBatchJob* job = (const ExpmBatchJob*)ctx;
+    ExpmWorkspace ws;
+    CoreErrorStatus status = pade_expm_workspace_init(&ws, job->A[0]->rows);
+    if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+
+    for (int i = begin; i < end && status == CORE_ERROR_SUCCESS; ++i) {
+        status = matrix_exp_exponential_ws(job->A[i], job->t, &ws, job->results[i]);
+    }
+    pade_expm_workspace_free(&ws);
+    CORE_ERROR_RETURN(status);
+}
+
+CoreErrorStatus matrix_exp_exponential_batch(const Matrix* const* A, double t, int count,
+    Matrix* const* results)
+{
+    if (!A || !results) CORE_ERROR_RETURN(CORE_ERROR_NULL);
+    if (count < 1) CORE_ERROR_RETURN(CORE_ERROR_INVALID_ARG);
+    if (!A[0]) CORE_ERROR_RETURN(CORE_ERROR_NULL);
+    const int n = A[0]->rows;
+    for (int i = 0; i < count; ++i) {
+        if (!A[i] || !results[i]) CORE_ERROR_RETURN(CORE_ERROR_NULL);
+        if (A[i]->rows != n || A[i]->cols != n || results[i]->rows != n || results[i]->cols != n) {
+            CORE_ERROR_RETURN(CORE_ERROR_DIMENSION);
+        }
+    }
+
+    ExpmBatchJob job = { A, t, results };
+    CORE_ERROR_RETURN(expm_batch_run(n, count, expm_batch_range, &job));
+}
+
+/* ---- exp(tA) * V (Al-Mohy & Higham 2011) ---- */
+
+/* The operator A - shift * I. */
+typedef struct {
+    const MatrixLinearOperator* base;
+    double shift;
+} ExpmvShiftedOp;
+
+static CoreErrorStatus expmv_shifted_apply(void* ctx, MatrixTranspose trans, const Matrix* X, Matrix* Y) {
+    const ExpmvShiftedOp* so = (const ExpmvShiftedOp*)ctx;
+    CoreErrorStatus status = matrix_linop_apply(so->base, trans, X, Y);
+    if (status != CORE_ERROR_SUCCESS || so->shift == 0.0) CORE_ERROR_RETURN(status);
+    CORE_ERROR_RETURN(matrix_ops_axpy(Y, -so->shift, X));
+}
+
+/* Norms of the shifted operator; d[p] = ||A^p||_1^(1/p) for p = 2..P_MAX+1
+   are estimated on first use and shared by every step of the grid. */
+typedef struct {
+    const MatrixLinearOperator* op;
+    double norm1;
+    double d[MATRIX_EXPMV_P_MAX + 2];
+    int have_d;
+    double* work;       /* MATRIX_NORMEST_WORK(n, T) + n * T doubles */
+} ExpmvNorms;
+
+static CoreErrorStatus expmv_estimate_d(ExpmvNorms* nm) {
+    const int n = nm->op->n;
+    MatrixPowerOp pw = { nm->op, 1, nm->work + MATRIX_NORMEST_WORK(n, MATRIX_NORMEST_T), MATRIX_NORMEST_T };
+    for (int p = 2; p <= MATRIX_EXPMV_P_MAX + 1; ++p) {
+        MatrixLinearOperator op;
+        pw.power = p;
+        CoreErrorStatus status = matrix_linop_power(&op, &pw);
+        if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+        double est = 0.0;
+        status = matrix_norm_1_est(&op, MATRIX_NORMEST_T, nm->work, &est, NULL);
+        if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+        nm->d[p] = pow(est, 1.0 / p);
+    }
+    nm->have_d = 1;
+    CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
+}
+
+/*
+ * Degree m and substeps s for exp(hA): minimize m * s with s = ceil(a / theta_m).
+ * a is ||hA||_1 when that is small enough (condition (3.13): the norm
+ * estimates would cost more than they can save), otherwise
+ * alpha_p = |h| max(d_p, d_{p+1}) over the p allowed for m.
+ */
+static CoreErrorStatus expmv_select(ExpmvNorms* nm, double h, int k, int* m_out, int* s_out) {
+    const double a1 = fabs(h) * nm->norm1;
+    if (a1 == 0.0) {
+        *m_out = 0;
+        *s_out = 1;
+        CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
+    }
+
+    const double p_max = MATRIX_EXPMV_P_MAX;
+    const double small = 2.0 * MATRIX_NORMEST_T * p_max * (p_max + 3.0)
+        * s_expmv_theta[EXPMV_NTHETA - 1] / ((double)k * MATRIX_EXPMV_M_MAX);
+    double best_m = 0.0, best_s = 0.0;
+    if (a1 <= small) {
+        for (int i = 0; i < EXPMV_NTHETA; ++i) {
+            const double sc = ceil(a1 / s_expmv_theta[i]);
+            if (best_m == 0.0 || s_expmv_m[i] * sc < best_m * best_s) {
+                best_m = s_expmv_m[i];
+                best_s = sc;
+            }
+        }
+    }
+    else {
+        if (!nm->have_d) {
+            CoreErrorStatus status = expmv_estimate_d(nm);
+            if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+        }
+        for (int p = 2; p <= MATRIX_EXPMV_P_MAX; ++p) {
+            const double alpha = fabs(h) * fmax(nm->d[p], nm->d[p + 1]);
+            for (int i = 0; i < EXPMV_NTHETA; ++i) {
+                if (s_expmv_m[i] < p * (p - 1) - 1) continue;
+                const double sc = ceil(alpha / s_expmv_theta[i]);
+                if (best_m == 0.0 || s_expmv_m[i] * sc < best_m * best_s) {
+                    best_m = s_expmv_m[i];
+                    best_s = sc;
+                }
+            }
+        }
+        best_s = fmax(best_s, 1.0);
+    }
+    if (!(best_s <= INT_MAX)) CORE_ERROR_RETURN(CORE_ERROR_NUMERIC);
+    *m_out = (int)best_m;
+    *s_out = (int)best_s;
+    CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
+}
+
+/*
+ * F <- exp(h (A + shift I)) F in s substeps of the degree-m Taylor series
+ * of the shifted A, each stopped once two consecutive terms are below
+ * EXPMV_TOL relative to the sum. B, Y are n x k scratch blocks.
+ */
+static CoreErrorStatus expmv_step(const MatrixLinearOperator* op, double shift, double h,
+    int m, int s, Matrix* F, Matrix* B, Matrix* Y)
+{
+    const double eta = exp(h * shift / s);
+    CoreErrorStatus status;
+    for (int i = 0; i < s; ++i) {
+        status = matrix_ops_copy(B, F);
+        if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+        double c1 = 0.0, c2 = 0.0, f = 0.0;
+        status = matrix_norm_inf(B, &c1);
+        if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+        for (int j = 1; j <= m; ++j) {
+            /* next term: B <- (h / (s j)) A B */
+            status = matrix_linop_apply(op, MATRIX_NO_TRANS, B, Y);
+            if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+            status = matrix_ops_scale(Y, h / ((double)s * j));
+            if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+            Matrix* T = B; B = Y; Y = T;
+
+            status = matrix_ops_axpy(F, 1.0, B);
+            if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+            status = matrix_norm_inf(B, &c2);
+            if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+            status = matrix_norm_inf(F, &f);
+            if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+            if (c1 + c2 <= EXPMV_TOL * f) break;
+            c1 = c2;
+        }
+        if (eta != 1.0) {
+            status = matrix_ops_scale(F, eta);
+            if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+        }
+    }
+    CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
+}
+
+static CoreErrorStatus expmv_check(int n, const Matrix* V, const double* t, int nt,
+    const double* work, Matrix* const* out)
+{
+    if (!V || !t || !work || !out) CORE_ERROR_RETURN(CORE_ERROR_NULL);
+    if (nt < 1) CORE_ERROR_RETURN(CORE_ERROR_INVALID_ARG);
+    if (V->rows != n || V->cols < 1) CORE_ERROR_RETURN(CORE_ERROR_DIMENSION);
+    for (int i = 0; i < nt; ++i) {
+        if (!out[i]) CORE_ERROR_RETURN(CORE_ERROR_NULL);
+        if (out[i]->rows != n || out[i]->cols != V->cols) CORE_ERROR_RETURN(CORE_ERROR_DIMENSION);
+        if (!isfinite(t[i])) CORE_ERROR_RETURN(CORE_ERROR_INVALID_ARG);
+    }
+    CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
+}
+
+/* March through the grid from t = 0; each out[i] starts from the previous one. */
+static CoreErrorStatus expmv_run(ExpmvNorms* nm, double shift, const Matrix* V,
+    const double* t, int nt, double* work, Matrix* const* out)
+{
+    const int n = V->rows, k = V->cols;
+    MatrixView B, Y;
+    CoreErrorStatus status = matrix_view_of(&B, work, n, k, k);
+    if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+    status = matrix_view_of(&Y, work + (size_t)n * k, n, k, k);
+    if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
 
+    const Matrix* prev = V;
+    double t_prev = 0.0;
+    for (int i = 0; i < nt; ++i) {
+        if (out[i] != prev) {
+            status = matrix_ops_copy(out[i], prev);
+            if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+        }
+        const double h = t[i] - t_prev;
+        if (h != 0.0) {
+            int m = 0, s = 0;
+            status = expmv_select(nm, h, k, &m, &s);
+            if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+            status = expmv_step(nm->op, shift, h, m, s, out[i], &B, &Y);
+            if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+        }
+        prev = out[i];
+        t_prev = t[i];
+    }
+    CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
+}
+
+CoreErrorStatus matrix_exp_multiply(const Matrix* A, const Matrix* V,
+    const double* t, int nt, double* work, Matrix* const* out)
+{
+    if (!A || !A->data) CORE_ERROR_RETURN(CORE_ERROR_NULL);
+    if (A->rows != A->cols) CORE_ERROR_RETURN(CORE_ERROR_DIMENSION);
+    const int n = A->rows;
+    CoreErrorStatus status = expmv_check(n, V, t, nt, work, out);
+    if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+
+    double trace = 0.0;
+    for (int i = 0; i < n; ++i) trace += A->data[(size_t)i * A->ld + i];
+    const double mu = trace / n;
+
+    /* exact ||A - mu I||_1, column sums accumulated row by row in work */
+    double* colsum = work;
+    for (int j = 0; j < n; ++j) colsum[j] = 0.0;
+    for (int i = 0; i < n; ++i) {
+        const double* row = A->data + (size_t)i * A->ld;
+        for (int j = 0; j < n; ++j) colsum[j] += fabs(row[j] - (j == i ? mu : 0.0));
+    }
+    double norm1 = 0.0;
+    for (int j = 0; j < n; ++j) norm1 = fmax(norm1, colsum[j]);
+    if (!isfinite(norm1) || !isfinite(mu)) CORE_ERROR_RETURN(CORE_ERROR_INVALID_ARG);
+
+    MatrixLinearOperator dense;
+    status = matrix_linop_dense(&dense, A);
+    if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+    ExpmvShiftedOp so = { &dense, mu };
+    const MatrixLinearOperator shifted = { n, expmv_shifted_apply, &so };
+
+    const int k = V->cols;
+    ExpmvNorms nm = { &shifted, norm1, { 0.0 }, 0, work + 2 * (size_t)n * k };
+    CORE_ERROR_RETURN(expmv_run(&nm, mu, V, t, nt, work, out));
+}
+
+CoreErrorStatus matrix_exp_multiply_op(const MatrixLinearOperator* op, double shift,
+    const Matrix* V, const double* t, int nt, double* work, Matrix* const* out)
+{
+    if (!op || !op->apply) CORE_ERROR_RETURN(CORE_ERROR_NULL);
+    if (!isfinite(shift)) CORE_ERROR_RETURN(CORE_ERROR_INVALID_ARG);
+    const int n = op->n;
+    CoreErrorStatus status = expmv_check(n, V, t, nt, work, out);
+    if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+
+    ExpmvShiftedOp so = { op, shift };
+    const MatrixLinearOperator shifted = { n, expmv_shifted_apply, &so };
+
+    const int k = V->cols;
+    ExpmvNorms nm = { &shifted, 0.0, { 0.0 }, 0, work + 2 * (size_t)n * k };
+    status = matrix_norm_1_est(&shifted, MATRIX_NORMEST_T, nm.work, &nm.norm1, NULL);
+    if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+    if (!isfinite(nm.norm1)) CORE_ERROR_RETURN(CORE_ERROR_INVALID_ARG);
+    CORE_ERROR_RETURN(expmv_run(&nm, shift, V, t, nt, work, out));
+}
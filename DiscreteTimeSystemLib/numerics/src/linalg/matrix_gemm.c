@@ -0,0 +1,418 @@
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include <stdlib.h>
+#include <string.h>
+#include "matrix_gemm.h"
+#include "matrix_simd.h"
+#include "matrix_blas.h"
+#include "core_error.h"
+#include "core_thread_pool.h"
+
+/* Products with m*n*k at or below this volume skip packing entirely. */
+#define GEMM_SMALL_VOLUME 4096
+/* C with at most this many columns (blocks of vectors) skips packing too:
+   packing A would cost as much as the product itself. */
+#define GEMM_NARROW_N 4
+
+#define MR MATRIX_GEMM_MR
+#define NR MATRIX_GEMM_NR
+#define MC MATRIX_GEMM_MC
+#define KC MATRIX_GEMM_KC
+#define NC MATRIX_GEMM_NC
+
+/* ---------- Per-thread packing buffers ---------- */
+
+static THREAD_LOCAL double* s_pack_a = NULL;
+static THREAD_LOCAL size_t  s_pack_a_cap = 0;
+static THREAD_LOCAL double* s_pack_b = NULL;
+static THREAD_LOCAL size_t  s_pack_b_cap = 0;
+
+static THREAD_LOCAL int s_exit_hooked = 0;
+
+void matrix_gemm_release_buffers(void) {
+    free(s_pack_a); s_pack_a = NULL; s_pack_a_cap = 0;
+    free(s_pack_b); s_pack_b = NULL; s_pack_b_cap = 0;
+}
+
+/*
+ * Thread-exit hook: pool workers and the batched expm threads never call
+ * matrix_gemm_release_buffers themselves, so the first allocation on a
+ * thread arms a per-thread destructor that frees its buffers when it exits.
+ * If the key cannot be created the buffers simply live until process exit.
+ */
+#if defined(_WIN32)
+#include <windows.h>
+
+static INIT_ONCE s_exit_once = INIT_ONCE_STATIC_INIT;
+static DWORD s_exit_slot = FLS_OUT_OF_INDEXES;
+
+static void WINAPI on_thread_exit(void* unused) {
+    (void)unused;
+    matrix_gemm_release_buffers();
+}
+
+static BOOL CALLBACK create_exit_slot(PINIT_ONCE once, void* param, void** ctx) {
+    (void)once; (void)param; (void)ctx;
+    s_exit_slot = FlsAlloc(on_thread_exit);
+    return TRUE;
+}
+
+static void hook_thread_exit(void) {
+    InitOnceExecuteOnce(&s_exit_once, create_exit_slot, NULL, NULL);
+    if (s_exit_slot != FLS_OUT_OF_INDEXES && FlsSetValue(s_exit_slot, (void*)1)) {
+        s_exit_hooked = 1;
+    }
+}
+
+#else
+#include <pthread.h>
+
+static pthread_once_t s_exit_once = PTHREAD_ONCE_INIT;
+static pthread_key_t s_exit_key;
+static int s_exit_key_ok = 0;
+
+static void on_thread_exit(void* unused) {
+    (void)unused;
+    matrix_gemm_release_buffers();
+}
+
+static void create_exit_key(void) {
+    s_exit_key_ok = pthread_key_create(&s_exit_key, on_thread_exit) == 0;
+}
+
+static void hook_thread_exit(void) {
+    pthread_once(&s_exit_once, create_exit_key);
+    if (s_exit_key_ok && pthread_setspecific(s_exit_key, (void*)1) == 0) {
+        s_exit_hooked = 1;
+    }
+}
+#endif
+
+static double* reserve_buffer(double** buf, size_t* cap, size_t count) {
+    if (*cap >= count) return *buf;
+    double* p = (double*)realloc(*buf, count * sizeof(double));
+    if (!p) return NULL;
+    *buf = p;
+    *cap = count;
+    if (!s_exit_hooked) hook_thread_exit();
+    return p;
+}
+
+/* ---------- Internal helpers ---------- */
+
+/* C(m x n) *= beta, treating beta == 0 as an overwrite so NaNs in C do not leak. */
+static void scale_c(int m, int n, double beta, double* C, int ldc) {
+    if (beta == 1.0) return;
+    for (int i = 0; i < m; ++i) {
+        double* c = C + (size_t)i * ldc;
+        if (beta == 0.0) {
+            memset(c, 0, (size_t)n * sizeof(double));
+        }
+        else {
+            for (int j = 0; j < n; ++j) c[j] *= beta;
+        }
+    }
+}
+
+/*
+ * Operands are addressed through (row, column) strides so that a transposed
+ * operand is just a swapped stride pair: element (i, p) of op(A) lives at
+ * A[i * rs + p * cs].
+ */
+
+/* C += alpha * op(A) * op(B) without packing (i-k-j order). */
+static void gemm_direct(int m, int n, int k, double alpha,
+    const double* A, int rsa, int csa, const double* B, int rsb, int csb, double* C, int ldc)
+{
+    for (int i = 0; i < m; ++i) {
+        const double* a = A + (size_t)i * rsa;
+        double* c = C + (size_t)i * ldc;
+        for (int p = 0; p < k; ++p) {
+            const double aip = alpha * a[(size_t)p * csa];
+            if (aip == 0.0) continue;
+            const double* b = B + (size_t)p * rsb;
+            if (csb == 1) {
+                for (int j = 0; j < n; ++j) c[j] += aip * b[j];
+            }
+            else {
+                for (int j = 0; j < n; ++j) c[j] += aip * b[(size_t)j * csb];
+            }
+        }
+    }
+}
+
+/*
+ * C += alpha * op(A) * B for C with at most GEMM_NARROW_N columns: one SIMD
+ * GEMV (op(A) = A) or row-axpy sweep (op(A) = A^T) per column, through
+ * contiguous copies of the B and C columns in the per-thread pack buffers.
+ * Returns 0 if the buffers cannot be grown.
+ */
+static int gemm_narrow(int trans_a, int m, int n, int k, double alpha, const double* A, int lda,
+    const double* B, int ldb, double* C, int ldc)
+{
+    double* x = reserve_buffer(&s_pack_b, &s_pack_b_cap, (size_t)k);
+    double* y = reserve_buffer(&s_pack_a, &s_pack_a_cap, (size_t)m);
+    if (!x || !y) return 0;
+
+    const MatrixSimdKernels* simd = matrix_simd_kernels();
+    for (int j = 0; j < n; ++j) {
+        for (int p = 0; p < k; ++p) x[p] = B[(size_t)p * ldb + j];
+        if (!trans_a) {
+            simd->gemv(m, k, alpha, A, lda, x, 0.0, y);
+        }
+        else {
+            simd->fill(m, 0.0, y);
+            for (int p = 0; p < k; ++p) {
+                const double axp = alpha * x[p];
+                if (axp != 0.0) simd->axpy(m, axp, A + (size_t)p * lda, y);
+            }
+        }
+        for (int i = 0; i < m; ++i) C[(size_t)i * ldc + j] += y[i];
+    }
+    return 1;
+}
+
+/**
+ * @brief Pack an mc x kc block of A into MR-row slivers (column-major inside a sliver).
+ *        Rows beyond mc are zero-padded so the micro-kernel never branches.
+ */
+static void pack_a(int mc, int kc, const double* A, int rsa, int csa, double* ap) {
+    for (int ir = 0; ir < mc; ir += MR) {
+        const int mr = (mc - ir < MR) ? mc - ir : MR;
+        for (int p = 0; p < kc; ++p) {
+            const double* a = A + (size_t)ir * rsa + (size_t)p * csa;
+            for (int i = 0; i < mr; ++i) ap[i] = a[(size_t)i * rsa];
+            for (int i = mr; i < MR; ++i) ap[i] = 0.0;
+            ap += MR;
+        }
+    }
+}
+
+/**
+ * @brief Pack a kc x nc panel of B into NR-column slivers (row-major inside a sliver).
+ *        Columns beyond nc are zero-padded.
+ */
+static void pack_b(int kc, int nc, const double* B, int rsb, int csb, double* bp) {
+    for (int jr = 0; jr < nc; jr += NR) {
+        const int nr = (nc - jr < NR) ? nc - jr : NR;
+        for (int p = 0; p < kc; ++p) {
+            const double* b = B + (size_t)p * rsb + (size_t)jr * csb;
+            for (int j = 0; j < nr; ++j) bp[j] = b[(size_t)j * csb];
+            for (int j = nr; j < NR; ++j) bp[j] = 0.0;
+            bp += NR;
+        }
+    }
+}
+
+/**
+ * @brief Edge tile: run the full-size micro-kernel into a zeroed scratch tile and
+ *        add back only the valid mr x nr part.
+ */
+static void micro_kernel_edge(const MatrixSimdKernels* simd, int kc, double alpha,
+    const double* ap, const double* bp, double* C, int ldc, int mr, int nr)
+{
+    double tile[MR * NR] = { 0 };
+    simd->gemm_micro(kc, alpha, ap, bp, tile, NR);
+    for (int i = 0; i < mr; ++i) {
+        double* c = C + (size_t)i * ldc;
+        const double* t = tile + (size_t)i * NR;
+        for (int j = 0; j < nr; ++j) c[j] += t[j];
+    }
+}
+
+/* Multiply a packed mc x kc block of A by a packed kc x nc panel of B into C. */
+static void macro_kernel(int mc, int nc, int kc, double alpha,
+    const double* ap, const double* bp, double* C, int ldc)
+{
+    const MatrixSimdKernels* simd = matrix_simd_kernels();
+    for (int jr = 0; jr < nc; jr += NR) {
+        const int nr = (nc - jr < NR) ? nc - jr : NR;
+        const double* b = bp + (size_t)(jr / NR) * NR * kc;
+        for (int ir = 0; ir < mc; ir += MR) {
+            const int mr = (mc - ir < MR) ? mc - ir : MR;
+            const double* a = ap + (size_t)(ir / MR) * MR * kc;
+            double* c = C + (size_t)ir * ldc + jr;
+            if (mr == MR && nr == NR) {
+                simd->gemm_micro(kc, alpha, a, b, c, ldc);
+            }
+            else {
+                micro_kernel_edge(simd, kc, alpha, a, b, c, ldc, mr, nr);
+            }
+        }
+    }
+}
+
+/* Arguments of one packed GEMM, shared by the bands of a parallel split. */
+typedef struct {
+    int m, n, k;
+    double alpha, beta;
+    const double* A; int rsa, csa;
+    const double* B; int rsb, csb;
+    double* C; int ldc;
+} GemmJob;
+
+/* C[i0:i1, j0:j1] = alpha * op(A)[i0:i1, :] * op(B)[:, j0:j1] + beta * C[i0:i1, j0:j1] */
+static CoreErrorStatus gemm_block(const GemmJob* job, int i0, int i1, int j0, int j1) {
+    const int m = i1 - i0, n = j1 - j0, k = job->k;
+    const int rsa = job->rsa, csa = job->csa, rsb = job->rsb, csb = job->csb, ldc = job->ldc;
+    const double* A = job->A + (size_t)i0 * rsa;
+    const double* B = job->B + (size_t)j0 * csb;
+    double* C = job->C + (size_t)i0 * ldc + j0;
+
+    scale_c(m, n, job->beta, C, ldc);
+
+    const int kc_max = (k < KC) ? k : KC;
+    const int mc_max = (m < MC) ? m : MC;
+    const int nc_max = (n < NC) ? n : NC;
+    const size_t a_len = (size_t)((mc_max + MR - 1) / MR) * MR * kc_max;
+    const size_t b_len = (size_t)((nc_max + NR - 1) / NR) * NR * kc_max;
+
+    /* Pack buffers are thread-local, so concurrent bands never share them. */
+    double* ap = reserve_buffer(&s_pack_a, &s_pack_a_cap, a_len);
+    double* bp = reserve_buffer(&s_pack_b, &s_pack_b_cap, b_len);
+    if (!ap || !bp) CORE_ERROR_RETURN(CORE_ERROR_ALLOCATION_FAILED);
+
+    /* Loop order (outer to inner): NC panels of B, KC slices of the depth,
+       MC blocks of A. The packed B panel stays in L3 while A blocks cycle
+       through L2, and each micro-kernel streams one MR/NR sliver from L1. */
+    for (int jc = 0; jc < n; jc += NC) {
+        const int nc = (n - jc < NC) ? n - jc : NC;
+        for (int pc = 0; pc < k; pc += KC) {
+            const int kc = (k - pc < KC) ? k - pc : KC;
+            pack_b(kc, nc, B + (size_t)pc * rsb + (size_t)jc * csb, rsb, csb, bp);
+            for (int ic = 0; ic < m; ic += MC) {
+                const int mc = (m - ic < MC) ? m - ic : MC;
+                pack_a(mc, kc, A + (size_t)ic * rsa + (size_t)pc * csa, rsa, csa, ap);
+                macro_kernel(mc, nc, kc, job->alpha, ap, bp, C + (size_t)ic * ldc + jc, ldc);
+            }
+        }
+    }
+
+    CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
+}
+
+static CoreErrorStatus gemm_row_band(void* ctx, int begin, int end) {
+    const GemmJob* job = (const GemmJob*)ctx;
+    return gemm_block(job, begin, end, 0, job->n);
+}
+
+static CoreErrorStatus gemm_col_band(void* ctx, int begin, int end) {
+    const GemmJob* job = (const GemmJob*)ctx;
+    return gemm_block(job, 0, job->m, begin, end);
+}
+
+/* ---------- Public API ---------- */
+
+CoreErrorStatus matrix_gemv_compute(MatrixTranspose trans_a, int m, int n,
+    double alpha,
+    const double* A, int lda,
+    const double* x,
+    double beta,
+    double* y)
+{
+    if (!A || !x || !y) CORE_ERROR_RETURN(CORE_ERROR_NULL);
+    if (m < 0 || n < 0 || lda < n) CORE_ERROR_RETURN(CORE_ERROR_INVALID_ARG);
+    if (trans_a != MATRIX_NO_TRANS && trans_a != MATRIX_TRANS) CORE_ERROR_RETURN(CORE_ERROR_INVALID_ARG);
+
+    const MatrixSimdKernels* simd = matrix_simd_kernels();
+    const int ylen = trans_a ? n : m;
+
+    if (alpha == 0.0 || (trans_a ? m : n) == 0) {
+        scale_c(1, ylen, beta, y, ylen);
+        CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
+    }
+
+    if (!trans_a) {
+        simd->gemv(m, n, alpha, A, lda, x, beta, y);
+    }
+    else {
+        /* y = beta * y, then one axpy per row of A (unit stride on A and y). */
+        scale_c(1, ylen, beta, y, ylen);
+        for (int i = 0; i < m; ++i) {
+            const double axi = alpha * x[i];
+            if (axi == 0.0) continue;
+            simd->axpy(n, axi, A + (size_t)i * lda, y);
+        }
+    }
+    CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
+}
+
+CoreErrorStatus matrix_gemm_compute(int m, int n, int k,
+    double alpha,
+    const double* A, int lda,
+    const double* B, int ldb,
+    double beta,
+    double* C, int ldc)
+{
+    return matrix_gemm_compute_op(MATRIX_NO_TRANS, MATRIX_NO_TRANS,
+        m, n, k, alpha, A, lda, B, ldb, beta, C, ldc);
+}
+
+CoreErrorStatus matrix_gemm_compute_op(MatrixTranspose trans_a, MatrixTranspose trans_b,
+    int m, int n, int k,
+    double alpha,
+    const double* A, int lda,
+    const double* B, int ldb,
+    double beta,
+    double* C, int ldc)
+{
+    if (!A || !B || !C) CORE_ERROR_RETURN(CORE_ERROR_NULL);
+    if (m < 0 || n < 0 || k < 0) CORE_ERROR_RETURN(CORE_ERROR_INVALID_ARG);
+    if ((trans_a != MATRIX_NO_TRANS && trans_a != MATRIX_TRANS) ||
+        (trans_b != MATRIX_NO_TRANS && trans_b != MATRIX_TRANS)) {
+        CORE_ERROR_RETURN(CORE_ERROR_INVALID_ARG);
+    }
+    if (lda < (trans_a ? m : k) || ldb < (trans_b ? k : n) || ldc < n) {
+        CORE_ERROR_RETURN(CORE_ERROR_INVALID_ARG);
+    }
+    if (m == 0 || n == 0) CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
+
+    if (k == 0 || alpha == 0.0) {
+        scale_c(m, n, beta, C, ldc);
+        CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
+    }
+
+    GemmJob job;
+    job.m = m; job.n = n; job.k = k;
+    job.alpha = alpha;
+    job.beta = beta;
+    job.A = A; job.rsa = trans_a ? 1 : lda; job.csa = trans_a ? lda : 1;
+    job.B = B; job.rsb = trans_b ? 1 : ldb; job.csb = trans_b ? ldb : 1;
+    job.C = C; job.ldc = ldc;
+
+    const size_t volume = (size_t)m * (size_t)n * (size_t)k;
+    if (volume <= GEMM_SMALL_VOLUME) {
+        scale_c(m, n, beta, C, ldc);
+        gemm_direct(m, n, k, alpha, A, job.rsa, job.csa, B, job.rsb, job.csb, C, ldc);
+        CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
+    }
+
+    if (MATRIX_BLAS_ENABLED) {
+        CoreErrorStatus status = matrix_blas_gemm(trans_a, trans_b, m, n, k,
+            alpha, A, lda, B, ldb, beta, C, ldc);
+        CORE_ERROR_RETURN(status);
+    }
+
+    if (n <= GEMM_NARROW_N && !trans_b) {
+        scale_c(m, n, beta, C, ldc);
+        if (gemm_narrow(trans_a, m, n, k, alpha, A, lda, B, ldb, C, ldc)) {
+            CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
+        }
+        CORE_ERROR_RETURN(CORE_ERROR_ALLOCATION_FAILED);
+    }
+
+    /* Split C into independent row (or column) bands. Band edges are
+       multiples of MC, itself a multiple of MR and NR, so every band sees the
+       same register tiles and the same KC slices as the serial loop and the
+       result is bitwise identical for any worker count. */
+    if (volume >= MATRIX_GEMM_PARALLEL_MIN_VOLUME && core_thread_pool_get_workers() > 1) {
+        const CoreParallelFn band = (m >= n) ? gemm_row_band : gemm_col_band;
+        CoreErrorStatus status = core_thread_pool_parallel_for(m >= n ? m : n, MC, band, &job);
+        CORE_ERROR_RETURN(status);
+    }
+
+    CoreErrorStatus status = gemm_block(&job, 0, m, 0, n);
+    CORE_ERROR_RETURN(status);
+}
@@ -0,0 +1,99 @@
+#include "matrix_linop.h"
+#include "matrix_ops.h"
+
+static CoreErrorStatus dense_apply(void* ctx, MatrixTranspose trans, const Matrix* X, Matrix* Y) {
+    const Matrix* A = (const Matrix*)ctx;
+    CORE_ERROR_RETURN(matrix_ops_gemm(Y, 1.0, A, trans, X, MATRIX_NO_TRANS, 0.0));
+}
+
+/* Factor by factor, ping-ponging between Y and the scratch block so that the
+   last product lands in Y: F_{c-1} is applied first, or F_0^T when transposed. */
+static CoreErrorStatus product_apply(void* ctx, MatrixTranspose trans, const Matrix* X, Matrix* Y) {
+    const MatrixProductOp* p = (const MatrixProductOp*)ctx;
+    const int c = p->count;
+    if (X->cols > p->kmax) CORE_ERROR_RETURN(CORE_ERROR_DIMENSION);
+
+    MatrixView W;
+    CoreErrorStatus status = matrix_view_of(&W, p->work, X->rows, X->cols, X->cols);
+    if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+
+    const Matrix* src = X;
+    for (int i = 0; i < c; ++i) {
+        const Matrix* F = p->factors[trans == MATRIX_TRANS ? i : c - 1 - i];
+        Matrix* dst = ((c - 1 - i) % 2 == 0) ? Y : &W;
+        status = matrix_ops_gemm(dst, 1.0, F, trans, src, MATRIX_NO_TRANS, 0.0);
+        if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+        src = dst;
+    }
+    CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
+}
+
+/* Same ping-pong as product_apply with every factor the base operator;
+   (B^p)^T = (B^T)^p, so the order does not depend on trans. */
+static CoreErrorStatus power_apply(void* ctx, MatrixTranspose trans, const Matrix* X, Matrix* Y) {
+    const MatrixPowerOp* p = (const MatrixPowerOp*)ctx;
+    const int c = p->power;
+    if (X->cols > p->kmax) CORE_ERROR_RETURN(CORE_ERROR_DIMENSION);
+
+    MatrixView W;
+    CoreErrorStatus status = matrix_view_of(&W, p->work, X->rows, X->cols, X->cols);
+    if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+
+    const Matrix* src = X;
+    for (int i = 0; i < c; ++i) {
+        Matrix* dst = ((c - 1 - i) % 2 == 0) ? Y : &W;
+        status = matrix_linop_apply(p->base, trans, src, dst);
+        if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+        src = dst;
+    }
+    CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
+}
+
+CoreErrorStatus matrix_linop_dense(MatrixLinearOperator* op, const Matrix* A) {
+    if (!op || !A || !A->data) CORE_ERROR_RETURN(CORE_ERROR_NULL);
+    if (A->rows != A->cols) CORE_ERROR_RETURN(CORE_ERROR_DIMENSION);
+
+    op->n = A->rows;
+    op->apply = dense_apply;
+    op->ctx = (void*)A;
+    CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
+}
+
+CoreErrorStatus matrix_linop_product(MatrixLinearOperator* op, MatrixProductOp* prod) {
+    if (!op || !prod || !prod->factors || !prod->work) CORE_ERROR_RETURN(CORE_ERROR_NULL);
+    if (prod->count < 1 || prod->kmax < 1) CORE_ERROR_RETURN(CORE_ERROR_INVALID_ARG);
+
+    const Matrix* F0 = prod->factors[0];
+    if (!F0) CORE_ERROR_RETURN(CORE_ERROR_NULL);
+    for (int i = 0; i < prod->count; ++i) {
+        const Matrix* F = prod->factors[i];
+        if (!F || !F->data) CORE_ERROR_RETURN(CORE_ERROR_NULL);
+        if (F->rows != F0->rows || F->cols != F0->rows) CORE_ERROR_RETURN(CORE_ERROR_DIMENSION);
+    }
+
+    op->n = F0->rows;
+    op->apply = product_apply;
+    op->ctx = prod;
+    CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
+}
+
+CoreErrorStatus matrix_linop_power(MatrixLinearOperator* op, MatrixPowerOp* pw) {
+    if (!op || !pw || !pw->base || !pw->base->apply || !pw->work) CORE_ERROR_RETURN(CORE_ERROR_NULL);
+    if (pw->power < 1 || pw->kmax < 1) CORE_ERROR_RETURN(CORE_ERROR_INVALID_ARG);
+
+    op->n = pw->base->n;
+    op->apply = power_apply;
+    op->ctx = pw;
+    CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
+}
+
+CoreErrorStatus matrix_linop_apply(const MatrixLinearOperator* op, MatrixTranspose trans,
+    const Matrix* X, Matrix* Y)
+{
+    if (!op || !op->apply || !X || !Y) CORE_ERROR_RETURN(CORE_ERROR_NULL);
+    if (trans != MATRIX_NO_TRANS && trans != MATRIX_TRANS) CORE_ERROR_RETURN(CORE_ERROR_INVALID_ARG);
+    if (X->rows != op->n || Y->rows != op->n || X->cols != Y->cols || X->cols < 1) {
+        CORE_ERROR_RETURN(CORE_ERROR_DIMENSION);
+    }
+    CORE_ERROR_RETURN(op->apply(op->ctx, trans, X, Y));
+}
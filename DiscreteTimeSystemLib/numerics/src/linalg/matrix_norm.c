@@ -9,20 +9,26 @@ CoreErrorStatus matrix_norm_1(const Matrix* mat, double* result) {
         CORE_ERROR_RETURN(CORE_ERROR_INVALID_ARG);
     }
 
-    CoreErrorStatus status;
+    if (!mat->data) {
+        CORE_ERROR_RETURN(CORE_ERROR_NULL);
+    }
+
+    // Column sums accumulated row by row: every row segment is read
+    // contiguously, MATRIX_NORM_COL_CHUNK columns per pass.
+    double sums[MATRIX_NORM_COL_CHUNK];
     double max_col_sum = 0.0;
 
-    for (int j = 0; j < mat->cols; j++) {
-        double col_sum = 0.0;
+    for (int j0 = 0; j0 < mat->cols; j0 += MATRIX_NORM_COL_CHUNK) {
+        const int w = (mat->cols - j0 < MATRIX_NORM_COL_CHUNK) ? mat->cols - j0 : MATRIX_NORM_COL_CHUNK;
+        for (int j = 0; j < w; j++) sums[j] = 0.0;
         for (int i = 0; i < mat->rows; i++) {
-            double val = matrix_ops_get(mat, i, j, &status);
-            if (status != CORE_ERROR_SUCCESS) {
-                CORE_ERROR_RETURN(status);
-            }
-            col_sum += fabs(val);
+            const double* row = mat->data + (size_t)i * mat->ld + j0;
+            for (int j = 0; j < w; j++) sums[j] += fabs(row[j]);
         }
-        if (j == 0 || col_sum > max_col_sum) {
-            max_col_sum = col_sum;
+        for (int j = 0; j < w; j++) {
+            if (j0 + j == 0 || sums[j] > max_col_sum) {
+                max_col_sum = sums[j];
+            }
         }
     }
 
@@ -38,16 +44,16 @@ CoreErrorStatus matrix_norm_inf(const Matrix* mat, double* result) {
         CORE_ERROR_RETURN(CORE_ERROR_INVALID_ARG);
     }
 
+    if (!mat->data) {
+        CORE_ERROR_RETURN(CORE_ERROR_NULL);
+    }
+
     double max_row_sum = 0.0;
     for (int i = 0; i < mat->rows; i++) {
         double row_sum = 0.0;
+        const double* row = mat->data + (size_t)i * mat->ld;
         for (int j = 0; j < mat->cols; j++) {
-            CoreErrorStatus status;
-            double val = matrix_ops_get(mat, i, j, &status);
-            if (status != CORE_ERROR_SUCCESS) {
-                CORE_ERROR_RETURN(status);
-            }
-            row_sum += fabs(val);
+            row_sum += fabs(row[j]);
         }
         if (i == 0 || row_sum > max_row_sum) {
             max_row_sum = row_sum;
@@ -65,17 +71,209 @@ CoreErrorStatus matrix_norm_fro(const Matrix* mat, double* result) {
         CORE_ERROR_RETURN(CORE_ERROR_INVALID_ARG);
     }
 
+    if (!mat->data) {
+        CORE_ERROR_RETURN(CORE_ERROR_NULL);
+    }
+
     double sum_sq = 0.0;
     for (int i = 0; i < mat->rows; i++) {
+        const double* row = mat->data + (size_t)i * mat->ld;
         for (int j = 0; j < mat->cols; j++) {
-            CoreErrorStatus status;
-            double val = matrix_ops_get(mat, i, j, &status);
-            if (status != CORE_ERROR_SUCCESS) {
-                CORE_ERROR_RETURN(status);
-            }
-            sum_sq += val * val;
+            sum_sq += row[j] * row[j];
         }
     }
     *result = sqrt(sum_sq);
     CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
 }
+
+/* ---------- Block 1-norm estimation ---------- */
+
+/* xorshift64: the +-1 columns only need to be unlikely to be parallel. */
+static double random_sign(unsigned long long* state) {
+    unsigned long long x = *state;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    *state = x;
+    return (x >> 63) ? -1.0 : 1.0;
+}
+
+/* Columns a and b of two n x t +-1 blocks are parallel iff |a . b| == n. */
+static int columns_parallel(const double* A, int ja, const double* B, int jb, int n, int t) {
+    double dot = 0.0;
+    for (int i = 0; i < n; ++i) dot += A[(size_t)i * t + ja] * B[(size_t)i * t + jb];
+    return fabs(dot) == (double)n;
+}
+
+/* Redraw column j of S while it is parallel to an earlier column of S or to
+   any column of S_old (S_old == NULL on the first iteration). */
+static void resample_parallel(double* S, const double* S_old, int n, int t, int j,
+    unsigned long long* rng)
+{
+    for (int attempt = 0; attempt < 64; ++attempt) {
+        int parallel = 0;
+        for (int i = 0; i < j && !parallel; ++i) parallel = columns_parallel(S, j, S, i, n, t);
+        for (int i = 0; i < t && S_old && !parallel; ++i) parallel = columns_parallel(S, j, S_old, i, n, t);
+        if (!parallel) return;
+        for (int r = 0; r < n; ++r) S[(size_t)r * t + j] = random_sign(rng);
+    }
+}
+
+/* max over the columns of an n x t block of the column 1-norms */
+static double max_column_norm(const double* Y, int n, int t, int* jbest) {
+    double best = -1.0;
+    *jbest = 0;
+    for (int j = 0; j < t; ++j) {
+        double s = 0.0;
+        for (int i = 0; i < n; ++i) s += fabs(Y[(size_t)i * t + j]);
+        if (s > best) { best = s; *jbest = j; }
+    }
+    return best;
+}
+
+/* ||A||_1 exactly from A * I, for n <= t. */
+static CoreErrorStatus norm_1_exact_op(const MatrixLinearOperator* op, double* work, double* est,
+    int* applies)
+{
+    const int n = op->n;
+    MatrixView X, Y;
+    CoreErrorStatus status = matrix_view_of(&X, work, n, n, n);
+    if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+    status = matrix_view_of(&Y, work + (size_t)n * n, n, n, n);
+    if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < n; ++j) work[(size_t)i * n + j] = (i == j) ? 1.0 : 0.0;
+    }
+    status = matrix_linop_apply(op, MATRIX_NO_TRANS, &X, &Y);
+    if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+    if (applies) *applies = 1;
+
+    int jbest;
+    *est = max_column_norm(Y.data, n, n, &jbest);
+    CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
+}
+
+CoreErrorStatus matrix_norm_1_est(const MatrixLinearOperator* op, int t, double* work,
+    double* est, int* applies)
+{
+    if (!op || !work || !est) CORE_ERROR_RETURN(CORE_ERROR_NULL);
+    if (t < 1 || t > 64 || op->n < 1) CORE_ERROR_RETURN(CORE_ERROR_INVALID_ARG);
+    const int n = op->n;
+    if (applies) *applies = 0;
+    if (n <= t) CORE_ERROR_RETURN(norm_1_exact_op(op, work, est, applies));
+
+    /* X (also holds Z = A^T S), Y, S, S_old: n x t each; h, hist: n each */
+    double* X = work;
+    double* Y = X + (size_t)n * t;
+    double* S = Y + (size_t)n * t;
+    double* S_old = S + (size_t)n * t;
+    double* h = S_old + (size_t)n * t;
+    double* hist = h + n;
+    int ind[64];   /* unit-vector indices of the current X columns */
+
+    MatrixView Xv, Yv, Sv;
+    CoreErrorStatus status = matrix_view_of(&Xv, X, n, t, t);
+    if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+    status = matrix_view_of(&Yv, Y, n, t, t);
+    if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+    status = matrix_view_of(&Sv, S, n, t, t);
+    if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+
+    /* Starting block: ones, then random +-1 columns not parallel to earlier ones; scaled by 1/n */
+    unsigned long long rng = 0x9E3779B97F4A7C15ull;
+    for (int i = 0; i < n; ++i) {
+        X[(size_t)i * t] = 1.0;
+        for (int j = 1; j < t; ++j) X[(size_t)i * t + j] = random_sign(&rng);
+    }
+    for (int j = 1; j < t; ++j) resample_parallel(X, NULL, n, t, j, &rng);
+    for (size_t i = 0; i < (size_t)n * t; ++i) X[i] /= n;
+    for (int i = 0; i < n; ++i) hist[i] = 0.0;
+
+    double est_old = 0.0, value = 0.0;
+    int ind_best = -1, have_s_old = 0, count = 0;
+    for (int k = 1; ; ++k) {
+        status = matrix_linop_apply(op, MATRIX_NO_TRANS, &Xv, &Yv);
+        if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+        ++count;
+
+        int jbest;
+        value = max_column_norm(Y, n, t, &jbest);
+        if (k >= 2 && value > est_old) ind_best = ind[jbest];
+        if (k >= 2 && value <= est_old) {
+            value = est_old;                         /* no improvement */
+            break;
+        }
+        est_old = value;
+        if (k > MATRIX_NORMEST_ITMAX) break;
+
+        /* S = sign(Y); stop once every column repeats a previous one */
+        if (have_s_old) {
+            for (size_t i = 0; i < (size_t)n * t; ++i) S_old[i] = S[i];
+        }
+        for (size_t i = 0; i < (size_t)n * t; ++i) S[i] = (Y[i] >= 0.0) ? 1.0 : -1.0;
+        if (have_s_old) {
+            int all_parallel = 1;
+            for (int j = 0; j < t && all_parallel; ++j) {
+                int p = 0;
+                for (int i = 0; i < t && !p; ++i) p = columns_parallel(S, j, S_old, i, n, t);
+                all_parallel = p;
+            }
+            if (all_parallel) break;
+            for (int j = 0; j < t; ++j) resample_parallel(S, S_old, n, t, j, &rng);
+        }
+        else {
+            for (int j = 1; j < t; ++j) resample_parallel(S, NULL, n, t, j, &rng);
+        }
+        have_s_old = 1;
+
+        /* Z = A^T S (in X); h_i = max_j |Z_ij| is the gradient size along e_i */
+        status = matrix_linop_apply(op, MATRIX_TRANS, &Sv, &Xv);
+        if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+        ++count;
+        double hmax = 0.0;
+        for (int i = 0; i < n; ++i) {
+            double m = 0.0;
+            for (int j = 0; j < t; ++j) m = fmax(m, fabs(X[(size_t)i * t + j]));
+            h[i] = m;
+            hmax = fmax(hmax, m);
+        }
+        if (k >= 2 && ind_best >= 0 && h[ind_best] == hmax) break;   /* gradient converged */
+
+        /* Next X: unit vectors along the t largest h_i not visited before;
+           stop if the t largest overall were all visited already */
+        int fresh = 0;
+        for (int j = 0; j < t; ++j) {
+            int best = -1;
+            for (int i = 0; i < n; ++i) {
+                int taken = 0;
+                for (int q = 0; q < j && !taken; ++q) taken = (ind[q] == i);
+                if (!taken && (best < 0 || h[i] > h[best])) best = i;
+            }
+            ind[j] = best;
+            if (hist[best] == 0.0) ++fresh;
+        }
+        if (fresh == 0) break;
+        int picked = 0;
+        for (; picked < t; ++picked) {
+            int best = -1;
+            for (int i = 0; i < n; ++i) {
+                int taken = (hist[i] != 0.0);
+                for (int q = 0; q < picked && !taken; ++q) taken = (ind[q] == i);
+                if (!taken && (best < 0 || h[i] > h[best])) best = i;
+            }
+            if (best < 0) break;
+            ind[picked] = best;
+        }
+        if (picked < t) break;   /* fewer than t unvisited unit vectors left */
+        for (size_t i = 0; i < (size_t)n * t; ++i) X[i] = 0.0;
+        for (int j = 0; j < t; ++j) {
+            X[(size_t)ind[j] * t + j] = 1.0;
+            hist[ind[j]] = 1.0;
+        }
+    }
+
+    *est = value;
+    if (applies) *applies = count;
+    CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
+}
@@ -1,24 +1,104 @@
 #pragma once
 
 #include <stdio.h>
+#include <stdint.h>
 #include <string.h>
 #include <math.h>
 #include "matrix_ops.h"
+#include "matrix_gemm.h"
+#include "matrix_simd.h"
 #include "bit_utils.h"
 #include "core_matrix.h"
+#include "core_thread_pool.h"
 
-CoreErrorStatus matrix_ops_fill(Matrix* mat, double value) {
-    if (mat == NULL) {
-        CORE_ERROR_RETURN(CORE_ERROR_NULL);
+static inline double* row_at(Matrix* m, int i) {
+    return m->data + (size_t)i * (size_t)m->ld;
+}
+static inline const double* row_at_c(const Matrix* m, int i) {
+    return m->data + (size_t)i * (size_t)m->ld;
+}
+
+/* Whether the address spans [data, data + (rows-1)*ld + cols) of x and y
+   intersect. Views of one parent overlap at different base pointers, so
+   comparing data pointers alone is not enough to rule out aliasing. */
+static int storage_overlaps(const Matrix* x, const Matrix* y) {
+    if (x->rows <= 0 || x->cols <= 0 || y->rows <= 0 || y->cols <= 0) return 0;
+    const uintptr_t x0 = (uintptr_t)x->data;
+    const uintptr_t x1 = (uintptr_t)(x->data + (size_t)(x->rows - 1) * (size_t)x->ld + (size_t)x->cols);
+    const uintptr_t y0 = (uintptr_t)y->data;
+    const uintptr_t y1 = (uintptr_t)(y->data + (size_t)(y->rows - 1) * (size_t)y->ld + (size_t)y->cols);
+    return x0 < y1 && y0 < x1;
+}
+
+/* ---------- Element-wise kernels (split across the thread pool when large) ---------- */
+
+/* Elements handled per parallel_for range at minimum. */
+#define ELEM_GRAIN 8192
+
+typedef enum { ELEM_FILL, ELEM_ADD, ELEM_SCALE, ELEM_AXPY, ELEM_COPY } ElemOp;
+
+typedef struct {
+    ElemOp op;
+    double alpha;
+    const Matrix* a;    /* first operand (unused by FILL and SCALE) */
+    const Matrix* b;    /* second operand (ADD only) */
+    Matrix* out;
+    int flat;           /* all operands contiguous: index elements, not rows */
+} ElemJob;
+
+static void elem_span(const ElemJob* job, const MatrixSimdKernels* simd, int len,
+    const double* a, const double* b, double* out)
+{
+    switch (job->op) {
+    case ELEM_FILL:  simd->fill(len, job->alpha, out); break;
+    case ELEM_ADD:   simd->add(len, a, b, out); break;
+    case ELEM_SCALE: simd->scale(len, job->alpha, out); break;
+    case ELEM_AXPY:  simd->axpy(len, job->alpha, a, out); break;
+    case ELEM_COPY:  memcpy(out, a, (size_t)len * sizeof(double)); break;
+    }
+}
+
+static CoreErrorStatus elem_range(void* ctx, int begin, int end) {
+    const ElemJob* job = (const ElemJob*)ctx;
+    const MatrixSimdKernels* simd = matrix_simd_kernels();
+    if (job->flat) {
+        elem_span(job, simd, end - begin,
+            job->a ? job->a->data + begin : NULL,
+            job->b ? job->b->data + begin : NULL,
+            job->out->data + begin);
+    }
+    else {
+        for (int i = begin; i < end; ++i) {
+            elem_span(job, simd, job->out->cols,
+                job->a ? row_at_c(job->a, i) : NULL,
+                job->b ? row_at_c(job->b, i) : NULL,
+                row_at(job->out, i));
+        }
     }
+    return CORE_ERROR_SUCCESS;
+}
 
-    int size = mat->rows * mat->cols;
+static CoreErrorStatus elem_run(ElemOp op, double alpha, const Matrix* a, const Matrix* b, Matrix* out) {
+    ElemJob job = { op, alpha, a, b, out, 0 };
+    job.flat = matrix_core_is_contiguous(out) &&
+        (!a || matrix_core_is_contiguous(a)) && (!b || matrix_core_is_contiguous(b));
 
-    for (int i = 0; i < size; ++i) {
-        mat->data[i] = value;
+    const int rows = out->rows, cols = out->cols;
+    const int count = job.flat ? rows * cols : rows;
+    if ((size_t)rows * (size_t)cols < MATRIX_OPS_PARALLEL_MIN_ELEMENTS) {
+        return elem_range(&job, 0, count);
     }
+    const int grain = job.flat ? ELEM_GRAIN : (ELEM_GRAIN + cols - 1) / cols;
+    return core_thread_pool_parallel_for(count, grain, elem_range, &job);
+}
 
-    CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
+CoreErrorStatus matrix_ops_fill(Matrix* mat, double value) {
+    if (mat == NULL) {
+        CORE_ERROR_RETURN(CORE_ERROR_NULL);
+    }
+
+    CoreErrorStatus status = elem_run(ELEM_FILL, value, NULL, NULL, mat);
+    CORE_ERROR_RETURN(status);
 }
 
 CoreErrorStatus matrix_ops_set(Matrix* mat, int i, int j, double value) {
@@ -32,7 +112,7 @@ CoreErrorStatus matrix_ops_set(Matrix* mat, int i, int j, double value) {
         CORE_ERROR_RETURN(CORE_ERROR_OUT_OF_BOUNDS);
     }
 
-    mat->data[i * mat->cols + j] = value;
+    row_at(mat, i)[j] = value;
 
     CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
 }
@@ -51,7 +131,7 @@ double matrix_ops_get(const Matrix* mat, int i, int j, CoreErrorStatus* err)
     }
 
     if (err) *err = CORE_ERROR_SUCCESS;
-    return mat->data[i * mat->cols + j];
+    return row_at_c(mat, i)[j];
 }
 
 CoreErrorStatus matrix_ops_set_zero(Matrix* mat)
@@ -86,7 +166,7 @@ CoreErrorStatus matrix_ops_set_identity(Matrix* mat) {
     }
 
     for (int i = 0; i < mat->rows; ++i)  {
-        mat->data[i * mat->cols + i] = 1.0;
+        row_at(mat, i)[i] = 1.0;
     }
 
     CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
@@ -101,13 +181,8 @@ CoreErrorStatus matrix_ops_add(Matrix* result, const Matrix* a, const Matrix* b)
         CORE_ERROR_RETURN(CORE_ERROR_DIMENSION);
     }
 
-    int size = a->rows * a->cols;
-
-    for (int i = 0; i < size; ++i) {
-        result->data[i] = a->data[i] + b->data[i];
-    }
-
-    CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
+    CoreErrorStatus status = elem_run(ELEM_ADD, 0.0, a, b, result);
+    CORE_ERROR_RETURN(status);
 }
 
 CoreErrorStatus matrix_ops_multiply(Matrix* result, const Matrix* a, const Matrix* b) {
@@ -120,27 +195,91 @@ CoreErrorStatus matrix_ops_multiply(Matrix* result, const Matrix* a, const Matri
         CORE_ERROR_RETURN(CORE_ERROR_DIMENSION);
     }
 
-    CoreErrorStatus status;
+    // Column-vector right-hand side: matrix-vector product
+    if (b->cols == 1 && b->ld == 1 && result->ld == 1) {
+        CoreErrorStatus status = matrix_gemv_compute(MATRIX_NO_TRANS, a->rows, a->cols,
+            1.0, a->data, a->ld, b->data, 0.0, result->data);
+        CORE_ERROR_RETURN(status);
+    }
 
-    for (int i = 0; i < a->rows; ++i) 
-    {
-        for (int j = 0; j < b->cols; ++j)
-        {
-            double sum = 0.0;
-            for (int k = 0; k < a->cols; ++k) {
-                sum += matrix_ops_get(a, i, k, &status) * matrix_ops_get(b, k, j, &status);
-                if (status != CORE_ERROR_SUCCESS) {
-                    CORE_ERROR_RETURN(status);
-                }
-            }
-            status =matrix_ops_set(result, i, j, sum);
-            if (status != CORE_ERROR_SUCCESS) {
-                CORE_ERROR_RETURN(status);
-            }
-        }
+    // Arguments are validated above, so hand the raw buffers to the blocked
+    // GEMM engine: result = 1.0 * a * b + 0.0 * result
+    CoreErrorStatus status = matrix_gemm_compute(a->rows, b->cols, a->cols,
+        1.0, a->data, a->ld,
+        b->data, b->ld,
+        0.0, result->data, result->ld);
+    CORE_ERROR_RETURN(status);
+}
+
+CoreErrorStatus matrix_ops_gemm(Matrix* C, double alpha,
+    const Matrix* A, MatrixTranspose trans_a,
+    const Matrix* B, MatrixTranspose trans_b,
+    double beta)
+{
+    if (C == NULL || A == NULL || B == NULL) {
+        CORE_ERROR_RETURN(CORE_ERROR_NULL);
+    }
+    if (C->data == NULL || A->data == NULL || B->data == NULL) {
+        CORE_ERROR_RETURN(CORE_ERROR_NULL);
     }
 
-    CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
+    const int m = trans_a ? A->cols : A->rows;
+    const int k = trans_a ? A->rows : A->cols;
+    const int kb = trans_b ? B->cols : B->rows;
+    const int n = trans_b ? B->rows : B->cols;
+    if (k != kb || C->rows != m || C->cols != n) {
+        CORE_ERROR_RETURN(CORE_ERROR_DIMENSION);
+    }
+    // C is read (beta) and written while A/B are streamed, so no aliasing
+    if (storage_overlaps(C, A) || storage_overlaps(C, B)) {
+        CORE_ERROR_RETURN(CORE_ERROR_INVALID_ARG);
+    }
+
+    // op(B) is a single contiguous column: use GEMV
+    if (n == 1 && matrix_core_is_contiguous(B) && C->ld == 1) {
+        CoreErrorStatus status = matrix_gemv_compute(trans_a, A->rows, A->cols,
+            alpha, A->data, A->ld, B->data, beta, C->data);
+        CORE_ERROR_RETURN(status);
+    }
+
+    CoreErrorStatus status = matrix_gemm_compute_op(trans_a, trans_b, m, n, k,
+        alpha, A->data, A->ld,
+        B->data, B->ld,
+        beta, C->data, C->ld);
+    CORE_ERROR_RETURN(status);
+}
+
+CoreErrorStatus matrix_ops_gemv(Matrix* y, double alpha,
+    const Matrix* A, MatrixTranspose trans_a,
+    const Matrix* x,
+    double beta)
+{
+    if (y == NULL || A == NULL || x == NULL) {
+        CORE_ERROR_RETURN(CORE_ERROR_NULL);
+    }
+    if (y->data == NULL || A->data == NULL || x->data == NULL) {
+        CORE_ERROR_RETURN(CORE_ERROR_NULL);
+    }
+
+    const int m = trans_a ? A->cols : A->rows;
+    const int k = trans_a ? A->rows : A->cols;
+    if (x->cols != 1 || x->rows != k || y->cols != 1 || y->rows != m) {
+        CORE_ERROR_RETURN(CORE_ERROR_DIMENSION);
+    }
+    if (storage_overlaps(y, A) || storage_overlaps(y, x)) {
+        CORE_ERROR_RETURN(CORE_ERROR_INVALID_ARG);
+    }
+
+    // Padded column vectors are strided: route them through the GEMM engine
+    if (x->ld != 1 || y->ld != 1) {
+        CoreErrorStatus status = matrix_gemm_compute_op(trans_a, MATRIX_NO_TRANS, m, 1, k,
+            alpha, A->data, A->ld, x->data, x->ld, beta, y->data, y->ld);
+        CORE_ERROR_RETURN(status);
+    }
+
+    CoreErrorStatus status = matrix_gemv_compute(trans_a, A->rows, A->cols,
+        alpha, A->data, A->ld, x->data, beta, y->data);
+    CORE_ERROR_RETURN(status);
 }
 
 CoreErrorStatus matrix_ops_copy(Matrix* dest, const Matrix* src)
@@ -154,10 +293,8 @@ CoreErrorStatus matrix_ops_copy(Matrix* dest, const Matrix* src)
     }
    if (src == dest) CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
 
-    size_t n = (size_t)src->rows * (size_t)src->cols;
-    memcpy(dest->data, src->data, n * sizeof(double));
-
-    CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
+    CoreErrorStatus status = elem_run(ELEM_COPY, 0.0, src, NULL, dest);
+    CORE_ERROR_RETURN(status);
 }
 
 CoreErrorStatus matrix_ops_power(const Matrix* mat, int n, Matrix* result)
@@ -307,14 +444,9 @@ CoreErrorStatus matrix_ops_scale(Matrix* mat, double factor) {
         return matrix_ops_set_zero(mat);
     }
 
-    const int n = mat->rows * mat->cols;
-
     // General case
-    double* __restrict d = mat->data;
-    for (int i = 0; i < n; ++i) {
-        d[i] *= factor;
-    }
-    CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
+    CoreErrorStatus status = elem_run(ELEM_SCALE, factor, NULL, NULL, mat);
+    CORE_ERROR_RETURN(status);
 }
 
 CoreErrorStatus matrix_ops_axpy(Matrix* Y, double alpha, const Matrix* X)
@@ -331,16 +463,8 @@ CoreErrorStatus matrix_ops_axpy(Matrix* Y, double alpha, const Matrix* X)
         CORE_ERROR_RETURN(CORE_ERROR_INVALID_ARG);
     }
 
-    const int nrows = Y->rows;
-    const int ncols = Y->cols;
-    double* ydata = Y->data;
-    const double* xdata = X->data;
-
-    for (int i = 0; i < nrows * ncols; ++i) {
-        ydata[i] += alpha * xdata[i];
-    }
-
-    CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
+    CoreErrorStatus status = elem_run(ELEM_AXPY, alpha, X, NULL, Y);
+    CORE_ERROR_RETURN(status);
 }
 
 CoreErrorStatus matrix_ops_fill_sequential(Matrix* mat, double start, double step) {
@@ -365,15 +489,13 @@ CoreErrorStatus matrix_ops_set_block(Matrix* dst, int offset_row, int offset_col
     if (src->rows + offset_row > dst->rows) CORE_ERROR_RETURN(CORE_ERROR_OUT_OF_BOUNDS);
     if (src->cols + offset_col > dst->cols) CORE_ERROR_RETURN(CORE_ERROR_OUT_OF_BOUNDS);
   
-    CoreErrorStatus status = CORE_ERROR_SUCCESS;
-
-    for (int r = 0; r < src->rows; ++r) {
-        double* dst_row = &dst->data[(offset_row + r) * dst->cols + offset_col];
-        const double* src_row = &src->data[r * src->cols];
+    // Copy straight into a view of the destination block
+    MatrixView blk;
+    CoreErrorStatus status = matrix_view_block(&blk, dst, offset_row, offset_col, src->rows, src->cols);
+    if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
 
-        memcpy(dst_row, src_row, sizeof(double) * src->cols);
-    }
-    CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
+    status = matrix_ops_copy(&blk, src);
+    CORE_ERROR_RETURN(status);
 }
 
 CoreErrorStatus matrix_ops_get_block(const Matrix* src, int offset_row, int offset_col, Matrix* out)
@@ -384,11 +506,10 @@ CoreErrorStatus matrix_ops_get_block(const Matrix* src, int offset_row, int offs
     if (offset_row + out->rows > src->rows ||
         offset_col + out->cols > src->cols)    CORE_ERROR_RETURN(CORE_ERROR_OUT_OF_BOUNDS);
 
-    for (int r = 0; r < out->rows; ++r) {
-        const double* src_row = &src->data[(offset_row + r) * src->cols + offset_col];
-        double* out_row = &out->data[r * out->cols];
-        memcpy(out_row, src_row, sizeof(double) * (size_t)out->cols);
-    }
+    MatrixView blk;
+    CoreErrorStatus status = matrix_view_block(&blk, src, offset_row, offset_col, out->rows, out->cols);
+    if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
 
-    CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
+    status = matrix_ops_copy(out, &blk);
+    CORE_ERROR_RETURN(status);
 }
@@ -0,0 +1,845 @@
+#include <stddef.h>
+#include "matrix_simd.h"
+#include "matrix_gemm.h"
+#include "core_error.h"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define MATRIX_SIMD_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#else
+#define MATRIX_SIMD_X86 0
+#endif
+
+/* GCC/Clang need a per-function target to emit wider instructions than the
+   translation unit's baseline; MSVC accepts the intrinsics unconditionally. */
+#if defined(__GNUC__) || defined(__clang__)
+#define SIMD_TARGET(isa) __attribute__((target(isa)))
+#else
+#define SIMD_TARGET(isa)
+#endif
+
+#if MATRIX_GEMM_MR != 4 || MATRIX_GEMM_NR != 8
+#error "SIMD micro-kernels are hand-tiled for a 4 x 8 register tile"
+#endif
+
+/*
+ * Element-wise kernels round exactly like the scalar loops (axpy uses a separate
+ * multiply and add, never FMA), so results do not depend on the dispatch level.
+ * Only the GEMM micro-kernel, the GEMV dot products and the float GEMM
+ * contract to FMA where available, through explicit FMA intrinsics. The file
+ * is built with -ffp-contract=off (CMakeLists.txt) so GCC/Clang do not fuse
+ * the element-wise multiply-adds inside "fma" target functions.
+ */
+
+/* ---------- Scalar reference kernels ---------- */
+
+static void scalar_fill(int n, double value, double* x) {
+    for (int i = 0; i < n; ++i) x[i] = value;
+}
+
+static void scalar_add(int n, const double* a, const double* b, double* out) {
+    for (int i = 0; i < n; ++i) out[i] = a[i] + b[i];
+}
+
+static void scalar_scale(int n, double alpha, double* x) {
+    for (int i = 0; i < n; ++i) x[i] *= alpha;
+}
+
+static void scalar_axpy(int n, double alpha, const double* x, double* y) {
+    for (int i = 0; i < n; ++i) y[i] += alpha * x[i];
+}
+
+static void scalar_gemm_micro(int kc, double alpha, const double* ap, const double* bp, double* C, int ldc) {
+    double c0[8] = { 0 }, c1[8] = { 0 }, c2[8] = { 0 }, c3[8] = { 0 };
+    for (int p = 0; p < kc; ++p) {
+        const double a0 = ap[0], a1 = ap[1], a2 = ap[2], a3 = ap[3];
+        for (int j = 0; j < 8; ++j) {
+            const double b = bp[j];
+            c0[j] += a0 * b;
+            c1[j] += a1 * b;
+            c2[j] += a2 * b;
+            c3[j] += a3 * b;
+        }
+        ap += 4;
+        bp += 8;
+    }
+    const double* ab[4] = { c0, c1, c2, c3 };
+    for (int i = 0; i < 4; ++i) {
+        double* c = C + (size_t)i * ldc;
+        for (int j = 0; j < 8; ++j) c[j] += alpha * ab[i][j];
+    }
+}
+
+/* y = alpha * s + beta * y, with beta == 0 overwriting y (NaN-safe). */
+static inline double gemv_combine(double alpha, double s, double beta, double y) {
+    return (beta == 0.0) ? alpha * s : alpha * s + beta * y;
+}
+
+static void scalar_gemv(int m, int n, double alpha, const double* A, int lda,
+    const double* x, double beta, double* y)
+{
+    int i = 0;
+    for (; i + 4 <= m; i += 4) {
+        const double* a0 = A + (size_t)i * lda;
+        const double* a1 = a0 + lda;
+        const double* a2 = a1 + lda;
+        const double* a3 = a2 + lda;
+        double s0 = 0.0, s1 = 0.0, s2 = 0.0, s3 = 0.0;
+        for (int j = 0; j < n; ++j) {
+            const double xj = x[j];
+            s0 += a0[j] * xj;
+            s1 += a1[j] * xj;
+            s2 += a2[j] * xj;
+            s3 += a3[j] * xj;
+        }
+        y[i + 0] = gemv_combine(alpha, s0, beta, y[i + 0]);
+        y[i + 1] = gemv_combine(alpha, s1, beta, y[i + 1]);
+        y[i + 2] = gemv_combine(alpha, s2, beta, y[i + 2]);
+        y[i + 3] = gemv_combine(alpha, s3, beta, y[i + 3]);
+    }
+    for (; i < m; ++i) {
+        const double* a = A + (size_t)i * lda;
+        double s0 = 0.0;
+        for (int j = 0; j < n; ++j) s0 += a[j] * x[j];
+        y[i] = gemv_combine(alpha, s0, beta, y[i]);
+    }
+}
+
+/* C += alpha * A * B in float, row-major and unpacked. Also the edge path of
+   the vector versions below. */
+static void scalar_sgemm(int m, int n, int k, float alpha, const float* A, int lda,
+    const float* B, int ldb, float* C, int ldc)
+{
+    for (int i = 0; i < m; ++i) {
+        const float* a = A + (size_t)i * lda;
+        float* c = C + (size_t)i * ldc;
+        for (int p = 0; p < k; ++p) {
+            const float t = alpha * a[p];
+            const float* b = B + (size_t)p * ldb;
+            for (int j = 0; j < n; ++j) c[j] += t * b[j];
+        }
+    }
+}
+
+#if MATRIX_SIMD_X86
+
+/* ---------- SSE2 kernels ---------- */
+
+SIMD_TARGET("sse2")
+static void sse2_fill(int n, double value, double* x) {
+    const __m128d v = _mm_set1_pd(value);
+    int i = 0;
+    for (; i + 2 <= n; i += 2) _mm_storeu_pd(x + i, v);
+    for (; i < n; ++i) x[i] = value;
+}
+
+SIMD_TARGET("sse2")
+static void sse2_add(int n, const double* a, const double* b, double* out) {
+    int i = 0;
+    for (; i + 2 <= n; i += 2) _mm_storeu_pd(out + i, _mm_add_pd(_mm_loadu_pd(a + i), _mm_loadu_pd(b + i)));
+    for (; i < n; ++i) out[i] = a[i] + b[i];
+}
+
+SIMD_TARGET("sse2")
+static void sse2_scale(int n, double alpha, double* x) {
+    const __m128d va = _mm_set1_pd(alpha);
+    int i = 0;
+    for (; i + 2 <= n; i += 2) _mm_storeu_pd(x + i, _mm_mul_pd(va, _mm_loadu_pd(x + i)));
+    for (; i < n; ++i) x[i] *= alpha;
+}
+
+SIMD_TARGET("sse2")
+static void sse2_axpy(int n, double alpha, const double* x, double* y) {
+    const __m128d va = _mm_set1_pd(alpha);
+    int i = 0;
+    for (; i + 2 <= n; i += 2) {
+        _mm_storeu_pd(y + i, _mm_add_pd(_mm_loadu_pd(y + i), _mm_mul_pd(va, _mm_loadu_pd(x + i))));
+    }
+    for (; i < n; ++i) y[i] += alpha * x[i];
+}
+
+SIMD_TARGET("sse2")
+static void sse2_gemm_micro(int kc, double alpha, const double* ap, const double* bp, double* C, int ldc) {
+    __m128d acc[4][4];
+    for (int i = 0; i < 4; ++i)
+        for (int j = 0; j < 4; ++j) acc[i][j] = _mm_setzero_pd();
+
+    for (int p = 0; p < kc; ++p) {
+        const __m128d b0 = _mm_loadu_pd(bp + 0);
+        const __m128d b1 = _mm_loadu_pd(bp + 2);
+        const __m128d b2 = _mm_loadu_pd(bp + 4);
+        const __m128d b3 = _mm_loadu_pd(bp + 6);
+        for (int i = 0; i < 4; ++i) {
+            const __m128d a = _mm_set1_pd(ap[i]);
+            acc[i][0] = _mm_add_pd(acc[i][0], _mm_mul_pd(a, b0));
+            acc[i][1] = _mm_add_pd(acc[i][1], _mm_mul_pd(a, b1));
+            acc[i][2] = _mm_add_pd(acc[i][2], _mm_mul_pd(a, b2));
+            acc[i][3] = _mm_add_pd(acc[i][3], _mm_mul_pd(a, b3));
+        }
+        ap += 4;
+        bp += 8;
+    }
+
+    const __m128d va = _mm_set1_pd(alpha);
+    for (int i = 0; i < 4; ++i) {
+        double* c = C + (size_t)i * ldc;
+        for (int j = 0; j < 4; ++j) {
+            _mm_storeu_pd(c + 2 * j, _mm_add_pd(_mm_loadu_pd(c + 2 * j), _mm_mul_pd(va, acc[i][j])));
+        }
+    }
+}
+
+SIMD_TARGET("sse2")
+static inline double sse2_hsum(__m128d v) {
+    return _mm_cvtsd_f64(_mm_add_sd(v, _mm_unpackhi_pd(v, v)));
+}
+
+SIMD_TARGET("sse2")
+static void sse2_gemv(int m, int n, double alpha, const double* A, int lda,
+    const double* x, double beta, double* y)
+{
+    const int n2 = n & ~1;
+    int i = 0;
+    for (; i + 4 <= m; i += 4) {
+        const double* a0 = A + (size_t)i * lda;
+        const double* a1 = a0 + lda;
+        const double* a2 = a1 + lda;
+        const double* a3 = a2 + lda;
+        __m128d c0 = _mm_setzero_pd(), c1 = _mm_setzero_pd(), c2 = _mm_setzero_pd(), c3 = _mm_setzero_pd();
+        for (int j = 0; j < n2; j += 2) {
+            const __m128d xv = _mm_loadu_pd(x + j);
+            c0 = _mm_add_pd(c0, _mm_mul_pd(_mm_loadu_pd(a0 + j), xv));
+            c1 = _mm_add_pd(c1, _mm_mul_pd(_mm_loadu_pd(a1 + j), xv));
+            c2 = _mm_add_pd(c2, _mm_mul_pd(_mm_loadu_pd(a2 + j), xv));
+            c3 = _mm_add_pd(c3, _mm_mul_pd(_mm_loadu_pd(a3 + j), xv));
+        }
+        double s0 = sse2_hsum(c0), s1 = sse2_hsum(c1), s2 = sse2_hsum(c2), s3 = sse2_hsum(c3);
+        if (n2 < n) {
+            const double xj = x[n2];
+            s0 += a0[n2] * xj; s1 += a1[n2] * xj; s2 += a2[n2] * xj; s3 += a3[n2] * xj;
+        }
+        y[i + 0] = gemv_combine(alpha, s0, beta, y[i + 0]);
+        y[i + 1] = gemv_combine(alpha, s1, beta, y[i + 1]);
+        y[i + 2] = gemv_combine(alpha, s2, beta, y[i + 2]);
+        y[i + 3] = gemv_combine(alpha, s3, beta, y[i + 3]);
+    }
+    for (; i < m; ++i) {
+        const double* a = A + (size_t)i * lda;
+        __m128d c = _mm_setzero_pd();
+        for (int j = 0; j < n2; j += 2) c = _mm_add_pd(c, _mm_mul_pd(_mm_loadu_pd(a + j), _mm_loadu_pd(x + j)));
+        double s0 = sse2_hsum(c);
+        if (n2 < n) s0 += a[n2] * x[n2];
+        y[i] = gemv_combine(alpha, s0, beta, y[i]);
+    }
+}
+
+/*
+ * The float GEMMs work on 4-row tiles of C held in registers over the whole
+ * depth k. Column slabs are the outer loop, so the k x slab panel of B is
+ * reused from L1 by every row tile. Leftover rows run one at a time on the
+ * same vectors; only columns that do not fill a vector go through scalar_sgemm.
+ */
+SIMD_TARGET("sse2")
+static void sse2_sgemm(int m, int n, int k, float alpha, const float* A, int lda,
+    const float* B, int ldb, float* C, int ldc)
+{
+    const int m4 = m & ~3, n8 = n & ~7;
+    const __m128 va = _mm_set1_ps(alpha);
+    for (int j = 0; j < n8; j += 8) {
+        for (int i = 0; i < m4; i += 4) {
+            const float* a = A + (size_t)i * lda;
+            __m128 acc[4][2];
+            for (int r = 0; r < 4; ++r) acc[r][0] = acc[r][1] = _mm_setzero_ps();
+            const float* b = B + j;
+            for (int p = 0; p < k; ++p, b += ldb) {
+                const __m128 b0 = _mm_loadu_ps(b), b1 = _mm_loadu_ps(b + 4);
+                for (int r = 0; r < 4; ++r) {
+                    const __m128 ar = _mm_set1_ps(a[(size_t)r * lda + p]);
+                    acc[r][0] = _mm_add_ps(acc[r][0], _mm_mul_ps(ar, b0));
+                    acc[r][1] = _mm_add_ps(acc[r][1], _mm_mul_ps(ar, b1));
+                }
+            }
+            for (int r = 0; r < 4; ++r) {
+                float* c = C + (size_t)(i + r) * ldc + j;
+                _mm_storeu_ps(c, _mm_add_ps(_mm_loadu_ps(c), _mm_mul_ps(va, acc[r][0])));
+                _mm_storeu_ps(c + 4, _mm_add_ps(_mm_loadu_ps(c + 4), _mm_mul_ps(va, acc[r][1])));
+            }
+        }
+        for (int i = m4; i < m; ++i) {
+            const float* a = A + (size_t)i * lda;
+            __m128 c0 = _mm_setzero_ps(), c1 = _mm_setzero_ps();
+            const float* b = B + j;
+            for (int p = 0; p < k; ++p, b += ldb) {
+                const __m128 ap = _mm_set1_ps(a[p]);
+                c0 = _mm_add_ps(c0, _mm_mul_ps(ap, _mm_loadu_ps(b)));
+                c1 = _mm_add_ps(c1, _mm_mul_ps(ap, _mm_loadu_ps(b + 4)));
+            }
+            float* c = C + (size_t)i * ldc + j;
+            _mm_storeu_ps(c, _mm_add_ps(_mm_loadu_ps(c), _mm_mul_ps(va, c0)));
+            _mm_storeu_ps(c + 4, _mm_add_ps(_mm_loadu_ps(c + 4), _mm_mul_ps(va, c1)));
+        }
+    }
+    if (n8 < n) scalar_sgemm(m, n - n8, k, alpha, A, lda, B + n8, ldb, C + n8, ldc);
+}
+
+/* ---------- AVX2 + FMA kernels ---------- */
+
+SIMD_TARGET("avx2,fma")
+static void avx2_fill(int n, double value, double* x) {
+    const __m256d v = _mm256_set1_pd(value);
+    int i = 0;
+    for (; i + 4 <= n; i += 4) _mm256_storeu_pd(x + i, v);
+    for (; i < n; ++i) x[i] = value;
+}
+
+SIMD_TARGET("avx2,fma")
+static void avx2_add(int n, const double* a, const double* b, double* out) {
+    int i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const __m256d s0 = _mm256_add_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i));
+        const __m256d s1 = _mm256_add_pd(_mm256_loadu_pd(a + i + 4), _mm256_loadu_pd(b + i + 4));
+        _mm256_storeu_pd(out + i, s0);
+        _mm256_storeu_pd(out + i + 4, s1);
+    }
+    for (; i + 4 <= n; i += 4) _mm256_storeu_pd(out + i, _mm256_add_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i)));
+    for (; i < n; ++i) out[i] = a[i] + b[i];
+}
+
+SIMD_TARGET("avx2,fma")
+static void avx2_scale(int n, double alpha, double* x) {
+    const __m256d va = _mm256_set1_pd(alpha);
+    int i = 0;
+    for (; i + 4 <= n; i += 4) _mm256_storeu_pd(x + i, _mm256_mul_pd(va, _mm256_loadu_pd(x + i)));
+    for (; i < n; ++i) x[i] *= alpha;
+}
+
+SIMD_TARGET("avx2,fma")
+static void avx2_axpy(int n, double alpha, const double* x, double* y) {
+    const __m256d va = _mm256_set1_pd(alpha);
+    int i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const __m256d y0 = _mm256_add_pd(_mm256_loadu_pd(y + i), _mm256_mul_pd(va, _mm256_loadu_pd(x + i)));
+        const __m256d y1 = _mm256_add_pd(_mm256_loadu_pd(y + i + 4), _mm256_mul_pd(va, _mm256_loadu_pd(x + i + 4)));
+        _mm256_storeu_pd(y + i, y0);
+        _mm256_storeu_pd(y + i + 4, y1);
+    }
+    for (; i + 4 <= n; i += 4) _mm256_storeu_pd(y + i, _mm256_add_pd(_mm256_loadu_pd(y + i), _mm256_mul_pd(va, _mm256_loadu_pd(x + i))));
+    for (; i < n; ++i) y[i] += alpha * x[i];
+}
+
+SIMD_TARGET("avx2,fma")
+static void avx2_gemm_micro(int kc, double alpha, const double* ap, const double* bp, double* C, int ldc) {
+    __m256d c00 = _mm256_setzero_pd(), c01 = _mm256_setzero_pd();
+    __m256d c10 = _mm256_setzero_pd(), c11 = _mm256_setzero_pd();
+    __m256d c20 = _mm256_setzero_pd(), c21 = _mm256_setzero_pd();
+    __m256d c30 = _mm256_setzero_pd(), c31 = _mm256_setzero_pd();
+
+    for (int p = 0; p < kc; ++p) {
+        const __m256d b0 = _mm256_loadu_pd(bp);
+        const __m256d b1 = _mm256_loadu_pd(bp + 4);
+        __m256d a = _mm256_broadcast_sd(ap + 0);
+        c00 = _mm256_fmadd_pd(a, b0, c00); c01 = _mm256_fmadd_pd(a, b1, c01);
+        a = _mm256_broadcast_sd(ap + 1);
+        c10 = _mm256_fmadd_pd(a, b0, c10); c11 = _mm256_fmadd_pd(a, b1, c11);
+        a = _mm256_broadcast_sd(ap + 2);
+        c20 = _mm256_fmadd_pd(a, b0, c20); c21 = _mm256_fmadd_pd(a, b1, c21);
+        a = _mm256_broadcast_sd(ap + 3);
+        c30 = _mm256_fmadd_pd(a, b0, c30); c31 = _mm256_fmadd_pd(a, b1, c31);
+        ap += 4;
+        bp += 8;
+    }
+
+    const __m256d va = _mm256_set1_pd(alpha);
+    double* c = C;
+    _mm256_storeu_pd(c, _mm256_fmadd_pd(va, c00, _mm256_loadu_pd(c)));
+    _mm256_storeu_pd(c + 4, _mm256_fmadd_pd(va, c01, _mm256_loadu_pd(c + 4)));
+    c += ldc;
+    _mm256_storeu_pd(c, _mm256_fmadd_pd(va, c10, _mm256_loadu_pd(c)));
+    _mm256_storeu_pd(c + 4, _mm256_fmadd_pd(va, c11, _mm256_loadu_pd(c + 4)));
+    c += ldc;
+    _mm256_storeu_pd(c, _mm256_fmadd_pd(va, c20, _mm256_loadu_pd(c)));
+    _mm256_storeu_pd(c + 4, _mm256_fmadd_pd(va, c21, _mm256_loadu_pd(c + 4)));
+    c += ldc;
+    _mm256_storeu_pd(c, _mm256_fmadd_pd(va, c30, _mm256_loadu_pd(c)));
+    _mm256_storeu_pd(c + 4, _mm256_fmadd_pd(va, c31, _mm256_loadu_pd(c + 4)));
+}
+
+SIMD_TARGET("avx2,fma")
+static inline double avx2_hsum(__m256d v) {
+    __m128d lo = _mm_add_pd(_mm256_castpd256_pd128(v), _mm256_extractf128_pd(v, 1));
+    return _mm_cvtsd_f64(_mm_add_sd(lo, _mm_unpackhi_pd(lo, lo)));
+}
+
+SIMD_TARGET("avx2,fma")
+static void avx2_gemv(int m, int n, double alpha, const double* A, int lda,
+    const double* x, double beta, double* y)
+{
+    const int n4 = n & ~3;
+    int i = 0;
+    for (; i + 4 <= m; i += 4) {
+        const double* a0 = A + (size_t)i * lda;
+        const double* a1 = a0 + lda;
+        const double* a2 = a1 + lda;
+        const double* a3 = a2 + lda;
+        __m256d c0 = _mm256_setzero_pd(), c1 = _mm256_setzero_pd();
+        __m256d c2 = _mm256_setzero_pd(), c3 = _mm256_setzero_pd();
+        for (int j = 0; j < n4; j += 4) {
+            const __m256d xv = _mm256_loadu_pd(x + j);
+            c0 = _mm256_fmadd_pd(_mm256_loadu_pd(a0 + j), xv, c0);
+            c1 = _mm256_fmadd_pd(_mm256_loadu_pd(a1 + j), xv, c1);
+            c2 = _mm256_fmadd_pd(_mm256_loadu_pd(a2 + j), xv, c2);
+            c3 = _mm256_fmadd_pd(_mm256_loadu_pd(a3 + j), xv, c3);
+        }
+        /* Reduce the four row accumulators into one vector [s0 s1 s2 s3]. */
+        const __m256d h01 = _mm256_hadd_pd(c0, c1);
+        const __m256d h23 = _mm256_hadd_pd(c2, c3);
+        __m256d sv = _mm256_add_pd(_mm256_permute2f128_pd(h01, h23, 0x20),
+                                   _mm256_permute2f128_pd(h01, h23, 0x31));
+        if (n4 < n) {
+            double t0 = 0.0, t1 = 0.0, t2 = 0.0, t3 = 0.0;
+            for (int j = n4; j < n; ++j) {
+                const double xj = x[j];
+                t0 += a0[j] * xj; t1 += a1[j] * xj; t2 += a2[j] * xj; t3 += a3[j] * xj;
+            }
+            sv = _mm256_add_pd(sv, _mm256_set_pd(t3, t2, t1, t0));
+        }
+        const __m256d va = _mm256_set1_pd(alpha);
+        if (beta == 0.0) {
+            _mm256_storeu_pd(y + i, _mm256_mul_pd(va, sv));
+        }
+        else {
+            _mm256_storeu_pd(y + i, _mm256_add_pd(_mm256_mul_pd(va, sv),
+                _mm256_mul_pd(_mm256_set1_pd(beta), _mm256_loadu_pd(y + i))));
+        }
+    }
+    for (; i < m; ++i) {
+        const double* a = A + (size_t)i * lda;
+        __m256d c = _mm256_setzero_pd();
+        for (int j = 0; j < n4; j += 4) c = _mm256_fmadd_pd(_mm256_loadu_pd(a + j), _mm256_loadu_pd(x + j), c);
+        double s0 = avx2_hsum(c);
+        for (int j = n4; j < n; ++j) s0 += a[j] * x[j];
+        y[i] = gemv_combine(alpha, s0, beta, y[i]);
+    }
+}
+
+SIMD_TARGET("avx2,fma")
+static void avx2_sgemm(int m, int n, int k, float alpha, const float* A, int lda,
+    const float* B, int ldb, float* C, int ldc)
+{
+    const int m4 = m & ~3, n16 = n & ~15;
+    const __m256 va = _mm256_set1_ps(alpha);
+    for (int j = 0; j < n16; j += 16) {
+        for (int i = 0; i < m4; i += 4) {
+            const float* a0 = A + (size_t)i * lda;
+            const float* a1 = a0 + lda;
+            const float* a2 = a1 + lda;
+            const float* a3 = a2 + lda;
+            __m256 c00 = _mm256_setzero_ps(), c01 = _mm256_setzero_ps();
+            __m256 c10 = _mm256_setzero_ps(), c11 = _mm256_setzero_ps();
+            __m256 c20 = _mm256_setzero_ps(), c21 = _mm256_setzero_ps();
+            __m256 c30 = _mm256_setzero_ps(), c31 = _mm256_setzero_ps();
+            const float* b = B + j;
+            for (int p = 0; p < k; ++p, b += ldb) {
+                const __m256 b0 = _mm256_loadu_ps(b);
+                const __m256 b1 = _mm256_loadu_ps(b + 8);
+                __m256 a = _mm256_broadcast_ss(a0 + p);
+                c00 = _mm256_fmadd_ps(a, b0, c00); c01 = _mm256_fmadd_ps(a, b1, c01);
+                a = _mm256_broadcast_ss(a1 + p);
+                c10 = _mm256_fmadd_ps(a, b0, c10); c11 = _mm256_fmadd_ps(a, b1, c11);
+                a = _mm256_broadcast_ss(a2 + p);
+                c20 = _mm256_fmadd_ps(a, b0, c20); c21 = _mm256_fmadd_ps(a, b1, c21);
+                a = _mm256_broadcast_ss(a3 + p);
+                c30 = _mm256_fmadd_ps(a, b0, c30); c31 = _mm256_fmadd_ps(a, b1, c31);
+            }
+            float* c = C + (size_t)i * ldc + j;
+            _mm256_storeu_ps(c, _mm256_fmadd_ps(va, c00, _mm256_loadu_ps(c)));
+            _mm256_storeu_ps(c + 8, _mm256_fmadd_ps(va, c01, _mm256_loadu_ps(c + 8)));
+            c += ldc;
+            _mm256_storeu_ps(c, _mm256_fmadd_ps(va, c10, _mm256_loadu_ps(c)));
+            _mm256_storeu_ps(c + 8, _mm256_fmadd_ps(va, c11, _mm256_loadu_ps(c + 8)));
+            c += ldc;
+            _mm256_storeu_ps(c, _mm256_fmadd_ps(va, c20, _mm256_loadu_ps(c)));
+            _mm256_storeu_ps(c + 8, _mm256_fmadd_ps(va, c21, _mm256_loadu_ps(c + 8)));
+            c += ldc;
+            _mm256_storeu_ps(c, _mm256_fmadd_ps(va, c30, _mm256_loadu_ps(c)));
+            _mm256_storeu_ps(c + 8, _mm256_fmadd_ps(va, c31, _mm256_loadu_ps(c + 8)));
+        }
+        for (int i = m4; i < m; ++i) {
+            const float* a = A + (size_t)i * lda;
+            __m256 c0 = _mm256_setzero_ps(), c1 = _mm256_setzero_ps();
+            const float* b = B + j;
+            for (int p = 0; p < k; ++p, b += ldb) {
+                const __m256 ap = _mm256_broadcast_ss(a + p);
+                c0 = _mm256_fmadd_ps(ap, _mm256_loadu_ps(b), c0);
+                c1 = _mm256_fmadd_ps(ap, _mm256_loadu_ps(b + 8), c1);
+            }
+            float* c = C + (size_t)i * ldc + j;
+            _mm256_storeu_ps(c, _mm256_fmadd_ps(va, c0, _mm256_loadu_ps(c)));
+            _mm256_storeu_ps(c + 8, _mm256_fmadd_ps(va, c1, _mm256_loadu_ps(c + 8)));
+        }
+    }
+    if (n16 < n) scalar_sgemm(m, n - n16, k, alpha, A, lda, B + n16, ldb, C + n16, ldc);
+}
+
+/* ---------- AVX-512F kernels ---------- */
+
+SIMD_TARGET("avx512f")
+static void avx512_fill(int n, double value, double* x) {
+    const __m512d v = _mm512_set1_pd(value);
+    int i = 0;
+    for (; i + 8 <= n; i += 8) _mm512_storeu_pd(x + i, v);
+    for (; i < n; ++i) x[i] = value;
+}
+
+SIMD_TARGET("avx512f")
+static void avx512_add(int n, const double* a, const double* b, double* out) {
+    int i = 0;
+    for (; i + 8 <= n; i += 8) _mm512_storeu_pd(out + i, _mm512_add_pd(_mm512_loadu_pd(a + i), _mm512_loadu_pd(b + i)));
+    for (; i < n; ++i) out[i] = a[i] + b[i];
+}
+
+SIMD_TARGET("avx512f")
+static void avx512_scale(int n, double alpha, double* x) {
+    const __m512d va = _mm512_set1_pd(alpha);
+    int i = 0;
+    for (; i + 8 <= n; i += 8) _mm512_storeu_pd(x + i, _mm512_mul_pd(va, _mm512_loadu_pd(x + i)));
+    for (; i < n; ++i) x[i] *= alpha;
+}
+
+SIMD_TARGET("avx512f")
+static void avx512_axpy(int n, double alpha, const double* x, double* y) {
+    const __m512d va = _mm512_set1_pd(alpha);
+    int i = 0;
+    for (; i + 8 <= n; i += 8) _mm512_storeu_pd(y + i, _mm512_add_pd(_mm512_loadu_pd(y + i), _mm512_mul_pd(va, _mm512_loadu_pd(x + i))));
+    for (; i < n; ++i) y[i] += alpha * x[i];
+}
+
+SIMD_TARGET("avx512f")
+static void avx512_gemm_micro(int kc, double alpha, const double* ap, const double* bp, double* C, int ldc) {
+    /* Two accumulator sets (even/odd p) give eight independent FMA chains,
+       enough to cover FMA latency with a single zmm per tile row. */
+    __m512d e0 = _mm512_setzero_pd(), e1 = _mm512_setzero_pd(), e2 = _mm512_setzero_pd(), e3 = _mm512_setzero_pd();
+    __m512d o0 = _mm512_setzero_pd(), o1 = _mm512_setzero_pd(), o2 = _mm512_setzero_pd(), o3 = _mm512_setzero_pd();
+
+    int p = 0;
+    for (; p + 2 <= kc; p += 2) {
+        const __m512d b0 = _mm512_loadu_pd(bp);
+        const __m512d b1 = _mm512_loadu_pd(bp + 8);
+        e0 = _mm512_fmadd_pd(_mm512_set1_pd(ap[0]), b0, e0);
+        e1 = _mm512_fmadd_pd(_mm512_set1_pd(ap[1]), b0, e1);
+        e2 = _mm512_fmadd_pd(_mm512_set1_pd(ap[2]), b0, e2);
+        e3 = _mm512_fmadd_pd(_mm512_set1_pd(ap[3]), b0, e3);
+        o0 = _mm512_fmadd_pd(_mm512_set1_pd(ap[4]), b1, o0);
+        o1 = _mm512_fmadd_pd(_mm512_set1_pd(ap[5]), b1, o1);
+        o2 = _mm512_fmadd_pd(_mm512_set1_pd(ap[6]), b1, o2);
+        o3 = _mm512_fmadd_pd(_mm512_set1_pd(ap[7]), b1, o3);
+        ap += 8;
+        bp += 16;
+    }
+    if (p < kc) {
+        const __m512d b0 = _mm512_loadu_pd(bp);
+        e0 = _mm512_fmadd_pd(_mm512_set1_pd(ap[0]), b0, e0);
+        e1 = _mm512_fmadd_pd(_mm512_set1_pd(ap[1]), b0, e1);
+        e2 = _mm512_fmadd_pd(_mm512_set1_pd(ap[2]), b0, e2);
+        e3 = _mm512_fmadd_pd(_mm512_set1_pd(ap[3]), b0, e3);
+    }
+
+    const __m512d va = _mm512_set1_pd(alpha);
+    double* c = C;
+    _mm512_storeu_pd(c, _mm512_fmadd_pd(va, _mm512_add_pd(e0, o0), _mm512_loadu_pd(c))); c += ldc;
+    _mm512_storeu_pd(c, _mm512_fmadd_pd(va, _mm512_add_pd(e1, o1), _mm512_loadu_pd(c))); c += ldc;
+    _mm512_storeu_pd(c, _mm512_fmadd_pd(va, _mm512_add_pd(e2, o2), _mm512_loadu_pd(c))); c += ldc;
+    _mm512_storeu_pd(c, _mm512_fmadd_pd(va, _mm512_add_pd(e3, o3), _mm512_loadu_pd(c)));
+}
+
+SIMD_TARGET("avx512f")
+static void avx512_gemv(int m, int n, double alpha, const double* A, int lda,
+    const double* x, double beta, double* y)
+{
+    /* The column tail is handled with a masked load, so rows need no scalar cleanup. */
+    const int n8 = n & ~7;
+    const __mmask8 tail = (__mmask8)((1u << (n - n8)) - 1u);
+    int i = 0;
+    for (; i + 4 <= m; i += 4) {
+        const double* a0 = A + (size_t)i * lda;
+        const double* a1 = a0 + lda;
+        const double* a2 = a1 + lda;
+        const double* a3 = a2 + lda;
+        __m512d c0 = _mm512_setzero_pd(), c1 = _mm512_setzero_pd();
+        __m512d c2 = _mm512_setzero_pd(), c3 = _mm512_setzero_pd();
+        for (int j = 0; j < n8; j += 8) {
+            const __m512d xv = _mm512_loadu_pd(x + j);
+            c0 = _mm512_fmadd_pd(_mm512_loadu_pd(a0 + j), xv, c0);
+            c1 = _mm512_fmadd_pd(_mm512_loadu_pd(a1 + j), xv, c1);
+            c2 = _mm512_fmadd_pd(_mm512_loadu_pd(a2 + j), xv, c2);
+            c3 = _mm512_fmadd_pd(_mm512_loadu_pd(a3 + j), xv, c3);
+        }
+        if (tail) {
+            const __m512d xv = _mm512_maskz_loadu_pd(tail, x + n8);
+            c0 = _mm512_fmadd_pd(_mm512_maskz_loadu_pd(tail, a0 + n8), xv, c0);
+            c1 = _mm512_fmadd_pd(_mm512_maskz_loadu_pd(tail, a1 + n8), xv, c1);
+            c2 = _mm512_fmadd_pd(_mm512_maskz_loadu_pd(tail, a2 + n8), xv, c2);
+            c3 = _mm512_fmadd_pd(_mm512_maskz_loadu_pd(tail, a3 + n8), xv, c3);
+        }
+        y[i + 0] = gemv_combine(alpha, _mm512_reduce_add_pd(c0), beta, y[i + 0]);
+        y[i + 1] = gemv_combine(alpha, _mm512_reduce_add_pd(c1), beta, y[i + 1]);
+        y[i + 2] = gemv_combine(alpha, _mm512_reduce_add_pd(c2), beta, y[i + 2]);
+        y[i + 3] = gemv_combine(alpha, _mm512_reduce_add_pd(c3), beta, y[i + 3]);
+    }
+    for (; i < m; ++i) {
+        const double* a = A + (size_t)i * lda;
+        __m512d c = _mm512_setzero_pd();
+        for (int j = 0; j < n8; j += 8) c = _mm512_fmadd_pd(_mm512_loadu_pd(a + j), _mm512_loadu_pd(x + j), c);
+        if (tail) c = _mm512_fmadd_pd(_mm512_maskz_loadu_pd(tail, a + n8), _mm512_maskz_loadu_pd(tail, x + n8), c);
+        y[i] = gemv_combine(alpha, _mm512_reduce_add_pd(c), beta, y[i]);
+    }
+}
+
+SIMD_TARGET("avx512f")
+static void avx512_sgemm(int m, int n, int k, float alpha, const float* A, int lda,
+    const float* B, int ldb, float* C, int ldc)
+{
+    const int m4 = m & ~3, n32 = n & ~31;
+    const __m512 va = _mm512_set1_ps(alpha);
+    for (int j = 0; j < n32; j += 32) {
+        for (int i = 0; i < m4; i += 4) {
+            const float* a0 = A + (size_t)i * lda;
+            const float* a1 = a0 + lda;
+            const float* a2 = a1 + lda;
+            const float* a3 = a2 + lda;
+            __m512 c00 = _mm512_setzero_ps(), c01 = _mm512_setzero_ps();
+            __m512 c10 = _mm512_setzero_ps(), c11 = _mm512_setzero_ps();
+            __m512 c20 = _mm512_setzero_ps(), c21 = _mm512_setzero_ps();
+            __m512 c30 = _mm512_setzero_ps(), c31 = _mm512_setzero_ps();
+            const float* b = B + j;
+            for (int p = 0; p < k; ++p, b += ldb) {
+                const __m512 b0 = _mm512_loadu_ps(b);
+                const __m512 b1 = _mm512_loadu_ps(b + 16);
+                __m512 a = _mm512_set1_ps(a0[p]);
+                c00 = _mm512_fmadd_ps(a, b0, c00); c01 = _mm512_fmadd_ps(a, b1, c01);
+                a = _mm512_set1_ps(a1[p]);
+                c10 = _mm512_fmadd_ps(a, b0, c10); c11 = _mm512_fmadd_ps(a, b1, c11);
+                a = _mm512_set1_ps(a2[p]);
+                c20 = _mm512_fmadd_ps(a, b0, c20); c21 = _mm512_fmadd_ps(a, b1, c21);
+                a = _mm512_set1_ps(a3[p]);
+                c30 = _mm512_fmadd_ps(a, b0, c30); c31 = _mm512_fmadd_ps(a, b1, c31);
+            }
+            float* c = C + (size_t)i * ldc + j;
+            _mm512_storeu_ps(c, _mm512_fmadd_ps(va, c00, _mm512_loadu_ps(c)));
+            _mm512_storeu_ps(c + 16, _mm512_fmadd_ps(va, c01, _mm512_loadu_ps(c + 16)));
+            c += ldc;
+            _mm512_storeu_ps(c, _mm512_fmadd_ps(va, c10, _mm512_loadu_ps(c)));
+            _mm512_storeu_ps(c + 16, _mm512_fmadd_ps(va, c11, _mm512_loadu_ps(c + 16)));
+            c += ldc;
+            _mm512_storeu_ps(c, _mm512_fmadd_ps(va, c20, _mm512_loadu_ps(c)));
+            _mm512_storeu_ps(c + 16, _mm512_fmadd_ps(va, c21, _mm512_loadu_ps(c + 16)));
+            c += ldc;
+            _mm512_storeu_ps(c, _mm512_fmadd_ps(va, c30, _mm512_loadu_ps(c)));
+            _mm512_storeu_ps(c + 16, _mm512_fmadd_ps(va, c31, _mm512_loadu_ps(c + 16)));
+        }
+        for (int i = m4; i < m; ++i) {
+            const float* a = A + (size_t)i * lda;
+            __m512 c0 = _mm512_setzero_ps(), c1 = _mm512_setzero_ps();
+            const float* b = B + j;
+            for (int p = 0; p < k; ++p, b += ldb) {
+                const __m512 ap = _mm512_set1_ps(a[p]);
+                c0 = _mm512_fmadd_ps(ap, _mm512_loadu_ps(b), c0);
+                c1 = _mm512_fmadd_ps(ap, _mm512_loadu_ps(b + 16), c1);
+            }
+            float* c = C + (size_t)i * ldc + j;
+            _mm512_storeu_ps(c, _mm512_fmadd_ps(va, c0, _mm512_loadu_ps(c)));
+            _mm512_storeu_ps(c + 16, _mm512_fmadd_ps(va, c1, _mm512_loadu_ps(c + 16)));
+        }
+    }
+    /* A 16-wide slab left over from the 32-wide ones still gets full vectors */
+    const int n16 = n & ~15;
+    if (n32 < n16) {
+        for (int i = 0; i < m4; i += 4) {
+            const float* a = A + (size_t)i * lda;
+            __m512 c0 = _mm512_setzero_ps(), c1 = _mm512_setzero_ps();
+            __m512 c2 = _mm512_setzero_ps(), c3 = _mm512_setzero_ps();
+            const float* b = B + n32;
+            for (int p = 0; p < k; ++p, b += ldb) {
+                const __m512 b0 = _mm512_loadu_ps(b);
+                c0 = _mm512_fmadd_ps(_mm512_set1_ps(a[p]), b0, c0);
+                c1 = _mm512_fmadd_ps(_mm512_set1_ps(a[(size_t)lda + p]), b0, c1);
+                c2 = _mm512_fmadd_ps(_mm512_set1_ps(a[(size_t)2 * lda + p]), b0, c2);
+                c3 = _mm512_fmadd_ps(_mm512_set1_ps(a[(size_t)3 * lda + p]), b0, c3);
+            }
+            float* c = C + (size_t)i * ldc + n32;
+            _mm512_storeu_ps(c, _mm512_fmadd_ps(va, c0, _mm512_loadu_ps(c))); c += ldc;
+            _mm512_storeu_ps(c, _mm512_fmadd_ps(va, c1, _mm512_loadu_ps(c))); c += ldc;
+            _mm512_storeu_ps(c, _mm512_fmadd_ps(va, c2, _mm512_loadu_ps(c))); c += ldc;
+            _mm512_storeu_ps(c, _mm512_fmadd_ps(va, c3, _mm512_loadu_ps(c)));
+        }
+        for (int i = m4; i < m; ++i) {
+            const float* a = A + (size_t)i * lda;
+            __m512 c0 = _mm512_setzero_ps();
+            const float* b = B + n32;
+            for (int p = 0; p < k; ++p, b += ldb) c0 = _mm512_fmadd_ps(_mm512_set1_ps(a[p]), _mm512_loadu_ps(b), c0);
+            float* c = C + (size_t)i * ldc + n32;
+            _mm512_storeu_ps(c, _mm512_fmadd_ps(va, c0, _mm512_loadu_ps(c)));
+        }
+    }
+    if (n16 < n) scalar_sgemm(m, n - n16, k, alpha, A, lda, B + n16, ldb, C + n16, ldc);
+}
+
+/* ---------- CPU feature detection ---------- */
+
+static void cpuid_query(unsigned leaf, unsigned subleaf, unsigned regs[4]) {
+#if defined(_MSC_VER)
+    int r[4];
+    __cpuidex(r, (int)leaf, (int)subleaf);
+    for (int i = 0; i < 4; ++i) regs[i] = (unsigned)r[i];
+#else
+    regs[0] = regs[1] = regs[2] = regs[3] = 0;
+    __cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+#endif
+}
+
+static unsigned long long xgetbv0(void) {
+#if defined(_MSC_VER)
+    return (unsigned long long)_xgetbv(0);
+#else
+    unsigned lo, hi;
+    __asm__ volatile("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+    return ((unsigned long long)hi << 32) | lo;
+#endif
+}
+
+static MatrixSimdLevel detect_x86(void) {
+    unsigned r[4];
+    cpuid_query(0, 0, r);
+    const unsigned max_leaf = r[0];
+
+    cpuid_query(1, 0, r);
+    const int has_sse2 = (r[3] >> 26) & 1;
+    const int has_fma = (r[2] >> 12) & 1;
+    const int has_osxsave = (r[2] >> 27) & 1;
+    const int has_avx = (r[2] >> 28) & 1;
+    if (!has_sse2) return MATRIX_SIMD_SCALAR;
+    if (!has_osxsave || !has_avx || max_leaf < 7) return MATRIX_SIMD_SSE2;
+
+    /* The OS must save the wider register state on context switches. */
+    const unsigned long long xcr0 = xgetbv0();
+    const int os_avx = (xcr0 & 0x6) == 0x6;            /* XMM | YMM */
+    const int os_avx512 = (xcr0 & 0xE6) == 0xE6;       /* + opmask | ZMM_Hi256 | Hi16_ZMM */
+
+    cpuid_query(7, 0, r);
+    const int has_avx2 = (r[1] >> 5) & 1;
+    const int has_avx512f = (r[1] >> 16) & 1;
+
+    if (has_avx512f && os_avx512) return MATRIX_SIMD_AVX512;
+    if (has_avx2 && has_fma && os_avx) return MATRIX_SIMD_AVX2;
+    return MATRIX_SIMD_SSE2;
+}
+
+#endif /* MATRIX_SIMD_X86 */
+
+/* ---------- Dispatch tables ---------- */
+
+static const MatrixSimdKernels SIMD_TABLES[MATRIX_SIMD_LEVEL_COUNT] = {
+    { MATRIX_SIMD_SCALAR, "scalar", scalar_fill, scalar_add, scalar_scale, scalar_axpy, scalar_gemm_micro, scalar_gemv, scalar_sgemm },
+#if MATRIX_SIMD_X86
+    { MATRIX_SIMD_SSE2,   "sse2",   sse2_fill,   sse2_add,   sse2_scale,   sse2_axpy,   sse2_gemm_micro,   sse2_gemv,   sse2_sgemm   },
+    { MATRIX_SIMD_AVX2,   "avx2",   avx2_fill,   avx2_add,   avx2_scale,   avx2_axpy,   avx2_gemm_micro,   avx2_gemv,   avx2_sgemm   },
+    { MATRIX_SIMD_AVX512, "avx512", avx512_fill, avx512_add, avx512_scale, avx512_axpy, avx512_gemm_micro, avx512_gemv, avx512_sgemm },
+#endif
+};
+
+/*
+ * Dispatch state is read by pool workers and concurrent expm callers, so it
+ * is published atomically: detection is idempotent and stored with release
+ * semantics, and the first lookup installs the detected table with a
+ * compare-exchange so it cannot overwrite a concurrent set_level().
+ */
+#if defined(_WIN32)
+#include <windows.h>
+
+static volatile LONG s_detected = MATRIX_SIMD_LEVEL_COUNT;   /* not yet detected */
+static void* volatile s_active = NULL;
+
+static MatrixSimdLevel load_detected(void) {
+    return (MatrixSimdLevel)InterlockedCompareExchange(&s_detected, 0, 0);
+}
+static void store_detected(MatrixSimdLevel level) {
+    InterlockedExchange(&s_detected, (LONG)level);
+}
+static const MatrixSimdKernels* load_active(void) {
+    return (const MatrixSimdKernels*)InterlockedCompareExchangePointer(&s_active, NULL, NULL);
+}
+static void store_active(const MatrixSimdKernels* k) {
+    InterlockedExchangePointer(&s_active, (void*)k);
+}
+static const MatrixSimdKernels* install_active(const MatrixSimdKernels* k) {
+    void* prev = InterlockedCompareExchangePointer(&s_active, (void*)k, NULL);
+    return prev ? (const MatrixSimdKernels*)prev : k;
+}
+
+#else
+
+static MatrixSimdLevel s_detected = MATRIX_SIMD_LEVEL_COUNT;   /* not yet detected */
+static const MatrixSimdKernels* s_active = NULL;
+
+static MatrixSimdLevel load_detected(void) {
+    return __atomic_load_n(&s_detected, __ATOMIC_ACQUIRE);
+}
+static void store_detected(MatrixSimdLevel level) {
+    __atomic_store_n(&s_detected, level, __ATOMIC_RELEASE);
+}
+static const MatrixSimdKernels* load_active(void) {
+    return __atomic_load_n(&s_active, __ATOMIC_ACQUIRE);
+}
+static void store_active(const MatrixSimdKernels* k) {
+    __atomic_store_n(&s_active, k, __ATOMIC_RELEASE);
+}
+static const MatrixSimdKernels* install_active(const MatrixSimdKernels* k) {
+    const MatrixSimdKernels* expected = NULL;
+    if (__atomic_compare_exchange_n(&s_active, &expected, k, 0,
+            __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+        return k;
+    }
+    return expected;
+}
+#endif
+
+MatrixSimdLevel matrix_simd_detect(void) {
+    MatrixSimdLevel level = load_detected();
+    if (level == MATRIX_SIMD_LEVEL_COUNT) {
+#if MATRIX_SIMD_X86
+        level = detect_x86();
+#else
+        level = MATRIX_SIMD_SCALAR;
+#endif
+        store_detected(level);
+    }
+    return level;
+}
+
+const MatrixSimdKernels* matrix_simd_kernels_for(MatrixSimdLevel level) {
+    if (level < MATRIX_SIMD_SCALAR || level >= MATRIX_SIMD_LEVEL_COUNT) return NULL;
+    if (level > matrix_simd_detect()) return NULL;
+    return &SIMD_TABLES[level];
+}
+
+const MatrixSimdKernels* matrix_simd_kernels(void) {
+    const MatrixSimdKernels* k = load_active();
+    if (!k) k = install_active(matrix_simd_kernels_for(matrix_simd_detect()));
+    return k;
+}
+
+MatrixSimdLevel matrix_simd_get_level(void) {
+    return matrix_simd_kernels()->level;
+}
+
+CoreErrorStatus matrix_simd_set_level(MatrixSimdLevel level) {
+    const MatrixSimdKernels* k = matrix_simd_kernels_for(level);
+    if (!k) CORE_ERROR_RETURN(CORE_ERROR_INVALID_ARG);
+    store_active(k);
+    CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
+}
@@ -0,0 +1,195 @@
+#include <math.h>
+#include "matrix_small.h"
+#include "core_error.h"
+
+/* Series terms for exp(N) with ||N||_1 <= 1: the tail after 18 terms is below
+   e / 19! ~ 2.2e-17, under half an ulp of the leading term. */
+#define EXPM_SERIES_TERMS 18
+
+typedef double Small[MATRIX_SMALL_MAX_N][MATRIX_SMALL_MAX_N];
+
+/* ---------- Internal helpers ---------- */
+
+static void load(const Matrix* M, Small out) {
+    for (int i = 0; i < M->rows; ++i) {
+        const double* r = M->data + (size_t)i * M->ld;
+        for (int j = 0; j < M->cols; ++j) out[i][j] = r[j];
+    }
+}
+
+static void store(Small in, Matrix* M) {
+    for (int i = 0; i < M->rows; ++i) {
+        double* r = M->data + (size_t)i * M->ld;
+        for (int j = 0; j < M->cols; ++j) r[j] = in[i][j];
+    }
+}
+
+static double norm_1(int n, Small a) {
+    double best = 0.0;
+    for (int j = 0; j < n; ++j) {
+        double s = 0.0;
+        for (int i = 0; i < n; ++i) s += fabs(a[i][j]);
+        if (s > best) best = s;
+    }
+    return best;
+}
+
+/* c = a * b (c must not alias a or b) */
+static void multiply(int n, Small a, Small b, Small c) {
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < n; ++j) {
+            double s = 0.0;
+            for (int k = 0; k < n; ++k) s += a[i][k] * b[k][j];
+            c[i][j] = s;
+        }
+    }
+}
+
+/* adj(A) and det(A) for n <= 3 */
+static double adjugate(int n, Small a, Small adj) {
+    switch (n) {
+    case 1:
+        adj[0][0] = 1.0;
+        return a[0][0];
+    case 2:
+        adj[0][0] = a[1][1];  adj[0][1] = -a[0][1];
+        adj[1][0] = -a[1][0]; adj[1][1] = a[0][0];
+        return a[0][0] * a[1][1] - a[0][1] * a[1][0];
+    default:
+        adj[0][0] = a[1][1] * a[2][2] - a[1][2] * a[2][1];
+        adj[0][1] = a[0][2] * a[2][1] - a[0][1] * a[2][2];
+        adj[0][2] = a[0][1] * a[1][2] - a[0][2] * a[1][1];
+        adj[1][0] = a[1][2] * a[2][0] - a[1][0] * a[2][2];
+        adj[1][1] = a[0][0] * a[2][2] - a[0][2] * a[2][0];
+        adj[1][2] = a[0][2] * a[1][0] - a[0][0] * a[1][2];
+        adj[2][0] = a[1][0] * a[2][1] - a[1][1] * a[2][0];
+        adj[2][1] = a[0][1] * a[2][0] - a[0][0] * a[2][1];
+        adj[2][2] = a[0][0] * a[1][1] - a[0][1] * a[1][0];
+        return a[0][0] * adj[0][0] + a[0][1] * adj[1][0] + a[0][2] * adj[2][0];
+    }
+}
+
+/* ---------- Public API ---------- */
+
+CoreErrorStatus matrix_small_expm(const Matrix* A, Matrix* result, int* done) {
+    if (!A || !result || !done || !A->data || !result->data) CORE_ERROR_RETURN(CORE_ERROR_NULL);
+    *done = 0;
+    if (A->rows != A->cols || result->rows != A->rows || result->cols != A->cols) {
+        CORE_ERROR_RETURN(CORE_ERROR_DIMENSION);
+    }
+    const int n = A->rows;
+    if (n > MATRIX_SMALL_MAX_N) CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
+
+    /* A = mu * I + N with tr(N) = 0; exp(A) = e^mu * exp(N) since mu*I commutes. */
+    Small N = { { 0 } };
+    load(A, N);
+    double mu = 0.0;
+    for (int i = 0; i < n; ++i) mu += N[i][i];
+    mu /= n;
+    for (int i = 0; i < n; ++i) N[i][i] -= mu;
+
+    double nrm = norm_1(n, N);
+    if (!isfinite(nrm) || !isfinite(mu)) CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
+
+    int s = 0;
+    while (nrm > MATRIX_SMALL_EXPM_THETA && s < MATRIX_SMALL_EXPM_MAX_SQUARINGS) {
+        nrm *= 0.5;
+        ++s;
+    }
+    if (nrm > MATRIX_SMALL_EXPM_THETA) CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
+    if (s > 0) {
+        const double f = ldexp(1.0, -s);
+        for (int i = 0; i < n; ++i) {
+            for (int j = 0; j < n; ++j) N[i][j] *= f;
+        }
+    }
+
+    /* Cayley-Hamilton for traceless N: N^3 = p*N + q*I, with
+       n = 3: p = tr(N^2)/2, q = det(N);  n = 2: N^2 = delta*I, so p = delta, q = 0. */
+    Small N2 = { { 0 } };
+    double p = 0.0, q = 0.0;
+    if (n == 3) {
+        Small adj;
+        multiply(n, N, N, N2);
+        p = 0.5 * (N2[0][0] + N2[1][1] + N2[2][2]);
+        q = adjugate(n, N, adj);
+    }
+    else if (n == 2) {
+        p = N[0][0] * N[0][0] + N[0][1] * N[1][0];
+        N2[0][0] = N2[1][1] = p;
+    }
+
+    /* exp(N) = sum_k N^k / k!, with N^k / k! = a*I + b*N + g*N^2 reduced by the
+       recurrence N^(k+1) = g*q*I + (a + g*p)*N + b*N^2. */
+    double a = 1.0, b = 0.0, g = 0.0;
+    double c0 = 1.0, c1 = 0.0, c2 = 0.0;
+    for (int k = 1; k <= EXPM_SERIES_TERMS; ++k) {
+        const double na = g * q / k;
+        const double nb = (a + g * p) / k;
+        const double ng = b / k;
+        a = na; b = nb; g = ng;
+        c0 += a; c1 += b; c2 += g;
+    }
+
+    Small E, T;
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < n; ++j) {
+            E[i][j] = c1 * N[i][j] + c2 * N2[i][j] + (i == j ? c0 : 0.0);
+        }
+    }
+
+    /* Undo the scaling: exp(N) = exp(N / 2^s)^(2^s) */
+    for (int k = 0; k < s; ++k) {
+        multiply(n, E, E, T);
+        for (int i = 0; i < n; ++i) {
+            for (int j = 0; j < n; ++j) E[i][j] = T[i][j];
+        }
+    }
+
+    const double emu = exp(mu);
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < n; ++j) {
+            E[i][j] *= emu;
+            if (!isfinite(E[i][j])) CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
+        }
+    }
+
+    store(E, result);
+    *done = 1;
+    CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
+}
+
+CoreErrorStatus matrix_small_solve(const Matrix* A, Matrix* X, const Matrix* B, int* done) {
+    if (!A || !X || !B || !done || !A->data || !X->data || !B->data) CORE_ERROR_RETURN(CORE_ERROR_NULL);
+    *done = 0;
+    if (A->rows != A->cols || B->rows != A->rows || X->rows != A->rows || X->cols != B->cols) {
+        CORE_ERROR_RETURN(CORE_ERROR_DIMENSION);
+    }
+    const int n = A->rows;
+    if (n > MATRIX_SMALL_MAX_N) CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
+
+    Small a = { { 0 } }, adj = { { 0 } };
+    load(A, a);
+    const double det = adjugate(n, a, adj);
+
+    /* kappa_1(A) = ||A||_1 * ||adj(A)||_1 / |det(A)|; reject singular and
+       ill-conditioned systems so LU with pivoting handles them. */
+    if (det == 0.0 || !isfinite(det)) CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
+    const double cond = norm_1(n, a) * norm_1(n, adj) / fabs(det);
+    if (!(cond <= MATRIX_SMALL_SOLVE_COND_MAX)) CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
+
+    /* Column by column: each RHS column is read before its X column is
+       written, so X may share storage with B (and A is already copied). */
+    for (int c = 0; c < B->cols; ++c) {
+        double bc[MATRIX_SMALL_MAX_N];
+        for (int i = 0; i < n; ++i) bc[i] = B->data[(size_t)i * B->ld + c];
+        for (int i = 0; i < n; ++i) {
+            double s = 0.0;
+            for (int j = 0; j < n; ++j) s += adj[i][j] * bc[j];
+            X->data[(size_t)i * X->ld + c] = s / det;
+        }
+    }
+
+    *done = 1;
+    CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
+}
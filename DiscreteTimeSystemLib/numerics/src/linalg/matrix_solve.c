@@ -1,17 +1,24 @@
 ﻿#include <math.h>
+#include <float.h>
 #include <string.h>
-#include <stdlib.h>
 #include "matrix_solve.h"
 #include "matrix_ops.h"
+#include "matrix_norm.h"
+#include "matrix_gemm.h"
+#include "matrix_trsm.h"
+#include "matrix_small.h"
+#include "matrix_blas.h"
+#include "matrix_simd.h"
 #include "core_error.h"
+#include "core_arena.h"
 
 /* ---------- Internal helpers ---------- */
 
 static inline double* row_ptr(Matrix* M, int r) {
-    return M->data + (size_t)r * (size_t)M->cols;
+    return M->data + (size_t)r * (size_t)M->ld;
 }
 static inline const double* row_ptr_c(const Matrix* M, int r) {
-    return M->data + (size_t)r * (size_t)M->cols;
+    return M->data + (size_t)r * (size_t)M->ld;
 }
 
 static void swap_rows(Matrix* M, int r1, int r2) {
@@ -24,48 +31,98 @@ static void swap_rows(Matrix* M, int r1, int r2) {
     }
 }
 
-/**
- * @brief In-place LU factorization with partial pivoting (A = P * L * U).
- * @param[in,out] A   (n x n) On entry: A. On exit: L (unit diag) & U stored in A.
- * @param[out]    piv (n)     Pivot indices; row i swapped with piv[i].
- */
-static CoreErrorStatus lu_decompose_inplace(Matrix* A, int* piv) {
-    if (!A || !A->data || !piv) CORE_ERROR_RETURN(CORE_ERROR_NULL);
-    if (A->rows <= 0 || A->cols <= 0 || A->rows != A->cols) CORE_ERROR_RETURN(CORE_ERROR_INVALID_ARG);
+/* Column count at or below which the LU recursion switches to plain loops. */
+#define LU_LEAF_COLS 16
 
-    const int n = A->rows;
-    for (int i = 0; i < n; ++i) piv[i] = i;
+/* Replay swaps piv[k0..k1) (row k <-> row piv[k]) on columns [0, ncols) of A. */
+static void swap_rows_block(double* A, int ld, const int* piv, int k0, int k1, int ncols) {
+    for (int k = k0; k < k1; ++k) {
+        const int p = piv[k];
+        if (p == k) continue;
+        double* a = A + (size_t)k * ld;
+        double* b = A + (size_t)p * ld;
+        for (int j = 0; j < ncols; ++j) {
+            double t = a[j]; a[j] = b[j]; b[j] = t;
+        }
+    }
+}
 
+/* Unblocked LU of an m x n panel (m >= n). Swaps touch only the panel's own
+   columns; the caller replays them on the rest of the matrix. */
+static CoreErrorStatus lu_leaf(double* A, int ld, int m, int n, int* piv) {
     for (int k = 0; k < n; ++k) {
-        /* pivot selection */
         int p = k;
-        double amax = fabs(row_ptr(A, k)[k]);
-        for (int r = k + 1; r < n; ++r) {
-            double v = fabs(row_ptr(A, r)[k]);
+        double amax = fabs(A[(size_t)k * ld + k]);
+        for (int r = k + 1; r < m; ++r) {
+            const double v = fabs(A[(size_t)r * ld + k]);
             if (v > amax) { amax = v; p = r; }
         }
         if (amax == 0.0) {
             CORE_ERROR_RETURN(CORE_ERROR_NUMERIC); /* singular/near-singular */
         }
-        if (p != k) {
-            swap_rows(A, p, k);
-            int tmp = piv[k]; piv[k] = piv[p]; piv[p] = tmp;
-        }
+        piv[k] = p;
+        swap_rows_block(A, ld, piv, k, k + 1, n);
 
-        double* Ak = row_ptr(A, k);
-        const double Akk = Ak[k];
-        for (int i = k + 1; i < n; ++i) {
-            double* Ai = row_ptr(A, i);
-            Ai[k] /= Akk;               /* L(i,k) */
-            const double Lik = Ai[k];
-            for (int j = k + 1; j < n; ++j) {
-                Ai[j] -= Lik * Ak[j];   /* U update */
-            }
+        const double* ak = A + (size_t)k * ld;
+        const double inv = 1.0 / ak[k];
+        for (int i = k + 1; i < m; ++i) {
+            double* ai = A + (size_t)i * ld;
+            const double lik = (ai[k] *= inv);
+            for (int j = k + 1; j < n; ++j) ai[j] -= lik * ak[j];
         }
     }
     CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
 }
 
+/*
+ * Recursive LU of an m x n panel (m >= n), column halves [A11; A21 | A12; A22]:
+ *   factor the left half, replay its swaps on the right half,
+ *   A12 <- L11^-1 * A12 (TRSM), A22 <- A22 - A21 * A12 (GEMM),
+ *   factor A22, replay its swaps on A21.
+ * Row swaps are applied once per block instead of per column, and the
+ * O(n^3) work runs in matrix_gemm_compute().
+ */
+static CoreErrorStatus lu_recursive(double* A, int ld, int m, int n, int* piv) {
+    if (n <= LU_LEAF_COLS) return lu_leaf(A, ld, m, n, piv);
+
+    const int n1 = n / 2, n2 = n - n1;
+    double* A12 = A + n1;
+    double* A21 = A + (size_t)n1 * ld;
+    double* A22 = A21 + n1;
+
+    CoreErrorStatus status = lu_recursive(A, ld, m, n1, piv);
+    if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+    swap_rows_block(A12, ld, piv, 0, n1, n2);
+
+    status = matrix_trsm_compute(MATRIX_SIDE_LEFT, MATRIX_LOWER, MATRIX_NO_TRANS, MATRIX_UNIT,
+        n1, n2, 1.0, A, ld, A12, ld);
+    if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+    status = matrix_gemm_compute(m - n1, n2, n1, -1.0, A21, ld, A12, ld, 1.0, A22, ld);
+    if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+
+    status = lu_recursive(A22, ld, m - n1, n2, piv + n1);
+    if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+    swap_rows_block(A21, ld, piv + n1, 0, n2, n1);
+    for (int k = n1; k < n; ++k) piv[k] += n1;
+
+    CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
+}
+
+/**
+ * @brief In-place LU factorization with partial pivoting (A = P * L * U).
+ * @param[in,out] A   (n x n) On entry: A. On exit: L (unit diag) & U stored in A.
+ * @param[out]    piv (n)     Pivot sequence (LAPACK style): at step k, row k was
+ *                            swapped with row piv[k] (piv[k] >= k).
+ */
+static CoreErrorStatus lu_decompose_inplace(Matrix* A, int* piv) {
+    if (!A || !A->data || !piv) CORE_ERROR_RETURN(CORE_ERROR_NULL);
+    if (A->rows <= 0 || A->cols <= 0 || A->rows != A->cols) CORE_ERROR_RETURN(CORE_ERROR_INVALID_ARG);
+
+    CoreErrorStatus status = lu_recursive(A->data, A->ld, A->rows, A->cols, piv);
+    CORE_ERROR_RETURN(status);
+}
+
+/* Replay the recorded row swaps on B, in factorization order: B <- P * B. */
 static void apply_pivots_to_rhs(Matrix* B, const int* piv) {
     const int n = B->rows;
     for (int k = 0; k < n; ++k) {
@@ -73,102 +130,522 @@ static void apply_pivots_to_rhs(Matrix* B, const int* piv) {
     }
 }
 
-static void forward_subst_L(const Matrix* LU, Matrix* B /* becomes Y */) {
-    const int n = LU->rows;
-    const int nrhs = B->cols;
-    for (int i = 0; i < n; ++i) {
-        /* subtract L(i,0..i-1)*Y(0..i-1,:) ; L has unit diagonal */
-        for (int j = 0; j < i; ++j) {
-            const double Lij = row_ptr_c(LU, i)[j];
-            if (Lij == 0.0) continue;
-            double* Bi = row_ptr(B, i);
-            const double* Bj = row_ptr_c(B, j);
-            for (int c = 0; c < nrhs; ++c) Bi[c] -= Lij * Bj[c];
-        }
+/* Undo the recorded row swaps, in reverse order: B <- P^T * B. */
+static void apply_pivots_inverse(Matrix* B, const int* piv) {
+    for (int k = B->rows - 1; k >= 0; --k) {
+        if (piv[k] != k) swap_rows(B, k, piv[k]);
     }
 }
 
-static CoreErrorStatus back_subst_U(const Matrix* LU, Matrix* Y /* becomes X */) {
-    const int n = LU->rows;
-    const int nrhs = Y->cols;
-    for (int i = n - 1; i >= 0; --i) {
-        const double Uii = row_ptr_c(LU, i)[i];
-        if (Uii == 0.0) CORE_ERROR_RETURN(CORE_ERROR_NUMERIC);
-        double* Xi = row_ptr(Y, i);
-        for (int c = 0; c < nrhs; ++c) Xi[c] /= Uii;
-        for (int r = 0; r < i; ++r) {
-            const double Uri = row_ptr_c(LU, r)[i];
-            if (Uri == 0.0) continue;
-            double* Xr = row_ptr(Y, r);
-            for (int c = 0; c < nrhs; ++c) Xr[c] -= Uri * Xi[c];
-        }
+/* Factor with LAPACK when linked (same L\U + pivot layout), else in-house. */
+static CoreErrorStatus lu_factor(Matrix* LU, int* piv) {
+    if (MATRIX_BLAS_ENABLED) {
+        CoreErrorStatus status = matrix_blas_getrf(LU->rows, LU->data, LU->ld, piv);
+        CORE_ERROR_RETURN(status);
     }
-    CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
+    CoreErrorStatus status = lu_decompose_inplace(LU, piv);
+    CORE_ERROR_RETURN(status);
+}
+
+/* X <- U^-1 * L^-1 * X for an already permuted right-hand side. */
+static CoreErrorStatus lu_substitute(const Matrix* LU, Matrix* X) {
+    const int n = LU->rows;
+    CoreErrorStatus status = matrix_trsm_compute(MATRIX_SIDE_LEFT, MATRIX_LOWER, MATRIX_NO_TRANS,
+        MATRIX_UNIT, n, X->cols, 1.0, LU->data, LU->ld, X->data, X->ld);
+    if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+    status = matrix_trsm_compute(MATRIX_SIDE_LEFT, MATRIX_UPPER, MATRIX_NO_TRANS,
+        MATRIX_NON_UNIT, n, X->cols, 1.0, LU->data, LU->ld, X->data, X->ld);
+    CORE_ERROR_RETURN(status);
+}
+
+/* X <- L^-T * U^-T * X; the caller undoes the pivots afterwards. */
+static CoreErrorStatus lu_substitute_trans(const Matrix* LU, Matrix* X) {
+    const int n = LU->rows;
+    CoreErrorStatus status = matrix_trsm_compute(MATRIX_SIDE_LEFT, MATRIX_UPPER, MATRIX_TRANS,
+        MATRIX_NON_UNIT, n, X->cols, 1.0, LU->data, LU->ld, X->data, X->ld);
+    if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+    status = matrix_trsm_compute(MATRIX_SIDE_LEFT, MATRIX_LOWER, MATRIX_TRANS,
+        MATRIX_UNIT, n, X->cols, 1.0, LU->data, LU->ld, X->data, X->ld);
+    CORE_ERROR_RETURN(status);
 }
 
 /* ---------- Public API ---------- */
-/**
- * @brief Build the U and V matrices for [m/m] Padé approximation of exp(A).
- * 1. Computes the required even powers of A (A^2, A^4, ..., A^maxp).
- * 2. Uses the given Padé coefficients ( {k even} b, {k odd} b ) to construct:
- */
-CoreErrorStatus matrix_solve_LU(const Matrix* A, Matrix* X, const Matrix* B) {
+
+CoreErrorStatus matrix_solve_LU_ws(const Matrix* A, Matrix* X, const Matrix* B,
+    Matrix* LU_ws, int* piv_ws)
+{
     if (!A || !B || !X || !A->data || !B->data || !X->data) CORE_ERROR_RETURN(CORE_ERROR_NULL);
+    if (!LU_ws || !LU_ws->data || !piv_ws) CORE_ERROR_RETURN(CORE_ERROR_NULL);
     if (A->rows <= 0 || A->cols <= 0) CORE_ERROR_RETURN(CORE_ERROR_INVALID_ARG);
     if (A->rows != A->cols) CORE_ERROR_RETURN(CORE_ERROR_INVALID_ARG);
     if (B->rows != A->rows || X->rows != A->rows) CORE_ERROR_RETURN(CORE_ERROR_INVALID_ARG);
     if (B->cols != X->cols) CORE_ERROR_RETURN(CORE_ERROR_INVALID_ARG);
+    if (LU_ws->rows != A->rows || LU_ws->cols != A->cols) CORE_ERROR_RETURN(CORE_ERROR_DIMENSION);
 
     CoreErrorStatus status = CORE_ERROR_SUCCESS;
+
+    /* 0) n <= 3 and well conditioned: Cramer's rule, no factorization */
+    int done = 0;
+    status = matrix_small_solve(A, X, B, &done);
+    if (status != CORE_ERROR_SUCCESS || done) CORE_ERROR_RETURN(status);
+
+    /* 1) Working copies: LU <- A first, then X <- B, so X may share storage with A */
+    status = matrix_ops_copy(LU_ws, A);
+    if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+    if (X != B) {
+        status = matrix_ops_copy(X, B);
+        if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+    }
+
+    /* 2) LU factorization with partial pivoting */
+    status = lu_factor(LU_ws, piv_ws);
+    if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+
+    /* 3) Apply row permutations to RHS: X = P * B */
+    apply_pivots_to_rhs(X, piv_ws);
+
+    /* 4) Solve L*Y = X (forward), then U*X = Y (backward) */
+    status = lu_substitute(LU_ws, X);
+    CORE_ERROR_RETURN(status);
+}
+
+CoreErrorStatus matrix_solve_LU(const Matrix* A, Matrix* X, const Matrix* B) {
+    if (!A || !B || !X || !A->data || !B->data || !X->data) CORE_ERROR_RETURN(CORE_ERROR_NULL);
+    if (A->rows <= 0 || A->cols <= 0) CORE_ERROR_RETURN(CORE_ERROR_INVALID_ARG);
+    if (A->rows != A->cols) CORE_ERROR_RETURN(CORE_ERROR_INVALID_ARG);
+
     const int n = A->rows;
-    const int nrhs = B->cols; (void)nrhs; /* only to silence unused if not referenced later */
+    CoreErrorStatus status = CORE_ERROR_SUCCESS;
 
-    /* 1) Working copies: LU <- A, X <- B  (matrix_ops_copy(src, dst)) */
-    Matrix* LU = matrix_core_create(n, n, &status);
-    if (status != CORE_ERROR_SUCCESS) {
-        matrix_core_free(LU);
-        CORE_ERROR_RETURN(status);
+    /* Small well-conditioned systems need no factorization (or arena) at all. */
+    if (n <= MATRIX_SMALL_MAX_N && B->rows == n && X->rows == n && B->cols == X->cols) {
+        int done = 0;
+        status = matrix_small_solve(A, X, B, &done);
+        if (status != CORE_ERROR_SUCCESS || done) CORE_ERROR_RETURN(status);
+    }
+
+    /* LU copy and pivots share one per-call arena block. */
+    MatrixArena arena;
+    status = matrix_arena_init(&arena,
+        matrix_core_bytes_in(n, n) + matrix_arena_bytes_for((size_t)n * sizeof(int)));
+    if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+
+    Matrix* LU = matrix_core_create_in(&arena, n, n, &status);
+    int* piv = NULL;
+    if (status == CORE_ERROR_SUCCESS) {
+        piv = (int*)matrix_arena_alloc(&arena, (size_t)n * sizeof(int), &status);
     }
-    status = matrix_ops_copy(LU, A);
-    if (status != CORE_ERROR_SUCCESS) {
-        matrix_core_free(LU); 
-        CORE_ERROR_RETURN(status); 
+    if (status == CORE_ERROR_SUCCESS) {
+        status = matrix_solve_LU_ws(A, X, B, LU, piv);
     }
-    status = matrix_ops_copy(X, B);
-    if (status != CORE_ERROR_SUCCESS) {
-        matrix_core_free(LU);
-        CORE_ERROR_RETURN(status); 
+
+    matrix_arena_destroy(&arena);
+    CORE_ERROR_RETURN(status);
+}
+
+/* ---------- Reusable factorization ---------- */
+
+CoreErrorStatus matrix_lu_init(LUFactor* f, Matrix* LU, int* piv) {
+    if (!f || !LU || !LU->data || !piv) CORE_ERROR_RETURN(CORE_ERROR_NULL);
+    if (LU->rows <= 0 || LU->rows != LU->cols) CORE_ERROR_RETURN(CORE_ERROR_INVALID_ARG);
+
+    f->LU = LU;
+    f->piv = piv;
+    f->n = LU->rows;
+    f->anorm = 0.0;
+    f->factored = 0;
+    CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
+}
+
+CoreErrorStatus matrix_lu_factor(LUFactor* f, const Matrix* A) {
+    if (!f || !f->LU || !f->piv || !A || !A->data) CORE_ERROR_RETURN(CORE_ERROR_NULL);
+    if (A->rows != f->n || A->cols != f->n) CORE_ERROR_RETURN(CORE_ERROR_DIMENSION);
+
+    f->factored = 0;
+    CoreErrorStatus status = matrix_norm_1(A, &f->anorm);
+    if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+    if (A != f->LU) {
+        status = matrix_ops_copy(f->LU, A);
+        if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
     }
 
-    /* 2) LU factorization with partial pivoting */
-    int* piv = (int*)malloc((size_t)n * sizeof(int));
-    if (!piv) { 
-        matrix_core_free(LU); 
-        CORE_ERROR_RETURN(CORE_ERROR_NOMEM); 
+    status = lu_factor(f->LU, f->piv);
+    if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+    f->factored = 1;
+    CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
+}
+
+CoreErrorStatus matrix_lu_solve(const LUFactor* f, MatrixTranspose trans, Matrix* X, const Matrix* B) {
+    if (!f || !X || !B || !X->data || !B->data) CORE_ERROR_RETURN(CORE_ERROR_NULL);
+    if (!f->factored) CORE_ERROR_RETURN(CORE_ERROR_INVALID_ARG);
+    if (B->rows != f->n || X->rows != f->n || B->cols != X->cols) CORE_ERROR_RETURN(CORE_ERROR_DIMENSION);
+
+    CoreErrorStatus status = CORE_ERROR_SUCCESS;
+    if (X != B) {
+        status = matrix_ops_copy(X, B);
+        if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
     }
 
-    status = lu_decompose_inplace(LU, piv);
-    if (status != CORE_ERROR_SUCCESS) {
-        free(piv);
-        matrix_core_free(LU); 
-        CORE_ERROR_RETURN(status); 
+    if (trans == MATRIX_NO_TRANS) {
+        /* A = P^T L U:  X = U^-1 L^-1 P B */
+        apply_pivots_to_rhs(X, f->piv);
+        status = lu_substitute(f->LU, X);
+    }
+    else {
+        /* A^T = U^T L^T P:  X = P^T L^-T U^-T B */
+        status = lu_substitute_trans(f->LU, X);
+        if (status == CORE_ERROR_SUCCESS) apply_pivots_inverse(X, f->piv);
     }
+    CORE_ERROR_RETURN(status);
+}
 
-    /* 3) Apply row permutations to RHS: X = P * B */
-    apply_pivots_to_rhs(X, piv);
+CoreErrorStatus matrix_lu_det(const LUFactor* f, double* det) {
+    if (!f || !det) CORE_ERROR_RETURN(CORE_ERROR_NULL);
+    if (!f->factored) CORE_ERROR_RETURN(CORE_ERROR_INVALID_ARG);
 
-    /* 4) Solve L*Y = X (forward), then U*X = Y (backward) */
-    forward_subst_L(LU, X);
-    status = back_subst_U(LU, X);
-    if (status != CORE_ERROR_SUCCESS) {
-        CORE_ERROR_RETURN(status);
+    double d = 1.0;
+    for (int k = 0; k < f->n; ++k) {
+        d *= row_ptr_c(f->LU, k)[k];
+        if (f->piv[k] != k) d = -d;
     }
+    *det = d;
+    CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
+}
 
-    free(piv);
-    status = matrix_core_free(LU);
-    if (status != CORE_ERROR_SUCCESS) {
-        CORE_ERROR_RETURN(status);
+static double vec_norm_1(const double* x, int n) {
+    double s = 0.0;
+    for (int i = 0; i < n; ++i) s += fabs(x[i]);
+    return s;
+}
+
+CoreErrorStatus matrix_lu_rcond(const LUFactor* f, double* work, double* rcond) {
+    if (!f || !work || !rcond) CORE_ERROR_RETURN(CORE_ERROR_NULL);
+    if (!f->factored) CORE_ERROR_RETURN(CORE_ERROR_INVALID_ARG);
+
+    const int n = f->n;
+    double* x = work;          /* probe / solution vector */
+    double* sgn = work + n;    /* sign pattern of the last A^-1 x */
+    MatrixView xv;
+    CoreErrorStatus status = matrix_view_of(&xv, x, n, 1, 1);
+    if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+
+    /* Hager/Higham: maximize ||A^-1 x||_1 over the unit 1-norm ball by
+       gradient steps; each step costs one solve with A and one with A^T. */
+    double est = 0.0;
+    for (int i = 0; i < n; ++i) x[i] = 1.0 / n;
+    status = matrix_lu_solve(f, MATRIX_NO_TRANS, &xv, &xv);
+    if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+    est = vec_norm_1(x, n);
+
+    if (n > 1) {
+        int j = 0;
+        for (int iter = 0; iter < 5; ++iter) {
+            if (iter > 0) {
+                for (int i = 0; i < n; ++i) x[i] = 0.0;
+                x[j] = 1.0;
+                status = matrix_lu_solve(f, MATRIX_NO_TRANS, &xv, &xv);
+                if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+
+                const double est_old = est;
+                est = vec_norm_1(x, n);
+                int same = 1;
+                for (int i = 0; i < n && same; ++i) same = ((x[i] >= 0.0 ? 1.0 : -1.0) == sgn[i]);
+                if (same || est <= est_old) {
+                    if (est < est_old) est = est_old;
+                    break;
+                }
+            }
+            for (int i = 0; i < n; ++i) x[i] = sgn[i] = (x[i] >= 0.0 ? 1.0 : -1.0);
+            status = matrix_lu_solve(f, MATRIX_TRANS, &xv, &xv);
+            if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+
+            const int j_old = j;
+            j = 0;
+            for (int i = 1; i < n; ++i) {
+                if (fabs(x[i]) > fabs(x[j])) j = i;
+            }
+            if (iter > 0 && fabs(x[j_old]) == fabs(x[j])) break;
+        }
+
+        /* Alternating probe guards against the gradient ascent stalling */
+        for (int i = 0; i < n; ++i) x[i] = ((i & 1) ? -1.0 : 1.0) * (1.0 + (double)i / (n - 1));
+        status = matrix_lu_solve(f, MATRIX_NO_TRANS, &xv, &xv);
+        if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+        const double alt = 2.0 * vec_norm_1(x, n) / (3.0 * n);
+        if (alt > est) est = alt;
+    }
+
+    *rcond = (f->anorm > 0.0 && est > 0.0) ? 1.0 / (f->anorm * est) : 0.0;
+    CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
+}
+
+/* ---------- Mixed precision (float factors, double refinement) ---------- */
+
+/* Float copy of a double block; returns 0 if an entry is outside float range. */
+static int to_float(const double* src, int lds, int rows, int cols, float* dst, int ldd) {
+    for (int i = 0; i < rows; ++i) {
+        const double* a = src + (size_t)i * lds;
+        float* f = dst + (size_t)i * ldd;
+        for (int j = 0; j < cols; ++j) {
+            if (!(fabs(a[j]) <= FLT_MAX)) return 0;
+            f[j] = (float)a[j];
+        }
+    }
+    return 1;
+}
+
+static void swap_rows_block_f(float* A, int ld, const int* piv, int k0, int k1, int ncols) {
+    for (int k = k0; k < k1; ++k) {
+        const int p = piv[k];
+        if (p == k) continue;
+        float* a = A + (size_t)k * ld;
+        float* b = A + (size_t)p * ld;
+        for (int j = 0; j < ncols; ++j) {
+            float t = a[j]; a[j] = b[j]; b[j] = t;
+        }
+    }
+}
+
+/* Single-precision lu_leaf(). */
+static CoreErrorStatus lu_leaf_f(float* A, int ld, int m, int n, int* piv) {
+    for (int k = 0; k < n; ++k) {
+        int p = k;
+        float amax = fabsf(A[(size_t)k * ld + k]);
+        for (int r = k + 1; r < m; ++r) {
+            const float v = fabsf(A[(size_t)r * ld + k]);
+            if (v > amax) { amax = v; p = r; }
+        }
+        if (amax == 0.0f) CORE_ERROR_RETURN(CORE_ERROR_NUMERIC);
+        piv[k] = p;
+        swap_rows_block_f(A, ld, piv, k, k + 1, n);
+
+        const float* ak = A + (size_t)k * ld;
+        const float inv = 1.0f / ak[k];
+        for (int i = k + 1; i < m; ++i) {
+            float* ai = A + (size_t)i * ld;
+            const float lik = (ai[k] *= inv);
+            for (int j = k + 1; j < n; ++j) ai[j] -= lik * ak[j];
+        }
+    }
+    CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
+}
+
+/* Plain substitution for trsm_lu_f(): rows of B are updated with axpys. */
+static void trsm_lu_leaf_f(int lower, int m, int n, const float* T, int ldt, float* B, int ldb) {
+    for (int s = 0; s < m; ++s) {
+        const int i = lower ? s : m - 1 - s;
+        const int k0 = lower ? 0 : i + 1;
+        const int k1 = lower ? i : m;
+        const float* ti = T + (size_t)i * ldt;
+        float* bi = B + (size_t)i * ldb;
+        if (n == 1) {
+            /* Single RHS: a dot product, split over four chains */
+            float acc[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+            int k = k0;
+            for (; k + 4 <= k1; k += 4) {
+                for (int u = 0; u < 4; ++u) acc[u] += ti[k + u] * B[(size_t)(k + u) * ldb];
+            }
+            for (; k < k1; ++k) acc[0] += ti[k] * B[(size_t)k * ldb];
+            const float x = bi[0] - ((acc[0] + acc[1]) + (acc[2] + acc[3]));
+            bi[0] = lower ? x : x / ti[i];
+            continue;
+        }
+        for (int k = k0; k < k1; ++k) {
+            const float t = ti[k];
+            const float* bk = B + (size_t)k * ldb;
+            for (int c = 0; c < n; ++c) bi[c] -= t * bk[c];
+        }
+        if (!lower) {
+            for (int c = 0; c < n; ++c) bi[c] /= ti[i];
+        }
+    }
+}
+
+/* B <- T^-1 * B with T the unit-lower (lower != 0) or upper factor of a float
+   LU; halves T and applies the off-diagonal block with the SIMD float GEMM.
+   Fewer columns than one vector tile (refinement with a few RHS) stay scalar,
+   since per-call kernel overhead would outweigh the O(m^2 n) work. */
+static void trsm_lu_f(const MatrixSimdKernels* simd, int lower, int m, int n,
+    const float* T, int ldt, float* B, int ldb)
+{
+    if (m <= LU_LEAF_COLS || n < LU_LEAF_COLS) {
+        trsm_lu_leaf_f(lower, m, n, T, ldt, B, ldb);
+        return;
+    }
+
+    const int h = m / 2;
+    const float* T22 = T + (size_t)h * ldt + h;
+    float* B2 = B + (size_t)h * ldb;
+    if (lower) {
+        trsm_lu_f(simd, lower, h, n, T, ldt, B, ldb);
+        simd->sgemm(m - h, n, h, -1.0f, T + (size_t)h * ldt, ldt, B, ldb, B2, ldb);
+        trsm_lu_f(simd, lower, m - h, n, T22, ldt, B2, ldb);
+    }
+    else {
+        trsm_lu_f(simd, lower, m - h, n, T22, ldt, B2, ldb);
+        simd->sgemm(h, n, m - h, -1.0f, T + h, ldt, B2, ldb, B, ldb);
+        trsm_lu_f(simd, lower, h, n, T, ldt, B, ldb);
     }
+}
+
+/* Single-precision lu_recursive(). */
+static CoreErrorStatus lu_recursive_f(const MatrixSimdKernels* simd, float* A, int ld, int m, int n, int* piv) {
+    if (n <= LU_LEAF_COLS) return lu_leaf_f(A, ld, m, n, piv);
+
+    const int n1 = n / 2, n2 = n - n1;
+    float* A12 = A + n1;
+    float* A21 = A + (size_t)n1 * ld;
+    float* A22 = A21 + n1;
+
+    CoreErrorStatus status = lu_recursive_f(simd, A, ld, m, n1, piv);
+    if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+    swap_rows_block_f(A12, ld, piv, 0, n1, n2);
+
+    trsm_lu_f(simd, 1, n1, n2, A, ld, A12, ld);
+    simd->sgemm(m - n1, n2, n1, -1.0f, A21, ld, A12, ld, A22, ld);
+
+    status = lu_recursive_f(simd, A22, ld, m - n1, n2, piv + n1);
+    if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+    swap_rows_block_f(A21, ld, piv + n1, 0, n2, n1);
+    for (int k = n1; k < n; ++k) piv[k] += n1;
+
+    CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
+}
+
+/* W <- A^-1 * W (n x nrhs, contiguous) from the float factors. */
+static void lu_solve_f(const MatrixSimdKernels* simd, const float* LU, const int* piv,
+    int n, int nrhs, float* W)
+{
+    swap_rows_block_f(W, nrhs, piv, 0, n, nrhs);
+    trsm_lu_f(simd, 1, n, nrhs, LU, n, W, nrhs);
+    trsm_lu_f(simd, 0, n, nrhs, LU, n, W, nrhs);
+}
+
+/* Every column of R small against its column of X (LAPACK dsgesv criterion). */
+static int mixed_converged(const double* R, const Matrix* X, double cte) {
+    const int n = X->rows, nrhs = X->cols;
+    for (int c = 0; c < nrhs; ++c) {
+        double rnrm = 0.0, xnrm = 0.0;
+        for (int i = 0; i < n; ++i) {
+            rnrm = fmax(rnrm, fabs(R[(size_t)i * nrhs + c]));
+            xnrm = fmax(xnrm, fabs(X->data[(size_t)i * X->ld + c]));
+        }
+        if (!(rnrm <= xnrm * cte)) return 0;
+    }
+    return 1;
+}
+
+/*
+ * Factor A in float, then X <- X + A^-1 (B - A X) with the residual in double
+ * until it passes mixed_converged(). *converged is 0 (and the status SUCCESS)
+ * whenever the caller should fall back to the double LU instead.
+ */
+static CoreErrorStatus mixed_refine(const Matrix* A, Matrix* X, const Matrix* B, int max_iter,
+    float* LUf, int* piv, float* Wf, double* R, int* converged, int* sweeps)
+{
+    const int n = A->rows, nrhs = B->cols;
+    const MatrixSimdKernels* simd = matrix_simd_kernels();
+    *converged = 0;
+
+    /* 1) Float factors; entries outside float range or a float-singular A mean
+          the float path cannot help */
+    if (!to_float(A->data, A->ld, n, n, LUf, n)) CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
+    CoreErrorStatus status = MATRIX_BLAS_ENABLED
+        ? matrix_blas_sgetrf(n, LUf, n, piv)
+        : lu_recursive_f(simd, LUf, n, n, n, piv);
+    if (status == CORE_ERROR_NUMERIC) CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
+    if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+
+    double anrm = 0.0;
+    status = matrix_norm_inf(A, &anrm);
+    if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+    const double cte = anrm * (DBL_EPSILON * 0.5) * sqrt((double)n);
+
+    /* 2) Initial solution from the float factors */
+    if (!to_float(B->data, B->ld, n, nrhs, Wf, nrhs)) CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
+    lu_solve_f(simd, LUf, piv, n, nrhs, Wf);
+    for (int i = 0; i < n; ++i) {
+        double* x = X->data + (size_t)i * X->ld;
+        const float* w = Wf + (size_t)i * nrhs;
+        for (int c = 0; c < nrhs; ++c) x[c] = (double)w[c];
+    }
+
+    /* 3) Refinement sweeps: residual in double, correction with the float factors */
+    for (int it = 0; ; ++it) {
+        for (int i = 0; i < n; ++i) {
+            memcpy(R + (size_t)i * nrhs, B->data + (size_t)i * B->ld, (size_t)nrhs * sizeof(double));
+        }
+        status = matrix_gemm_compute(n, nrhs, n, -1.0, A->data, A->ld, X->data, X->ld, 1.0, R, nrhs);
+        if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+        if (mixed_converged(R, X, cte)) {
+            *converged = 1;
+            *sweeps = it;
+            CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
+        }
+        if (it == max_iter) break;
 
+        if (!to_float(R, nrhs, n, nrhs, Wf, nrhs)) break;
+        lu_solve_f(simd, LUf, piv, n, nrhs, Wf);
+        for (int i = 0; i < n; ++i) {
+            double* x = X->data + (size_t)i * X->ld;
+            const float* w = Wf + (size_t)i * nrhs;
+            for (int c = 0; c < nrhs; ++c) x[c] += (double)w[c];
+        }
+    }
     CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
 }
+
+CoreErrorStatus matrix_solve_LU_mixed(const Matrix* A, Matrix* X, const Matrix* B,
+    int max_iter, int* iter)
+{
+    if (!A || !B || !X || !A->data || !B->data || !X->data) CORE_ERROR_RETURN(CORE_ERROR_NULL);
+    if (A->rows <= 0 || A->cols <= 0) CORE_ERROR_RETURN(CORE_ERROR_INVALID_ARG);
+    if (A->rows != A->cols) CORE_ERROR_RETURN(CORE_ERROR_INVALID_ARG);
+    if (B->rows != A->rows || X->rows != A->rows) CORE_ERROR_RETURN(CORE_ERROR_INVALID_ARG);
+    if (B->cols != X->cols) CORE_ERROR_RETURN(CORE_ERROR_INVALID_ARG);
+    if (max_iter < 0) CORE_ERROR_RETURN(CORE_ERROR_INVALID_ARG);
+    /* The residual needs A and B intact while X is updated */
+    if (X->data == A->data || X->data == B->data) CORE_ERROR_RETURN(CORE_ERROR_INVALID_ARG);
+    if (iter) *iter = -1;
+
+    const int n = A->rows, nrhs = B->cols;
+    CoreErrorStatus status = CORE_ERROR_SUCCESS;
+
+    /* Tiny systems have nothing to gain from float factors */
+    if (n <= MATRIX_SMALL_MAX_N) {
+        status = matrix_solve_LU(A, X, B);
+        CORE_ERROR_RETURN(status);
+    }
+
+    /* Float factors, pivots, float RHS and the double residual share one arena block. */
+    const size_t nn = (size_t)n * (size_t)n, nr = (size_t)n * (size_t)nrhs;
+    MatrixArena arena;
+    status = matrix_arena_init(&arena,
+        matrix_arena_bytes_for(nn * sizeof(float)) + matrix_arena_bytes_for((size_t)n * sizeof(int))
+        + matrix_arena_bytes_for(nr * sizeof(float)) + matrix_arena_bytes_for(nr * sizeof(double)));
+    if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+
+    float* LUf = (float*)matrix_arena_alloc(&arena, nn * sizeof(float), &status);
+    int* piv = NULL;
+    float* Wf = NULL;
+    double* R = NULL;
+    if (status == CORE_ERROR_SUCCESS) piv = (int*)matrix_arena_alloc(&arena, (size_t)n * sizeof(int), &status);
+    if (status == CORE_ERROR_SUCCESS) Wf = (float*)matrix_arena_alloc(&arena, nr * sizeof(float), &status);
+    if (status == CORE_ERROR_SUCCESS) R = (double*)matrix_arena_alloc(&arena, nr * sizeof(double), &status);
+
+    int converged = 0, sweeps = 0;
+    if (status == CORE_ERROR_SUCCESS) {
+        status = mixed_refine(A, X, B, max_iter, LUf, piv, Wf, R, &converged, &sweeps);
+    }
+    matrix_arena_destroy(&arena);
+    if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+
+    if (converged) {
+        if (iter) *iter = sweeps;
+        CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
+    }
+
+    /* Not converged within max_iter (or float range/singularity): full double LU */
+    status = matrix_solve_LU(A, X, B);
+    CORE_ERROR_RETURN(status);
+}
@@ -0,0 +1,472 @@
+#include <math.h>
+#include "matrix_sym.h"
+#include "matrix_ops.h"
+
+/* ---------- Triangle-restricted product ---------- */
+
+/*
+ * One triangle of C = alpha * op(A) * op(B)^T + beta * C, where op(X) is the
+ * n x k matrix X (trans == 0) or X^T (trans != 0). SYRK is the case B == A;
+ * the LDL^T trailing update uses B = L * D. C is halved recursively so the
+ * off-diagonal blocks are GEMMs; diagonal leaves are computed in full into a
+ * small scratch block and only their triangle is merged.
+ */
+static CoreErrorStatus tri_gemm(int lower, int trans, int n, int k, double alpha,
+    const double* A, int lda, const double* B, int ldb,
+    double beta, double* C, int ldc)
+{
+    const MatrixTranspose ta = trans ? MATRIX_TRANS : MATRIX_NO_TRANS;
+    const MatrixTranspose tb = trans ? MATRIX_NO_TRANS : MATRIX_TRANS;
+
+    if (n <= MATRIX_SYM_LEAF) {
+        /* Full diagonal block through the GEMM kernel into scratch, then
+           merge only the requested triangle into C */
+        double tmp[MATRIX_SYM_LEAF * MATRIX_SYM_LEAF];
+        CoreErrorStatus status = matrix_gemm_compute_op(ta, tb, n, n, k, alpha, A, lda, B, ldb,
+            0.0, tmp, n);
+        if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+        for (int i = 0; i < n; ++i) {
+            const int j0 = lower ? 0 : i;
+            const int j1 = lower ? i + 1 : n;
+            double* ci = C + (size_t)i * ldc;
+            const double* ti = tmp + (size_t)i * n;
+            for (int j = j0; j < j1; ++j) ci[j] = (beta == 0.0) ? ti[j] : ti[j] + beta * ci[j];
+        }
+        CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
+    }
+
+    const int h = n / 2;
+    /* Second half of op(A) / op(B): rows h.. (or columns h.. when transposed) */
+    const double* A2 = trans ? A + h : A + (size_t)h * lda;
+    const double* B2 = trans ? B + h : B + (size_t)h * ldb;
+
+    CoreErrorStatus status = tri_gemm(lower, trans, h, k, alpha, A, lda, B, ldb, beta, C, ldc);
+    if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+    if (lower) {
+        /* C21 = alpha * op(A)2 * op(B)1^T + beta * C21 */
+        status = matrix_gemm_compute_op(ta, tb, n - h, h, k, alpha, A2, lda, B, ldb,
+            beta, C + (size_t)h * ldc, ldc);
+    }
+    else {
+        /* C12 = alpha * op(A)1 * op(B)2^T + beta * C12 */
+        status = matrix_gemm_compute_op(ta, tb, h, n - h, k, alpha, A, lda, B2, ldb,
+            beta, C + h, ldc);
+    }
+    if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+    status = tri_gemm(lower, trans, n - h, k, alpha, A2, lda, B2, ldb,
+        beta, C + (size_t)h * ldc + h, ldc);
+    CORE_ERROR_RETURN(status);
+}
+
+CoreErrorStatus matrix_syrk_compute(MatrixUplo uplo, MatrixTranspose trans,
+    int n, int k, double alpha,
+    const double* A, int lda,
+    double beta,
+    double* C, int ldc)
+{
+    if (uplo != MATRIX_UPPER && uplo != MATRIX_LOWER) CORE_ERROR_RETURN(CORE_ERROR_INVALID_ARG);
+    if (trans != MATRIX_NO_TRANS && trans != MATRIX_TRANS) CORE_ERROR_RETURN(CORE_ERROR_INVALID_ARG);
+    if (n < 0 || k < 0) CORE_ERROR_RETURN(CORE_ERROR_INVALID_ARG);
+    if (n == 0) CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
+    if (!C || (k > 0 && !A)) CORE_ERROR_RETURN(CORE_ERROR_NULL);
+    if (ldc < n) CORE_ERROR_RETURN(CORE_ERROR_INVALID_ARG);
+    if (k > 0 && lda < (trans ? n : k)) CORE_ERROR_RETURN(CORE_ERROR_INVALID_ARG);
+
+    CoreErrorStatus status = tri_gemm(uplo == MATRIX_LOWER, trans == MATRIX_TRANS, n, k,
+        alpha, A, lda, A, lda, beta, C, ldc);
+    CORE_ERROR_RETURN(status);
+}
+
+/* ---------- Cholesky ---------- */
+
+/* Unblocked lower Cholesky (row-oriented Crout: every inner loop is a dot
+   product of two contiguous rows of L). */
+static CoreErrorStatus chol_leaf(double* A, int ld, int n) {
+    for (int j = 0; j < n; ++j) {
+        double* aj = A + (size_t)j * ld;
+        double d = aj[j];
+        for (int p = 0; p < j; ++p) d -= aj[p] * aj[p];
+        if (!(d > 0.0)) CORE_ERROR_RETURN(CORE_ERROR_NUMERIC); /* not positive definite */
+        const double ljj = sqrt(d);
+        aj[j] = ljj;
+        for (int i = j + 1; i < n; ++i) {
+            double* ai = A + (size_t)i * ld;
+            double s = ai[j];
+            for (int p = 0; p < j; ++p) s -= ai[p] * aj[p];
+            ai[j] = s / ljj;
+        }
+    }
+    CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
+}
+
+/*
+ * Recursive lower Cholesky, halves [A11 .; A21 A22]:
+ *   A11 = L11 L11^T, L21 = A21 L11^-T (TRSM), A22 -= L21 L21^T (SYRK),
+ *   A22 = L22 L22^T.
+ */
+static CoreErrorStatus chol_recursive(double* A, int ld, int n) {
+    if (n <= MATRIX_SYM_LEAF) return chol_leaf(A, ld, n);
+
+    const int n1 = n / 2, n2 = n - n1;
+    double* A21 = A + (size_t)n1 * ld;
+    double* A22 = A21 + n1;
+
+    CoreErrorStatus status = chol_recursive(A, ld, n1);
+    if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+    status = matrix_trsm_compute(MATRIX_SIDE_RIGHT, MATRIX_LOWER, MATRIX_TRANS, MATRIX_NON_UNIT,
+        n2, n1, 1.0, A, ld, A21, ld);
+    if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+    status = tri_gemm(1, 0, n2, n1, -1.0, A21, ld, A21, ld, 1.0, A22, ld);
+    if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+    status = chol_recursive(A22, ld, n2);
+    CORE_ERROR_RETURN(status);
+}
+
+CoreErrorStatus matrix_chol_factor(Matrix* A) {
+    if (!A || !A->data) CORE_ERROR_RETURN(CORE_ERROR_NULL);
+    if (A->rows <= 0 || A->rows != A->cols) CORE_ERROR_RETURN(CORE_ERROR_INVALID_ARG);
+
+    CoreErrorStatus status = chol_recursive(A->data, A->ld, A->rows);
+    CORE_ERROR_RETURN(status);
+}
+
+CoreErrorStatus matrix_chol_solve(const Matrix* L, Matrix* X, const Matrix* B) {
+    if (!L || !X || !B || !L->data || !X->data || !B->data) CORE_ERROR_RETURN(CORE_ERROR_NULL);
+    if (L->rows != L->cols) CORE_ERROR_RETURN(CORE_ERROR_DIMENSION);
+    if (B->rows != L->rows || X->rows != L->rows || B->cols != X->cols) CORE_ERROR_RETURN(CORE_ERROR_DIMENSION);
+
+    CoreErrorStatus status = CORE_ERROR_SUCCESS;
+    if (X != B) {
+        status = matrix_ops_copy(X, B);
+        if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+    }
+
+    /* L Y = B, then L^T X = Y */
+    const int n = L->rows;
+    status = matrix_trsm_compute(MATRIX_SIDE_LEFT, MATRIX_LOWER, MATRIX_NO_TRANS, MATRIX_NON_UNIT,
+        n, X->cols, 1.0, L->data, L->ld, X->data, X->ld);
+    if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+    status = matrix_trsm_compute(MATRIX_SIDE_LEFT, MATRIX_LOWER, MATRIX_TRANS, MATRIX_NON_UNIT,
+        n, X->cols, 1.0, L->data, L->ld, X->data, X->ld);
+    CORE_ERROR_RETURN(status);
+}
+
+/* ---------- Bunch-Kaufman LDL^T ---------- */
+
+/* Bunch-Kaufman pivot threshold (1 + sqrt(17)) / 8: bounds element growth. */
+#define BK_ALPHA 0.6403882032022076
+
+#define A_(i, j) a[(size_t)(i) * ld + (j)]
+#define W_(i, j) w[(size_t)(i) * MATRIX_LDLT_NB + (j)]
+
+static void swap_d(double* x, double* y) {
+    const double t = *x; *x = *y; *y = t;
+}
+
+/* Swap rows r1 and r2 of A over columns [0, ncols). */
+static void swap_row_prefix(double* a, int ld, int r1, int r2, int ncols) {
+    for (int j = 0; j < ncols; ++j) swap_d(&A_(r1, j), &A_(r2, j));
+}
+
+/*
+ * Unblocked Bunch-Kaufman on the lower triangle of an n x n block (LAPACK
+ * dsytf2). At step k only the trailing block k.. is permuted; columns of L
+ * already computed keep their row order, which matrix_ldlt_solve() replays.
+ */
+static CoreErrorStatus ldlt_unblocked(double* a, int ld, int n, int* piv) {
+    int k = 0;
+    while (k < n) {
+        int kstep = 1, kp = k;
+        const double absakk = fabs(A_(k, k));
+        int imax = k;
+        double colmax = 0.0;
+        for (int i = k + 1; i < n; ++i) {
+            const double v = fabs(A_(i, k));
+            if (v > colmax) { colmax = v; imax = i; }
+        }
+        if (fmax(absakk, colmax) == 0.0) CORE_ERROR_RETURN(CORE_ERROR_NUMERIC); /* singular */
+
+        if (absakk < BK_ALPHA * colmax) {
+            /* Largest off-diagonal entry in row/column imax of the trailing block */
+            double rowmax = 0.0;
+            for (int j = k; j < imax; ++j) rowmax = fmax(rowmax, fabs(A_(imax, j)));
+            for (int i = imax + 1; i < n; ++i) rowmax = fmax(rowmax, fabs(A_(i, imax)));
+
+            if (absakk >= BK_ALPHA * colmax * (colmax / rowmax)) {
+                kp = k;
+            }
+            else if (fabs(A_(imax, imax)) >= BK_ALPHA * rowmax) {
+                kp = imax;
+            }
+            else {
+                kp = imax;
+                kstep = 2;
+            }
+        }
+
+        /* Symmetric interchange of kk and kp inside the trailing block */
+        const int kk = k + kstep - 1;
+        if (kp != kk) {
+            for (int i = kp + 1; i < n; ++i) swap_d(&A_(i, kk), &A_(i, kp));
+            for (int j = kk + 1; j < kp; ++j) swap_d(&A_(j, kk), &A_(kp, j));
+            swap_d(&A_(kk, kk), &A_(kp, kp));
+            if (kstep == 2) swap_d(&A_(k + 1, k), &A_(kp, k));
+        }
+
+        if (kstep == 1) {
+            /* A22 -= x x^T / d, then x /= d (x = column k below the diagonal) */
+            const double r1 = 1.0 / A_(k, k);
+            for (int j = k + 1; j < n; ++j) {
+                const double xj = A_(j, k) * r1;
+                if (xj != 0.0) {
+                    for (int i = j; i < n; ++i) A_(i, j) -= A_(i, k) * xj;
+                }
+            }
+            for (int i = k + 1; i < n; ++i) A_(i, k) *= r1;
+            piv[k] = kp;
+        }
+        else {
+            /* A22 -= [x y] D^-1 [x y]^T with D the 2x2 block; store [x y] D^-1 */
+            if (k < n - 2) {
+                double d21 = A_(k + 1, k);
+                const double d11 = A_(k + 1, k + 1) / d21;
+                const double d22 = A_(k, k) / d21;
+                const double t = 1.0 / (d11 * d22 - 1.0);
+                d21 = t / d21;
+                for (int j = k + 2; j < n; ++j) {
+                    const double wk = d21 * (d11 * A_(j, k) - A_(j, k + 1));
+                    const double wkp1 = d21 * (d22 * A_(j, k + 1) - A_(j, k));
+                    for (int i = j; i < n; ++i) A_(i, j) -= A_(i, k) * wk + A_(i, k + 1) * wkp1;
+                    A_(j, k) = wk;
+                    A_(j, k + 1) = wkp1;
+                }
+            }
+            piv[k] = piv[k + 1] = ~kp;
+        }
+        k += kstep;
+    }
+    CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
+}
+
+/*
+ * Factor up to MATRIX_LDLT_NB - 1 leading columns of the n x n lower block
+ * (LAPACK dlasyf). Columns are updated lazily from W = L * D, the trailing
+ * block gets one A22 -= L21 * W21^T triangle update, and the row swaps made
+ * inside the panel are then undone on earlier columns so the result has the
+ * same layout as ldlt_unblocked(). *kb receives the number of columns done.
+ */
+static CoreErrorStatus ldlt_panel(double* a, int ld, int n, int* piv, double* w, int* kb) {
+    const int nb = MATRIX_LDLT_NB;
+    int k = 0;
+    while (k < n && !(k >= nb - 1 && nb < n)) {
+        /* W(k:n, k) = column k of the updated trailing matrix */
+        for (int i = k; i < n; ++i) {
+            const double* ai = &A_(i, 0);
+            const double* wk = &W_(k, 0);
+            double s = A_(i, k);
+            for (int p = 0; p < k; ++p) s -= ai[p] * wk[p];
+            W_(i, k) = s;
+        }
+
+        int kstep = 1, kp = k;
+        const double absakk = fabs(W_(k, k));
+        int imax = k;
+        double colmax = 0.0;
+        for (int i = k + 1; i < n; ++i) {
+            const double v = fabs(W_(i, k));
+            if (v > colmax) { colmax = v; imax = i; }
+        }
+        if (fmax(absakk, colmax) == 0.0) CORE_ERROR_RETURN(CORE_ERROR_NUMERIC); /* singular */
+
+        if (absakk < BK_ALPHA * colmax) {
+            /* W(k:n, k+1) = column imax of the updated trailing matrix */
+            for (int i = k; i < imax; ++i) W_(i, k + 1) = A_(imax, i);
+            for (int i = imax; i < n; ++i) W_(i, k + 1) = A_(i, imax);
+            const double* wm = &W_(imax, 0);
+            for (int i = k; i < n; ++i) {
+                const double* ai = &A_(i, 0);
+                double s = 0.0;
+                for (int p = 0; p < k; ++p) s += ai[p] * wm[p];
+                W_(i, k + 1) -= s;
+            }
+
+            double rowmax = 0.0;
+            for (int i = k; i < imax; ++i) rowmax = fmax(rowmax, fabs(W_(i, k + 1)));
+            for (int i = imax + 1; i < n; ++i) rowmax = fmax(rowmax, fabs(W_(i, k + 1)));
+
+            if (absakk >= BK_ALPHA * colmax * (colmax / rowmax)) {
+                kp = k;
+            }
+            else if (fabs(W_(imax, k + 1)) >= BK_ALPHA * rowmax) {
+                kp = imax;
+                for (int i = k; i < n; ++i) W_(i, k) = W_(i, k + 1);
+            }
+            else {
+                kp = imax;
+                kstep = 2;
+            }
+        }
+
+        const int kk = k + kstep - 1;
+        if (kp != kk) {
+            /* Move the not yet updated column kk to kp, swap rows kk/kp of the
+               finished panel columns of A and of W */
+            A_(kp, kp) = A_(kk, kk);
+            for (int j = kk + 1; j < kp; ++j) A_(kp, j) = A_(j, kk);
+            for (int i = kp + 1; i < n; ++i) A_(i, kp) = A_(i, kk);
+            swap_row_prefix(a, ld, kk, kp, kk);
+            for (int j = 0; j <= kk; ++j) swap_d(&W_(kk, j), &W_(kp, j));
+        }
+
+        if (kstep == 1) {
+            for (int i = k; i < n; ++i) A_(i, k) = W_(i, k);
+            const double r1 = 1.0 / A_(k, k);
+            for (int i = k + 1; i < n; ++i) A_(i, k) *= r1;
+            piv[k] = kp;
+        }
+        else {
+            if (k < n - 2) {
+                double d21 = W_(k + 1, k);
+                const double d11 = W_(k + 1, k + 1) / d21;
+                const double d22 = W_(k, k) / d21;
+                const double t = 1.0 / (d11 * d22 - 1.0);
+                d21 = t / d21;
+                for (int j = k + 2; j < n; ++j) {
+                    A_(j, k) = d21 * (d11 * W_(j, k) - W_(j, k + 1));
+                    A_(j, k + 1) = d21 * (d22 * W_(j, k + 1) - W_(j, k));
+                }
+            }
+            A_(k, k) = W_(k, k);
+            A_(k + 1, k) = W_(k + 1, k);
+            A_(k + 1, k + 1) = W_(k + 1, k + 1);
+            piv[k] = piv[k + 1] = ~kp;
+        }
+        k += kstep;
+    }
+    *kb = k;
+
+    /* A22 -= L21 * W21^T on the lower triangle */
+    CoreErrorStatus status = tri_gemm(1, 0, n - k, k, -1.0, &A_(k, 0), ld, &W_(k, 0), MATRIX_LDLT_NB,
+        1.0, &A_(k, k), ld);
+    if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+
+    /* Undo the swaps of each step on the columns left of that step */
+    int j = k - 1;
+    while (j > 0) {
+        const int jj = j;
+        int jp = piv[j];
+        if (jp < 0) {
+            jp = ~jp;
+            --j;
+        }
+        --j;
+        if (jp != jj && j >= 0) swap_row_prefix(a, ld, jp, jj, j + 1);
+    }
+    CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
+}
+
+CoreErrorStatus matrix_ldlt_factor(Matrix* A, int* piv, double* work) {
+    if (!A || !A->data || !piv || !work) CORE_ERROR_RETURN(CORE_ERROR_NULL);
+    if (A->rows <= 0 || A->rows != A->cols) CORE_ERROR_RETURN(CORE_ERROR_INVALID_ARG);
+
+    const int n = A->rows, ld = A->ld;
+    CoreErrorStatus status = CORE_ERROR_SUCCESS;
+    int k = 0;
+    while (k < n) {
+        double* a = A->data + (size_t)k * ld + k;
+        int kb = n - k;
+        if (n - k > MATRIX_LDLT_NB) {
+            status = ldlt_panel(a, ld, n - k, piv + k, work, &kb);
+        }
+        else {
+            status = ldlt_unblocked(a, ld, n - k, piv + k);
+        }
+        if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+
+        /* Block-local pivots -> global row indices */
+        for (int i = k; i < k + kb; ++i) piv[i] = (piv[i] >= 0) ? piv[i] + k : ~(~piv[i] + k);
+        k += kb;
+    }
+    CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
+}
+
+#undef A_
+#undef W_
+
+static void swap_rhs_rows(Matrix* X, int r1, int r2) {
+    if (r1 == r2) return;
+    double* x1 = X->data + (size_t)r1 * X->ld;
+    double* x2 = X->data + (size_t)r2 * X->ld;
+    for (int c = 0; c < X->cols; ++c) swap_d(&x1[c], &x2[c]);
+}
+
+CoreErrorStatus matrix_ldlt_solve(const Matrix* LD, const int* piv, Matrix* X, const Matrix* B) {
+    if (!LD || !piv || !X || !B || !LD->data || !X->data || !B->data) CORE_ERROR_RETURN(CORE_ERROR_NULL);
+    if (LD->rows != LD->cols) CORE_ERROR_RETURN(CORE_ERROR_DIMENSION);
+    if (B->rows != LD->rows || X->rows != LD->rows || B->cols != X->cols) CORE_ERROR_RETURN(CORE_ERROR_DIMENSION);
+
+    CoreErrorStatus status = CORE_ERROR_SUCCESS;
+    if (X != B) {
+        status = matrix_ops_copy(X, B);
+        if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+    }
+
+    const int n = LD->rows, nrhs = X->cols;
+    const size_t ld = (size_t)LD->ld, ldx = (size_t)X->ld;
+    const double* a = LD->data;
+    double* x = X->data;
+
+    /* 1) P L D Y = B, one pivot block at a time (LAPACK dsytrs) */
+    for (int k = 0; k < n; ) {
+        double* xk = x + (size_t)k * ldx;
+        if (piv[k] >= 0) {
+            swap_rhs_rows(X, k, piv[k]);
+            for (int i = k + 1; i < n; ++i) {
+                const double l = a[i * ld + k];
+                if (l == 0.0) continue;
+                double* xi = x + (size_t)i * ldx;
+                for (int c = 0; c < nrhs; ++c) xi[c] -= l * xk[c];
+            }
+            const double d = a[k * ld + k];
+            for (int c = 0; c < nrhs; ++c) xk[c] /= d;
+            k += 1;
+        }
+        else {
+            swap_rhs_rows(X, k + 1, ~piv[k]);
+            double* xk1 = xk + ldx;
+            for (int i = k + 2; i < n; ++i) {
+                const double l0 = a[i * ld + k], l1 = a[i * ld + k + 1];
+                double* xi = x + (size_t)i * ldx;
+                for (int c = 0; c < nrhs; ++c) xi[c] -= l0 * xk[c] + l1 * xk1[c];
+            }
+            /* 2x2 block [d11 d21; d21 d22], solved in the scaled form of dsytrs */
+            const double d21 = a[(k + 1) * ld + k];
+            const double d11 = a[k * ld + k] / d21;
+            const double d22 = a[(k + 1) * ld + k + 1] / d21;
+            const double denom = d11 * d22 - 1.0;
+            for (int c = 0; c < nrhs; ++c) {
+                const double b0 = xk[c] / d21, b1 = xk1[c] / d21;
+                xk[c] = (d22 * b0 - b1) / denom;
+                xk1[c] = (d11 * b1 - b0) / denom;
+            }
+            k += 2;
+        }
+    }
+
+    /* 2) L^T P^T X = Y, walking the blocks backwards */
+    for (int k = n - 1; k >= 0; ) {
+        const int k0 = (piv[k] >= 0) ? k : k - 1;    /* first row of the block */
+        for (int r = k0; r <= k; ++r) {
+            double* xr = x + (size_t)r * ldx;
+            for (int i = k + 1; i < n; ++i) {
+                const double l = a[i * ld + r];
+                if (l == 0.0) continue;
+                const double* xi = x + (size_t)i * ldx;
+                for (int c = 0; c < nrhs; ++c) xr[c] -= l * xi[c];
+            }
+        }
+        swap_rhs_rows(X, k, piv[k] >= 0 ? piv[k] : ~piv[k]);
+        k = k0 - 1;
+    }
+    CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
+}
@@ -0,0 +1,207 @@
+#include "matrix_trsm.h"
+#include "matrix_blas.h"
+
+/*
+ * Every case is reduced to "effectively lower" or "effectively upper": op(T)
+ * is lower triangular when T is lower and not transposed, or upper and
+ * transposed. Row i of op(T) starts at T + i * rs and steps by cs, with
+ * (rs, cs) = (ldt, 1), or (1, ldt) when transposed.
+ */
+
+/* op(T) * X = B for an m x m leaf; rows of B are updated with contiguous axpys. */
+static void trsm_left_leaf(int eff_lower, int trans, int unit, int m, int n,
+    const double* T, int ldt, double* B, int ldb)
+{
+    const size_t rs = trans ? 1 : (size_t)ldt;
+    const size_t cs = trans ? (size_t)ldt : 1;
+    for (int s = 0; s < m; ++s) {
+        const int i = eff_lower ? s : m - 1 - s;
+        const int k0 = eff_lower ? 0 : i + 1;
+        const int k1 = eff_lower ? i : m;
+        const double* ti = T + (size_t)i * rs;
+        double* bi = B + (size_t)i * ldb;
+        if (n == 1) {
+            double acc = bi[0];
+            for (int k = k0; k < k1; ++k) acc -= ti[(size_t)k * cs] * B[(size_t)k * ldb];
+            bi[0] = unit ? acc : acc / ti[(size_t)i * cs];
+            continue;
+        }
+        for (int k = k0; k < k1; ++k) {
+            const double t = ti[(size_t)k * cs];
+            if (t == 0.0) continue;
+            const double* bk = B + (size_t)k * ldb;
+            for (int c = 0; c < n; ++c) bi[c] -= t * bk[c];
+        }
+        if (!unit) {
+            const double d = ti[(size_t)i * cs];
+            for (int c = 0; c < n; ++c) bi[c] /= d;
+        }
+    }
+}
+
+/* X * op(T) = B for an n x n leaf, one row of B at a time. Column j of op(T)
+   is contiguous when transposed (dot form), row j otherwise (axpy form). */
+static void trsm_right_leaf(int eff_lower, int trans, int unit, int m, int n,
+    const double* T, int ldt, double* B, int ldb)
+{
+    for (int r = 0; r < m; ++r) {
+        double* b = B + (size_t)r * ldb;
+        for (int s = 0; s < n; ++s) {
+            const int j = eff_lower ? n - 1 - s : s;
+            const double* tj = T + (size_t)j * ldt;
+            const int l0 = eff_lower ? j + 1 : 0;
+            const int l1 = eff_lower ? n : j;
+            if (trans) {
+                /* x_j = (b_j - sum over solved l of x_l * T(j, l)) / T(j, j) */
+                double acc = b[j];
+                for (int l = l0; l < l1; ++l) acc -= b[l] * tj[l];
+                b[j] = unit ? acc : acc / tj[j];
+                continue;
+            }
+            if (!unit) b[j] /= tj[j];
+            const double xj = b[j];
+            if (xj == 0.0) continue;
+            /* push x_j into the unsolved entries: l on the other side of j */
+            const int u0 = eff_lower ? 0 : j + 1;
+            const int u1 = eff_lower ? j : n;
+            for (int l = u0; l < u1; ++l) b[l] -= xj * tj[l];
+        }
+    }
+}
+
+/*
+ * Left solve, T split into halves [T11 ., T21 T22] (op(T) lower) or
+ * [T11 T12; . T22] (op(T) upper): solve the leading block, fold it into the
+ * other half of B with one GEMM, then solve the trailing block.
+ */
+static CoreErrorStatus trsm_left_rec(int eff_lower, int trans, int unit, int m, int n,
+    const double* T, int ldt, double* B, int ldb)
+{
+    if (m <= MATRIX_TRSM_LEAF) {
+        trsm_left_leaf(eff_lower, trans, unit, m, n, T, ldt, B, ldb);
+        CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
+    }
+
+    const int h = m / 2;
+    const double* T22 = T + (size_t)h * ldt + h;
+    const double* T12 = T + h;
+    const double* T21 = T + (size_t)h * ldt;
+    double* B2 = B + (size_t)h * ldb;
+    const MatrixTranspose op = trans ? MATRIX_TRANS : MATRIX_NO_TRANS;
+    CoreErrorStatus status;
+
+    if (eff_lower) {
+        /* op(T)21 is T21, or T12^T when transposed */
+        status = trsm_left_rec(eff_lower, trans, unit, h, n, T, ldt, B, ldb);
+        if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+        status = matrix_gemm_compute_op(op, MATRIX_NO_TRANS, m - h, n, h,
+            -1.0, trans ? T12 : T21, ldt, B, ldb, 1.0, B2, ldb);
+        if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+        status = trsm_left_rec(eff_lower, trans, unit, m - h, n, T22, ldt, B2, ldb);
+    }
+    else {
+        status = trsm_left_rec(eff_lower, trans, unit, m - h, n, T22, ldt, B2, ldb);
+        if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+        status = matrix_gemm_compute_op(op, MATRIX_NO_TRANS, h, n, m - h,
+            -1.0, trans ? T21 : T12, ldt, B2, ldb, 1.0, B, ldb);
+        if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+        status = trsm_left_rec(eff_lower, trans, unit, h, n, T, ldt, B, ldb);
+    }
+    CORE_ERROR_RETURN(status);
+}
+
+/* Right solve: same splitting on the columns of B. */
+static CoreErrorStatus trsm_right_rec(int eff_lower, int trans, int unit, int m, int n,
+    const double* T, int ldt, double* B, int ldb)
+{
+    if (n <= MATRIX_TRSM_LEAF) {
+        trsm_right_leaf(eff_lower, trans, unit, m, n, T, ldt, B, ldb);
+        CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
+    }
+
+    const int h = n / 2;
+    const double* T22 = T + (size_t)h * ldt + h;
+    const double* T12 = T + h;
+    const double* T21 = T + (size_t)h * ldt;
+    double* B2 = B + h;
+    const MatrixTranspose op = trans ? MATRIX_TRANS : MATRIX_NO_TRANS;
+    CoreErrorStatus status;
+
+    if (eff_lower) {
+        /* X2 first, then B1 -= X2 * op(T)21 */
+        status = trsm_right_rec(eff_lower, trans, unit, m, n - h, T22, ldt, B2, ldb);
+        if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+        status = matrix_gemm_compute_op(MATRIX_NO_TRANS, op, m, h, n - h,
+            -1.0, B2, ldb, trans ? T12 : T21, ldt, 1.0, B, ldb);
+        if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+        status = trsm_right_rec(eff_lower, trans, unit, m, h, T, ldt, B, ldb);
+    }
+    else {
+        /* X1 first, then B2 -= X1 * op(T)12 */
+        status = trsm_right_rec(eff_lower, trans, unit, m, h, T, ldt, B, ldb);
+        if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+        status = matrix_gemm_compute_op(MATRIX_NO_TRANS, op, m, n - h, h,
+            -1.0, B, ldb, trans ? T21 : T12, ldt, 1.0, B2, ldb);
+        if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+        status = trsm_right_rec(eff_lower, trans, unit, m, n - h, T22, ldt, B2, ldb);
+    }
+    CORE_ERROR_RETURN(status);
+}
+
+CoreErrorStatus matrix_trsm_compute(MatrixSide side, MatrixUplo uplo,
+    MatrixTranspose trans, MatrixDiag diag,
+    int m, int n, double alpha,
+    const double* T, int ldt,
+    double* B, int ldb)
+{
+    if (side != MATRIX_SIDE_LEFT && side != MATRIX_SIDE_RIGHT) CORE_ERROR_RETURN(CORE_ERROR_INVALID_ARG);
+    if (uplo != MATRIX_UPPER && uplo != MATRIX_LOWER) CORE_ERROR_RETURN(CORE_ERROR_INVALID_ARG);
+    if (trans != MATRIX_NO_TRANS && trans != MATRIX_TRANS) CORE_ERROR_RETURN(CORE_ERROR_INVALID_ARG);
+    if (diag != MATRIX_NON_UNIT && diag != MATRIX_UNIT) CORE_ERROR_RETURN(CORE_ERROR_INVALID_ARG);
+    if (m < 0 || n < 0) CORE_ERROR_RETURN(CORE_ERROR_INVALID_ARG);
+
+    const int order = (side == MATRIX_SIDE_LEFT) ? m : n;
+    if (m == 0 || n == 0) CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
+    if (!T || !B) CORE_ERROR_RETURN(CORE_ERROR_NULL);
+    if (ldt < order || ldb < n) CORE_ERROR_RETURN(CORE_ERROR_INVALID_ARG);
+
+    if (alpha == 0.0) {
+        for (int i = 0; i < m; ++i) {
+            double* bi = B + (size_t)i * ldb;
+            for (int c = 0; c < n; ++c) bi[c] = 0.0;
+        }
+        CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
+    }
+
+    /* A zero pivot would spread inf/nan through B; report it up front instead */
+    if (diag == MATRIX_NON_UNIT) {
+        for (int i = 0; i < order; ++i) {
+            if (T[(size_t)i * ldt + i] == 0.0) CORE_ERROR_RETURN(CORE_ERROR_NUMERIC);
+        }
+    }
+
+    CoreErrorStatus status;
+    if (MATRIX_BLAS_ENABLED) {
+        const int lower = (uplo == MATRIX_LOWER);
+        const int unit = (diag == MATRIX_UNIT);
+        status = (side == MATRIX_SIDE_LEFT)
+            ? matrix_blas_trsm_left(lower, trans, unit, m, n, alpha, T, ldt, B, ldb)
+            : matrix_blas_trsm_right(lower, trans, unit, m, n, alpha, T, ldt, B, ldb);
+        CORE_ERROR_RETURN(status);
+    }
+
+    if (alpha != 1.0) {
+        for (int i = 0; i < m; ++i) {
+            double* bi = B + (size_t)i * ldb;
+            for (int c = 0; c < n; ++c) bi[c] *= alpha;
+        }
+    }
+
+    const int t = (trans == MATRIX_TRANS);
+    const int eff_lower = (uplo == MATRIX_LOWER) != t;
+    const int unit = (diag == MATRIX_UNIT);
+    status = (side == MATRIX_SIDE_LEFT)
+        ? trsm_left_rec(eff_lower, t, unit, m, n, T, ldt, B, ldb)
+        : trsm_right_rec(eff_lower, t, unit, m, n, T, ldt, B, ldb);
+    CORE_ERROR_RETURN(status);
+}
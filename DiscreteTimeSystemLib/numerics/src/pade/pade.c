@@ -7,110 +7,81 @@
 #include "matrix_norm.h"
 #include "matrix_ops.h"
 #include "matrix_solve.h"
+#include "matrix_small.h"
+#include "core_arena.h"
 
 typedef struct {
     Matrix* A2;   // may be NULL if not requested
     Matrix* A4;
     Matrix* A6;
-    Matrix* A8;
-    Matrix* A10;
-    Matrix* A12;
+    Matrix* A8;   // m = 9 only; staged in the U buffer, which is written last
 } EvenPowers;
 
 /**
- * @brief Precompute and store even powers of matrix A up to max_power.
+ * @brief Extend the even powers of matrix A in P from A^{have} up to A^{max_power}.
  *
- * This function allocates and fills matrices for A^2, A^4, ..., A^{max_power}.
- * The computed powers are stored in the EvenPowers structure `P` for later
- * reuse when building the U and V matrices in the Padé approximation.
+ * pade_select_scaling() leaves A^2 .. A^{have} in the buffers referenced by
+ * `P` (normally the power buffers of an ExpmWorkspace); this fills the ones
+ * the chosen order needs beyond them (only A^8 for m = 9 in practice). The
+ * computed powers are reused when building the U and V matrices in the
+ * Padé approximation.
  *
- * @param[in]  A          Pointer to the input matrix A (n x n).
- * @param[in]  max_power  Maximum even exponent to compute (mustatusbe positive and even).
- * @param[out] P          Pointer to an EvenPowers struct to store computed powers.
- *                        Any unneeded members may remain NULL.
+ * @param[in]     A          Pointer to the input matrix A (n x n).
+ * @param[in]     have       Highest even exponent already in P (0 if none).
+ * @param[in]     max_power  Maximum even exponent to compute (2, 4, 6 or 8).
+ * @param[in,out] P          EvenPowers whose members up to A^{max_power} are non-NULL
+ *                           n x n matrices; those above A^{have} are overwritten.
+ * @param[out]    products   Incremented by the number of products performed.
  *
- * @return CORE_ERROR_SUCCESS on success, or an error code on failure
- *         (e.g., allocation failure, invalid argument).
+ * @return CORE_ERROR_SUCCESS on success, or an error code on failure.
  *
- * @note
- * - The function will allocate matrices inside `P` only for the powers
- *   up to `max_power`.
- * - Caller mustatuscall `free_even_powers(&P)` after use to release memory.
- * - This is an internal helper and should not be declared in a header file.
+ * @note This is an internal helper and should not be declared in a header file.
  */
-static CoreErrorStatus build_even_powers(const Matrix* A, int max_power, EvenPowers* P) {
+static CoreErrorStatus build_even_powers(const Matrix* A, int have, int max_power,
+    const EvenPowers* P, int* products)
+{
     if (!A || !P) {
         return CORE_ERROR_INVALID_ARG;
     }
 
     CoreErrorStatus status = CORE_ERROR_SUCCESS;
 
-    // Allocate all elements of EvenPowers
-#define MAKE(name) \
-    do { \
-        if (max_power >= name) { \
-            P->A##name = matrix_core_create(A->rows, A->cols, &status); \
-            if (status) return status; \
-        } \
-    } while (0)
-
-    P->A2 = P->A4 = P->A6 = P->A8 = P->A10 = P->A12 = NULL;
-    MAKE(2); MAKE(4); MAKE(6); MAKE(8); MAKE(10); MAKE(12);
-#undef MAKE
-
     // A2 = A*A
-    if (max_power >= 2) {
+    if (max_power >= 2 && have < 2) {
         status = matrix_ops_multiply(P->A2, A, A); if (status) return status;
+        ++*products;
     }
     // A4 = A2*A2
-    if (max_power >= 4) {
+    if (max_power >= 4 && have < 4) {
         status = matrix_ops_multiply(P->A4, P->A2, P->A2); if (status) return status;
+        ++*products;
     }
     // A6 = A4*A2
-    if (max_power >= 6) {
+    if (max_power >= 6 && have < 6) {
         status = matrix_ops_multiply(P->A6, P->A4, P->A2); if (status) return status;
+        ++*products;
     }
     // A8 = A4*A4
-    if (max_power >= 8) {
+    if (max_power >= 8 && have < 8) {
         status = matrix_ops_multiply(P->A8, P->A4, P->A4); if (status) return status;
-    }
-    // A10 = A8*A2
-    if (max_power >= 10) {
-        status = matrix_ops_multiply(P->A10, P->A8, P->A2); if (status) return status;
-    }
-    // A12 = A6*A6
-    if (max_power >= 12) {
-        status = matrix_ops_multiply(P->A12, P->A6, P->A6); if (status) return status;
+        ++*products;
     }
 
     CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
 }
 
 /**
- * @brief Free all allocated matrices in an EvenPowers structure.
- *
- * This function releases memory for each non-NULL matrix pointer in `P`
- * (e.g., A2, A4, A6, ...) and sets the pointers to NULL.
- *
- * @param[in,out] P  Pointer to an EvenPowers structure whose members will be freed.
- *                   If P is NULL, the function does nothing.
- *
- * @return CORE_ERROR_SUCCESS always.
- *
- * @note
- * - This function does not free the EvenPowers struct itself, only the matrices it holds.
- * - Safe to call multiple times; calling on already-freed members has no effect.
- * - Intended for internal use (should be declared static in the `.c` file).
+ * @brief M = c * I without materializing a separate identity matrix.
  */
-static CoreErrorStatus free_even_powers(EvenPowers* P) {
-    if (!P) CORE_ERROR_RETURN(CORE_ERROR_NULL);
-    if (P->A2)  matrix_core_free(P->A2);
-    if (P->A4)  matrix_core_free(P->A4);
-    if (P->A6)  matrix_core_free(P->A6);
-    if (P->A8)  matrix_core_free(P->A8);
-    if (P->A10) matrix_core_free(P->A10);
-    if (P->A12) matrix_core_free(P->A12);
-    *P = (EvenPowers){ 0 };
+static CoreErrorStatus set_scaled_identity(Matrix* M, double c) {
+    if (M->rows != M->cols) CORE_ERROR_RETURN(CORE_ERROR_DIMENSION);
+    CoreErrorStatus status = matrix_ops_set_zero(M);
+    if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+
+    for (int i = 0; i < M->rows; ++i) {
+        M->data[(size_t)i * M->ld + i] = c;
+    }
+    CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
 }
 
 /**
@@ -129,19 +100,21 @@ static CoreErrorStatus free_even_powers(EvenPowers* P) {
  * @param[in]  P         Pointer to EvenPowers containing precomputed A^2, A^4, ... up to required max.
  * @param[out] U         Output matrix to hold odd-term sum.
  * @param[out] V         Output matrix to hold even-term sum.
- * @param[out] tmpS      Temporary scratch matrix for intermediate multiplications.
- * @param[in]  I         Identity matrix of same dimension as A.
+ * @param[out] tmpS      Temporary scratch matrix for the inner odd polynomial.
+ * @param[in]  B         Optional n x k block (NULL if not needed).
+ * @param[out] SB        tmpS * B when B is given (step 2.4).
  *
  * @return CORE_ERROR_SUCCESS if successful, otherwise an error code.
  * 
  * **Steps:**
  * 1. Build V = c0 * I + c2 * A^2 + c4 * A^4 + ...
- *     1.1. Calculate V = c0 * I
+ *     1.1. Write V = c0 * I directly (no identity matrix is materialized)
  *     1.2. Calculate V = c0 * I + c2 * A^2 + c4 * A^4 +  ...
  * 2. Build U = c1 * A^1 + c3 * A^3 + c5 * A^5 + ...
- *     2.1. Initialize U = c1 * A.
- *     2.2. V = c1 * I + c3 * A^2 + c5 * A^4 + ... 
- *     2.3. V = A (c1 * I + c3 * A^2 + c5 * A^4 + ...) = c1 * A^1 + c3 * A^3 + c5 * A^5 + ...
+ *     2.1. tmpS = c1 * I
+ *     2.2. tmpS = c1 * I + c3 * A^2 + c5 * A^4 + ... 
+ *     2.3. U = A * tmpS = c1 * A^1 + c3 * A^3 + c5 * A^5 + ... (one GEMM, beta = 0)
+ *     2.4. SB = tmpS * B, if B is given
  * 
  * @note
  * - Assumes all matrices are correctly allocated and sized before calling.
@@ -153,9 +126,10 @@ static CoreErrorStatus build_UV_with_powers(
     const double* b_even, int even_len,
     const double* b_odd, int odd_len,
     const EvenPowers* P,
-    Matrix* U, Matrix* V, Matrix* tmpS, Matrix* I)
+    Matrix* U, Matrix* V, Matrix* tmpS,
+    const Matrix* B, Matrix* SB)
 {
-    if (!A || !b_even || !b_odd || !P || !U || !V || !tmpS || !I) {
+    if (!A || !b_even || !b_odd || !P || !U || !V || !tmpS) {
         CORE_ERROR_RETURN(CORE_ERROR_NULL);
     }
     if (even_len <= 0 || odd_len < 0) {
@@ -174,9 +148,7 @@ static CoreErrorStatus build_UV_with_powers(
     P->A2,       // j=1 : A^2
     P->A4,       // j=2 : A^4
     P->A6,       // j=3 : A^6
-    P->A8,       // j=4 : A^8
-    P->A10,      // j=5 : A^10
-    P->A12       // j=6 : A^12
+    P->A8        // j=4 : A^8 (aliases U, read before U is written in Step 2.3)
     };
     // Maximum valid index for accessing A2k_list[]
     // (subtract 1 because index 0 is always NULL)
@@ -184,13 +156,7 @@ static CoreErrorStatus build_UV_with_powers(
         (int)(sizeof(A2k_list) / sizeof(A2k_list[0])) - 1;
 
     // --- Step 1.1 : V = c0 * I ---
-    status = matrix_ops_set_identity(I);
-    if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
-
-    status = matrix_ops_copy(V, I);
-    if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
-
-    status = matrix_ops_scale(V, b_even[0]);     
+    status = set_scaled_identity(V, b_even[0]);
     if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
 
     // ---Step 1.2: V = c0 * I + c2 * A^2 + c4 * A^4 + ... ---
@@ -207,10 +173,7 @@ static CoreErrorStatus build_UV_with_powers(
     // --- Step 2: build inner odd polynomial S = b1*I + b3*A^2 + b5*A^4 + ... ---
     if (odd_len > 0) {
         // --- Step 2.1 : tmpS = c1 * I ---
-        status = matrix_ops_copy(tmpS, I);
-        if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
-
-        status = matrix_ops_scale(tmpS, b_odd[0]);
+        status = set_scaled_identity(tmpS, b_odd[0]);
         if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
 
         // ---Step 2.2: U = c1 * I + c3 * A^2 + c5 * A^4 + ... ---
@@ -228,24 +191,30 @@ static CoreErrorStatus build_UV_with_powers(
         if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
     }
 
-    // ---Step 2.3: V = A (c1 * I + c3 * A^2 + c5 * A^4 + ...) ---
-    status = matrix_ops_multiply(U, A, tmpS);
+    // ---Step 2.3: U = A (c1 * I + c3 * A^2 + c5 * A^4 + ...) ---
+    status = matrix_ops_gemm(U, 1.0, A, MATRIX_NO_TRANS, tmpS, MATRIX_NO_TRANS, 0.0);
     if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
 
+    // ---Step 2.4: SB = (c1 * I + c3 * A^2 + ...) B ---
+    if (B) {
+        status = matrix_ops_gemm(SB, 1.0, tmpS, MATRIX_NO_TRANS, B, MATRIX_NO_TRANS, 0.0);
+        if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+    }
+
     CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
 }
 
 /**
  * @brief Get the maximum even power of A required for the given Pade order.
  *
- * This function returns the highestatuseven exponent needed when building
- * the polynomial terms \( U \) and \( V \) for a given [m/m] Pade approximation.
- * The value corresponds to the largestatus\( A^{2k} \) that mustatusbe precomputed
- * in `build_even_powers()` before constructing the approximation.
+ * This function returns the highest even exponent that `build_even_powers()`
+ * must precompute before the U and V matrices of a given [m/m] Pade
+ * approximation can be built.
  *
- * @param m   Pade order (mustatusbe one of 3, 5, 7, 9, or 13)
- * @return    The maximum even power required (2, 4, 6, 8, or 12),
- *            or -1 if the order is unsupported.
+ * @param m   Pade order (must be one of 3, 5, 7, 9, or 13)
+ * @return    The maximum even power required (2, 4, 6, 8, or 6 for m = 13,
+ *            whose higher terms are factored through A^6), or -1 if the
+ *            order is unsupported.
  *
  * @note This is a `static` internal helper; it should not be placed in a header.
  */
@@ -255,14 +224,77 @@ static int max_even_power_for_m(int m) {
     case 5:  return 4;
     case 7:  return 6;
     case 9:  return 8;
-    case 13: return 12;
+    case 13: return 6;
     default: return -1;
     }
 }
 
+/**
+ * @brief M = c0 * I + c2 * A^2 + c4 * A^4 + c6 * A^6.
+ */
+static CoreErrorStatus even_combination(Matrix* M, double c0, double c2, double c4, double c6,
+    const EvenPowers* P)
+{
+    CoreErrorStatus status = set_scaled_identity(M, c0);
+    if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+    status = matrix_ops_axpy(M, c2, P->A2);
+    if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+    status = matrix_ops_axpy(M, c4, P->A4);
+    if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+    status = matrix_ops_axpy(M, c6, P->A6);
+    CORE_ERROR_RETURN(status);
+}
+
+/**
+ * @brief Build U and V for m = 13 from A^2, A^4 and A^6 only (Higham 2005).
+ *
+ *   U = A [A^6 (b13 A^6 + b11 A^4 + b9 A^2) + b7 A^6 + b5 A^4 + b3 A^2 + b1 I]
+ *   V =    A^6 (b12 A^6 + b10 A^4 + b8 A^2) + b6 A^6 + b4 A^4 + b2 A^2 + b0 I
+ *
+ * Three products beyond the powers (six in total) instead of forming A^8,
+ * A^10 and A^12 explicitly (seven in total).
+ *
+ * **Steps:**
+ * 1. U = b13 A^6 + b11 A^4 + b9 A^2 (U is free until step 3)
+ * 2. tmpS = b7 A^6 + b5 A^4 + b3 A^2 + b1 I, then tmpS += A^6 * U
+ * 3. U = A * tmpS (and SB = tmpS * B when B is given)
+ * 4. tmpS = b12 A^6 + b10 A^4 + b8 A^2
+ * 5. V = b6 A^6 + b4 A^4 + b2 A^2 + b0 I, then V += A^6 * tmpS
+ */
+static CoreErrorStatus build_UV_m13(
+    const Matrix* A, const PadeExpTable* t, const EvenPowers* P,
+    Matrix* U, Matrix* V, Matrix* tmpS,
+    const Matrix* B, Matrix* SB)
+{
+    if (t->even_len != 7 || t->odd_len != 7) CORE_ERROR_RETURN(CORE_ERROR_INVALID_ARG);
+    const double* be = t->even;   // b0, b2, ..., b12
+    const double* bo = t->odd;    // b1, b3, ..., b13
+
+    CoreErrorStatus status = even_combination(U, 0.0, bo[4], bo[5], bo[6], P);
+    if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+    status = even_combination(tmpS, bo[0], bo[1], bo[2], bo[3], P);
+    if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+    status = matrix_ops_gemm(tmpS, 1.0, P->A6, MATRIX_NO_TRANS, U, MATRIX_NO_TRANS, 1.0);
+    if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+    status = matrix_ops_gemm(U, 1.0, A, MATRIX_NO_TRANS, tmpS, MATRIX_NO_TRANS, 0.0);
+    if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+    if (B) {
+        status = matrix_ops_gemm(SB, 1.0, tmpS, MATRIX_NO_TRANS, B, MATRIX_NO_TRANS, 0.0);
+        if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+    }
+
+    status = even_combination(tmpS, 0.0, be[4], be[5], be[6], P);
+    if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+    status = even_combination(V, be[0], be[1], be[2], be[3], P);
+    if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+    status = matrix_ops_gemm(V, 1.0, P->A6, MATRIX_NO_TRANS, tmpS, MATRIX_NO_TRANS, 1.0);
+    CORE_ERROR_RETURN(status);
+}
+
 /**
  * @brief Build the U and V matrices for [m/m] Padé approximation of exp(A).
- * 1. Computes the required even powers of A (A^2, A^4, ..., A^maxp).
+ * 1. Completes the required even powers of A (A^2, A^4, ..., A^maxp) on top of
+ *    the ones pade_select_scaling() already formed.
  * 2. Uses the given Padé coefficients ( {k even} b, {k odd} b ) to construct:
  *    - U = sum_{k odd} b_k * A^k
  *    - V = sum_{k even} b_k * A^k
@@ -276,25 +308,27 @@ static int max_even_power_for_m(int m) {
  * @param[in]  odd_len   Number of elements in b_odd (should be m).
  * @param[out] U         Output matrix to store U part of the Padé approximation.
  * @param[out] V         Output matrix to store V part of the Padé approximation.
+ * @param[in]  have      Highest even power already in P.
+ * @param[in]  P         Storage for the even powers (completed here).
  * @param[in,out] tmpS   Scratch matrix (same size as A) for temporary calculations.
- * @param[in]  I         Identity matrix of the same size as A (can be reused).
+ * @param[in]  B         Optional n x k block; NULL when only U and V are wanted.
+ * @param[out] SB        S_odd(A^2) * B, where U = A * S_odd(A^2), when B is given.
+ * @param[out] products  Incremented by the number of n x n products performed.
  *
  * @return CORE_ERROR_SUCCESS on success, otherwise an appropriate error code.
- *
- * @note The EvenPowers struct is created internally and freed before returning.
  */
 static CoreErrorStatus build_UV_for_m(
     const Matrix* A, int m,
     const double* b_even, int even_len,
     const double* b_odd, int odd_len,
+    int have, const EvenPowers* P,
     Matrix* U, Matrix* V,
-    Matrix* tmpS, Matrix* I)
+    Matrix* tmpS, const Matrix* B, Matrix* SB, int* products)
 {
     CoreErrorStatus status;
-    EvenPowers P = { 0 };
 
     // Determine the maximum even power (A^(2k)) required for the given Pade order `m`.
-    // This tells us up to which power of A we need to precompute (e.g., m=13 → A^12).
+    // This tells us up to which power of A we need to precompute (e.g., m=9 → A^8).
     // If `m` is unsupported, max_even_power_for_m() returns a negative value, so we treat it as invalid.
     const int maxp = max_even_power_for_m(m);
     if (maxp < 0) {
@@ -302,12 +336,19 @@ static CoreErrorStatus build_UV_for_m(
     }
 
     // Precompute the required even powers of matrix A up to A^maxp.
-    // Example: if maxp = 4, this generates A^2 and A^4.
+    // Example: if maxp = 4, this generates A^2 and A^4. For m = 9, A^8 is
+    // written into U, which build_UV_with_powers() only overwrites at the end.
     // The results are stored in the EvenPowers struct `P` for reuse
     // in building the Padé U and V matrices (avoids repeated multiplications).
-    status = build_even_powers(A, maxp, &P);
+    status = build_even_powers(A, have, maxp, P, products);
     if (status != CORE_ERROR_SUCCESS) {
-        free_even_powers(&P); 
+        CORE_ERROR_RETURN(status);
+    }
+
+    // m = 13 factors its high-order terms through A^6 (minimal product count).
+    if (m == 13) {
+        *products += 3;
+        status = build_UV_m13(A, pade_exp_get_table(13), P, U, V, tmpS, B, SB);
         CORE_ERROR_RETURN(status);
     }
 
@@ -316,134 +357,295 @@ static CoreErrorStatus build_UV_for_m(
     // 2. The Padé coefficients defined in pade_exp_coeffs.h (`b_even`, `b_odd`)
     // This step combines the coefficients with the precomputed powers
     // to form the final U and V matrices for the [m/m] Padé approximation.
-    status = build_UV_with_powers(A, b_even, even_len, b_odd, odd_len, &P, U, V, tmpS, I);
-
-    free_even_powers(&P);
-    return status;
+    *products += 1;
+    status = build_UV_with_powers(A, b_even, even_len, b_odd, odd_len, P, U, V, tmpS, B, SB);
+    CORE_ERROR_RETURN(status);
 }
 
-CoreErrorStatus pade_expm(const Matrix* A, Matrix* result) {
-    if (!A || !result) {
-        CORE_ERROR_RETURN(CORE_ERROR_NULL);
+/**
+ * @brief Overwrite (U, V) with (V + U, V - U) in a single fused pass.
+ *
+ * @note U and V must have the same dimensions (guaranteed by the caller).
+ */
+static void form_pade_quotient_terms(Matrix* U, Matrix* V) {
+    for (int r = 0; r < U->rows; ++r) {
+        double* u = U->data + (size_t)r * U->ld;
+        double* v = V->data + (size_t)r * V->ld;
+        for (int j = 0; j < U->cols; ++j) {
+            const double uj = u[j];
+            const double vj = v[j];
+            u[j] = vj + uj;
+            v[j] = vj - uj;
+        }
     }
+}
+
+/* Number of n x n matrices held by an ExpmWorkspace. */
+#define EXPM_WS_MATRICES 8
+
+size_t pade_expm_workspace_bytes(int n) {
+    if (n <= 0) return 0;
+    return EXPM_WS_MATRICES * matrix_core_bytes_in(n, n)
+        + matrix_arena_bytes_for((size_t)n * sizeof(int))
+        + matrix_arena_bytes_for(PADE_SCALING_WORK(n) * sizeof(double));
+}
+
+CoreErrorStatus pade_expm_workspace_init_in(ExpmWorkspace* ws, int n, MatrixArena* arena) {
+    if (!ws) CORE_ERROR_RETURN(CORE_ERROR_NULL);
+    *ws = (ExpmWorkspace){ 0 };
+    if (!arena) CORE_ERROR_RETURN(CORE_ERROR_NULL);
+    if (n <= 0) CORE_ERROR_RETURN(CORE_ERROR_INVALID_ARG);
 
-    Matrix* As = NULL;
-    Matrix* U = NULL;
-    Matrix* V = NULL;
-    Matrix* tempS = NULL;
-    Matrix* I = NULL;
-    Matrix* VminusU = NULL;
-    Matrix* VplusU = NULL;
-    Matrix* Tmp = NULL;
     CoreErrorStatus status = CORE_ERROR_SUCCESS;
+    Matrix** mats[EXPM_WS_MATRICES] = {
+        &ws->As, &ws->U, &ws->V, &ws->S,
+        &ws->A2, &ws->A4, &ws->A6,
+        &ws->LU
+    };
+    for (size_t i = 0; i < EXPM_WS_MATRICES; ++i) {
+        *mats[i] = matrix_core_create_in(arena, n, n, &status);
+        if (status != CORE_ERROR_SUCCESS) goto FAIL;
+    }
 
-    // Calculate norm
-    double anorm = 0;
-    status = matrix_norm_1(A, &anorm);
-    if (status) { CORE_ERROR_SET(status); goto CLEANUP_EARLY; }
+    ws->piv = (int*)matrix_arena_alloc(arena, (size_t)n * sizeof(int), &status);
+    if (status != CORE_ERROR_SUCCESS) goto FAIL;
+    ws->work = (double*)matrix_arena_alloc(arena, PADE_SCALING_WORK(n) * sizeof(double), &status);
+    if (status != CORE_ERROR_SUCCESS) goto FAIL;
 
-    // Determine the order of pade and the number of scaling
-    int order = 0;
-    int scale = 0;
-    pade_choose_scaling_and_order(anorm, &scale, &order);
+    ws->n = n;
+    CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
 
-    // Scale A with the scaling value.
-    As = matrix_core_create(A->rows, A->cols, &status);
-    if (status) { CORE_ERROR_SET(status); goto CLEANUP_EARLY; }
+FAIL:
+    *ws = (ExpmWorkspace){ 0 };
+    CORE_ERROR_RETURN(status);
+}
 
-    status = matrix_scale_down_pow2(A, scale, As);
-    if (status) { CORE_ERROR_SET(status); goto CLEANUP_EARLY; }
+CoreErrorStatus pade_expm_workspace_init(ExpmWorkspace* ws, int n) {
+    if (!ws) CORE_ERROR_RETURN(CORE_ERROR_NULL);
+    *ws = (ExpmWorkspace){ 0 };
+    if (n <= 0) CORE_ERROR_RETURN(CORE_ERROR_INVALID_ARG);
 
-    // Get coefficients of each, od
-    const PadeExpTable* PadeCoeffs = pade_exp_get_table(order);
+    /* Everything comes from one exactly-sized block. */
+    MatrixArena arena;
+    CoreErrorStatus status = matrix_arena_init(&arena, pade_expm_workspace_bytes(n));
+    if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
 
-    U = matrix_core_create(As->rows, As->cols, &status);
-    if (status) { CORE_ERROR_SET(status); goto CLEANUP_EARLY; }
+    status = pade_expm_workspace_init_in(ws, n, &arena);
+    if (status != CORE_ERROR_SUCCESS) {
+        matrix_arena_destroy(&arena);
+        CORE_ERROR_RETURN(status);
+    }
+    ws->own = arena;
+    CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
+}
 
-    V = matrix_core_create(As->rows, As->cols, &status);
-    if (status) { CORE_ERROR_SET(status); goto CLEANUP_EARLY; }
+CoreErrorStatus pade_expm_workspace_free(ExpmWorkspace* ws) {
+    if (!ws) CORE_ERROR_RETURN(CORE_ERROR_NULL);
+    matrix_arena_destroy(&ws->own);
+    *ws = (ExpmWorkspace){ 0 };
+    CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
+}
 
-    tempS = matrix_core_create(As->rows, As->cols, &status);
-    if (status) { CORE_ERROR_SET(status); goto CLEANUP_EARLY; }
+static CoreErrorStatus check_workspace(const ExpmWorkspace* ws, const Matrix* result) {
+    if (!ws || !result || !ws->As || !ws->LU || !ws->piv || !ws->work) CORE_ERROR_RETURN(CORE_ERROR_NULL);
+    if (result->rows != ws->n || result->cols != ws->n) CORE_ERROR_RETURN(CORE_ERROR_DIMENSION);
+    CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
+}
+
+CoreErrorStatus pade_expm_ws_inplace(ExpmWorkspace* ws, Matrix* result) {
+    CoreErrorStatus status = check_workspace(ws, result);
+    if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
 
-    I = matrix_core_create(As->rows, As->cols, &status);
-    if (status) { CORE_ERROR_SET(status); goto CLEANUP_EARLY; }
+    Matrix* As = ws->As;
+    ws->stats = (ExpmStats){ 0 };
 
-    status = build_UV_for_m(As, order,
+    // Closed form for n <= 3 whenever its accuracy guard passes
+    int done = 0;
+    status = matrix_small_expm(As, result, &done);
+    if (status) CORE_ERROR_RETURN(status);
+    if (done) CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
+
+    // Determine the order of pade and the number of scaling from the norms of
+    // A^2, A^4, A^6; the powers it formed are kept (already scaled by 2^-s).
+    PadeScaling sel;
+    status = pade_select_scaling(As, ws->A2, ws->A4, ws->A6, ws->work, &sel);
+    if (status) CORE_ERROR_RETURN(status);
+
+    // Scale A with the scaling value (in place: As <- As / 2^s).
+    status = matrix_scale_down_pow2(As, sel.s, As);
+    if (status) CORE_ERROR_RETURN(status);
+
+    status = pade_expm_ws_selected(ws, &sel, result);
+    CORE_ERROR_RETURN(status);
+}
+
+CoreErrorStatus pade_expm_ws_selected(ExpmWorkspace* ws, const PadeScaling* sel, Matrix* result) {
+    CoreErrorStatus status = check_workspace(ws, result);
+    if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+    if (!sel) CORE_ERROR_RETURN(CORE_ERROR_NULL);
+    if (!pade_exp_get_table(sel->m) || sel->s < 0) CORE_ERROR_RETURN(CORE_ERROR_INVALID_ARG);
+
+    const int order = sel->m;
+    const int scale = sel->s;
+    ws->stats = (ExpmStats){ 0 };
+
+    // Get coefficients of each, od
+    const PadeExpTable* PadeCoeffs = pade_exp_get_table(order);
+    const EvenPowers P = { ws->A2, ws->A4, ws->A6, ws->U };
+
+    int products = sel->products;
+    status = build_UV_for_m(ws->As, order,
         PadeCoeffs->even, PadeCoeffs->even_len,
         PadeCoeffs->odd, PadeCoeffs->odd_len,
-        U, V, tempS, I);
-    if (status) { CORE_ERROR_SET(status); goto CLEANUP_EARLY; }
-
-    /* ---------- 3) Form (V - U) and (V + U) ---------- */
-    VminusU = matrix_core_create(As->rows, As->cols, &status);
-    if (status) { CORE_ERROR_SET(status); goto CLEANUP_EARLY; }
-
-    VplusU = matrix_core_create(As->rows, As->cols, &status); 
-    if (status) { CORE_ERROR_SET(status); goto CLEANUP_EARLY; }
-
-    /* VminusU = V - U */
-    status = matrix_ops_copy(VminusU, V);
-    if (status) { CORE_ERROR_SET(status); goto CLEANUP_EARLY; }
-    status = matrix_ops_axpy(VminusU, -1.0, U);
-    if (status) { CORE_ERROR_SET(status); goto CLEANUP_EARLY; }
-
-    /* VplusU = V + U */
-    status = matrix_ops_copy(VplusU, V);
-    if (status) { CORE_ERROR_SET(status); goto CLEANUP_EARLY; }
-    status = matrix_ops_axpy(VplusU, 1.0, U);  
-    if (status) { CORE_ERROR_SET(status); goto CLEANUP_EARLY; }
-
-    /* ---------- 4) Solve (V - U) * X = (V + U)  via LU (no inverse) ---------- */
-    /* result: caller-provided buffer (n x n). We solve into it directly. */
-    status = matrix_solve_LU(VminusU, result, VplusU);
-    if (status) {
-        CORE_ERROR_SET(status);
-        goto CLEANUP_EARLY;
-    }
+        sel->max_power, &P, ws->U, ws->V, ws->S, NULL, NULL, &products);
+    if (status) CORE_ERROR_RETURN(status);
+
+    /* ---------- 3) Form (V - U) and (V + U) in place ----------
+       One pass over U and V: afterwards V holds V - U and U holds V + U,
+       so no extra n x n buffers are needed. */
+    form_pade_quotient_terms(ws->U, ws->V);
+
+    /* ---------- 4) Solve (V - U) * X = (V + U)  via LU (no inverse) ----------
+       The squaring loop below ping-pongs between `result` and ws->S (free again
+       once U has been formed), so X is placed in whichever buffer makes the last
+       square land in `result`. */
+    Matrix* cur = (scale % 2 == 0) ? result : ws->S;
+    Matrix* next = (cur == result) ? ws->S : result;
+
+    status = matrix_solve_LU_ws(ws->V, cur, ws->U, ws->LU, ws->piv);
+    if (status) CORE_ERROR_RETURN(status);
 
     /* ---------- 5) Undo scaling by repeated squaring: X <- X^(2^s) ----------
        Scaling-and-squaring: exp(A) = (exp(As))^(2^s)
-       Do s times: result = result * result
     ------------------------------------------------------------------------ */
-    if (scale > 0) {
-        Matrix* Tmp = matrix_core_create(result->rows, result->cols, &status);
-        if (!Tmp || status) {
-            status = status ? status : CORE_ERROR_NULL;
-            goto CLEANUP_EARLY;
-        }
+    for (int i = 0; i < scale; ++i) {
+        status = matrix_ops_multiply(next, cur, cur);
+        if (status) CORE_ERROR_RETURN(status);
 
-        for (int i = 0; i < scale; ++i) {
-            /* Tmp = result * result  */
-            status = matrix_ops_multiply(Tmp, result, result);
-            if (status) { matrix_core_free(Tmp); goto CLEANUP_EARLY; }
+        Matrix* t = cur; cur = next; next = t;
+    }
 
-            /* result <- Tmp */
-            status = matrix_ops_copy(result, Tmp);
-            if (status) { matrix_core_free(Tmp); goto CLEANUP_EARLY; }
-        }
+    ws->stats.m = order;
+    ws->stats.s = scale;
+    ws->stats.ell = sel->ell;
+    ws->stats.products = products + scale;
+    CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
+}
 
-        matrix_core_free(Tmp);
+CoreErrorStatus pade_expm_block_ws_inplace(ExpmWorkspace* ws, Matrix* B, Matrix* W,
+    Matrix* result, Matrix* F)
+{
+    CoreErrorStatus status = check_workspace(ws, result);
+    if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+    if (!B || !W || !F || !B->data || !W->data || !F->data) CORE_ERROR_RETURN(CORE_ERROR_NULL);
+    if (B->rows != ws->n || W->rows != ws->n || F->rows != ws->n) CORE_ERROR_RETURN(CORE_ERROR_DIMENSION);
+    if (B->cols < 1 || W->cols != B->cols || F->cols != B->cols) CORE_ERROR_RETURN(CORE_ERROR_DIMENSION);
+
+    Matrix* As = ws->As;
+    ws->stats = (ExpmStats){ 0 };
+
+    // Powers of M = [[A, B], [0, 0]] are [[A^k, A^(k-1) B], [0, 0]]: the order
+    // and scaling follow A, whose backward-error bounds also bound the
+    // relative error of the coupling block.
+    PadeScaling sel;
+    status = pade_select_scaling(As, ws->A2, ws->A4, ws->A6, ws->work, &sel);
+    if (status) CORE_ERROR_RETURN(status);
+    const int order = sel.m;
+    const int scale = sel.s;
+
+    status = matrix_scale_down_pow2(As, scale, As);
+    if (status) CORE_ERROR_RETURN(status);
+    status = matrix_scale_down_pow2(B, scale, B);
+    if (status) CORE_ERROR_RETURN(status);
+
+    // U and V of As, plus W = S_odd(As^2) B: the top-right block of U(M) is
+    // that, and V(M)'s cancels in the quotient below.
+    const PadeExpTable* PadeCoeffs = pade_exp_get_table(order);
+    const EvenPowers P = { ws->A2, ws->A4, ws->A6, ws->U };
+
+    int products = sel.products;
+    status = build_UV_for_m(As, order,
+        PadeCoeffs->even, PadeCoeffs->even_len,
+        PadeCoeffs->odd, PadeCoeffs->odd_len,
+        sel.max_power, &P, ws->U, ws->V, ws->S, B, W, &products);
+    if (status) CORE_ERROR_RETURN(status);
+
+    form_pade_quotient_terms(ws->U, ws->V);
+
+    /* (V - U)(M) X = (V + U)(M) is block upper triangular with b0 I in the
+       bottom-right of both sides, so X = [[X11, X12], [0, I]] with
+       X11 = (V - U)^-1 (V + U) and X12 = (V - U)^-1 (2 W): one LU of order n.
+       Both blocks are placed so the last squaring lands in result / F. */
+    Matrix* cur = (scale % 2 == 0) ? result : ws->S;
+    Matrix* next = (cur == result) ? ws->S : result;
+    Matrix* cur12 = (scale % 2 == 0) ? F : W;
+    Matrix* next12 = (cur12 == F) ? W : F;
+
+    LUFactor lu;
+    status = matrix_lu_init(&lu, ws->LU, ws->piv);
+    if (status) CORE_ERROR_RETURN(status);
+    status = matrix_lu_factor(&lu, ws->V);
+    if (status) CORE_ERROR_RETURN(status);
+    status = matrix_lu_solve(&lu, MATRIX_NO_TRANS, cur, ws->U);
+    if (status) CORE_ERROR_RETURN(status);
+    status = matrix_ops_scale(W, 2.0);
+    if (status) CORE_ERROR_RETURN(status);
+    status = matrix_lu_solve(&lu, MATRIX_NO_TRANS, cur12, W);
+    if (status) CORE_ERROR_RETURN(status);
+
+    /* X^2 = [[X11^2, X11 X12 + X12], [0, I]]: the zero and identity blocks
+       are never touched, so a squaring costs n^2 (n + k) instead of (n + k)^3 */
+    for (int i = 0; i < scale; ++i) {
+        status = matrix_ops_copy(next12, cur12);
+        if (status) CORE_ERROR_RETURN(status);
+        status = matrix_ops_gemm(next12, 1.0, cur, MATRIX_NO_TRANS, cur12, MATRIX_NO_TRANS, 1.0);
+        if (status) CORE_ERROR_RETURN(status);
+        status = matrix_ops_multiply(next, cur, cur);
+        if (status) CORE_ERROR_RETURN(status);
+
+        Matrix* t = cur; cur = next; next = t;
+        t = cur12; cur12 = next12; next12 = t;
     }
 
-    /* ---------- 6) Success / cleanup ---------- */
-    matrix_core_free(As);
-    matrix_core_free(U);
-    matrix_core_free(V);
-    matrix_core_free(tempS);
-    matrix_core_free(I);
-    matrix_core_free(VminusU);
-    matrix_core_free(VplusU);
+    ws->stats.m = order;
+    ws->stats.s = scale;
+    ws->stats.ell = sel.ell;
+    ws->stats.products = products + scale;
     CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
+}
 
-CLEANUP_EARLY:
-    if (As)      matrix_core_free(As);
-    if (U)       matrix_core_free(U);
-    if (V)       matrix_core_free(V);
-    if (tempS)    matrix_core_free(tempS);
-    if (I)       matrix_core_free(I);
-    if (VminusU) matrix_core_free(VminusU);
-    if (VplusU)  matrix_core_free(VplusU);
-    return status;
+CoreErrorStatus pade_expm_ws(const Matrix* A, ExpmWorkspace* ws, Matrix* result) {
+    if (!A || !ws || !result) {
+        CORE_ERROR_RETURN(CORE_ERROR_NULL);
+    }
+    if (A->rows != A->cols || A->rows != ws->n) {
+        CORE_ERROR_RETURN(CORE_ERROR_DIMENSION);
+    }
+
+    CoreErrorStatus status = check_workspace(ws, result);
+    if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+
+    status = matrix_ops_copy(ws->As, A);
+    if (status) CORE_ERROR_RETURN(status);
+
+    status = pade_expm_ws_inplace(ws, result);
+    CORE_ERROR_RETURN(status);
 }
 
+CoreErrorStatus pade_expm(const Matrix* A, Matrix* result) {
+    if (!A || !result) {
+        CORE_ERROR_RETURN(CORE_ERROR_NULL);
+    }
+    if (A->rows != A->cols) {
+        CORE_ERROR_RETURN(CORE_ERROR_DIMENSION);
+    }
+
+    ExpmWorkspace ws;
+    CoreErrorStatus status = pade_expm_workspace_init(&ws, A->rows);
+    if (status) CORE_ERROR_RETURN(status);
+
+    status = pade_expm_ws(A, &ws, result);
+
+    pade_expm_workspace_free(&ws);
+    CORE_ERROR_RETURN(status);
+}
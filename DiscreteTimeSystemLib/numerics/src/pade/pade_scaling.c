@@ -6,6 +6,7 @@
 #include "matrix_ops.h"
 #include <math.h>
 #include <float.h>
+#include <stddef.h>
 
 /* Higham-style theta_m thresholds (double precision) for m = 3,5,7,9,13.
    These are widely used in expm implementations. */
@@ -98,6 +99,364 @@ CoreErrorStatus pade_choose_scaling_and_order(double anorm, int* out_s, int* out
     CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
 }
 
+/* Al-Mohy & Higham (2009), Table 3.1: theta_m for m = 3, 5, 7, 9 as above;
+   theta_13 is lowered to 4.25 because ell() now guards the backward error. */
+#define PADE_THETA13_2009 4.25
+
+/* |c_{2m+1}|^{-1}: reciprocal of the leading coefficient of the backward-error
+   series h_{2m+1}(x) of the [m/m] approximant (2009, eq. (5.1)). */
+static double ell_coeff_recip(int m) {
+    switch (m) {
+    case 3:  return 100800.0;
+    case 5:  return 10059033600.0;
+    case 7:  return 4487938430976000.0;
+    case 9:  return 5914384781877411840000.0;
+    default: return 113250775606021113483283660800000000.0;   /* m = 13 */
+    }
+}
+
+static double theta_for(int m) {
+    const int N = (int)(sizeof(PADE_THETA) / sizeof(PADE_THETA[0]));
+    for (int i = 0; i < N; ++i) {
+        if (PADE_THETA[i].m == m) return PADE_THETA[i].theta;
+    }
+    return 0.0;
+}
+
+/**
+ * @brief log2 || |A|^p ||_1, exactly, for ascending p[0] < ... < p[count-1].
+ *
+ * |A|^p is nonnegative, so its largest column sum is the largest entry of
+ * e^T |A|^p. Rows of A are streamed once per step; the vector is renormalized
+ * every step so no power overflows, and every p on the way is read off the
+ * same sequence. out[i] is -HUGE_VAL if the power is zero.
+ */
+static void log2_abs_power_norms(const Matrix* A, const int* p, int count, double* work,
+    double* out)
+{
+    const int n = A->rows;
+    double* v = work;
+    double* y = work + n;
+    double log2_norm = 0.0;
+    int next = 0;
+
+    for (int j = 0; j < n; ++j) v[j] = 1.0;
+    for (int step = 1; next < count; ++step) {
+        for (int j = 0; j < n; ++j) y[j] = 0.0;
+        for (int i = 0; i < n; ++i) {
+            const double vi = v[i];
+            if (vi == 0.0) continue;
+            const double* ai = A->data + (size_t)i * A->ld;
+            for (int j = 0; j < n; ++j) y[j] += fabs(ai[j]) * vi;
+        }
+        double mx = 0.0;
+        for (int j = 0; j < n; ++j) mx = fmax(mx, y[j]);
+        if (mx == 0.0) {
+            while (next < count) out[next++] = -HUGE_VAL;
+            return;
+        }
+        for (int j = 0; j < n; ++j) v[j] = y[j] / mx;
+        log2_norm += log2(mx);
+        if (step == p[next]) out[next++] = log2_norm;
+    }
+}
+
+static double log2_abs_power_norm(const Matrix* A, int p, double* work) {
+    double out = 0.0;
+    log2_abs_power_norms(A, &p, 1, work, &out);
+    return out;
+}
+
+/**
+ * @brief ell(2^-s A, m): extra squarings keeping the backward error below u.
+ *
+ * alpha = |c_{2m+1}| || |A|^{2m+1} ||_1 / ||A||_1 shrinks by 2^{-2m} per squaring,
+ * so one norm of the unscaled power serves every s.
+ */
+static int ell_correction(double log2_pow_norm, double norm1, int m, int s) {
+    if (log2_pow_norm == -HUGE_VAL || norm1 == 0.0) return 0;
+    const double log2_alpha = log2_pow_norm - log2(norm1) - log2(ell_coeff_recip(m))
+        - 2.0 * m * (double)s;
+    const double value = ceil((log2_alpha + 53.0) / (2.0 * m));   /* log2(alpha / u) */
+    return (value > 0.0) ? (int)value : 0;
+}
+
+static int ell_for(const Matrix* A, double norm1, int m, double* work) {
+    return ell_correction(log2_abs_power_norm(A, 2 * m + 1, work), norm1, m, 0);
+}
+
+/* Upper bound ||A^8||_1 <= min(||A^4||^2, ||A^6|| ||A^2||). */
+static double bound_a8(double a2, double a4, double a6) {
+    return fmin(a4 * a4, a6 * a2);
+}
+
+/**
+ * @brief min(bound, normest1 of F_0 * ... * F_{count-1})^(1/k).
+ *
+ * The estimate (Higham & Tisseur) costs O(count n^2) per probe block and
+ * never forms the product; it only replaces the bound, which is an upper
+ * limit, when it is smaller.
+ */
+static CoreErrorStatus sharpen_dk(double bound, int k, const Matrix* const* factors, int count,
+    double* work, double* out)
+{
+    const int n = factors[0]->rows;
+    MatrixProductOp prod = { factors, count,
+        work + MATRIX_NORMEST_WORK(n, MATRIX_NORMEST_T), MATRIX_NORMEST_T };
+    MatrixLinearOperator op;
+    CoreErrorStatus status = matrix_linop_product(&op, &prod);
+    if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+
+    double est = 0.0;
+    status = matrix_norm_1_est(&op, MATRIX_NORMEST_T, work, &est, NULL);
+    if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+    *out = pow(fmin(bound, est), 1.0 / k);
+    CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
+}
+
+/* Powers of 2^-s * A from those of A: exact, since only exponents change. */
+static CoreErrorStatus scale_powers(Matrix* A2, Matrix* A4, Matrix* A6, int s) {
+    CoreErrorStatus status = matrix_scale_down_pow2(A2, 2 * s, A2);
+    if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+    status = matrix_scale_down_pow2(A4, 4 * s, A4);
+    if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+    status = matrix_scale_down_pow2(A6, 6 * s, A6);
+    CORE_ERROR_RETURN(status);
+}
+
+/**
+ * @brief Norm-only fallback (m = 13) when a power of the unscaled A overflows.
+ *
+ * The powers are rebuilt from 2^-s A, staged in the A6 buffer. s targets the
+ * same 4.25 threshold as the regular m = 13 path; with no ell() guard here,
+ * the looser 5.37 would not be justified.
+ */
+static CoreErrorStatus select_overflow_fallback(const Matrix* A, double norm1,
+    Matrix* A2, Matrix* A4, Matrix* A6, PadeScaling* out)
+{
+    int s = 0;
+    CoreErrorStatus status = ceil_log2_pos(fmax(norm1 / PADE_THETA13_2009, 1.0), &s);
+    if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+
+    status = matrix_scale_down_pow2(A, s, A6);
+    if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+    status = matrix_ops_multiply(A2, A6, A6);
+    if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+    status = matrix_ops_multiply(A4, A2, A2);
+    if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+    status = matrix_ops_multiply(A6, A4, A2);
+    if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+
+    out->m = 13;
+    out->s = s;
+    out->ell = 0;
+    out->max_power = 6;
+    out->products += 3;
+    CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
+}
+
+CoreErrorStatus pade_select_scaling(const Matrix* A, Matrix* A2, Matrix* A4, Matrix* A6,
+    double* work, PadeScaling* out)
+{
+    if (!A || !A2 || !A4 || !A6 || !work || !out) CORE_ERROR_RETURN(CORE_ERROR_NULL);
+    const int n = A->rows;
+    if (A->cols != n) CORE_ERROR_RETURN(CORE_ERROR_DIMENSION);
+    *out = (PadeScaling){ 0 };
+
+    double norm1 = 0.0, a2 = 0.0, a4 = 0.0, a6 = 0.0;
+    CoreErrorStatus status = matrix_norm_1(A, &norm1);
+    if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+    if (!isfinite(norm1)) CORE_ERROR_RETURN(CORE_ERROR_INVALID_ARG);
+
+    /* ---- m = 3: d4, d6 <= ||A^2||^(1/2) ---- */
+    status = matrix_ops_multiply(A2, A, A);
+    if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+    out->products = 1;
+    out->max_power = 2;
+    status = matrix_norm_1(A2, &a2);
+    if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+    if (!isfinite(a2)) CORE_ERROR_RETURN(select_overflow_fallback(A, norm1, A2, A4, A6, out));
+
+    /* Forming A^4 costs about what an estimate of its norm would, so m = 3
+       is decided from the bound alone */
+    if (sqrt(a2) <= theta_for(3) && ell_for(A, norm1, 3, work) == 0) {
+        out->m = 3;
+        CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
+    }
+
+    /* ---- m = 5: d4 exact, d6 <= (||A^4|| ||A^2||)^(1/6) ---- */
+    status = matrix_ops_multiply(A4, A2, A2);
+    if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+    out->products = 2;
+    out->max_power = 4;
+    status = matrix_norm_1(A4, &a4);
+    if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+    if (!isfinite(a4)) CORE_ERROR_RETURN(select_overflow_fallback(A, norm1, A2, A4, A6, out));
+
+    /* From here on a power's norm is estimated only when its bound is what
+       fails a test, and only for orders where the estimate is cheaper than
+       the product it can save. */
+    const int sharpen = (n >= PADE_NORMEST_MIN_N);
+    const double d4 = pow(a4, 1.0 / 4.0);
+    double d6 = pow(a4 * a2, 1.0 / 6.0);
+    if (sharpen && d4 <= theta_for(5) && d6 > theta_for(5)) {
+        const Matrix* f[2] = { A4, A2 };
+        status = sharpen_dk(a4 * a2, 6, f, 2, work, &d6);
+        if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+    }
+    if (fmax(d4, d6) <= theta_for(5) && ell_for(A, norm1, 5, work) == 0) {
+        out->m = 5;
+        CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
+    }
+
+    /* ---- m = 7, 9: d6 exact, d8 <= min(||A^4||^2, ||A^6|| ||A^2||)^(1/8) ---- */
+    status = matrix_ops_multiply(A6, A4, A2);
+    if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+    out->products = 3;
+    out->max_power = 6;
+    status = matrix_norm_1(A6, &a6);
+    if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+    if (!isfinite(a6)) CORE_ERROR_RETURN(select_overflow_fallback(A, norm1, A2, A4, A6, out));
+
+    d6 = pow(a6, 1.0 / 6.0);
+    const double a8 = bound_a8(a2, a4, a6);
+    double d8 = pow(a8, 1.0 / 8.0);
+    const Matrix* f8[2] = { A4, A4 };
+    int d8_estimated = 0;
+    if (sharpen && d6 <= theta_for(9) && d8 > theta_for(7)) {
+        status = sharpen_dk(a8, 8, f8, 2, work, &d8);
+        if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+        d8_estimated = 1;
+    }
+    const double eta3 = fmax(d6, d8);
+    if (eta3 <= theta_for(7) && ell_for(A, norm1, 7, work) == 0) {
+        out->m = 7;
+        CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
+    }
+    if (eta3 <= theta_for(9) && ell_for(A, norm1, 9, work) == 0) {
+        out->m = 9;
+        CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
+    }
+
+    /* ---- m = 13: d10 <= min(||A^4|| ||A^6||, ||A^8|| ||A^2||)^(1/10) ---- */
+    double d10 = pow(fmin(a4 * a6, a8 * a2), 1.0 / 10.0);
+    if (sharpen && fmin(eta3, fmax(d8, d10)) > PADE_THETA13_2009) {
+        /* every squaring saved is an n x n product: sharpen both */
+        if (!d8_estimated) {
+            status = sharpen_dk(a8, 8, f8, 2, work, &d8);
+            if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+        }
+        const Matrix* f10[2] = { A4, A6 };
+        status = sharpen_dk(fmin(a4 * a6, a8 * a2), 10, f10, 2, work, &d10);
+        if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+    }
+    const double eta5 = fmin(fmax(d6, d8), fmax(d8, d10));
+    int s = 0;
+    if (eta5 > PADE_THETA13_2009) {
+        status = ceil_log2_pos(eta5 / PADE_THETA13_2009, &s);
+        if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+    }
+    const int ell = ell_correction(log2_abs_power_norm(A, 27, work), norm1, 13, s);
+
+    out->m = 13;
+    out->s = s + ell;
+    out->ell = ell;
+    if (out->s > 0) {
+        status = scale_powers(A2, A4, A6, out->s);
+        if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+    }
+    CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
+}
+
+/* Orders indexing PadeNormProfile.log2_abs. */
+static const int PROFILE_ORDERS[5] = { 3, 5, 7, 9, 13 };
+
+CoreErrorStatus pade_norm_profile(const Matrix* A, const Matrix* A2, const Matrix* A4,
+    const Matrix* A6, double* work, PadeNormProfile* out)
+{
+    if (!A || !A2 || !A4 || !A6 || !work || !out) CORE_ERROR_RETURN(CORE_ERROR_NULL);
+    const int n = A->rows;
+    if (A->cols != n) CORE_ERROR_RETURN(CORE_ERROR_DIMENSION);
+    *out = (PadeNormProfile){ 0 };
+
+    double a2 = 0.0, a4 = 0.0, a6 = 0.0;
+    CoreErrorStatus status = matrix_norm_1(A, &out->norm1);
+    if (status == CORE_ERROR_SUCCESS) status = matrix_norm_1(A2, &a2);
+    if (status == CORE_ERROR_SUCCESS) status = matrix_norm_1(A4, &a4);
+    if (status == CORE_ERROR_SUCCESS) status = matrix_norm_1(A6, &a6);
+    if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+    if (!isfinite(out->norm1) || !isfinite(a2) || !isfinite(a4) || !isfinite(a6)) {
+        CORE_ERROR_RETURN(CORE_ERROR_INVALID_ARG);
+    }
+
+    const double a8 = bound_a8(a2, a4, a6);
+    const double a10 = fmin(a4 * a6, a8 * a2);
+    out->d4 = pow(a4, 1.0 / 4.0);
+    out->d6 = pow(a6, 1.0 / 6.0);
+    out->d8 = pow(a8, 1.0 / 8.0);
+    out->d10 = pow(a10, 1.0 / 10.0);
+    if (n >= PADE_NORMEST_MIN_N) {
+        /* paid once for all t, so both are sharpened unconditionally */
+        const Matrix* f8[2] = { A4, A4 };
+        status = sharpen_dk(a8, 8, f8, 2, work, &out->d8);
+        if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+        const Matrix* f10[2] = { A4, A6 };
+        status = sharpen_dk(a10, 10, f10, 2, work, &out->d10);
+        if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+    }
+
+    int p[5];
+    for (int i = 0; i < 5; ++i) p[i] = 2 * PROFILE_ORDERS[i] + 1;
+    log2_abs_power_norms(A, p, 5, work, out->log2_abs);
+    CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
+}
+
+CoreErrorStatus pade_select_scaling_for_step(const PadeNormProfile* profile, double t,
+    PadeScaling* out)
+{
+    if (!profile || !out) CORE_ERROR_RETURN(CORE_ERROR_NULL);
+    if (!isfinite(t)) CORE_ERROR_RETURN(CORE_ERROR_INVALID_ARG);
+    *out = (PadeScaling){ 0 };
+
+    const double a = fabs(t);
+    const double norm1 = a * profile->norm1;
+    if (norm1 == 0.0) {
+        out->m = 3;
+        out->max_power = 2;
+        CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
+    }
+    const double log2_t = log2(a);
+    const double d4 = a * profile->d4, d6 = a * profile->d6;
+    const double d8 = a * profile->d8, d10 = a * profile->d10;
+
+    /* ---- m = 3, 5: max(d4, d6); m = 7, 9: max(d6, d8) ---- */
+    for (int i = 0; i < 4; ++i) {
+        const int m = PROFILE_ORDERS[i];
+        const double eta = (m <= 5) ? fmax(d4, d6) : fmax(d6, d8);
+        if (eta <= theta_for(m)
+            && ell_correction(profile->log2_abs[i] + (2 * m + 1) * log2_t, norm1, m, 0) == 0) {
+            out->m = m;
+            out->max_power = (m == 3) ? 2 : (m == 5) ? 4 : 6;
+            CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
+        }
+    }
+
+    /* ---- m = 13 ---- */
+    const double eta5 = fmin(fmax(d6, d8), fmax(d8, d10));
+    int s = 0;
+    if (eta5 > PADE_THETA13_2009) {
+        CoreErrorStatus status = ceil_log2_pos(eta5 / PADE_THETA13_2009, &s);
+        if (status != CORE_ERROR_SUCCESS) CORE_ERROR_RETURN(status);
+    }
+    const int ell = ell_correction(profile->log2_abs[4] + 27.0 * log2_t, norm1, 13, s);
+
+    out->m = 13;
+    out->s = s + ell;
+    out->ell = ell;
+    out->max_power = 6;
+    CORE_ERROR_RETURN(CORE_ERROR_SUCCESS);
+}
+
 CoreErrorStatus matrix_scale_down_pow2(const Matrix* src, int s, Matrix* dst) {
     if (!src || !dst) {
         CORE_ERROR_RETURN(CORE_ERROR_NULL);
@@ -14,6 +14,7 @@
 #include "runner_io_json.h"
 
 #include "core_matrix.h"
+#include "core_arena.h"
 #include "core_error.h"
 #include "matrix_ops.h"
 #include "state_space.h"
@@ -95,6 +96,7 @@ int main(int argc, char** argv) {
 
     // --- cleanupΏہigoto ׂ\̂Őɐ錾j ---
     CoreErrorStatus err = CORE_ERROR_SUCCESS;
+    MatrixArena arena{};                 // per-request temporaries (model, A, B)
     StateSpaceModel* sys = nullptr;
 
     SSDiscrete d{};
@@ -190,15 +192,22 @@ int main(int argc, char** argv) {
         // ȍ~Areq_opt O
         auto& req = *req_opt;
 
-        sys = (StateSpaceModel*)calloc(1, sizeof(StateSpaceModel));
-        if (!sys) {
-            err = CORE_ERROR_ALLOCATION_FAILED;
+        err = matrix_arena_init(&arena, 0);
+        if (err) {
+            exit_code = (int)runner_exit_from_core_status(err);
+            err_obj = make_error_core(exit_code, (int)err);
+            goto CLEANUP;
+        }
+
+        sys = (StateSpaceModel*)matrix_arena_alloc(&arena, sizeof(StateSpaceModel), &err);
+        if (err) {
             exit_code = (int)runner_exit_from_core_status(err);
             err_obj = make_error_core(exit_code, (int)err);
             goto CLEANUP;
         }
+        *sys = StateSpaceModel{};
 
-        sys->A = matrix_core_create(req.A.rows, req.A.cols, &err);
+        sys->A = matrix_core_create_in(&arena, req.A.rows, req.A.cols, &err);
         if (err) {
             exit_code = (int)runner_exit_from_core_status(err);
             err_obj = make_error_core(exit_code, (int)err);
@@ -215,7 +224,7 @@ int main(int argc, char** argv) {
             }
         }
 
-        sys->B = matrix_core_create(req.B.rows, req.B.cols, &err);
+        sys->B = matrix_core_create_in(&arena, req.B.rows, req.B.cols, &err);
         if (err) {
             exit_code = (int)runner_exit_from_core_status(err);
             err_obj = make_error_core(exit_code, (int)err);
@@ -277,9 +286,8 @@ CLEANUP:
     if (d_inited) {
         ss_discrete_free(&d);
     }
-    if (sys) {
-        state_space_free(sys);
-    }
+    // sys and its matrices live in the arena
+    matrix_arena_destroy(&arena);
 
     return write_result_or_runtime_error(out_path, exit_code, ok, ok_payload, err_obj);
 }
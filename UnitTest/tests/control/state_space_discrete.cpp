@@ -138,6 +138,41 @@ TEST(SSDiscrete, StepWS_MatchesStep)
     state_space_free(sys);
 }
 
+TEST(SSDiscrete, StepWS_InPlaceState_MatchesStep)
+{
+    CoreErrorStatus st = CORE_ERROR_SUCCESS;
+    StateSpaceModel* sys = make_csys_A01(&st);
+    ASSERT_EQ(st, CORE_ERROR_SUCCESS);
+
+    SSDiscrete d = { 0 };
+    ASSERT_EQ(ss_discrete_init_from_csys(&d, sys, 0.5), CORE_ERROR_SUCCESS);
+
+    Matrix* x = matrix_core_create(2, 1, &st);
+    Matrix* xn = matrix_core_create(2, 1, &st);
+    Matrix* u = matrix_core_create(1, 1, &st);
+    Matrix* Ax = matrix_core_create(2, 1, &st);
+    Matrix* Bu = matrix_core_create(2, 1, &st);
+    ASSERT_EQ(st, CORE_ERROR_SUCCESS);
+
+    x->data[0] = 0.4; x->data[1] = -0.7;
+    u->data[0] = 2.0;
+
+    ASSERT_EQ(ss_discrete_step(&d, x, u, xn), CORE_ERROR_SUCCESS);
+    // x_next aliases x_now: the step must still see the old state
+    ASSERT_EQ(ss_discrete_step_ws(&d, x, u, x, Ax, Bu), CORE_ERROR_SUCCESS);
+
+    EXPECT_NEAR(x->data[0], xn->data[0], 1e-12);
+    EXPECT_NEAR(x->data[1], xn->data[1], 1e-12);
+
+    matrix_core_free(Bu);
+    matrix_core_free(Ax);
+    matrix_core_free(u);
+    matrix_core_free(xn);
+    matrix_core_free(x);
+    ss_discrete_free(&d);
+    state_space_free(sys);
+}
+
 TEST(SSDiscrete, ScalarUStep_EqualsVectorVersionWhenM1)
 {
     CoreErrorStatus st = CORE_ERROR_SUCCESS;
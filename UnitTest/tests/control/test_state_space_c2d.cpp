@@ -1,10 +1,12 @@
 #include <gtest/gtest.h>
+#include <cmath>
 extern "C" {
 #include "core_matrix.h"
 #include "core_error.h"
 #include "matrix_ops.h"
 #include "state_space.h"     // StateSpaceModel ̐API
 #include "state_space_c2d.h" // ̑Ώ
+#include "core_memo.h"
 #include "pade.h"            // pade_expm ̖߂l^Ȃ
 }
 
@@ -114,3 +116,129 @@ TEST(StateSpaceC2D, NullArgs) {
     matrix_core_free(Bd);
     state_space_free(sys);
 }
+
+TEST(StateSpaceC2D, WorkspaceVariantMatchesAndChecksSize) {
+    CoreErrorStatus err = CORE_ERROR_SUCCESS;
+    StateSpaceModel* sys = state_space_create(2, 1, 1, &err);
+    ASSERT_NE(sys, nullptr);
+    ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+    const double a[4] = { 0.0, 1.0, -4.0, -0.4 };
+    for (int i = 0; i < 4; ++i) sys->A->data[i] = a[i];
+    sys->B->data[0] = 0.0;
+    sys->B->data[1] = 1.0;
+
+    Matrix* Ad = matrix_core_create(2, 2, &err);
+    Matrix* Bd = matrix_core_create(2, 1, &err);
+    Matrix* Adw = matrix_core_create(2, 2, &err);
+    Matrix* Bdw = matrix_core_create(2, 1, &err);
+    ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+
+    C2DWorkspace ws;
+    ASSERT_EQ(state_space_c2d_workspace_init(&ws, 2, 1), CORE_ERROR_SUCCESS);
+    for (double Ts : { 0.0, 0.001, 0.1, 5.0 }) {
+        ASSERT_EQ(state_space_c2d(sys, Ts, Ad, Bd), CORE_ERROR_SUCCESS);
+        ASSERT_EQ(state_space_c2d_ws(sys, Ts, &ws, Adw, Bdw), CORE_ERROR_SUCCESS);
+        for (int i = 0; i < 4; ++i) EXPECT_EQ(Adw->data[i], Ad->data[i]) << "Ts=" << Ts;
+        for (int i = 0; i < 2; ++i) EXPECT_EQ(Bdw->data[i], Bd->data[i]) << "Ts=" << Ts;
+    }
+    EXPECT_EQ(state_space_c2d_workspace_free(&ws), CORE_ERROR_SUCCESS);
+
+    ASSERT_EQ(state_space_c2d_workspace_init(&ws, 2, 2), CORE_ERROR_SUCCESS);
+    EXPECT_EQ(state_space_c2d_ws(sys, 0.1, &ws, Adw, Bdw), CORE_ERROR_DIMENSION);
+    EXPECT_EQ(state_space_c2d_ws(sys, 0.1, nullptr, Adw, Bdw), CORE_ERROR_NULL);
+    EXPECT_EQ(state_space_c2d_workspace_free(&ws), CORE_ERROR_SUCCESS);
+
+    matrix_core_free(Ad);
+    matrix_core_free(Bd);
+    matrix_core_free(Adw);
+    matrix_core_free(Bdw);
+    state_space_free(sys);
+}
+
+TEST(StateSpaceC2D, GivenMoreStatesAndInputs_WhenC2D_ThenBlockPathMatchesClosedForm) {
+    // Diagonal A: A_d = diag(e^{a Ts}), B_d = diag((e^{a Ts} - 1) / a) B
+    const int n = 5, m = 4;
+    CoreErrorStatus err = CORE_ERROR_SUCCESS;
+    StateSpaceModel* sys = state_space_create(n, m, 1, &err);
+    ASSERT_NE(sys, nullptr);
+    ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+    ASSERT_EQ(matrix_ops_set_zero(sys->A), CORE_ERROR_SUCCESS);
+    for (int i = 0; i < n; ++i) {
+        sys->A->data[i * n + i] = -0.5 * (i + 1);
+        for (int j = 0; j < m; ++j) sys->B->data[i * m + j] = 1.0 + i - 0.5 * j;
+    }
+
+    Matrix* Ad = matrix_core_create(n, n, &err);
+    Matrix* Bd = matrix_core_create(n, m, &err);
+    ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+    C2DWorkspace ws;
+    ASSERT_EQ(state_space_c2d_workspace_init(&ws, n, m), CORE_ERROR_SUCCESS);
+    EXPECT_EQ(ws.E->rows, n);   // only [A_d, B_d] is stored
+
+    for (double Ts : { 0.01, 1.0, 20.0 }) {
+        ASSERT_EQ(state_space_c2d_ws(sys, Ts, &ws, Ad, Bd), CORE_ERROR_SUCCESS);
+        for (int i = 0; i < n; ++i) {
+            const double a = sys->A->data[i * n + i];
+            const double ea = std::exp(a * Ts);
+            for (int j = 0; j < n; ++j)
+                EXPECT_NEAR(Ad->data[i * n + j], (i == j) ? ea : 0.0, 1e-15) << "Ts=" << Ts;
+            for (int j = 0; j < m; ++j) {
+                const double bd = (ea - 1.0) / a * sys->B->data[i * m + j];
+                EXPECT_NEAR(Bd->data[i * m + j], bd, 1e-14 * std::fmax(1.0, std::fabs(bd))) << "Ts=" << Ts;
+                EXPECT_EQ(ws.E->data[i * ws.E->ld + n + j], Bd->data[i * m + j]);
+            }
+        }
+    }
+
+    // Same result through the allocating entry point
+    Matrix* Ad2 = matrix_core_create(n, n, &err);
+    Matrix* Bd2 = matrix_core_create(n, m, &err);
+    ASSERT_EQ(state_space_c2d(sys, 20.0, Ad2, Bd2), CORE_ERROR_SUCCESS);
+    for (int i = 0; i < n * n; ++i) EXPECT_EQ(Ad2->data[i], Ad->data[i]);
+    for (int i = 0; i < n * m; ++i) EXPECT_EQ(Bd2->data[i], Bd->data[i]);
+
+    EXPECT_EQ(state_space_c2d_workspace_free(&ws), CORE_ERROR_SUCCESS);
+    matrix_core_free(Ad); matrix_core_free(Bd);
+    matrix_core_free(Ad2); matrix_core_free(Bd2);
+    state_space_free(sys);
+}
+
+TEST(StateSpaceC2D, GivenDefaultMemoCache_WhenSameModelRediscretized_ThenHitIsBitIdentical) {
+    const int n = 4, m = 2;
+    CoreErrorStatus err = CORE_ERROR_SUCCESS;
+    StateSpaceModel* sys = state_space_create(n, m, 1, &err);
+    ASSERT_NE(sys, nullptr);
+    for (int i = 0; i < n * n; ++i) sys->A->data[i] = std::cos(0.9 * i) - (i % (n + 1) == 0 ? 2.0 : 0.0);
+    for (int i = 0; i < n * m; ++i) sys->B->data[i] = 1.0 + 0.25 * i;
+
+    Matrix* Ad = matrix_core_create(n, n, &err);
+    Matrix* Bd = matrix_core_create(n, m, &err);
+    Matrix* Adc = matrix_core_create(n, n, &err);
+    Matrix* Bdc = matrix_core_create(n, m, &err);
+    ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+    ASSERT_EQ(state_space_c2d(sys, 0.05, Ad, Bd), CORE_ERROR_SUCCESS);
+
+    CoreMemoCache* cache = nullptr;
+    ASSERT_EQ(core_memo_create(&cache, 8, 0), CORE_ERROR_SUCCESS);
+    core_memo_set_default(cache);
+    for (int rep = 0; rep < 3; ++rep) {
+        ASSERT_EQ(state_space_c2d(sys, 0.05, Adc, Bdc), CORE_ERROR_SUCCESS);
+        for (int i = 0; i < n * n; ++i) EXPECT_EQ(Adc->data[i], Ad->data[i]);
+        for (int i = 0; i < n * m; ++i) EXPECT_EQ(Bdc->data[i], Bd->data[i]);
+    }
+    // Another B is another key
+    sys->B->data[0] += 1.0;
+    ASSERT_EQ(state_space_c2d(sys, 0.05, Adc, Bdc), CORE_ERROR_SUCCESS);
+    EXPECT_NE(Bdc->data[0], Bd->data[0]);
+    core_memo_set_default(nullptr);
+
+    CoreMemoStats st;
+    ASSERT_EQ(core_memo_get_stats(cache, &st), CORE_ERROR_SUCCESS);
+    EXPECT_EQ(st.hits, 2u);
+    EXPECT_EQ(st.misses, 2u);
+
+    core_memo_destroy(cache);
+    matrix_core_free(Ad); matrix_core_free(Bd);
+    matrix_core_free(Adc); matrix_core_free(Bdc);
+    state_space_free(sys);
+}
@@ -0,0 +1,115 @@
+#include <gtest/gtest.h>
+
+#include "state_space_discrete_fixed.h"
+
+extern "C" {
+#include "core_matrix.h"
+#include "core_error.h"
+#include "matrix_ops.h"
+#include "state_space.h"
+#include "state_space_discrete.h"
+}
+
+// 2-state DC motor shaped plant: x = [theta, omega], one input, one output.
+static StateSpaceModel* MakeMotor(CoreErrorStatus* err) {
+    StateSpaceModel* sys = state_space_create(2, 1, 1, err);
+    if (!sys || *err) return sys;
+    // matrix_core_create() leaves the entries uninitialized
+    matrix_ops_set_zero(sys->A);
+    matrix_ops_set_zero(sys->B);
+    matrix_ops_set_zero(sys->C);
+    matrix_ops_set_zero(sys->D);
+    matrix_ops_set(sys->A, 0, 1, 1.0);
+    matrix_ops_set(sys->A, 1, 1, -3.5);
+    matrix_ops_set(sys->B, 1, 0, 12.0);
+    matrix_ops_set(sys->C, 0, 1, 1.0);
+    return sys;
+}
+
+TEST(SSDiscreteFixed, GivenContinuousModel_WhenFromCsys_ThenMatchesSSDiscrete) {
+    CoreErrorStatus err = CORE_ERROR_SUCCESS;
+    StateSpaceModel* sys = MakeMotor(&err);
+    ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+
+    SSDiscrete ref;
+    ASSERT_EQ(ss_discrete_init_from_csys(&ref, sys, 0.01), CORE_ERROR_SUCCESS);
+
+    dts::SSDiscreteFixed<2, 1, 1> fx;
+    ASSERT_EQ(fx.from_csys(sys, 0.01), CORE_ERROR_SUCCESS);
+    EXPECT_EQ(fx.Ts, 0.01);
+    for (int i = 0; i < 2; ++i) {
+        for (int j = 0; j < 2; ++j) EXPECT_NEAR(fx.Ad(i, j), ref.Ad->data[i * ref.Ad->ld + j], 1e-15);
+        EXPECT_NEAR(fx.Bd(i, 0), ref.Bd->data[i * ref.Bd->ld], 1e-15);
+    }
+
+    // Simulate both engines side by side
+    Matrix* x = matrix_core_create(2, 1, &err);
+    Matrix* u = matrix_core_create(1, 1, &err);
+    Matrix* xn = matrix_core_create(2, 1, &err);
+    Matrix* y = matrix_core_create(1, 1, &err);
+    ASSERT_EQ(matrix_ops_set_zero(x), CORE_ERROR_SUCCESS);
+    dts::SSDiscreteFixed<2, 1, 1>::State xs{};
+    dts::SSDiscreteFixed<2, 1, 1>::Input us{};
+    for (int k = 0; k < 200; ++k) {
+        const double uk = (k < 100) ? 1.0 : -0.5;
+        u->data[0] = uk;
+        us(0, 0) = uk;
+        ASSERT_EQ(ss_discrete_step(&ref, x, u, xn), CORE_ERROR_SUCCESS);
+        ASSERT_EQ(matrix_ops_copy(x, xn), CORE_ERROR_SUCCESS);
+        xs = fx.step(xs, us);
+    }
+    EXPECT_NEAR(xs(0, 0), x->data[0], 1e-12);
+    EXPECT_NEAR(xs(1, 0), x->data[x->ld], 1e-12);
+
+    ASSERT_EQ(ss_discrete_output(&ref, x, u, y), CORE_ERROR_SUCCESS);
+    EXPECT_NEAR(fx.output(xs, us)(0, 0), y->data[0], 1e-12);
+
+    for (Matrix* m : { x, u, xn, y }) matrix_core_free(m);
+    ss_discrete_free(&ref);
+    state_space_free(sys);
+}
+
+TEST(SSDiscreteFixed, GivenSSDiscrete_WhenPromoteAndDemote_ThenRoundTrips) {
+    CoreErrorStatus err = CORE_ERROR_SUCCESS;
+    StateSpaceModel* sys = MakeMotor(&err);
+    ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+    SSDiscrete ref;
+    ASSERT_EQ(ss_discrete_init_from_csys(&ref, sys, 0.02), CORE_ERROR_SUCCESS);
+
+    dts::SSDiscreteFixed<2, 1, 1> fx;
+    ASSERT_EQ(fx.from_discrete(&ref), CORE_ERROR_SUCCESS);
+
+    SSDiscrete back;
+    ASSERT_EQ(fx.to_discrete(&back), CORE_ERROR_SUCCESS);
+    EXPECT_EQ(back.n, 2);
+    EXPECT_EQ(back.m, 1);
+    EXPECT_EQ(back.p, 1);
+    EXPECT_EQ(back.Ts, 0.02);
+    for (int i = 0; i < 4; ++i) EXPECT_EQ(back.Ad->data[i], ref.Ad->data[i]);
+    for (int i = 0; i < 2; ++i) EXPECT_EQ(back.Bd->data[i], ref.Bd->data[i]);
+    for (int i = 0; i < 2; ++i) EXPECT_EQ(back.C->data[i], ref.C->data[i]);
+
+    // Wrong compile-time shape is rejected
+    dts::SSDiscreteFixed<3, 1, 1> wrong;
+    EXPECT_EQ(wrong.from_discrete(&ref), CORE_ERROR_DIMENSION);
+
+    ss_discrete_free(&back);
+    ss_discrete_free(&ref);
+    state_space_free(sys);
+}
+
+TEST(SSDiscreteFixed, GivenTsZeroOrNegative_WhenFromCsys_ThenIdentityOrInvalid) {
+    CoreErrorStatus err = CORE_ERROR_SUCCESS;
+    StateSpaceModel* sys = MakeMotor(&err);
+    ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+
+    dts::SSDiscreteFixed<2, 1, 1> fx;
+    ASSERT_EQ(fx.from_csys(sys, 0.0), CORE_ERROR_SUCCESS);
+    EXPECT_EQ(fx.Ad.a, (dts::SMatrix<2, 2>::identity().a));
+    EXPECT_EQ(fx.Bd(1, 0), 0.0);
+
+    EXPECT_EQ(fx.from_csys(sys, -1.0), CORE_ERROR_INVALID_ARG);
+    EXPECT_EQ(fx.from_csys(nullptr, 0.1), CORE_ERROR_NULL);
+
+    state_space_free(sys);
+}
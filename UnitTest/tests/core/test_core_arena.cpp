@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+#include <climits>
+#include <cstdint>
+
+extern "C" {
+#include "core_arena.h"
+#include "core_matrix.h"
+#include "core_error.h"
+}
+
+static bool IsAligned(const void* p) {
+    return ((uintptr_t)p % MATRIX_ARENA_ALIGNMENT) == 0;
+}
+
+TEST(MatrixArena_Alloc, ReturnsAlignedDisjointBlocks) {
+    MatrixArena arena;
+    ASSERT_EQ(matrix_arena_init(&arena, 1024), CORE_ERROR_SUCCESS);
+
+    CoreErrorStatus err = CORE_ERROR_NULL;
+    char* a = (char*)matrix_arena_alloc(&arena, 10, &err);
+    ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+    char* b = (char*)matrix_arena_alloc(&arena, 100, &err);
+    ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+
+    EXPECT_TRUE(IsAligned(a));
+    EXPECT_TRUE(IsAligned(b));
+    EXPECT_GE(b - a, 10);
+
+    EXPECT_EQ(matrix_arena_destroy(&arena), CORE_ERROR_SUCCESS);
+    EXPECT_EQ(arena.head, nullptr);
+}
+
+TEST(MatrixArena_Alloc, GrowsBeyondFirstBlock) {
+    MatrixArena arena;
+    ASSERT_EQ(matrix_arena_init(&arena, 256), CORE_ERROR_SUCCESS);
+
+    CoreErrorStatus err = CORE_ERROR_SUCCESS;
+    double* small = (double*)matrix_arena_alloc(&arena, 200, &err);
+    ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+    double* big = (double*)matrix_arena_alloc(&arena, 4096 * sizeof(double), &err);
+    ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+    ASSERT_NE(big, nullptr);
+    for (int i = 0; i < 4096; ++i) big[i] = (double)i;
+    small[0] = -1.0;
+    EXPECT_EQ(big[0], 0.0);
+    EXPECT_EQ(big[4095], 4095.0);
+
+    EXPECT_EQ(matrix_arena_destroy(&arena), CORE_ERROR_SUCCESS);
+}
+
+TEST(MatrixArena_Reset, GivenMark_WhenReset_ThenReusesSameMemory) {
+    MatrixArena arena;
+    ASSERT_EQ(matrix_arena_init(&arena, 512), CORE_ERROR_SUCCESS);
+
+    CoreErrorStatus err = CORE_ERROR_SUCCESS;
+    void* keep = matrix_arena_alloc(&arena, 64, &err);
+    ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+
+    const MatrixArenaMark mark = matrix_arena_mark(&arena);
+    void* first = matrix_arena_alloc(&arena, 128, &err);
+    ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+    // Spill into a second block, then rewind past it.
+    ASSERT_NE(matrix_arena_alloc(&arena, 2048, &err), nullptr);
+
+    ASSERT_EQ(matrix_arena_reset(&arena, mark), CORE_ERROR_SUCCESS);
+    void* again = matrix_arena_alloc(&arena, 128, &err);
+    ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+    EXPECT_EQ(again, first);
+    EXPECT_NE(again, keep);
+
+    ASSERT_EQ(matrix_arena_clear(&arena), CORE_ERROR_SUCCESS);
+    EXPECT_EQ(matrix_arena_alloc(&arena, 8, &err), keep);
+
+    EXPECT_EQ(matrix_arena_destroy(&arena), CORE_ERROR_SUCCESS);
+}
+
+TEST(MatrixArena_Errors, ReturnsCORE_ERROR_NULL) {
+    CoreErrorStatus err = CORE_ERROR_SUCCESS;
+    EXPECT_EQ(matrix_arena_init(nullptr, 0), CORE_ERROR_NULL);
+    EXPECT_EQ(matrix_arena_destroy(nullptr), CORE_ERROR_NULL);
+    EXPECT_EQ(matrix_arena_clear(nullptr), CORE_ERROR_NULL);
+    EXPECT_EQ(matrix_arena_alloc(nullptr, 8, &err), nullptr);
+    EXPECT_EQ(err, CORE_ERROR_NULL);
+    EXPECT_EQ(matrix_core_create_in(nullptr, 2, 2, &err), nullptr);
+    EXPECT_EQ(err, CORE_ERROR_NULL);
+}
+
+TEST(MatrixCore_CreateIn, ReturnsAlignedMatrixSizedByBytesIn) {
+    MatrixArena arena;
+    ASSERT_EQ(matrix_arena_init(&arena, matrix_core_bytes_in(3, 5) + matrix_core_bytes_in(2, 2)),
+        CORE_ERROR_SUCCESS);
+
+    CoreErrorStatus err = CORE_ERROR_SUCCESS;
+    Matrix* m = matrix_core_create_in(&arena, 3, 5, &err);
+    ASSERT_NE(m, nullptr);
+    ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+    EXPECT_EQ(m->rows, 3);
+    EXPECT_EQ(m->cols, 5);
+    EXPECT_TRUE(IsAligned(m->data));
+    Matrix* s = matrix_core_create_in(&arena, 2, 2, &err);
+    ASSERT_NE(s, nullptr);
+
+    // Both fit in the exactly-sized first block.
+    EXPECT_EQ(arena.head, arena.current);
+
+    EXPECT_EQ(matrix_core_create_in(&arena, 0, 2, &err), nullptr);
+    EXPECT_EQ(err, CORE_ERROR_OUT_OF_BOUNDS);
+
+    // rows * cols * sizeof(double) overflows size_t: rejected before the arena moves
+    const MatrixArenaMark before = matrix_arena_mark(&arena);
+    EXPECT_EQ(matrix_core_create_in(&arena, INT_MAX, INT_MAX, &err), nullptr);
+    EXPECT_EQ(err, CORE_ERROR_ALLOCATION_FAILED);
+    EXPECT_EQ(matrix_arena_mark(&arena).used, before.used);
+
+    EXPECT_EQ(matrix_arena_destroy(&arena), CORE_ERROR_SUCCESS);
+}
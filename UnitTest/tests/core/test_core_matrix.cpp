@@ -1,4 +1,5 @@
 #include <gtest/gtest.h>
+#include <cstdint>
 
 extern "C" {
 #include "core_matrix.h"
@@ -85,3 +86,96 @@ TEST(MatrixCore_LastError, RecordsOriginFileAndLine) {
     EXPECT_NE(e.file, nullptr);
     EXPECT_GT(e.line, 0);
 }
+
+TEST(MatrixCore_Create, DataIsAlignedAndUnpadded) {
+    CoreErrorStatus err = CORE_ERROR_NULL;
+    Matrix* m = matrix_core_create(3, 5, &err);
+    ASSERT_NE(m, nullptr);
+    EXPECT_EQ(err, CORE_ERROR_SUCCESS);
+    EXPECT_EQ(m->ld, 5);
+    EXPECT_EQ((uintptr_t)m->data % MATRIX_CORE_ALIGNMENT, 0u);
+    EXPECT_TRUE(matrix_core_is_contiguous(m));
+    EXPECT_EQ(matrix_core_free(m), CORE_ERROR_SUCCESS);
+}
+
+TEST(MatrixCore_CreatePadded, RowsStartOnCacheLines) {
+    CoreErrorStatus err = CORE_ERROR_NULL;
+    Matrix* m = matrix_core_create_padded(4, 5, &err);
+    ASSERT_NE(m, nullptr);
+    EXPECT_EQ(err, CORE_ERROR_SUCCESS);
+    EXPECT_EQ(m->rows, 4);
+    EXPECT_EQ(m->cols, 5);
+    EXPECT_EQ(m->ld, MATRIX_CORE_PAD_DOUBLES);
+    EXPECT_FALSE(matrix_core_is_contiguous(m));
+    for (int i = 0; i < m->rows; ++i) {
+        EXPECT_EQ((uintptr_t)(m->data + (size_t)i * m->ld) % MATRIX_CORE_ALIGNMENT, 0u);
+    }
+
+    EXPECT_EQ(matrix_ops_set(m, 3, 4, 7.5), CORE_ERROR_SUCCESS);
+    EXPECT_EQ(m->data[3 * m->ld + 4], 7.5);
+    EXPECT_EQ(matrix_core_free(m), CORE_ERROR_SUCCESS);
+
+    // Column vectors keep unit stride
+    Matrix* v = matrix_core_create_padded(6, 1, &err);
+    ASSERT_NE(v, nullptr);
+    EXPECT_EQ(v->ld, 1);
+    EXPECT_EQ(matrix_core_free(v), CORE_ERROR_SUCCESS);
+
+    EXPECT_EQ(matrix_core_create_padded(0, 3, &err), nullptr);
+    EXPECT_EQ(err, CORE_ERROR_OUT_OF_BOUNDS);
+}
+
+TEST(MatrixCore_ViewBlock, SharesParentStorage) {
+    CoreErrorStatus err = CORE_ERROR_NULL;
+    Matrix* m = matrix_core_create(4, 6, &err);
+    ASSERT_NE(m, nullptr);
+
+    MatrixView v;
+    ASSERT_EQ(matrix_view_block(&v, m, 1, 2, 3, 4), CORE_ERROR_SUCCESS);
+    EXPECT_EQ(v.rows, 3);
+    EXPECT_EQ(v.cols, 4);
+    EXPECT_EQ(v.ld, m->ld);
+    EXPECT_EQ(v.data, m->data + 1 * m->ld + 2);
+    EXPECT_FALSE(matrix_core_is_contiguous(&v));
+
+    EXPECT_EQ(matrix_ops_set(&v, 2, 3, 9.0), CORE_ERROR_SUCCESS);
+    EXPECT_EQ(matrix_ops_get(m, 3, 5, &err), 9.0);
+
+    // A view of a view addresses the same parent storage
+    MatrixView w;
+    ASSERT_EQ(matrix_view_block(&w, &v, 2, 3, 1, 1), CORE_ERROR_SUCCESS);
+    EXPECT_EQ(w.data, m->data + 3 * m->ld + 5);
+
+    EXPECT_EQ(matrix_core_free(m), CORE_ERROR_SUCCESS);
+}
+
+TEST(MatrixCore_ViewBlock, RejectsInvalidRegions) {
+    CoreErrorStatus err = CORE_ERROR_NULL;
+    Matrix* m = matrix_core_create(3, 3, &err);
+    ASSERT_NE(m, nullptr);
+    MatrixView v;
+
+    EXPECT_EQ(matrix_view_block(nullptr, m, 0, 0, 1, 1), CORE_ERROR_NULL);
+    EXPECT_EQ(matrix_view_block(&v, nullptr, 0, 0, 1, 1), CORE_ERROR_NULL);
+    EXPECT_EQ(matrix_view_block(&v, m, -1, 0, 1, 1), CORE_ERROR_INVALID_ARG);
+    EXPECT_EQ(matrix_view_block(&v, m, 0, 0, 0, 1), CORE_ERROR_INVALID_ARG);
+    EXPECT_EQ(matrix_view_block(&v, m, 1, 0, 3, 1), CORE_ERROR_OUT_OF_BOUNDS);
+    EXPECT_EQ(matrix_view_block(&v, m, 0, 2, 1, 2), CORE_ERROR_OUT_OF_BOUNDS);
+
+    EXPECT_EQ(matrix_core_free(m), CORE_ERROR_SUCCESS);
+}
+
+TEST(MatrixCore_ViewOf, WrapsCallerBuffer) {
+    double buf[12] = { 0 };
+    MatrixView v;
+    ASSERT_EQ(matrix_view_of(&v, buf, 3, 2, 4), CORE_ERROR_SUCCESS);
+    EXPECT_EQ(v.rows, 3);
+    EXPECT_EQ(v.cols, 2);
+    EXPECT_EQ(v.ld, 4);
+    EXPECT_EQ(matrix_ops_fill(&v, 1.5), CORE_ERROR_SUCCESS);
+    for (int i = 0; i < 12; ++i) EXPECT_EQ(buf[i], (i % 4 < 2) ? 1.5 : 0.0) << i;
+
+    EXPECT_EQ(matrix_view_of(&v, nullptr, 3, 2, 4), CORE_ERROR_NULL);
+    EXPECT_EQ(matrix_view_of(&v, buf, 3, 2, 1), CORE_ERROR_INVALID_ARG);
+    EXPECT_EQ(matrix_view_of(&v, buf, 0, 2, 2), CORE_ERROR_INVALID_ARG);
+}
@@ -0,0 +1,225 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+extern "C" {
+#include "core_memo.h"
+#include "core_matrix.h"
+#include "core_error.h"
+}
+
+#include "test_utils.h"
+
+namespace {
+
+CoreMemoKey KeyOf(const Matrix* A, double t) {
+    CoreMemoKey key = { 7, t, 1, { A, nullptr } };
+    return key;
+}
+
+} // namespace
+
+TEST(CoreMemo, GivenStoredResult_WhenSameArguments_ThenHitCopiesExactBytes) {
+    CoreMemoCache* cache = nullptr;
+    ASSERT_EQ(core_memo_create(&cache, 8, 0), CORE_ERROR_SUCCESS);
+    Matrix* A = MakeTestMatrix(3, 3, 0.1);
+    Matrix* R = MakeTestMatrix(3, 3, 2.0);
+    const CoreMemoKey key = KeyOf(A, 0.5);
+    const Matrix* results[1] = { R };
+    ASSERT_EQ(core_memo_store(cache, &key, results, 1), CORE_ERROR_SUCCESS);
+
+    // A padded output and a copy of A living in another buffer
+    CoreErrorStatus err = CORE_ERROR_SUCCESS;
+    Matrix* out = matrix_core_create_padded(3, 3, &err);
+    ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+    Matrix* A2 = MakeTestMatrix(3, 3, 0.1);
+    const CoreMemoKey key2 = KeyOf(A2, 0.5);
+    int hit = 0;
+    ASSERT_EQ(core_memo_lookup(cache, &key2, &out, 1, &hit), CORE_ERROR_SUCCESS);
+    EXPECT_EQ(hit, 1);
+    for (int i = 0; i < 3; ++i)
+        for (int j = 0; j < 3; ++j) EXPECT_EQ(out->data[i * out->ld + j], R->data[i * 3 + j]);
+
+    CoreMemoStats st;
+    ASSERT_EQ(core_memo_get_stats(cache, &st), CORE_ERROR_SUCCESS);
+    EXPECT_EQ(st.hits, 1u);
+    EXPECT_EQ(st.misses, 0u);
+    EXPECT_EQ(st.entries, 1);
+    EXPECT_GT(st.bytes, 2 * 9 * sizeof(double));
+    EXPECT_EQ(core_memo_hash(&key), core_memo_hash(&key2));
+
+    core_memo_destroy(cache);
+    matrix_core_free(A); matrix_core_free(A2); matrix_core_free(R); matrix_core_free(out);
+}
+
+TEST(CoreMemo, GivenAnyArgumentBitChanged_WhenLookup_ThenMiss) {
+    CoreMemoCache* cache = nullptr;
+    ASSERT_EQ(core_memo_create(&cache, 8, 0), CORE_ERROR_SUCCESS);
+    Matrix* A = MakeTestMatrix(2, 2, 0.3);
+    Matrix* R = MakeTestMatrix(2, 2, 1.0);
+    Matrix* out = MakeTestMatrix(2, 2, 5.0);
+    const CoreMemoKey key = KeyOf(A, 1.0);
+    const Matrix* results[1] = { R };
+    ASSERT_EQ(core_memo_store(cache, &key, results, 1), CORE_ERROR_SUCCESS);
+
+    int hit = 1;
+    CoreMemoKey other = KeyOf(A, std::nextafter(1.0, 2.0));
+    ASSERT_EQ(core_memo_lookup(cache, &other, &out, 1, &hit), CORE_ERROR_SUCCESS);
+    EXPECT_EQ(hit, 0);
+    other = KeyOf(A, 1.0);
+    other.tag = 8;
+    ASSERT_EQ(core_memo_lookup(cache, &other, &out, 1, &hit), CORE_ERROR_SUCCESS);
+    EXPECT_EQ(hit, 0);
+
+    const double saved = A->data[3];
+    A->data[3] = std::nextafter(saved, 10.0);
+    ASSERT_EQ(core_memo_lookup(cache, &key, &out, 1, &hit), CORE_ERROR_SUCCESS);
+    EXPECT_EQ(hit, 0);
+    A->data[3] = saved;
+
+    // Same data read as a 1 x 4 matrix is another key
+    MatrixView flat;
+    ASSERT_EQ(matrix_view_of(&flat, A->data, 1, 4, 4), CORE_ERROR_SUCCESS);
+    other = KeyOf(&flat, 1.0);
+    ASSERT_EQ(core_memo_lookup(cache, &other, &out, 1, &hit), CORE_ERROR_SUCCESS);
+    EXPECT_EQ(hit, 0);
+    EXPECT_EQ(out->data[0], std::sin(5.0));   // untouched by misses
+
+    CoreMemoStats st;
+    ASSERT_EQ(core_memo_get_stats(cache, &st), CORE_ERROR_SUCCESS);
+    EXPECT_EQ(st.hits, 0u);
+    EXPECT_EQ(st.misses, 4u);
+
+    core_memo_destroy(cache);
+    matrix_core_free(A); matrix_core_free(R); matrix_core_free(out);
+}
+
+TEST(CoreMemo, GivenFullCache_WhenStoring_ThenLeastRecentlyUsedIsEvicted) {
+    CoreMemoCache* cache = nullptr;
+    ASSERT_EQ(core_memo_create(&cache, 2, 0), CORE_ERROR_SUCCESS);
+    Matrix* A = MakeTestMatrix(2, 2, 0.0);
+    Matrix* R = MakeTestMatrix(2, 2, 1.0);
+    const Matrix* results[1] = { R };
+    int hit = 0;
+
+    CoreMemoKey k1 = KeyOf(A, 1.0), k2 = KeyOf(A, 2.0), k3 = KeyOf(A, 3.0);
+    ASSERT_EQ(core_memo_store(cache, &k1, results, 1), CORE_ERROR_SUCCESS);
+    ASSERT_EQ(core_memo_store(cache, &k2, results, 1), CORE_ERROR_SUCCESS);
+    ASSERT_EQ(core_memo_lookup(cache, &k1, &R, 1, &hit), CORE_ERROR_SUCCESS);   // k1 now newest
+    ASSERT_EQ(hit, 1);
+    ASSERT_EQ(core_memo_store(cache, &k3, results, 1), CORE_ERROR_SUCCESS);      // evicts k2
+
+    ASSERT_EQ(core_memo_lookup(cache, &k2, &R, 1, &hit), CORE_ERROR_SUCCESS);
+    EXPECT_EQ(hit, 0);
+    ASSERT_EQ(core_memo_lookup(cache, &k1, &R, 1, &hit), CORE_ERROR_SUCCESS);
+    EXPECT_EQ(hit, 1);
+    ASSERT_EQ(core_memo_lookup(cache, &k3, &R, 1, &hit), CORE_ERROR_SUCCESS);
+    EXPECT_EQ(hit, 1);
+
+    CoreMemoStats st;
+    ASSERT_EQ(core_memo_get_stats(cache, &st), CORE_ERROR_SUCCESS);
+    EXPECT_EQ(st.entries, 2);
+    EXPECT_EQ(st.evictions, 1u);
+
+    // A byte bound below two entries keeps one
+    const size_t one = st.bytes / 2;
+    CoreMemoCache* small = nullptr;
+    ASSERT_EQ(core_memo_create(&small, 100, one + one / 2), CORE_ERROR_SUCCESS);
+    ASSERT_EQ(core_memo_store(small, &k1, results, 1), CORE_ERROR_SUCCESS);
+    ASSERT_EQ(core_memo_store(small, &k2, results, 1), CORE_ERROR_SUCCESS);
+    ASSERT_EQ(core_memo_get_stats(small, &st), CORE_ERROR_SUCCESS);
+    EXPECT_EQ(st.entries, 1);
+    EXPECT_EQ(st.evictions, 1u);
+
+    ASSERT_EQ(core_memo_clear(cache), CORE_ERROR_SUCCESS);
+    ASSERT_EQ(core_memo_reset_stats(cache), CORE_ERROR_SUCCESS);
+    ASSERT_EQ(core_memo_get_stats(cache, &st), CORE_ERROR_SUCCESS);
+    EXPECT_EQ(st.entries, 0);
+    EXPECT_EQ(st.bytes, 0u);
+    EXPECT_EQ(st.hits + st.misses + st.evictions, 0u);
+
+    core_memo_destroy(small);
+    core_memo_destroy(cache);
+    matrix_core_free(A); matrix_core_free(R);
+}
+
+TEST(CoreMemo, GivenSharedCache_WhenManyThreadsLookUpAndStore_ThenCountsAddUp) {
+    CoreMemoCache* cache = nullptr;
+    ASSERT_EQ(core_memo_create(&cache, 16, 0), CORE_ERROR_SUCCESS);
+    const int threads = 4, rounds = 500, keys = 8;
+
+    std::vector<std::thread> pool;
+    std::vector<int> wrong(threads, 0);
+    for (int w = 0; w < threads; ++w) {
+        pool.emplace_back([&, w]() {
+            Matrix* A = MakeTestMatrix(4, 4, 0.0);
+            Matrix* R = MakeTestMatrix(4, 4, 0.0);
+            for (int r = 0; r < rounds; ++r) {
+                const double t = (r + w) % keys;
+                const CoreMemoKey key = KeyOf(A, t);
+                int hit = 0;
+                if (core_memo_lookup(cache, &key, &R, 1, &hit) != CORE_ERROR_SUCCESS) ++wrong[w];
+                if (hit) {
+                    if (R->data[0] != t) ++wrong[w];
+                }
+                else {
+                    for (int i = 0; i < 16; ++i) R->data[i] = t;
+                    const Matrix* results[1] = { R };
+                    if (core_memo_store(cache, &key, results, 1) != CORE_ERROR_SUCCESS) ++wrong[w];
+                }
+            }
+            matrix_core_free(A); matrix_core_free(R);
+        });
+    }
+    for (auto& th : pool) th.join();
+
+    CoreMemoStats st;
+    ASSERT_EQ(core_memo_get_stats(cache, &st), CORE_ERROR_SUCCESS);
+    for (int w = 0; w < threads; ++w) EXPECT_EQ(wrong[w], 0);
+    EXPECT_EQ(st.hits + st.misses, (uint64_t)threads * rounds);
+    EXPECT_EQ(st.entries, keys);
+    EXPECT_GE(st.hits, (uint64_t)(threads * rounds - threads * keys));
+
+    core_memo_destroy(cache);
+}
+
+TEST(CoreMemo, GivenInvalidArguments_WhenCalled_ThenRejected) {
+    CoreMemoCache* cache = nullptr;
+    EXPECT_EQ(core_memo_create(nullptr, 4, 0), CORE_ERROR_NULL);
+    EXPECT_EQ(core_memo_create(&cache, 0, 0), CORE_ERROR_INVALID_ARG);
+    EXPECT_EQ(cache, nullptr);
+    ASSERT_EQ(core_memo_create(&cache, 4, 0), CORE_ERROR_SUCCESS);
+
+    Matrix* A = MakeTestMatrix(2, 2, 0.0);
+    CoreMemoKey key = KeyOf(A, 1.0);
+    const Matrix* results[1] = { A };
+    int hit = 0;
+    EXPECT_EQ(core_memo_lookup(cache, &key, &A, 1, nullptr), CORE_ERROR_NULL);
+    EXPECT_EQ(core_memo_lookup(cache, &key, &A, 0, &hit), CORE_ERROR_INVALID_ARG);
+    EXPECT_EQ(core_memo_store(cache, nullptr, results, 1), CORE_ERROR_NULL);
+    key.count = CORE_MEMO_MAX_MATRICES + 1;
+    EXPECT_EQ(core_memo_store(cache, &key, results, 1), CORE_ERROR_INVALID_ARG);
+    key.count = 2;   // m[1] is NULL
+    EXPECT_EQ(core_memo_lookup(cache, &key, &A, 1, &hit), CORE_ERROR_NULL);
+    EXPECT_EQ(core_memo_get_stats(cache, nullptr), CORE_ERROR_NULL);
+    EXPECT_EQ(core_memo_clear(nullptr), CORE_ERROR_NULL);
+
+    EXPECT_EQ(core_memo_get_default(), nullptr);
+    core_memo_destroy(cache);
+    core_memo_destroy(nullptr);
+    matrix_core_free(A);
+}
+
+TEST(CoreMemo, GivenInstalledDefault_WhenDestroyed_ThenDefaultIsCleared) {
+    CoreMemoCache* a = nullptr;
+    CoreMemoCache* b = nullptr;
+    ASSERT_EQ(core_memo_create(&a, 4, 0), CORE_ERROR_SUCCESS);
+    ASSERT_EQ(core_memo_create(&b, 4, 0), CORE_ERROR_SUCCESS);
+
+    core_memo_set_default(a);
+    core_memo_destroy(b);   // not the default: left installed
+    EXPECT_EQ(core_memo_get_default(), a);
+    core_memo_destroy(a);
+    EXPECT_EQ(core_memo_get_default(), nullptr);
+}
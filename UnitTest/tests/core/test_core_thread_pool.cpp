@@ -0,0 +1,86 @@
+#include <gtest/gtest.h>
+#include <vector>
+
+extern "C" {
+#include "core_thread_pool.h"
+#include "core_error.h"
+}
+
+namespace {
+
+struct Coverage {
+    std::vector<int> hits;
+    int grain;
+    int misaligned;
+};
+
+CoreErrorStatus MarkRange(void* ctx, int begin, int end) {
+    Coverage* c = static_cast<Coverage*>(ctx);
+    if (begin % c->grain != 0) ++c->misaligned;   // only written when a test fails
+    for (int i = begin; i < end; ++i) ++c->hits[i];
+    return CORE_ERROR_SUCCESS;
+}
+
+CoreErrorStatus FailOnSecondHalf(void* ctx, int begin, int end) {
+    (void)end;
+    const int count = *static_cast<int*>(ctx);
+    return begin >= count / 2 ? CORE_ERROR_NUMERIC : CORE_ERROR_SUCCESS;
+}
+
+// Restores a serial pool after each test so other suites run unthreaded.
+class CoreThreadPoolTest : public ::testing::Test {
+protected:
+    void TearDown() override {
+        core_thread_pool_set_schedule(CORE_THREAD_POOL_STATIC);
+        core_thread_pool_shutdown();
+    }
+};
+
+} // namespace
+
+TEST_F(CoreThreadPoolTest, GivenDefaultPool_WhenQueried_ThenSingleWorker) {
+    EXPECT_EQ(core_thread_pool_get_workers(), 1);
+    EXPECT_EQ(core_thread_pool_get_schedule(), CORE_THREAD_POOL_STATIC);
+    EXPECT_GE(core_thread_pool_hardware_concurrency(), 1);
+}
+
+TEST_F(CoreThreadPoolTest, GivenWorkerCount_WhenSet_ThenReported) {
+    ASSERT_EQ(core_thread_pool_set_workers(4), CORE_ERROR_SUCCESS);
+    EXPECT_EQ(core_thread_pool_get_workers(), 4);
+    ASSERT_EQ(core_thread_pool_set_workers(0), CORE_ERROR_SUCCESS);
+    EXPECT_EQ(core_thread_pool_get_workers(), core_thread_pool_hardware_concurrency());
+    ASSERT_EQ(core_thread_pool_set_workers(1), CORE_ERROR_SUCCESS);
+    EXPECT_EQ(core_thread_pool_get_workers(), 1);
+}
+
+TEST_F(CoreThreadPoolTest, GivenInvalidArguments_WhenCalled_ThenRejected) {
+    EXPECT_EQ(core_thread_pool_set_workers(-1), CORE_ERROR_INVALID_ARG);
+    EXPECT_EQ(core_thread_pool_set_workers(CORE_THREAD_POOL_MAX_WORKERS + 1), CORE_ERROR_INVALID_ARG);
+    EXPECT_EQ(core_thread_pool_set_schedule((CoreThreadPoolSchedule)7), CORE_ERROR_INVALID_ARG);
+    EXPECT_EQ(core_thread_pool_parallel_for(10, 1, nullptr, nullptr), CORE_ERROR_NULL);
+    EXPECT_EQ(core_thread_pool_parallel_for(-1, 1, MarkRange, nullptr), CORE_ERROR_INVALID_ARG);
+}
+
+TEST_F(CoreThreadPoolTest, GivenEachSchedule_WhenParallelFor_ThenEveryIndexRunsOnceOnGrainBoundaries) {
+    ASSERT_EQ(core_thread_pool_set_workers(4), CORE_ERROR_SUCCESS);
+    const CoreThreadPoolSchedule schedules[] = { CORE_THREAD_POOL_STATIC, CORE_THREAD_POOL_DYNAMIC };
+    for (CoreThreadPoolSchedule schedule : schedules) {
+        ASSERT_EQ(core_thread_pool_set_schedule(schedule), CORE_ERROR_SUCCESS);
+        for (int count : { 1, 7, 64, 1001 }) {
+            Coverage c{ std::vector<int>(count, 0), 8, 0 };
+            ASSERT_EQ(core_thread_pool_parallel_for(count, c.grain, MarkRange, &c), CORE_ERROR_SUCCESS);
+            EXPECT_EQ(c.misaligned, 0);
+            for (int i = 0; i < count; ++i) ASSERT_EQ(c.hits[i], 1) << "schedule " << schedule << " index " << i;
+        }
+    }
+}
+
+TEST_F(CoreThreadPoolTest, GivenFailingRange_WhenParallelFor_ThenErrorReported) {
+    ASSERT_EQ(core_thread_pool_set_workers(3), CORE_ERROR_SUCCESS);
+    int count = 300;
+    EXPECT_EQ(core_thread_pool_parallel_for(count, 10, FailOnSecondHalf, &count), CORE_ERROR_NUMERIC);
+    // The pool stays usable afterwards
+    Coverage c{ std::vector<int>(count, 0), 1, 0 };
+    EXPECT_EQ(core_thread_pool_parallel_for(count, 1, MarkRange, &c), CORE_ERROR_SUCCESS);
+    for (int i = 0; i < count; ++i) ASSERT_EQ(c.hits[i], 1);
+}
@@ -0,0 +1,174 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <vector>
+
+extern "C" {
+#include "integrators/krylov.h"
+#include "matrix_exp.h"
+#include "matrix_linop.h"
+#include "matrix_ops.h"
+#include "core_matrix.h"
+#include "core_error.h"
+}
+
+#include "test_utils.h"
+
+// ========== Helpers ==========
+
+static double MaxRelDiff(const Matrix* X, const Matrix* R) {
+    double diff = 0.0, ref = 0.0;
+    for (int i = 0; i < X->rows; ++i) {
+        diff = std::fmax(diff, std::fabs(X->data[i * X->ld] - R->data[i * R->ld]));
+        ref = std::fmax(ref, std::fabs(R->data[i * R->ld]));
+    }
+    return diff / ref;
+}
+
+// Matrix-free 1-D heat equation with advection: c (v_{i-1} - 2 v_i + v_{i+1}) + b (v_{i+1} - v_{i-1})
+struct Stencil { double c, b; };
+
+static CoreErrorStatus ApplyStencil(void* ctx, MatrixTranspose, const Matrix* X, Matrix* Y) {
+    const Stencil* s = static_cast<Stencil*>(ctx);
+    const int n = X->rows;
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < X->cols; ++j) {
+            const double l = (i > 0) ? X->data[(i - 1) * X->ld + j] : 0.0;
+            const double r = (i + 1 < n) ? X->data[(i + 1) * X->ld + j] : 0.0;
+            Y->data[i * Y->ld + j] = s->c * (l - 2.0 * X->data[i * X->ld + j] + r) + s->b * (r - l);
+        }
+    }
+    return CORE_ERROR_SUCCESS;
+}
+
+// ========== krylov_expv ==========
+
+TEST(KrylovExpv, GivenDenseMatrix_WhenExpv_ThenMatchesDenseExponentialTimesV) {
+    const int n = 50;
+    Matrix* A = MakeTestMatrix(n, n, 0.4, 0.5);
+    Matrix* v = MakeTestMatrix(n, 1, 1.9, 1.0);
+    CoreErrorStatus err = CORE_ERROR_SUCCESS;
+    Matrix* w = matrix_core_create(n, 1, &err);
+    Matrix* E = matrix_core_create(n, n, &err);
+    Matrix* R = matrix_core_create(n, 1, &err);
+    MatrixLinearOperator op;
+    ASSERT_EQ(matrix_linop_dense(&op, A), CORE_ERROR_SUCCESS);
+    KrylovWorkspace ws;
+    ASSERT_EQ(krylov_workspace_init(&ws, n, 20), CORE_ERROR_SUCCESS);
+
+    for (double t : { 0.3, 2.0, -1.5 }) {
+        ASSERT_EQ(krylov_expv(&op, t, v, 1e-12, &ws, w), CORE_ERROR_SUCCESS);
+        ASSERT_EQ(matrix_exp_exponential(A, t, E), CORE_ERROR_SUCCESS);
+        ASSERT_EQ(matrix_ops_multiply(R, E, v), CORE_ERROR_SUCCESS);
+        EXPECT_LT(MaxRelDiff(w, R), 1e-10) << "t=" << t;
+        EXPECT_GE(ws.stats.steps, 1);
+        EXPECT_LE(ws.stats.error, 1e-10);
+    }
+
+    EXPECT_EQ(krylov_workspace_free(&ws), CORE_ERROR_SUCCESS);
+    matrix_core_free(A); matrix_core_free(v); matrix_core_free(w);
+    matrix_core_free(E); matrix_core_free(R);
+}
+
+TEST(KrylovExpv, GivenLargeMatrixFreeOperator_WhenExpv_ThenRestartsAndMatchesExpmv) {
+    // ||A|| t ~ 900: far beyond one Krylov step, so the propagator restarts
+    const int n = 2000;
+    Stencil st = { 100.0, 20.0 };
+    const MatrixLinearOperator op = { n, ApplyStencil, &st };
+    CoreErrorStatus err = CORE_ERROR_SUCCESS;
+    Matrix* v = matrix_core_create(n, 1, &err);
+    for (int i = 0; i < n; ++i) v->data[i] = std::exp(-std::pow((i - n / 2) / 50.0, 2));
+    Matrix* w = matrix_core_create(n, 1, &err);
+    Matrix* R = matrix_core_create(n, 1, &err);
+    const double t = 2.0;
+
+    KrylovWorkspace ws;
+    ASSERT_EQ(krylov_workspace_init(&ws, n, KRYLOV_DEFAULT_M), CORE_ERROR_SUCCESS);
+    ASSERT_EQ(krylov_expv(&op, t, v, 1e-10, &ws, w), CORE_ERROR_SUCCESS);
+    EXPECT_GT(ws.stats.steps, 1);
+    EXPECT_LE(ws.stats.hump, 1.0 + 1e-12);   // dissipative: ||w(t)|| never grows
+
+    std::vector<double> work(MATRIX_EXPMV_WORK(n, 1));
+    ASSERT_EQ(matrix_exp_multiply_op(&op, -2.0 * st.c, v, &t, 1, work.data(), &R), CORE_ERROR_SUCCESS);
+    EXPECT_LT(MaxRelDiff(w, R), 1e-8);
+
+    EXPECT_EQ(krylov_workspace_free(&ws), CORE_ERROR_SUCCESS);
+    matrix_core_free(v); matrix_core_free(w); matrix_core_free(R);
+}
+
+TEST(KrylovExpv, GivenInvariantSubspace_WhenExpv_ThenHappyBreakdownGivesOneExactStep) {
+    // v spans an eigenvector of A: the first Arnoldi step already breaks down
+    const int n = 12;
+    CoreErrorStatus err = CORE_ERROR_SUCCESS;
+    Matrix* A = matrix_core_create(n, n, &err);
+    ASSERT_EQ(matrix_ops_set_zero(A), CORE_ERROR_SUCCESS);
+    for (int i = 0; i < n; ++i) A->data[i * n + i] = -0.5 * (i + 1);
+    A->data[0 * n + 5] = 3.0;   // non-normal, but e_2 is still an eigenvector
+    Matrix* v = matrix_core_create(n, 1, &err);
+    ASSERT_EQ(matrix_ops_set_zero(v), CORE_ERROR_SUCCESS);
+    v->data[2] = 2.0;
+    MatrixLinearOperator op;
+    ASSERT_EQ(matrix_linop_dense(&op, A), CORE_ERROR_SUCCESS);
+    KrylovWorkspace ws;
+    ASSERT_EQ(krylov_workspace_init(&ws, n, 8), CORE_ERROR_SUCCESS);
+
+    // in place: w aliases v
+    ASSERT_EQ(krylov_expv(&op, 4.0, v, 1e-12, &ws, v), CORE_ERROR_SUCCESS);
+    EXPECT_EQ(ws.stats.steps, 1);
+    EXPECT_EQ(ws.stats.applies, 1);
+    EXPECT_NEAR(v->data[2], 2.0 * std::exp(-1.5 * 4.0), 1e-15);
+    for (int i = 0; i < n; ++i) {
+        if (i != 2) { EXPECT_EQ(v->data[i], 0.0); }
+    }
+
+    EXPECT_EQ(krylov_workspace_free(&ws), CORE_ERROR_SUCCESS);
+    matrix_core_free(A); matrix_core_free(v);
+}
+
+TEST(KrylovExpv, GivenKrylovDimensionAboveOrder_WhenInit_ThenCappedAndExact) {
+    const int n = 6;
+    Matrix* A = MakeTestMatrix(n, n, 0.9, 1.0);
+    Matrix* v = MakeTestMatrix(n, 1, 0.1, 1.0);
+    CoreErrorStatus err = CORE_ERROR_SUCCESS;
+    Matrix* w = matrix_core_create(n, 1, &err);
+    Matrix* E = matrix_core_create(n, n, &err);
+    Matrix* R = matrix_core_create(n, 1, &err);
+    MatrixLinearOperator op;
+    ASSERT_EQ(matrix_linop_dense(&op, A), CORE_ERROR_SUCCESS);
+    KrylovWorkspace ws;
+    ASSERT_EQ(krylov_workspace_init(&ws, n, KRYLOV_DEFAULT_M), CORE_ERROR_SUCCESS);
+    EXPECT_EQ(ws.m, n);
+
+    ASSERT_EQ(krylov_expv(&op, 1.0, v, 1e-12, &ws, w), CORE_ERROR_SUCCESS);
+    ASSERT_EQ(matrix_exp_exponential(A, 1.0, E), CORE_ERROR_SUCCESS);
+    ASSERT_EQ(matrix_ops_multiply(R, E, v), CORE_ERROR_SUCCESS);
+    EXPECT_LT(MaxRelDiff(w, R), 1e-12);
+
+    EXPECT_EQ(krylov_workspace_free(&ws), CORE_ERROR_SUCCESS);
+    matrix_core_free(A); matrix_core_free(v); matrix_core_free(w);
+    matrix_core_free(E); matrix_core_free(R);
+}
+
+TEST(KrylovExpv, GivenInvalidArguments_WhenExpv_ThenReturnsError) {
+    const int n = 4;
+    Matrix* A = MakeTestMatrix(n, n, 0.2, 1.0);
+    Matrix* v = MakeTestMatrix(n, 1, 0.3, 1.0);
+    Matrix* v5 = MakeTestMatrix(n + 1, 1, 0.3, 1.0);
+    MatrixLinearOperator op;
+    ASSERT_EQ(matrix_linop_dense(&op, A), CORE_ERROR_SUCCESS);
+    KrylovWorkspace ws;
+    EXPECT_EQ(krylov_workspace_init(&ws, 0, 3), CORE_ERROR_INVALID_ARG);
+    EXPECT_EQ(krylov_workspace_init(&ws, n, 0), CORE_ERROR_INVALID_ARG);
+    EXPECT_EQ(krylov_workspace_init(nullptr, n, 3), CORE_ERROR_NULL);
+    ASSERT_EQ(krylov_workspace_init(&ws, n, 3), CORE_ERROR_SUCCESS);
+
+    EXPECT_EQ(krylov_expv(nullptr, 1.0, v, 1e-8, &ws, v), CORE_ERROR_NULL);
+    EXPECT_EQ(krylov_expv(&op, 1.0, v, 1e-8, &ws, nullptr), CORE_ERROR_NULL);
+    EXPECT_EQ(krylov_expv(&op, 1.0, v5, 1e-8, &ws, v5), CORE_ERROR_DIMENSION);
+    EXPECT_EQ(krylov_expv(&op, 1.0, v, 0.0, &ws, v), CORE_ERROR_INVALID_ARG);
+    EXPECT_EQ(krylov_expv(&op, NAN, v, 1e-8, &ws, v), CORE_ERROR_INVALID_ARG);
+
+    EXPECT_EQ(krylov_workspace_free(&ws), CORE_ERROR_SUCCESS);
+    KrylovWorkspace empty = {};
+    EXPECT_EQ(krylov_expv(&op, 1.0, v, 1e-8, &empty, v), CORE_ERROR_NULL);
+    matrix_core_free(A); matrix_core_free(v); matrix_core_free(v5);
+}
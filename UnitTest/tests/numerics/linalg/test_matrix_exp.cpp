@@ -1,13 +1,19 @@
 #include <gtest/gtest.h>
 #include <cmath>
+#include <limits>
+#include <vector>
 
 extern "C" {
 #include "matrix_exp.h"
+#include "core_memo.h"
+#include "core_thread_pool.h"
 #include "matrix_ops.h"
 #include "core_matrix.h"
 #include "core_error.h"
 }
 
+#include "test_utils.h"
+
 // Helper to check if matrix is identity
 static void ExpectIdentity(const Matrix* m) {
     CoreErrorStatus err = CORE_ERROR_SUCCESS;
@@ -120,3 +126,338 @@ TEST(MatrixExp, DimensionMismatch) {
     matrix_core_free(R);
 }
 
+
+// The workspace variant reuses one ExpmWorkspace across calls and matches exactly.
+TEST(MatrixExp, WorkspaceVariantMatchesAllocatingVersion) {
+    CoreErrorStatus err = CORE_ERROR_SUCCESS;
+    Matrix* A = matrix_core_create(3, 3, &err); ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+    Matrix* R = matrix_core_create(3, 3, &err); ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+    Matrix* Rws = matrix_core_create(3, 3, &err); ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+    const double a[9] = { 0.0, 1.0, 0.0, 0.0, 0.0, 1.0, -2.0, -3.0, -0.5 };
+    for (int i = 0; i < 9; ++i) A->data[i] = a[i];
+
+    ExpmWorkspace ws;
+    ASSERT_EQ(pade_expm_workspace_init(&ws, 3), CORE_ERROR_SUCCESS);
+    for (double t : { 0.01, 0.5, 7.0 }) {
+        ASSERT_EQ(matrix_exp_exponential(A, t, R), CORE_ERROR_SUCCESS);
+        ASSERT_EQ(matrix_exp_exponential_ws(A, t, &ws, Rws), CORE_ERROR_SUCCESS);
+        for (int i = 0; i < 9; ++i) EXPECT_EQ(Rws->data[i], R->data[i]) << "t=" << t;
+    }
+    EXPECT_EQ(pade_expm_workspace_free(&ws), CORE_ERROR_SUCCESS);
+
+    ASSERT_EQ(pade_expm_workspace_init(&ws, 2), CORE_ERROR_SUCCESS);
+    EXPECT_EQ(matrix_exp_exponential_ws(A, 1.0, &ws, Rws), CORE_ERROR_DIMENSION);
+    EXPECT_EQ(matrix_exp_exponential_ws(A, 1.0, nullptr, Rws), CORE_ERROR_NULL);
+    EXPECT_EQ(pade_expm_workspace_free(&ws), CORE_ERROR_SUCCESS);
+
+    matrix_core_free(A);
+    matrix_core_free(R);
+    matrix_core_free(Rws);
+}
+
+TEST(MatrixExp, GivenDefaultMemoCache_WhenRepeated_ThenServedFromCacheBitIdentical) {
+    CoreErrorStatus err = CORE_ERROR_SUCCESS;
+    const int n = 6;
+    Matrix* A = matrix_core_create(n, n, &err); ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+    Matrix* R = matrix_core_create(n, n, &err); ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+    Matrix* Rc = matrix_core_create(n, n, &err); ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+    for (int i = 0; i < n * n; ++i) A->data[i] = std::sin(0.3 * i) - (i % (n + 1) == 0 ? 1.0 : 0.0);
+
+    CoreMemoCache* cache = nullptr;
+    ASSERT_EQ(core_memo_create(&cache, 4, 0), CORE_ERROR_SUCCESS);
+    core_memo_set_default(cache);
+    for (double t : { 0.2, 3.0 }) {
+        ASSERT_EQ(matrix_exp_exponential(A, t, Rc), CORE_ERROR_SUCCESS);   // miss, stored
+        for (int i = 0; i < n * n; ++i) Rc->data[i] = 0.0;
+        ASSERT_EQ(matrix_exp_exponential(A, t, Rc), CORE_ERROR_SUCCESS);   // hit
+        core_memo_set_default(nullptr);
+        ASSERT_EQ(matrix_exp_exponential(A, t, R), CORE_ERROR_SUCCESS);
+        core_memo_set_default(cache);
+        for (int i = 0; i < n * n; ++i) EXPECT_EQ(Rc->data[i], R->data[i]) << "t=" << t;
+    }
+    core_memo_set_default(nullptr);
+
+    CoreMemoStats st;
+    ASSERT_EQ(core_memo_get_stats(cache, &st), CORE_ERROR_SUCCESS);
+    EXPECT_EQ(st.hits, 2u);
+    EXPECT_EQ(st.misses, 2u);
+    EXPECT_EQ(st.entries, 2);
+
+    core_memo_destroy(cache);
+    matrix_core_free(A);
+    matrix_core_free(R);
+    matrix_core_free(Rc);
+}
+
+// max |X - exp(tA)| relative to max |exp(tA)|
+static double ExpmError(const Matrix* A, double t, const Matrix* X) {
+    CoreErrorStatus err = CORE_ERROR_SUCCESS;
+    const int n = A->rows;
+    Matrix* E = matrix_core_create(n, n, &err);
+    EXPECT_EQ(matrix_exp_exponential(A, t, E), CORE_ERROR_SUCCESS);
+    double diff = 0.0, ref = 0.0;
+    for (int i = 0; i < n * n; ++i) {
+        diff = std::fmax(diff, std::fabs(X->data[i] - E->data[i]));
+        ref = std::fmax(ref, std::fabs(E->data[i]));
+    }
+    matrix_core_free(E);
+    return diff / ref;
+}
+
+// ========== Batched exponentials ==========
+
+TEST(MatrixExpBatch, GivenManyTimes_WhenExponentialTimes_ThenMatchesOneByOne) {
+    const int n = 24;
+    Matrix* A = MakeTestMatrix(n, n, 0.5, 0.4);
+    const std::vector<double> t = { 0.0, 1e-5, 0.01, -0.3, 0.8, 2.5, -7.0, 40.0 };
+    std::vector<Matrix*> R;
+    for (size_t i = 0; i < t.size(); ++i) R.push_back(MakeTestMatrix(n, n, 0.0, 1.0));
+
+    // serially and spread over the pool
+    for (int workers : { 1, 3 }) {
+        ASSERT_EQ(core_thread_pool_set_workers(workers), CORE_ERROR_SUCCESS);
+        const CoreErrorStatus status = matrix_exp_exponential_times(A, t.data(), (int)t.size(), R.data());
+        core_thread_pool_shutdown();
+        ASSERT_EQ(status, CORE_ERROR_SUCCESS);
+        ExpectIdentity(R[0]);
+        for (size_t i = 1; i < t.size(); ++i) {
+            EXPECT_LT(ExpmError(A, t[i], R[i]), 1e-12) << "t=" << t[i] << " workers=" << workers;
+        }
+    }
+
+    matrix_core_free(A);
+    for (Matrix* M : R) matrix_core_free(M);
+}
+
+TEST(MatrixExpBatch, GivenMultiplesOfStep_WhenExponentialMultiples_ThenMatchesDirectExponential) {
+    const int n = 10;
+    const double Ts = 0.05;
+    Matrix* A = MakeTestMatrix(n, n, 1.1, 1.0);
+    for (int i = 0; i < n; ++i) A->data[i * n + i] -= 2.0;
+    const std::vector<int> k = { 1, 0, 2, 3, 8, 13, 100 };
+    std::vector<Matrix*> R;
+    for (size_t i = 0; i < k.size(); ++i) R.push_back(MakeTestMatrix(n, n, 0.0, 1.0));
+
+    ASSERT_EQ(matrix_exp_exponential_multiples(A, Ts, k.data(), (int)k.size(), R.data()), CORE_ERROR_SUCCESS);
+    ExpectIdentity(R[1]);
+    EXPECT_LT(ExpmError(A, Ts, R[0]), 1e-15);   // exp(Ts A) itself
+    for (size_t i = 2; i < k.size(); ++i) {
+        EXPECT_LT(ExpmError(A, k[i] * Ts, R[i]), 1e-12) << "k=" << k[i];
+    }
+
+    matrix_core_free(A);
+    for (Matrix* M : R) matrix_core_free(M);
+}
+
+TEST(MatrixExpBatch, GivenManyMatrices_WhenExponentialBatch_ThenBitIdenticalToSingleCalls) {
+    const int n = 12, count = 9;
+    std::vector<Matrix*> A, R;
+    for (int j = 0; j < count; ++j) {
+        A.push_back(MakeTestMatrix(n, n, 0.3 * j, 0.2 + 0.3 * j));
+        R.push_back(MakeTestMatrix(n, n, 0.0, 1.0));
+    }
+    Matrix* E = MakeTestMatrix(n, n, 0.0, 1.0);
+
+    for (int workers : { 1, 4 }) {
+        ASSERT_EQ(core_thread_pool_set_workers(workers), CORE_ERROR_SUCCESS);
+        const CoreErrorStatus status = matrix_exp_exponential_batch(A.data(), 0.7, count, R.data());
+        core_thread_pool_shutdown();
+        ASSERT_EQ(status, CORE_ERROR_SUCCESS);
+        for (int j = 0; j < count; ++j) {
+            ASSERT_EQ(matrix_exp_exponential(A[j], 0.7, E), CORE_ERROR_SUCCESS);
+            for (int i = 0; i < n * n; ++i) ASSERT_EQ(R[j]->data[i], E->data[i]) << "j=" << j;
+        }
+    }
+
+    // in place
+    ASSERT_EQ(matrix_exp_exponential(A[2], 0.7, E), CORE_ERROR_SUCCESS);
+    ASSERT_EQ(matrix_exp_exponential_batch(A.data(), 0.7, count, A.data()), CORE_ERROR_SUCCESS);
+    for (int i = 0; i < n * n; ++i) EXPECT_EQ(A[2]->data[i], E->data[i]);
+
+    matrix_core_free(E);
+    for (Matrix* M : A) matrix_core_free(M);
+    for (Matrix* M : R) matrix_core_free(M);
+}
+
+TEST(MatrixExpBatch, GivenInvalidArguments_WhenBatched_ThenReturnsError) {
+    const int n = 4;
+    Matrix* A = MakeTestMatrix(n, n, 0.1, 1.0);
+    Matrix* B = MakeTestMatrix(n + 1, n + 1, 0.1, 1.0);
+    Matrix* R = MakeTestMatrix(n, n, 0.2, 1.0);
+    const double t[2] = { 1.0, std::numeric_limits<double>::quiet_NaN() };
+    const int k[2] = { 1, -1 };
+    Matrix* self[1] = { A };
+    Matrix* wrong[1] = { B };
+    const Matrix* mixed[2] = { A, B };
+    Matrix* out[2] = { R, R };
+
+    EXPECT_EQ(matrix_exp_exponential_times(nullptr, t, 1, &R), CORE_ERROR_NULL);
+    EXPECT_EQ(matrix_exp_exponential_times(A, nullptr, 1, &R), CORE_ERROR_NULL);
+    EXPECT_EQ(matrix_exp_exponential_times(A, t, 0, &R), CORE_ERROR_INVALID_ARG);
+    EXPECT_EQ(matrix_exp_exponential_times(A, t, 2, out), CORE_ERROR_INVALID_ARG);
+    EXPECT_EQ(matrix_exp_exponential_times(A, t, 1, wrong), CORE_ERROR_DIMENSION);
+    EXPECT_EQ(matrix_exp_exponential_times(A, t, 1, self), CORE_ERROR_INVALID_ARG);
+    EXPECT_EQ(matrix_exp_exponential_multiples(A, 0.1, k, 2, out), CORE_ERROR_INVALID_ARG);
+    EXPECT_EQ(matrix_exp_exponential_multiples(A, t[1], k, 1, &R), CORE_ERROR_INVALID_ARG);
+    EXPECT_EQ(matrix_exp_exponential_multiples(A, 0.1, nullptr, 1, &R), CORE_ERROR_NULL);
+    EXPECT_EQ(matrix_exp_exponential_batch(mixed, 1.0, 2, out), CORE_ERROR_DIMENSION);
+    EXPECT_EQ(matrix_exp_exponential_batch(mixed, 1.0, 0, out), CORE_ERROR_INVALID_ARG);
+    EXPECT_EQ(matrix_exp_exponential_batch(nullptr, 1.0, 1, out), CORE_ERROR_NULL);
+
+    // a power of A overflows: the items fall back to scaling first
+    for (int i = 0; i < n * n; ++i) A->data[i] *= 1e80;
+    Matrix* S = MakeTestMatrix(n, n, 0.0, 1.0);
+    Matrix* big[2] = { R, S };
+    const double ts[2] = { 1e-80, 2e-80 };
+    ASSERT_EQ(matrix_exp_exponential_times(A, ts, 2, big), CORE_ERROR_SUCCESS);
+    EXPECT_LT(ExpmError(A, ts[1], S), 1e-13);
+
+    matrix_core_free(A); matrix_core_free(B); matrix_core_free(R); matrix_core_free(S);
+}
+
+// ========== matrix_exp_multiply ==========
+
+// max |X - exp(tA) V| relative to max |exp(tA) V|, the reference from the dense exponential
+static double ExpmvError(const Matrix* A, double t, const Matrix* V, const Matrix* X) {
+    CoreErrorStatus err = CORE_ERROR_SUCCESS;
+    const int n = A->rows, k = V->cols;
+    Matrix* E = matrix_core_create(n, n, &err);
+    Matrix* R = matrix_core_create(n, k, &err);
+    EXPECT_EQ(matrix_exp_exponential(A, t, E), CORE_ERROR_SUCCESS);
+    EXPECT_EQ(matrix_ops_multiply(R, E, V), CORE_ERROR_SUCCESS);
+    double diff = 0.0, ref = 0.0;
+    for (int i = 0; i < n * k; ++i) {
+        diff = std::fmax(diff, std::fabs(X->data[i] - R->data[i]));
+        ref = std::fmax(ref, std::fabs(R->data[i]));
+    }
+    matrix_core_free(E);
+    matrix_core_free(R);
+    return diff / ref;
+}
+
+TEST(MatrixExpMultiply, GivenTimeGrid_WhenMultiply_ThenMatchesDenseExponentialTimesV) {
+    const int n = 40, k = 3;
+    Matrix* A = MakeTestMatrix(n, n, 0.3, 0.4);
+    Matrix* V = MakeTestMatrix(n, k, 1.1, 1.0);
+    // unsorted, negative, repeated and zero times
+    const double t[] = { 0.5, -0.3, 2.0, 2.0, 0.0 };
+    const int nt = 5;
+    CoreErrorStatus err = CORE_ERROR_SUCCESS;
+    std::vector<Matrix*> out(nt);
+    for (Matrix*& M : out) M = matrix_core_create(n, k, &err);
+    std::vector<double> work(MATRIX_EXPMV_WORK(n, k));
+
+    ASSERT_EQ(matrix_exp_multiply(A, V, t, nt, work.data(), out.data()), CORE_ERROR_SUCCESS);
+    for (int i = 0; i < nt; ++i) {
+        EXPECT_LT(ExpmvError(A, t[i], V, out[i]), 1e-12) << "t=" << t[i];
+    }
+
+    matrix_core_free(A); matrix_core_free(V);
+    for (Matrix* M : out) matrix_core_free(M);
+}
+
+TEST(MatrixExpMultiply, GivenLargeNormNonNormalMatrix_WhenMultiply_ThenAccurate) {
+    // ||A||_1 is large enough that the degree and substeps come from the
+    // estimates of ||A^p||_1^(1/p); the diagonal spread keeps the shift from
+    // absorbing the norm
+    const int n = 60, k = 2;
+    Matrix* A = MakeTestMatrix(n, n, 2.0, 3.0);
+    for (int i = 0; i < n; ++i) A->data[i * n + i] = -0.5 * i;
+    Matrix* V = MakeTestMatrix(n, k, 0.7, 1.0);
+    CoreErrorStatus err = CORE_ERROR_SUCCESS;
+    Matrix* X = matrix_core_create(n, k, &err);
+    std::vector<double> work(MATRIX_EXPMV_WORK(n, k));
+
+    const double t = 0.8;
+    ASSERT_EQ(matrix_exp_multiply(A, V, &t, 1, work.data(), &X), CORE_ERROR_SUCCESS);
+    EXPECT_LT(ExpmvError(A, t, V, X), 1e-11);
+
+    matrix_core_free(A); matrix_core_free(V); matrix_core_free(X);
+}
+
+// Matrix-free 1-D Laplacian (2 on the diagonal, -1 off it) scaled by c
+struct Laplacian1D { double c; };
+
+static CoreErrorStatus ApplyLaplacian(void* ctx, MatrixTranspose, const Matrix* X, Matrix* Y) {
+    const double c = static_cast<Laplacian1D*>(ctx)->c;
+    const int n = X->rows, k = X->cols;
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < k; ++j) {
+            double v = 2.0 * X->data[i * X->ld + j];
+            if (i > 0) v -= X->data[(i - 1) * X->ld + j];
+            if (i + 1 < n) v -= X->data[(i + 1) * X->ld + j];
+            Y->data[i * Y->ld + j] = -c * v;
+        }
+    }
+    return CORE_ERROR_SUCCESS;
+}
+
+TEST(MatrixExpMultiply, GivenMatrixFreeOperator_WhenMultiplyOp_ThenMatchesDenseMatrix) {
+    const int n = 120, k = 1;
+    Laplacian1D lap = { 25.0 };
+    const MatrixLinearOperator op = { n, ApplyLaplacian, &lap };
+    CoreErrorStatus err = CORE_ERROR_SUCCESS;
+    Matrix* A = matrix_core_create(n, n, &err);
+    ASSERT_EQ(matrix_ops_set_zero(A), CORE_ERROR_SUCCESS);
+    for (int i = 0; i < n; ++i) {
+        A->data[i * n + i] = -2.0 * lap.c;
+        if (i > 0) A->data[i * n + i - 1] = lap.c;
+        if (i + 1 < n) A->data[i * n + i + 1] = lap.c;
+    }
+    Matrix* V = MakeTestMatrix(n, k, 0.2, 1.0);
+    Matrix* X0 = matrix_core_create(n, k, &err);
+    Matrix* X1 = matrix_core_create(n, k, &err);
+    Matrix* out[2] = { X0, X1 };
+    const double t[2] = { 0.01, 0.1 };
+    std::vector<double> work(MATRIX_EXPMV_WORK(n, k));
+
+    // with and without the trace shift
+    for (double shift : { -2.0 * lap.c, 0.0 }) {
+        ASSERT_EQ(matrix_exp_multiply_op(&op, shift, V, t, 2, work.data(), out), CORE_ERROR_SUCCESS);
+        EXPECT_LT(ExpmvError(A, t[0], V, X0), 1e-12) << "shift=" << shift;
+        EXPECT_LT(ExpmvError(A, t[1], V, X1), 1e-12) << "shift=" << shift;
+    }
+
+    matrix_core_free(A); matrix_core_free(V); matrix_core_free(X0); matrix_core_free(X1);
+}
+
+TEST(MatrixExpMultiply, GivenZeroTimeInPlace_WhenMultiply_ThenVUnchanged) {
+    const int n = 5, k = 2;
+    Matrix* A = MakeTestMatrix(n, n, 0.1, 1.0);
+    Matrix* V = MakeTestMatrix(n, k, 0.9, 1.0);
+    std::vector<double> before(V->data, V->data + n * k);
+    std::vector<double> work(MATRIX_EXPMV_WORK(n, k));
+    const double t = 0.0;
+
+    ASSERT_EQ(matrix_exp_multiply(A, V, &t, 1, work.data(), &V), CORE_ERROR_SUCCESS);
+    for (int i = 0; i < n * k; ++i) EXPECT_EQ(V->data[i], before[i]);
+
+    matrix_core_free(A); matrix_core_free(V);
+}
+
+TEST(MatrixExpMultiply, GivenInvalidArguments_WhenMultiply_ThenReturnsError) {
+    const int n = 4;
+    Matrix* A = MakeTestMatrix(n, n, 0.1, 1.0);
+    Matrix* R = MakeTestMatrix(n, n + 1, 0.1, 1.0);
+    Matrix* V = MakeTestMatrix(n, 2, 0.2, 1.0);
+    Matrix* W = MakeTestMatrix(n, 3, 0.2, 1.0);
+    Matrix* X = MakeTestMatrix(n, 2, 0.3, 1.0);
+    std::vector<double> work(MATRIX_EXPMV_WORK(n, 3));
+    const double t[2] = { 1.0, std::numeric_limits<double>::quiet_NaN() };
+
+    EXPECT_EQ(matrix_exp_multiply(nullptr, V, t, 1, work.data(), &X), CORE_ERROR_NULL);
+    EXPECT_EQ(matrix_exp_multiply(A, V, nullptr, 1, work.data(), &X), CORE_ERROR_NULL);
+    EXPECT_EQ(matrix_exp_multiply(A, V, t, 1, nullptr, &X), CORE_ERROR_NULL);
+    EXPECT_EQ(matrix_exp_multiply(R, V, t, 1, work.data(), &X), CORE_ERROR_DIMENSION);
+    EXPECT_EQ(matrix_exp_multiply(A, V, t, 1, work.data(), &W), CORE_ERROR_DIMENSION);
+    EXPECT_EQ(matrix_exp_multiply(A, V, t, 0, work.data(), &X), CORE_ERROR_INVALID_ARG);
+    Matrix* two[2] = { X, X };
+    EXPECT_EQ(matrix_exp_multiply(A, V, t, 2, work.data(), two), CORE_ERROR_INVALID_ARG);
+
+    A->data[5] = std::numeric_limits<double>::infinity();
+    EXPECT_EQ(matrix_exp_multiply(A, V, t, 1, work.data(), &X), CORE_ERROR_INVALID_ARG);
+    EXPECT_EQ(matrix_exp_multiply_op(nullptr, 0.0, V, t, 1, work.data(), &X), CORE_ERROR_NULL);
+
+    matrix_core_free(A); matrix_core_free(R); matrix_core_free(V);
+    matrix_core_free(W); matrix_core_free(X);
+}
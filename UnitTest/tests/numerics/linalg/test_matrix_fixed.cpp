@@ -0,0 +1,155 @@
+#include <gtest/gtest.h>
+#include <cmath>
+
+#include "matrix_fixed.h"
+
+extern "C" {
+#include "core_matrix.h"
+#include "matrix_ops.h"
+#include "matrix_solve.h"
+#include "pade.h"
+#include "core_error.h"
+}
+
+// ========== Helpers ==========
+template <int R, int C>
+static dts::SMatrix<R, C> MakePattern(double seed, double scale = 1.0) {
+    dts::SMatrix<R, C> m;
+    for (int i = 0; i < R; ++i) {
+        for (int j = 0; j < C; ++j) {
+            m(i, j) = scale * std::sin(seed + 0.7 * i + 0.31 * j) + (i == j ? 2.0 : 0.0);
+        }
+    }
+    return m;
+}
+
+template <int R, int C>
+static Matrix* ToHeap(const dts::SMatrix<R, C>& s) {
+    CoreErrorStatus err = CORE_ERROR_SUCCESS;
+    Matrix* m = matrix_core_create(R, C, &err);
+    if (m) dts::smatrix_to(m, s);
+    return m;
+}
+
+template <int R, int C>
+static void ExpectNearHeap(const dts::SMatrix<R, C>& s, const Matrix* m, double tol) {
+    ASSERT_EQ(m->rows, R);
+    ASSERT_EQ(m->cols, C);
+    for (int i = 0; i < R; ++i) {
+        for (int j = 0; j < C; ++j) {
+            EXPECT_NEAR(s(i, j), m->data[i * m->ld + j], tol) << "(" << i << "," << j << ")";
+        }
+    }
+}
+
+// ========== Arithmetic ==========
+TEST(MatrixFixed, GivenSmallMatrices_WhenMultiply_ThenMatchesMatrixOps) {
+    const auto A = MakePattern<3, 4>(0.1);
+    const auto B = MakePattern<4, 2>(0.9);
+    const dts::SMatrix<3, 2> C = A * B;
+
+    Matrix* hA = ToHeap(A);
+    Matrix* hB = ToHeap(B);
+    Matrix* hC = matrix_core_create(3, 2, nullptr);
+    ASSERT_EQ(matrix_ops_multiply(hC, hA, hB), CORE_ERROR_SUCCESS);
+    ExpectNearHeap(C, hC, 1e-14);
+
+    const auto T = dts::transpose(A);
+    EXPECT_EQ(T(3, 1), A(1, 3));
+
+    const auto S = A + 2.0 * A - A;
+    for (int k = 0; k < 12; ++k) EXPECT_DOUBLE_EQ(S.a[k], 2.0 * A.a[k]);
+
+    for (Matrix* m : { hA, hB, hC }) matrix_core_free(m);
+}
+
+TEST(MatrixFixed, GivenIdentity_WhenMultiply_ThenUnchanged) {
+    const auto A = MakePattern<5, 5>(0.4);
+    const auto I = dts::SMatrix<5, 5>::identity();
+    const auto P = I * A;
+    EXPECT_EQ(P.a, A.a);
+}
+
+// ========== Interop ==========
+TEST(MatrixFixed, GivenMatrixOrView_WhenConvert_ThenRoundTrips) {
+    CoreErrorStatus err = CORE_ERROR_SUCCESS;
+    Matrix* big = matrix_core_create(4, 5, &err);
+    ASSERT_EQ(matrix_ops_fill_sequential(big, 1.0, 1.0), CORE_ERROR_SUCCESS);
+
+    MatrixView v;
+    ASSERT_EQ(matrix_view_block(&v, big, 1, 2, 2, 3), CORE_ERROR_SUCCESS);
+    dts::SMatrix<2, 3> s;
+    ASSERT_EQ(dts::smatrix_from(s, &v), CORE_ERROR_SUCCESS);
+    EXPECT_EQ(s(0, 0), 8.0);
+    EXPECT_EQ(s(1, 2), 15.0);
+
+    s(1, 1) = -1.0;
+    ASSERT_EQ(dts::smatrix_to(&v, s), CORE_ERROR_SUCCESS);
+    EXPECT_EQ(matrix_ops_get(big, 2, 3, &err), -1.0);
+
+    dts::SMatrix<3, 3> wrong;
+    EXPECT_EQ(dts::smatrix_from(wrong, &v), CORE_ERROR_DIMENSION);
+    EXPECT_EQ(dts::smatrix_to(nullptr, s), CORE_ERROR_NULL);
+
+    // The C API works directly on fixed-size storage through a view
+    MatrixView sv = s.view();
+    ASSERT_EQ(matrix_ops_scale(&sv, 2.0), CORE_ERROR_SUCCESS);
+    EXPECT_EQ(s(1, 1), -2.0);
+
+    matrix_core_free(big);
+}
+
+// ========== Solve ==========
+TEST(MatrixFixed, GivenNonsingularSystem_WhenSolve_ThenMatchesMatrixSolveLU) {
+    const auto A = MakePattern<6, 6>(0.2, 3.0);   // needs pivoting
+    const auto B = MakePattern<6, 2>(1.3);
+    dts::SMatrix<6, 2> X;
+    ASSERT_EQ(dts::solve(A, B, X), CORE_ERROR_SUCCESS);
+
+    Matrix* hA = ToHeap(A);
+    Matrix* hB = ToHeap(B);
+    Matrix* hX = matrix_core_create(6, 2, nullptr);
+    ASSERT_EQ(matrix_solve_LU(hA, hX, hB), CORE_ERROR_SUCCESS);
+    ExpectNearHeap(X, hX, 1e-12);
+
+    const auto R = A * X - B;
+    EXPECT_LT(dts::norm_1(R), 1e-12);
+
+    for (Matrix* m : { hA, hB, hX }) matrix_core_free(m);
+}
+
+TEST(MatrixFixed, GivenSingularMatrix_WhenSolve_ThenErrNumeric) {
+    dts::SMatrix<3, 3> A;   // zero
+    dts::SMatrix<3, 1> b, x;
+    EXPECT_EQ(dts::solve(A, b, x), CORE_ERROR_NUMERIC);
+}
+
+// ========== Expm ==========
+TEST(MatrixFixed, GivenMatricesOfVaryingNorm_WhenExpm_ThenMatchesPadeExpm) {
+    // Scales span every Pade order and several squarings.
+    for (double scale : { 1e-4, 0.05, 0.4, 1.5, 6.0, 40.0 }) {
+        const auto A = scale * MakePattern<4, 4>(0.5, 1.0);
+        dts::SMatrix<4, 4> E;
+        ASSERT_EQ(dts::expm(A, E), CORE_ERROR_SUCCESS);
+
+        Matrix* hA = ToHeap(A);
+        Matrix* hE = matrix_core_create(4, 4, nullptr);
+        ASSERT_EQ(pade_expm(hA, hE), CORE_ERROR_SUCCESS);
+        double ref = 0.0;
+        for (int k = 0; k < 16; ++k) ref = std::fmax(ref, std::fabs(hE->data[k]));
+        ExpectNearHeap(E, hE, 1e-13 * ref);
+
+        matrix_core_free(hA);
+        matrix_core_free(hE);
+    }
+}
+
+TEST(MatrixFixed, GivenDiagonal_WhenExpm_ThenExponentiatesDiagonal) {
+    dts::SMatrix<2, 2> A;
+    A(0, 0) = -1.0;
+    A(1, 1) = 0.5;
+    ASSERT_EQ(dts::expm(A, A), CORE_ERROR_SUCCESS);   // in place
+    EXPECT_NEAR(A(0, 0), std::exp(-1.0), 1e-15);
+    EXPECT_NEAR(A(1, 1), std::exp(0.5), 1e-15);
+    EXPECT_EQ(A(0, 1), 0.0);
+}
@@ -0,0 +1,339 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include <cmath>
+
+extern "C" {
+#include "core_matrix.h"
+#include "matrix_ops.h"
+#include "matrix_gemm.h"
+#include "core_error.h"
+#include "core_thread_pool.h"
+}
+
+#include "test_utils.h"
+
+// ========== Helpers ==========
+static void ReferenceGemm(int m, int n, int k, double alpha,
+    const double* A, int lda, const double* B, int ldb,
+    double beta, double* C, int ldc) {
+    for (int i = 0; i < m; ++i) {
+        for (int j = 0; j < n; ++j) {
+            double sum = 0.0;
+            for (int p = 0; p < k; ++p) sum += A[i * lda + p] * B[p * ldb + j];
+            C[i * ldc + j] = alpha * sum + (beta == 0.0 ? 0.0 : beta * C[i * ldc + j]);
+        }
+    }
+}
+
+// ========== matrix_gemm_compute ==========
+TEST(MatrixGemm_Compute, GivenVariousShapes_WhenCompute_ThenMatchesReference) {
+    struct Case { int m; int n; int k; } cases[] = {
+        {1, 1, 1}, {3, 3, 3}, {5, 7, 3}, {16, 16, 16}, {17, 9, 33},
+        {50, 50, 50}, {97, 130, 61}, {130, 17, 300}, {4, 2050, 5},
+    };
+
+    for (const auto& c : cases) {
+        std::vector<double> A((size_t)c.m * c.k), B((size_t)c.k * c.n);
+        std::vector<double> C((size_t)c.m * c.n), R((size_t)c.m * c.n);
+        FillPattern(A, 0.1);
+        FillPattern(B, 1.3);
+        FillPattern(C, 2.7);
+        R = C;
+
+        ASSERT_EQ(matrix_gemm_compute(c.m, c.n, c.k, 1.5, A.data(), c.k, B.data(), c.n,
+            -0.5, C.data(), c.n), CORE_ERROR_SUCCESS);
+        ReferenceGemm(c.m, c.n, c.k, 1.5, A.data(), c.k, B.data(), c.n, -0.5, R.data(), c.n);
+
+        for (size_t i = 0; i < C.size(); ++i) {
+            EXPECT_NEAR(C[i], R[i], 1e-11 * (double)c.k) << "m=" << c.m << " n=" << c.n << " k=" << c.k;
+        }
+    }
+}
+
+TEST(MatrixGemm_Compute, GivenLeadingDimensions_WhenComputeOnSubBlocks_ThenOnlyBlockIsWritten) {
+    const int m = 37, n = 29, k = 41, lda = 50, ldb = 40, ldc = 45;
+    std::vector<double> A((size_t)m * lda), B((size_t)k * ldb), C((size_t)m * ldc, 7.0);
+    FillPattern(A, 0.4);
+    FillPattern(B, 0.9);
+    std::vector<double> R = C;
+
+    ASSERT_EQ(matrix_gemm_compute(m, n, k, 1.0, A.data(), lda, B.data(), ldb, 0.0, C.data(), ldc),
+        CORE_ERROR_SUCCESS);
+    ReferenceGemm(m, n, k, 1.0, A.data(), lda, B.data(), ldb, 0.0, R.data(), ldc);
+
+    for (int i = 0; i < m; ++i) {
+        for (int j = 0; j < ldc; ++j) {
+            EXPECT_NEAR(C[i * ldc + j], R[i * ldc + j], 1e-11 * k);
+        }
+    }
+}
+
+TEST(MatrixGemm_Compute, GivenBetaZero_WhenCOriginallyNaN_ThenResultIsFinite) {
+    const int n = 20;
+    std::vector<double> A((size_t)n * n), B((size_t)n * n), C((size_t)n * n, NAN);
+    FillPattern(A, 0.2);
+    FillPattern(B, 0.3);
+
+    ASSERT_EQ(matrix_gemm_compute(n, n, n, 1.0, A.data(), n, B.data(), n, 0.0, C.data(), n),
+        CORE_ERROR_SUCCESS);
+    for (double v : C) EXPECT_TRUE(std::isfinite(v));
+}
+
+TEST(MatrixGemm_Compute, GivenInvalidArguments_WhenCompute_ThenReturnsError) {
+    double a[4] = { 0 }, b[4] = { 0 }, c[4] = { 0 };
+    EXPECT_EQ(matrix_gemm_compute(2, 2, 2, 1.0, nullptr, 2, b, 2, 0.0, c, 2), CORE_ERROR_NULL);
+    EXPECT_EQ(matrix_gemm_compute(2, 2, 2, 1.0, a, 2, nullptr, 2, 0.0, c, 2), CORE_ERROR_NULL);
+    EXPECT_EQ(matrix_gemm_compute(2, 2, 2, 1.0, a, 2, b, 2, 0.0, nullptr, 2), CORE_ERROR_NULL);
+    EXPECT_EQ(matrix_gemm_compute(-1, 2, 2, 1.0, a, 2, b, 2, 0.0, c, 2), CORE_ERROR_INVALID_ARG);
+    EXPECT_EQ(matrix_gemm_compute(2, 2, 2, 1.0, a, 1, b, 2, 0.0, c, 2), CORE_ERROR_INVALID_ARG);
+}
+
+// ========== matrix_ops_multiply (blocked path) ==========
+TEST(MatrixGemm_Multiply, GivenLargeSquareMatrices_WhenMultiply_ThenMatchesReference) {
+    CoreErrorStatus err = CORE_ERROR_SUCCESS;
+    const int n = 120;
+    Matrix* A = matrix_core_create(n, n, &err); ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+    Matrix* B = matrix_core_create(n, n, &err); ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+    Matrix* C = matrix_core_create(n, n, &err); ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+
+    std::vector<double> a((size_t)n * n), b((size_t)n * n), r((size_t)n * n);
+    FillPattern(a, 0.5);
+    FillPattern(b, 1.5);
+    for (int i = 0; i < n * n; ++i) { A->data[i] = a[i]; B->data[i] = b[i]; }
+
+    EXPECT_EQ(matrix_ops_multiply(C, A, B), CORE_ERROR_SUCCESS);
+    ReferenceGemm(n, n, n, 1.0, a.data(), n, b.data(), n, 0.0, r.data(), n);
+    for (int i = 0; i < n * n; ++i) EXPECT_NEAR(C->data[i], r[i], 1e-10);
+
+    EXPECT_EQ(matrix_core_free(C), CORE_ERROR_SUCCESS);
+    EXPECT_EQ(matrix_core_free(B), CORE_ERROR_SUCCESS);
+    EXPECT_EQ(matrix_core_free(A), CORE_ERROR_SUCCESS);
+}
+
+// ========== matrix_gemm_compute_op (transposed operands) ==========
+TEST(MatrixGemm_ComputeOp, GivenTransposeFlags_WhenCompute_ThenMatchesExplicitTranspose) {
+    const int m = 23, n = 31, k = 19;
+    for (int ta = 0; ta < 2; ++ta) {
+        for (int tb = 0; tb < 2; ++tb) {
+            // Stored shapes: A is m x k (or k x m), B is k x n (or n x k)
+            std::vector<double> A((size_t)m * k), B((size_t)k * n);
+            FillPattern(A, 0.6);
+            FillPattern(B, 1.9);
+            const int lda = ta ? m : k, ldb = tb ? k : n;
+
+            // Explicit op(A), op(B) for the reference
+            std::vector<double> opA((size_t)m * k), opB((size_t)k * n);
+            for (int i = 0; i < m; ++i)
+                for (int p = 0; p < k; ++p) opA[i * k + p] = ta ? A[p * lda + i] : A[i * lda + p];
+            for (int p = 0; p < k; ++p)
+                for (int j = 0; j < n; ++j) opB[p * n + j] = tb ? B[j * ldb + p] : B[p * ldb + j];
+
+            std::vector<double> C((size_t)m * n), R;
+            FillPattern(C, 3.1);
+            R = C;
+
+            ASSERT_EQ(matrix_gemm_compute_op(ta ? MATRIX_TRANS : MATRIX_NO_TRANS,
+                tb ? MATRIX_TRANS : MATRIX_NO_TRANS, m, n, k,
+                0.5, A.data(), lda, B.data(), ldb, 2.0, C.data(), n), CORE_ERROR_SUCCESS);
+            ReferenceGemm(m, n, k, 0.5, opA.data(), k, opB.data(), n, 2.0, R.data(), n);
+
+            for (size_t i = 0; i < C.size(); ++i) {
+                EXPECT_NEAR(C[i], R[i], 1e-12) << "ta=" << ta << " tb=" << tb;
+            }
+        }
+    }
+}
+
+TEST(MatrixGemm_ComputeOp, GivenFewColumns_WhenCompute_ThenNarrowPathMatchesReference) {
+    // n <= 4 with m * n * k above the direct-loop threshold takes the per-column gemv path
+    const int m = 150, k = 140;
+    for (int n = 1; n <= 5; ++n) {
+        for (int ta = 0; ta < 2; ++ta) {
+            std::vector<double> A((size_t)m * k), B((size_t)k * n), opA((size_t)m * k);
+            FillPattern(A, 0.3 + n);
+            FillPattern(B, 1.2);
+            const int lda = ta ? m : k;
+            for (int i = 0; i < m; ++i)
+                for (int p = 0; p < k; ++p) opA[i * k + p] = ta ? A[p * lda + i] : A[i * lda + p];
+
+            std::vector<double> C((size_t)m * n), R;
+            FillPattern(C, 2.7);
+            R = C;
+            ASSERT_EQ(matrix_gemm_compute_op(ta ? MATRIX_TRANS : MATRIX_NO_TRANS, MATRIX_NO_TRANS,
+                m, n, k, -0.75, A.data(), lda, B.data(), n, 0.5, C.data(), n), CORE_ERROR_SUCCESS);
+            ReferenceGemm(m, n, k, -0.75, opA.data(), k, B.data(), n, 0.5, R.data(), n);
+            for (size_t i = 0; i < C.size(); ++i) {
+                EXPECT_NEAR(C[i], R[i], 1e-12) << "n=" << n << " ta=" << ta;
+            }
+        }
+    }
+}
+
+TEST(MatrixGemm_ComputeOp, GivenThreadPool_WhenComputeLargeProducts_ThenBitwiseEqualToSerial) {
+    // Tall (row bands) and wide (column bands) shapes, with ragged band tails
+    struct Shape { int m, n, k; MatrixTranspose ta, tb; };
+    const Shape shapes[] = {
+        { 301, 97, 130, MATRIX_NO_TRANS, MATRIX_NO_TRANS },
+        { 90, 421, 75, MATRIX_TRANS, MATRIX_TRANS },
+    };
+    for (const Shape& s : shapes) {
+        ASSERT_GE((size_t)s.m * s.n * s.k, MATRIX_GEMM_PARALLEL_MIN_VOLUME);
+        const int lda = s.ta ? s.m : s.k, ldb = s.tb ? s.k : s.n;
+        std::vector<double> A((size_t)(s.ta ? s.k : s.m) * lda), B((size_t)(s.tb ? s.n : s.k) * ldb);
+        std::vector<double> C0((size_t)s.m * s.n), C1;
+        FillPattern(A, 0.3);
+        FillPattern(B, 1.9);
+        FillPattern(C0, 4.1);
+        C1 = C0;
+
+        ASSERT_EQ(matrix_gemm_compute_op(s.ta, s.tb, s.m, s.n, s.k, 0.75, A.data(), lda,
+            B.data(), ldb, -0.5, C0.data(), s.n), CORE_ERROR_SUCCESS);
+
+        ASSERT_EQ(core_thread_pool_set_workers(3), CORE_ERROR_SUCCESS);
+        const CoreErrorStatus status = matrix_gemm_compute_op(s.ta, s.tb, s.m, s.n, s.k, 0.75,
+            A.data(), lda, B.data(), ldb, -0.5, C1.data(), s.n);
+        core_thread_pool_shutdown();
+        ASSERT_EQ(status, CORE_ERROR_SUCCESS);
+
+        for (size_t i = 0; i < C0.size(); ++i) ASSERT_EQ(C0[i], C1[i]) << "index " << i;
+    }
+}
+
+TEST(MatrixGemm_ComputeOp, GivenTransposedLeadingDimensionTooSmall_WhenCompute_ThenInvalidArg) {
+    double a[12] = { 0 }, b[12] = { 0 }, c[12] = { 0 };
+    // op(A) = A^T is 4 x 3, so A is stored 3 x 4 and needs lda >= 4
+    EXPECT_EQ(matrix_gemm_compute_op(MATRIX_TRANS, MATRIX_NO_TRANS, 4, 3, 3,
+        1.0, a, 3, b, 3, 0.0, c, 3), CORE_ERROR_INVALID_ARG);
+    EXPECT_EQ(matrix_gemm_compute_op((MatrixTranspose)7, MATRIX_NO_TRANS, 3, 3, 3,
+        1.0, a, 3, b, 3, 0.0, c, 3), CORE_ERROR_INVALID_ARG);
+}
+
+// ========== matrix_ops_gemm ==========
+TEST(MatrixOps_Gemm, GivenAlphaBetaAndTranspose_WhenGemm_ThenAccumulatesIntoC) {
+    CoreErrorStatus err = CORE_ERROR_SUCCESS;
+    Matrix* A = matrix_core_create(3, 2, &err); ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+    Matrix* B = matrix_core_create(3, 2, &err); ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+    Matrix* C = matrix_core_create(2, 2, &err); ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+
+    // A = [1 2; 3 4; 5 6], B = [1 0; 0 1; 1 1]
+    const double a[] = { 1, 2, 3, 4, 5, 6 }, b[] = { 1, 0, 0, 1, 1, 1 };
+    for (int i = 0; i < 6; ++i) { A->data[i] = a[i]; B->data[i] = b[i]; }
+    ASSERT_EQ(matrix_ops_fill(C, 1.0), CORE_ERROR_SUCCESS);
+
+    // C = 2 * A^T B + 3 * C, A^T B = [6 8; 8 10]
+    EXPECT_EQ(matrix_ops_gemm(C, 2.0, A, MATRIX_TRANS, B, MATRIX_NO_TRANS, 3.0), CORE_ERROR_SUCCESS);
+    EXPECT_DOUBLE_EQ(C->data[0], 15.0);
+    EXPECT_DOUBLE_EQ(C->data[1], 19.0);
+    EXPECT_DOUBLE_EQ(C->data[2], 19.0);
+    EXPECT_DOUBLE_EQ(C->data[3], 23.0);
+
+    matrix_core_free(C);
+    matrix_core_free(B);
+    matrix_core_free(A);
+}
+
+TEST(MatrixOps_Gemm, GivenBadShapesOrAliasing_WhenGemm_ThenReturnsError) {
+    CoreErrorStatus err = CORE_ERROR_SUCCESS;
+    Matrix* A = matrix_core_create(2, 3, &err); ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+    Matrix* S = matrix_core_create(2, 2, &err); ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+    Matrix* C = matrix_core_create(2, 2, &err); ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+
+    EXPECT_EQ(matrix_ops_gemm(nullptr, 1.0, A, MATRIX_NO_TRANS, A, MATRIX_TRANS, 0.0), CORE_ERROR_NULL);
+    EXPECT_EQ(matrix_ops_gemm(C, 1.0, A, MATRIX_NO_TRANS, A, MATRIX_NO_TRANS, 0.0), CORE_ERROR_DIMENSION);
+    EXPECT_EQ(matrix_ops_gemm(C, 1.0, A, MATRIX_NO_TRANS, A, MATRIX_TRANS, 0.0), CORE_ERROR_SUCCESS);
+    EXPECT_EQ(matrix_ops_gemm(S, 1.0, S, MATRIX_NO_TRANS, C, MATRIX_NO_TRANS, 1.0), CORE_ERROR_INVALID_ARG);
+
+    matrix_core_free(C);
+    matrix_core_free(S);
+    matrix_core_free(A);
+}
+
+// ========== matrix_gemv_compute / matrix_ops_gemv ==========
+TEST(MatrixGemv_Compute, GivenVariousShapes_WhenCompute_ThenMatchesReference) {
+    struct Case { int m; int n; } cases[] = {
+        {1, 1}, {2, 2}, {3, 5}, {4, 4}, {7, 3}, {9, 17}, {33, 65}, {100, 3},
+    };
+
+    for (const auto& c : cases) {
+        const int lda = c.n + 2;
+        std::vector<double> A((size_t)c.m * lda), x(c.n), xt(c.m);
+        FillPattern(A, 0.2);
+        FillPattern(x, 1.4);
+        FillPattern(xt, 2.2);
+
+        // y = 1.5 * A x - 0.5 * y
+        std::vector<double> y(c.m), r;
+        FillPattern(y, 0.9);
+        r = y;
+        ASSERT_EQ(matrix_gemv_compute(MATRIX_NO_TRANS, c.m, c.n, 1.5, A.data(), lda, x.data(),
+            -0.5, y.data()), CORE_ERROR_SUCCESS);
+        ReferenceGemm(c.m, 1, c.n, 1.5, A.data(), lda, x.data(), 1, -0.5, r.data(), 1);
+        for (int i = 0; i < c.m; ++i) EXPECT_NEAR(y[i], r[i], 1e-12) << "m=" << c.m << " n=" << c.n;
+
+        // y = 2 * A^T xt (beta = 0 ignores NaN in y)
+        std::vector<double> yt(c.n, NAN), rt(c.n, 0.0);
+        ASSERT_EQ(matrix_gemv_compute(MATRIX_TRANS, c.m, c.n, 2.0, A.data(), lda, xt.data(),
+            0.0, yt.data()), CORE_ERROR_SUCCESS);
+        for (int j = 0; j < c.n; ++j) {
+            for (int i = 0; i < c.m; ++i) rt[j] += 2.0 * A[i * lda + j] * xt[i];
+            EXPECT_NEAR(yt[j], rt[j], 1e-12) << "m=" << c.m << " n=" << c.n;
+        }
+    }
+}
+
+TEST(MatrixGemv_Compute, GivenInvalidArguments_WhenCompute_ThenReturnsError) {
+    double a[4] = { 0 }, x[2] = { 0 }, y[2] = { 0 };
+    EXPECT_EQ(matrix_gemv_compute(MATRIX_NO_TRANS, 2, 2, 1.0, nullptr, 2, x, 0.0, y), CORE_ERROR_NULL);
+    EXPECT_EQ(matrix_gemv_compute(MATRIX_NO_TRANS, 2, 2, 1.0, a, 2, nullptr, 0.0, y), CORE_ERROR_NULL);
+    EXPECT_EQ(matrix_gemv_compute(MATRIX_NO_TRANS, 2, 2, 1.0, a, 1, x, 0.0, y), CORE_ERROR_INVALID_ARG);
+    EXPECT_EQ(matrix_gemv_compute(MATRIX_NO_TRANS, -1, 2, 1.0, a, 2, x, 0.0, y), CORE_ERROR_INVALID_ARG);
+}
+
+TEST(MatrixOps_Gemv, GivenColumnVector_WhenMultiplyOrGemv_ThenMatchesReference) {
+    CoreErrorStatus err = CORE_ERROR_SUCCESS;
+    const int n = 6;
+    Matrix* A = matrix_core_create(n, n, &err); ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+    Matrix* x = matrix_core_create(n, 1, &err); ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+    Matrix* y = matrix_core_create(n, 1, &err); ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+
+    std::vector<double> a((size_t)n * n), v(n), r(n);
+    FillPattern(a, 0.7);
+    FillPattern(v, 0.1);
+    for (int i = 0; i < n * n; ++i) A->data[i] = a[i];
+    for (int i = 0; i < n; ++i) x->data[i] = v[i];
+
+    // multiply dispatches to GEMV for b->cols == 1
+    ASSERT_EQ(matrix_ops_multiply(y, A, x), CORE_ERROR_SUCCESS);
+    ReferenceGemm(n, 1, n, 1.0, a.data(), n, v.data(), 1, 0.0, r.data(), 1);
+    for (int i = 0; i < n; ++i) EXPECT_NEAR(y->data[i], r[i], 1e-13);
+
+    // y = 2 * A^T x + y
+    std::vector<double> rt(r);
+    for (int j = 0; j < n; ++j)
+        for (int i = 0; i < n; ++i) rt[j] += 2.0 * a[i * n + j] * v[i];
+    ASSERT_EQ(matrix_ops_gemv(y, 2.0, A, MATRIX_TRANS, x, 1.0), CORE_ERROR_SUCCESS);
+    for (int i = 0; i < n; ++i) EXPECT_NEAR(y->data[i], rt[i], 1e-12);
+
+    matrix_core_free(y);
+    matrix_core_free(x);
+    matrix_core_free(A);
+}
+
+TEST(MatrixOps_Gemv, GivenBadShapesOrAliasing_WhenGemv_ThenReturnsError) {
+    CoreErrorStatus err = CORE_ERROR_SUCCESS;
+    Matrix* A = matrix_core_create(3, 2, &err); ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+    Matrix* x = matrix_core_create(2, 1, &err); ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+    Matrix* y = matrix_core_create(3, 1, &err); ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+    ASSERT_EQ(matrix_ops_set_zero(A), CORE_ERROR_SUCCESS);
+    ASSERT_EQ(matrix_ops_set_zero(x), CORE_ERROR_SUCCESS);
+
+    EXPECT_EQ(matrix_ops_gemv(nullptr, 1.0, A, MATRIX_NO_TRANS, x, 0.0), CORE_ERROR_NULL);
+    EXPECT_EQ(matrix_ops_gemv(y, 1.0, A, MATRIX_TRANS, x, 0.0), CORE_ERROR_DIMENSION);
+    EXPECT_EQ(matrix_ops_gemv(y, 1.0, A, MATRIX_NO_TRANS, y, 0.0), CORE_ERROR_DIMENSION);
+    EXPECT_EQ(matrix_ops_gemv(x, 1.0, A, MATRIX_TRANS, x, 0.0), CORE_ERROR_DIMENSION);
+    EXPECT_EQ(matrix_ops_gemv(y, 1.0, A, MATRIX_NO_TRANS, x, 0.0), CORE_ERROR_SUCCESS);
+
+    matrix_core_free(y);
+    matrix_core_free(x);
+    matrix_core_free(A);
+}
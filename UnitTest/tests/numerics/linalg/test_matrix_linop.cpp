@@ -0,0 +1,245 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <vector>
+
+extern "C" {
+#include "matrix_linop.h"
+#include "matrix_norm.h"
+#include "matrix_ops.h"
+#include "core_matrix.h"
+#include "core_error.h"
+}
+
+#include "test_utils.h"
+
+// ========== Helpers ==========
+
+// Strongly non-normal: unit diagonal plus a large, decaying upper triangle
+static Matrix* MakeNonNormal(int n, double scale) {
+    CoreErrorStatus err = CORE_ERROR_SUCCESS;
+    Matrix* A = matrix_core_create(n, n, &err);
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < n; ++j) {
+            A->data[i * n + j] = (i == j) ? -1.0 : (j > i ? scale * std::cos(0.3 * i + j) / (1 + j - i) : 0.0);
+        }
+    }
+    return A;
+}
+
+static double ExactNorm1(const Matrix* A) {
+    double r = 0.0;
+    EXPECT_EQ(matrix_norm_1(A, &r), CORE_ERROR_SUCCESS);
+    return r;
+}
+
+// ========== matrix_linop_dense / matrix_linop_product ==========
+
+TEST(MatrixLinop_Apply, GivenDenseAndProductOperators_WhenApply_ThenMatchExplicitProducts) {
+    const int n = 37, k = 3;
+    Matrix* A = MakeTestMatrix(n, n, 0.4);
+    Matrix* B = MakeTestMatrix(n, n, 1.7);
+    Matrix* X = MakeTestMatrix(n, k, 2.2);
+    CoreErrorStatus err = CORE_ERROR_SUCCESS;
+    Matrix* AB = matrix_core_create(n, n, &err);
+    Matrix* ABA = matrix_core_create(n, n, &err);
+    Matrix* Y = matrix_core_create(n, k, &err);
+    Matrix* R = matrix_core_create(n, k, &err);
+    ASSERT_EQ(matrix_ops_multiply(AB, A, B), CORE_ERROR_SUCCESS);
+    ASSERT_EQ(matrix_ops_multiply(ABA, AB, A), CORE_ERROR_SUCCESS);
+
+    MatrixLinearOperator dense;
+    ASSERT_EQ(matrix_linop_dense(&dense, A), CORE_ERROR_SUCCESS);
+    EXPECT_EQ(dense.n, n);
+
+    // Odd and even factor counts land the last product in Y either way
+    std::vector<double> work((size_t)n * k);
+    const Matrix* f2[2] = { A, B };
+    const Matrix* f3[3] = { A, B, A };
+    MatrixProductOp p2 = { f2, 2, work.data(), k };
+    MatrixProductOp p3 = { f3, 3, work.data(), k };
+    MatrixLinearOperator op2, op3;
+    ASSERT_EQ(matrix_linop_product(&op2, &p2), CORE_ERROR_SUCCESS);
+    ASSERT_EQ(matrix_linop_product(&op3, &p3), CORE_ERROR_SUCCESS);
+
+    struct Case { const MatrixLinearOperator* op; const Matrix* M; };
+    const Case cases[] = { { &dense, A }, { &op2, AB }, { &op3, ABA } };
+    for (const Case& c : cases) {
+        for (int t = 0; t < 2; ++t) {
+            const MatrixTranspose tr = t ? MATRIX_TRANS : MATRIX_NO_TRANS;
+            ASSERT_EQ(matrix_linop_apply(c.op, tr, X, Y), CORE_ERROR_SUCCESS);
+            ASSERT_EQ(matrix_ops_gemm(R, 1.0, c.M, tr, X, MATRIX_NO_TRANS, 0.0), CORE_ERROR_SUCCESS);
+            for (int i = 0; i < n * k; ++i) {
+                EXPECT_NEAR(Y->data[i], R->data[i], 1e-11) << "trans=" << t;
+            }
+        }
+    }
+
+    matrix_core_free(A); matrix_core_free(B); matrix_core_free(X);
+    matrix_core_free(AB); matrix_core_free(ABA);
+    matrix_core_free(Y); matrix_core_free(R);
+}
+
+TEST(MatrixLinop_Apply, GivenPowerOfOperator_WhenApply_ThenMatchesRepeatedFactorProduct) {
+    const int n = 29, k = 2;
+    Matrix* A = MakeTestMatrix(n, n, 0.8);
+    Matrix* X = MakeTestMatrix(n, k, 1.4);
+    CoreErrorStatus err = CORE_ERROR_SUCCESS;
+    Matrix* Y = matrix_core_create(n, k, &err);
+    Matrix* R = matrix_core_create(n, k, &err);
+
+    MatrixLinearOperator dense;
+    ASSERT_EQ(matrix_linop_dense(&dense, A), CORE_ERROR_SUCCESS);
+    std::vector<double> wp((size_t)n * k), wq((size_t)n * k);
+    for (int p = 1; p <= 4; ++p) {
+        MatrixPowerOp pw = { &dense, p, wp.data(), k };
+        const Matrix* f[4] = { A, A, A, A };
+        MatrixProductOp prod = { f, p, wq.data(), k };
+        MatrixLinearOperator pow_op, prod_op;
+        ASSERT_EQ(matrix_linop_power(&pow_op, &pw), CORE_ERROR_SUCCESS);
+        ASSERT_EQ(matrix_linop_product(&prod_op, &prod), CORE_ERROR_SUCCESS);
+        for (int t = 0; t < 2; ++t) {
+            const MatrixTranspose tr = t ? MATRIX_TRANS : MATRIX_NO_TRANS;
+            ASSERT_EQ(matrix_linop_apply(&pow_op, tr, X, Y), CORE_ERROR_SUCCESS);
+            ASSERT_EQ(matrix_linop_apply(&prod_op, tr, X, R), CORE_ERROR_SUCCESS);
+            for (int i = 0; i < n * k; ++i) EXPECT_EQ(Y->data[i], R->data[i]) << "p=" << p;
+        }
+    }
+
+    MatrixPowerOp bad = { &dense, 0, wp.data(), k };
+    MatrixLinearOperator op;
+    EXPECT_EQ(matrix_linop_power(&op, &bad), CORE_ERROR_INVALID_ARG);
+    bad.power = 1;
+    bad.base = nullptr;
+    EXPECT_EQ(matrix_linop_power(&op, &bad), CORE_ERROR_NULL);
+
+    matrix_core_free(A); matrix_core_free(X); matrix_core_free(Y); matrix_core_free(R);
+}
+
+TEST(MatrixLinop_Apply, GivenInvalidArguments_WhenCreateOrApply_ThenReturnsError) {
+    Matrix* A = MakeTestMatrix(4, 4, 0.1);
+    Matrix* R = MakeTestMatrix(4, 3, 0.1);
+    Matrix* X = MakeTestMatrix(4, 2, 0.2);
+    Matrix* Y3 = MakeTestMatrix(3, 2, 0.3);
+    Matrix* Y = MakeTestMatrix(4, 2, 0.3);
+    MatrixLinearOperator op;
+
+    EXPECT_EQ(matrix_linop_dense(NULL, A), CORE_ERROR_NULL);
+    EXPECT_EQ(matrix_linop_dense(&op, NULL), CORE_ERROR_NULL);
+    EXPECT_EQ(matrix_linop_dense(&op, R), CORE_ERROR_DIMENSION);
+
+    double work[4];
+    const Matrix* f[2] = { A, R };
+    MatrixProductOp bad = { f, 2, work, 1 };
+    EXPECT_EQ(matrix_linop_product(&op, &bad), CORE_ERROR_DIMENSION);
+    MatrixProductOp empty = { f, 0, work, 1 };
+    EXPECT_EQ(matrix_linop_product(&op, &empty), CORE_ERROR_INVALID_ARG);
+    MatrixProductOp nowork = { f, 1, NULL, 1 };
+    EXPECT_EQ(matrix_linop_product(&op, &nowork), CORE_ERROR_NULL);
+
+    // Blocks wider than kmax do not fit the scratch block
+    const Matrix* f1[1] = { A };
+    MatrixProductOp narrow = { f1, 1, work, 1 };
+    ASSERT_EQ(matrix_linop_product(&op, &narrow), CORE_ERROR_SUCCESS);
+    EXPECT_EQ(matrix_linop_apply(&op, MATRIX_NO_TRANS, X, Y), CORE_ERROR_DIMENSION);
+
+    ASSERT_EQ(matrix_linop_dense(&op, A), CORE_ERROR_SUCCESS);
+    EXPECT_EQ(matrix_linop_apply(&op, MATRIX_NO_TRANS, X, Y3), CORE_ERROR_DIMENSION);
+    EXPECT_EQ(matrix_linop_apply(&op, (MatrixTranspose)7, X, Y), CORE_ERROR_INVALID_ARG);
+    EXPECT_EQ(matrix_linop_apply(NULL, MATRIX_NO_TRANS, X, Y), CORE_ERROR_NULL);
+
+    matrix_core_free(A); matrix_core_free(R); matrix_core_free(X);
+    matrix_core_free(Y3); matrix_core_free(Y);
+}
+
+// ========== matrix_norm_1_est ==========
+
+TEST(MatrixNorm_1Est, GivenDenseMatrices_WhenEstimate_ThenLowerBoundCloseToExact) {
+    for (int n : { 3, 10, 64, 150 }) {
+        for (double seed : { 0.2, 1.1, 2.9 }) {
+            Matrix* A = MakeTestMatrix(n, n, seed);
+            MatrixLinearOperator op;
+            ASSERT_EQ(matrix_linop_dense(&op, A), CORE_ERROR_SUCCESS);
+            std::vector<double> work(MATRIX_NORMEST_WORK(n, MATRIX_NORMEST_T));
+
+            double est = -1.0;
+            int applies = 0;
+            ASSERT_EQ(matrix_norm_1_est(&op, MATRIX_NORMEST_T, work.data(), &est, &applies), CORE_ERROR_SUCCESS);
+            const double exact = ExactNorm1(A);
+            EXPECT_LE(est, exact * (1.0 + 1e-12)) << "n=" << n;
+            EXPECT_GE(est, exact / 3.0) << "n=" << n;
+            EXPECT_LE(applies, 2 * MATRIX_NORMEST_ITMAX + 1);
+            matrix_core_free(A);
+        }
+    }
+}
+
+TEST(MatrixNorm_1Est, GivenPowersOfNonNormalMatrix_WhenEstimate_ThenMuchTighterThanProductBound) {
+    // ||A^4||_1 is far below ||A^2||_1^2 for a non-normal A; the estimate must
+    // track the former without forming A^4
+    const int n = 96;
+    Matrix* A = MakeNonNormal(n, 50.0);
+    CoreErrorStatus err = CORE_ERROR_SUCCESS;
+    Matrix* A2 = matrix_core_create(n, n, &err);
+    Matrix* A4 = matrix_core_create(n, n, &err);
+    ASSERT_EQ(matrix_ops_multiply(A2, A, A), CORE_ERROR_SUCCESS);
+    ASSERT_EQ(matrix_ops_multiply(A4, A2, A2), CORE_ERROR_SUCCESS);
+
+    const Matrix* f[2] = { A2, A2 };
+    std::vector<double> work(MATRIX_NORMEST_WORK(n, MATRIX_NORMEST_T) + (size_t)n * MATRIX_NORMEST_T);
+    MatrixProductOp prod = { f, 2, work.data() + MATRIX_NORMEST_WORK(n, MATRIX_NORMEST_T), MATRIX_NORMEST_T };
+    MatrixLinearOperator op;
+    ASSERT_EQ(matrix_linop_product(&op, &prod), CORE_ERROR_SUCCESS);
+
+    double est = 0.0;
+    ASSERT_EQ(matrix_norm_1_est(&op, MATRIX_NORMEST_T, work.data(), &est, NULL), CORE_ERROR_SUCCESS);
+    const double exact = ExactNorm1(A4);
+    const double a2 = ExactNorm1(A2);
+    EXPECT_LE(est, exact * (1.0 + 1e-12));
+    EXPECT_GE(est, exact / 3.0);
+    EXPECT_LT(exact, 0.5 * a2 * a2);
+
+    matrix_core_free(A); matrix_core_free(A2); matrix_core_free(A4);
+}
+
+TEST(MatrixNorm_1Est, GivenSameOperatorTwice_WhenEstimate_ThenResultIsReproducible) {
+    const int n = 80;
+    Matrix* A = MakeTestMatrix(n, n, 0.9);
+    MatrixLinearOperator op;
+    ASSERT_EQ(matrix_linop_dense(&op, A), CORE_ERROR_SUCCESS);
+    std::vector<double> work(MATRIX_NORMEST_WORK(n, 3));
+
+    double e1 = 0.0, e2 = 0.0;
+    ASSERT_EQ(matrix_norm_1_est(&op, 3, work.data(), &e1, NULL), CORE_ERROR_SUCCESS);
+    ASSERT_EQ(matrix_norm_1_est(&op, 3, work.data(), &e2, NULL), CORE_ERROR_SUCCESS);
+    EXPECT_EQ(e1, e2);
+    matrix_core_free(A);
+}
+
+TEST(MatrixNorm_1Est, GivenOrderAtMostT_WhenEstimate_ThenExact) {
+    Matrix* A = MakeTestMatrix(2, 2, 0.5);
+    MatrixLinearOperator op;
+    ASSERT_EQ(matrix_linop_dense(&op, A), CORE_ERROR_SUCCESS);
+    std::vector<double> work(MATRIX_NORMEST_WORK(2, MATRIX_NORMEST_T));
+
+    double est = 0.0;
+    int applies = 0;
+    ASSERT_EQ(matrix_norm_1_est(&op, MATRIX_NORMEST_T, work.data(), &est, &applies), CORE_ERROR_SUCCESS);
+    EXPECT_DOUBLE_EQ(est, ExactNorm1(A));
+    EXPECT_EQ(applies, 1);
+    matrix_core_free(A);
+}
+
+TEST(MatrixNorm_1Est, GivenInvalidArguments_WhenEstimate_ThenReturnsError) {
+    Matrix* A = MakeTestMatrix(5, 5, 0.5);
+    MatrixLinearOperator op;
+    ASSERT_EQ(matrix_linop_dense(&op, A), CORE_ERROR_SUCCESS);
+    std::vector<double> work(MATRIX_NORMEST_WORK(5, MATRIX_NORMEST_T));
+    double est = 0.0;
+
+    EXPECT_EQ(matrix_norm_1_est(NULL, 2, work.data(), &est, NULL), CORE_ERROR_NULL);
+    EXPECT_EQ(matrix_norm_1_est(&op, 2, NULL, &est, NULL), CORE_ERROR_NULL);
+    EXPECT_EQ(matrix_norm_1_est(&op, 2, work.data(), NULL, NULL), CORE_ERROR_NULL);
+    EXPECT_EQ(matrix_norm_1_est(&op, 0, work.data(), &est, NULL), CORE_ERROR_INVALID_ARG);
+    EXPECT_EQ(matrix_norm_1_est(&op, 65, work.data(), &est, NULL), CORE_ERROR_INVALID_ARG);
+    matrix_core_free(A);
+}
@@ -232,4 +232,31 @@ TEST(MatrixNorm_AllKinds, MixedSigns2x3) {
     EXPECT_NEAR(nfro, std::sqrt(91.0), 1e-12);
 
     EXPECT_EQ(matrix_core_free(m), CORE_ERROR_SUCCESS);
-}
\ No newline at end of file
+}
+
+// ========== MatrixView operands ==========
+TEST(MatrixNorm_View, GivenBlockView_WhenNorms_ThenMatchCopiedBlock) {
+    CoreErrorStatus err = CORE_ERROR_SUCCESS;
+    Matrix* P = matrix_core_create(5, 6, &err);
+    Matrix* B = matrix_core_create(3, 2, &err);
+    ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+    ASSERT_EQ(matrix_ops_fill_sequential(P, -7.0, 0.5), CORE_ERROR_SUCCESS);
+    ASSERT_EQ(matrix_ops_get_block(P, 1, 3, B), CORE_ERROR_SUCCESS);
+
+    MatrixView v;
+    ASSERT_EQ(matrix_view_block(&v, P, 1, 3, 3, 2), CORE_ERROR_SUCCESS);
+
+    double a = 0.0, b = 0.0;
+    EXPECT_EQ(matrix_norm_1(&v, &a), CORE_ERROR_SUCCESS);
+    EXPECT_EQ(matrix_norm_1(B, &b), CORE_ERROR_SUCCESS);
+    EXPECT_EQ(a, b);
+    EXPECT_EQ(matrix_norm_inf(&v, &a), CORE_ERROR_SUCCESS);
+    EXPECT_EQ(matrix_norm_inf(B, &b), CORE_ERROR_SUCCESS);
+    EXPECT_EQ(a, b);
+    EXPECT_EQ(matrix_norm_fro(&v, &a), CORE_ERROR_SUCCESS);
+    EXPECT_EQ(matrix_norm_fro(B, &b), CORE_ERROR_SUCCESS);
+    EXPECT_EQ(a, b);
+
+    matrix_core_free(B);
+    matrix_core_free(P);
+}
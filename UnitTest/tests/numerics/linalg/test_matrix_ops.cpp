@@ -1,10 +1,12 @@
 #include <gtest/gtest.h>
 #include <string>
+#include <cmath>
 
 extern "C" {
 #include "core_matrix.h"
 #include "matrix_ops.h"
 #include "core_error.h"
+#include "core_thread_pool.h"
 }
 
 // ========== Helpers ==========
@@ -1449,3 +1451,219 @@ TEST(MatrixOpsGetBlock_Into, ErrorOutOfBounds) {
     matrix_core_free(sub);
     matrix_core_free(A);
 }
+
+// ========== Padded (ld > cols) operands ==========
+// Every op must give the same result whether or not rows are padded.
+static Matrix* CreateFilled(int rows, int cols, bool padded, double seed) {
+    CoreErrorStatus err = CORE_ERROR_SUCCESS;
+    Matrix* m = padded ? matrix_core_create_padded(rows, cols, &err) : matrix_core_create(rows, cols, &err);
+    if (!m) return nullptr;
+    for (int i = 0; i < m->rows * m->ld; ++i) m->data[i] = NAN;  // poison the padding
+    for (int i = 0; i < rows; ++i) {
+        for (int j = 0; j < cols; ++j) {
+            matrix_ops_set(m, i, j, std::sin(seed + 0.3 * i + 0.11 * j));
+        }
+    }
+    return m;
+}
+
+static void ExpectSameValues(const Matrix* a, const Matrix* b, double tol) {
+    ASSERT_EQ(a->rows, b->rows);
+    ASSERT_EQ(a->cols, b->cols);
+    CoreErrorStatus err = CORE_ERROR_SUCCESS;
+    for (int i = 0; i < a->rows; ++i) {
+        for (int j = 0; j < a->cols; ++j) {
+            EXPECT_NEAR(matrix_ops_get(a, i, j, &err), matrix_ops_get(b, i, j, &err), tol)
+                << "(" << i << "," << j << ")";
+        }
+    }
+}
+
+TEST(MatrixOpsPadded, GivenPaddedOperands_WhenElementwiseOps_ThenMatchUnpadded) {
+    const int r = 5, c = 11;
+    Matrix* A = CreateFilled(r, c, false, 0.1);
+    Matrix* B = CreateFilled(r, c, false, 0.9);
+    Matrix* R = CreateFilled(r, c, false, 0.0);
+    Matrix* Ap = CreateFilled(r, c, true, 0.1);
+    Matrix* Bp = CreateFilled(r, c, true, 0.9);
+    Matrix* Rp = CreateFilled(r, c, true, 0.0);
+
+    EXPECT_EQ(matrix_ops_add(R, A, B), CORE_ERROR_SUCCESS);
+    EXPECT_EQ(matrix_ops_add(Rp, Ap, Bp), CORE_ERROR_SUCCESS);
+    ExpectSameValues(R, Rp, 0.0);
+
+    EXPECT_EQ(matrix_ops_axpy(R, -0.5, A), CORE_ERROR_SUCCESS);
+    EXPECT_EQ(matrix_ops_axpy(Rp, -0.5, A), CORE_ERROR_SUCCESS);  // mixed strides
+    ExpectSameValues(R, Rp, 0.0);
+
+    EXPECT_EQ(matrix_ops_scale(R, 3.0), CORE_ERROR_SUCCESS);
+    EXPECT_EQ(matrix_ops_scale(Rp, 3.0), CORE_ERROR_SUCCESS);
+    ExpectSameValues(R, Rp, 0.0);
+
+    EXPECT_EQ(matrix_ops_copy(Rp, B), CORE_ERROR_SUCCESS);
+    ExpectSameValues(Rp, B, 0.0);
+    EXPECT_EQ(matrix_ops_copy(R, Bp), CORE_ERROR_SUCCESS);
+    ExpectSameValues(R, Bp, 0.0);
+
+    EXPECT_EQ(matrix_ops_fill(Rp, 2.0), CORE_ERROR_SUCCESS);
+    EXPECT_EQ(matrix_ops_fill(R, 2.0), CORE_ERROR_SUCCESS);
+    ExpectSameValues(R, Rp, 0.0);
+
+    Matrix* blk = CreateFilled(2, 3, true, 4.0);
+    EXPECT_EQ(matrix_ops_set_block(Rp, 1, 7, blk), CORE_ERROR_SUCCESS);
+    EXPECT_EQ(matrix_ops_set_block(R, 1, 7, blk), CORE_ERROR_SUCCESS);
+    ExpectSameValues(R, Rp, 0.0);
+    EXPECT_EQ(matrix_ops_get_block(Ap, 2, 5, blk), CORE_ERROR_SUCCESS);
+    CoreErrorStatus err = CORE_ERROR_SUCCESS;
+    EXPECT_EQ(matrix_ops_get(blk, 1, 2, &err), matrix_ops_get(A, 3, 7, &err));
+
+    for (Matrix* m : { A, B, R, Ap, Bp, Rp, blk }) matrix_core_free(m);
+}
+
+TEST(MatrixOpsPadded, GivenPaddedOperands_WhenMultiplyAndGemm_ThenMatchUnpadded) {
+    const int m = 13, k = 9, n = 17;
+    Matrix* A = CreateFilled(m, k, false, 0.2);
+    Matrix* B = CreateFilled(k, n, false, 0.4);
+    Matrix* C = CreateFilled(m, n, false, 0.6);
+    Matrix* Ap = CreateFilled(m, k, true, 0.2);
+    Matrix* Bp = CreateFilled(k, n, true, 0.4);
+    Matrix* Cp = CreateFilled(m, n, true, 0.6);
+
+    EXPECT_EQ(matrix_ops_multiply(C, A, B), CORE_ERROR_SUCCESS);
+    EXPECT_EQ(matrix_ops_multiply(Cp, Ap, Bp), CORE_ERROR_SUCCESS);
+    ExpectSameValues(C, Cp, 1e-13);
+
+    Matrix* At = CreateFilled(k, m, false, 0.2);
+    Matrix* Atp = CreateFilled(k, m, true, 0.2);
+    EXPECT_EQ(matrix_ops_gemm(C, 0.5, At, MATRIX_TRANS, B, MATRIX_NO_TRANS, 1.0), CORE_ERROR_SUCCESS);
+    EXPECT_EQ(matrix_ops_gemm(Cp, 0.5, Atp, MATRIX_TRANS, Bp, MATRIX_NO_TRANS, 1.0), CORE_ERROR_SUCCESS);
+    ExpectSameValues(C, Cp, 1e-13);
+
+    Matrix* x = CreateFilled(k, 1, false, 1.0);
+    Matrix* y = CreateFilled(m, 1, false, 0.0);
+    Matrix* yp = CreateFilled(m, 1, false, 0.0);
+    EXPECT_EQ(matrix_ops_multiply(y, A, x), CORE_ERROR_SUCCESS);
+    EXPECT_EQ(matrix_ops_gemv(yp, 1.0, Ap, MATRIX_NO_TRANS, x, 0.0), CORE_ERROR_SUCCESS);
+    ExpectSameValues(y, yp, 1e-13);
+
+    for (Matrix* p : { A, B, C, Ap, Bp, Cp, At, Atp, x, y, yp }) matrix_core_free(p);
+}
+
+// ========== MatrixView operands ==========
+TEST(MatrixOpsView, GivenBlockView_WhenElementwiseOps_ThenOnlyBlockChanges) {
+    Matrix* P = CreateFilled(6, 7, false, 0.1);
+    Matrix* R = CreateFilled(6, 7, false, 0.1);
+    Matrix* X = CreateFilled(3, 4, false, 0.9);
+
+    MatrixView v;
+    ASSERT_EQ(matrix_view_block(&v, P, 2, 1, 3, 4), CORE_ERROR_SUCCESS);
+    EXPECT_EQ(matrix_ops_scale(&v, 2.0), CORE_ERROR_SUCCESS);
+    EXPECT_EQ(matrix_ops_axpy(&v, -0.5, X), CORE_ERROR_SUCCESS);
+    EXPECT_EQ(matrix_ops_add(&v, &v, X), CORE_ERROR_SUCCESS);
+
+    CoreErrorStatus err = CORE_ERROR_SUCCESS;
+    for (int i = 0; i < 6; ++i) {
+        for (int j = 0; j < 7; ++j) {
+            double expected = matrix_ops_get(R, i, j, &err);
+            if (i >= 2 && i < 5 && j >= 1 && j < 5) {
+                const double x = matrix_ops_get(X, i - 2, j - 1, &err);
+                expected = 2.0 * expected - 0.5 * x + x;
+            }
+            EXPECT_EQ(matrix_ops_get(P, i, j, &err), expected) << "(" << i << "," << j << ")";
+        }
+    }
+
+    for (Matrix* p : { P, R, X }) matrix_core_free(p);
+}
+
+TEST(MatrixOpsView, GivenBlockViews_WhenMultiplyIntoBlock_ThenMatchesCopies) {
+    const int m = 5, k = 4, n = 6;
+    Matrix* P = CreateFilled(12, 12, false, 0.3);
+    Matrix* A = matrix_core_create(m, k, nullptr);
+    Matrix* B = matrix_core_create(k, n, nullptr);
+    Matrix* C = matrix_core_create(m, n, nullptr);
+    Matrix* Out = CreateFilled(m + 2, n + 3, false, 0.7);
+    Matrix* Ref = CreateFilled(m + 2, n + 3, false, 0.7);
+
+    MatrixView va, vb, vc, vx;
+    ASSERT_EQ(matrix_view_block(&va, P, 0, 3, m, k), CORE_ERROR_SUCCESS);
+    ASSERT_EQ(matrix_view_block(&vb, P, 6, 2, k, n), CORE_ERROR_SUCCESS);
+    ASSERT_EQ(matrix_view_block(&vc, Out, 1, 2, m, n), CORE_ERROR_SUCCESS);
+    ASSERT_EQ(matrix_ops_get_block(P, 0, 3, A), CORE_ERROR_SUCCESS);
+    ASSERT_EQ(matrix_ops_get_block(P, 6, 2, B), CORE_ERROR_SUCCESS);
+
+    EXPECT_EQ(matrix_ops_multiply(&vc, &va, &vb), CORE_ERROR_SUCCESS);
+    EXPECT_EQ(matrix_ops_multiply(C, A, B), CORE_ERROR_SUCCESS);
+    EXPECT_EQ(matrix_ops_set_block(Ref, 1, 2, C), CORE_ERROR_SUCCESS);
+    ExpectSameValues(Out, Ref, 1e-14);
+
+    // Column-vector view (ld > 1) takes the general GEMM path
+    Matrix* x = matrix_core_create(k, 1, nullptr);
+    Matrix* y = matrix_core_create(m, 1, nullptr);
+    MatrixView vy;
+    ASSERT_EQ(matrix_view_block(&vx, P, 7, 11, k, 1), CORE_ERROR_SUCCESS);
+    ASSERT_EQ(matrix_view_block(&vy, Out, 0, 0, m, 1), CORE_ERROR_SUCCESS);
+    ASSERT_EQ(matrix_ops_copy(x, &vx), CORE_ERROR_SUCCESS);
+    EXPECT_EQ(matrix_ops_gemm(&vy, 1.0, &va, MATRIX_NO_TRANS, &vx, MATRIX_NO_TRANS, 0.0), CORE_ERROR_SUCCESS);
+    EXPECT_EQ(matrix_ops_multiply(y, A, x), CORE_ERROR_SUCCESS);
+    ExpectSameValues(&vy, y, 1e-14);
+
+    for (Matrix* p : { P, A, B, C, Out, Ref, x, y }) matrix_core_free(p);
+}
+
+TEST(MatrixOpsView, GivenOverlappingViews_WhenGemmOrGemv_ThenInvalidArg) {
+    Matrix* P = CreateFilled(8, 8, false, 0.4);
+    MatrixView va, vc, vd, vx, vy;
+    ASSERT_EQ(matrix_view_block(&va, P, 0, 0, 4, 4), CORE_ERROR_SUCCESS);
+    ASSERT_EQ(matrix_view_block(&vc, P, 2, 2, 4, 4), CORE_ERROR_SUCCESS);   // overlaps va
+    ASSERT_EQ(matrix_view_block(&vd, P, 4, 0, 4, 4), CORE_ERROR_SUCCESS);   // rows after va
+    ASSERT_EQ(matrix_view_block(&vx, P, 1, 3, 4, 1), CORE_ERROR_SUCCESS);
+    ASSERT_EQ(matrix_view_block(&vy, P, 3, 3, 4, 1), CORE_ERROR_SUCCESS);   // overlaps vx
+
+    EXPECT_EQ(matrix_ops_gemm(&vc, 1.0, &va, MATRIX_NO_TRANS, &vd, MATRIX_NO_TRANS, 0.0), CORE_ERROR_INVALID_ARG);
+    EXPECT_EQ(matrix_ops_gemm(&vd, 1.0, &vc, MATRIX_NO_TRANS, &va, MATRIX_TRANS, 0.0), CORE_ERROR_INVALID_ARG);
+    EXPECT_EQ(matrix_ops_gemv(&vy, 1.0, &vd, MATRIX_NO_TRANS, &vx, 0.0), CORE_ERROR_INVALID_ARG);
+
+    // Disjoint row ranges of one parent are fine
+    Matrix* R = matrix_core_create(4, 4, nullptr);
+    Matrix* A = matrix_core_create(4, 4, nullptr);
+    ASSERT_EQ(matrix_ops_copy(A, &va), CORE_ERROR_SUCCESS);
+    EXPECT_EQ(matrix_ops_gemm(&vd, 1.0, &va, MATRIX_NO_TRANS, &va, MATRIX_TRANS, 0.0), CORE_ERROR_SUCCESS);
+    EXPECT_EQ(matrix_ops_gemm(R, 1.0, A, MATRIX_NO_TRANS, A, MATRIX_TRANS, 0.0), CORE_ERROR_SUCCESS);
+    ExpectSameValues(&vd, R, 1e-14);
+
+    for (Matrix* p : { P, R, A }) matrix_core_free(p);
+}
+
+TEST(MatrixOpsThreaded, GivenThreadPool_WhenElementwiseOpsOnLargeMatrices_ThenMatchSerial) {
+    // 400 x 400 is above MATRIX_OPS_PARALLEL_MIN_ELEMENTS; the view exercises row ranges
+    const int n = 400;
+    Matrix* A = CreateFilled(n, n, false, 0.2);
+    Matrix* B = CreateFilled(n, n, false, 1.3);
+    Matrix* S = matrix_core_create(n, n, nullptr);
+    Matrix* T = matrix_core_create(n, n, nullptr);
+    Matrix* P = CreateFilled(n + 1, n + 1, false, 2.5);
+    MatrixView v;
+    ASSERT_EQ(matrix_view_block(&v, P, 1, 1, n, n), CORE_ERROR_SUCCESS);
+
+    auto run = [&](Matrix* out) {
+        EXPECT_EQ(matrix_ops_add(out, A, B), CORE_ERROR_SUCCESS);
+        EXPECT_EQ(matrix_ops_axpy(out, -0.3, &v), CORE_ERROR_SUCCESS);
+        EXPECT_EQ(matrix_ops_scale(out, 1.7), CORE_ERROR_SUCCESS);
+    };
+    run(S);
+    ASSERT_EQ(core_thread_pool_set_workers(4), CORE_ERROR_SUCCESS);
+    run(T);
+    EXPECT_EQ(matrix_ops_copy(&v, T), CORE_ERROR_SUCCESS);
+    EXPECT_EQ(matrix_ops_fill(A, 3.0), CORE_ERROR_SUCCESS);
+    core_thread_pool_shutdown();
+
+    ExpectSameValues(S, T, 0.0);
+    ExpectSameValues(&v, T, 0.0);
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < n; ++j) ASSERT_EQ(A->data[i * A->ld + j], 3.0);
+    }
+    EXPECT_EQ(P->data[0], std::sin(2.5));  // outside the view
+
+    for (Matrix* p : { A, B, S, T, P }) matrix_core_free(p);
+}
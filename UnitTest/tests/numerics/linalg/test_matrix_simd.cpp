@@ -0,0 +1,199 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include <cmath>
+
+extern "C" {
+#include "core_matrix.h"
+#include "matrix_ops.h"
+#include "matrix_gemm.h"
+#include "matrix_simd.h"
+#include "core_error.h"
+}
+
+#include "test_utils.h"
+
+// ========== Helpers ==========
+// Restores the detected level when a test finishes so later tests are unaffected.
+class MatrixSimdTest : public ::testing::Test {
+protected:
+    void TearDown() override {
+        ASSERT_EQ(matrix_simd_set_level(matrix_simd_detect()), CORE_ERROR_SUCCESS);
+    }
+
+    static std::vector<const MatrixSimdKernels*> SupportedLevels() {
+        std::vector<const MatrixSimdKernels*> out;
+        for (int lv = 0; lv < MATRIX_SIMD_LEVEL_COUNT; ++lv) {
+            const MatrixSimdKernels* k = matrix_simd_kernels_for((MatrixSimdLevel)lv);
+            if (k) out.push_back(k);
+        }
+        return out;
+    }
+};
+
+// ========== Detection / selection ==========
+TEST_F(MatrixSimdTest, GivenDetectedLevel_WhenQueryTables_ThenAllLowerLevelsAreAvailable) {
+    const MatrixSimdLevel detected = matrix_simd_detect();
+    for (int lv = 0; lv < MATRIX_SIMD_LEVEL_COUNT; ++lv) {
+        const MatrixSimdKernels* k = matrix_simd_kernels_for((MatrixSimdLevel)lv);
+        if (lv <= detected) {
+            ASSERT_NE(k, nullptr);
+            EXPECT_EQ(k->level, (MatrixSimdLevel)lv);
+            EXPECT_NE(k->name, nullptr);
+        }
+        else {
+            EXPECT_EQ(k, nullptr);
+        }
+    }
+    EXPECT_NE(matrix_simd_kernels(), nullptr);
+}
+
+TEST_F(MatrixSimdTest, GivenUnsupportedLevel_WhenSetLevel_ThenReturnsErrorAndKeepsActive) {
+    ASSERT_EQ(matrix_simd_set_level(MATRIX_SIMD_SCALAR), CORE_ERROR_SUCCESS);
+    EXPECT_EQ(matrix_simd_get_level(), MATRIX_SIMD_SCALAR);
+
+    EXPECT_EQ(matrix_simd_set_level(MATRIX_SIMD_LEVEL_COUNT), CORE_ERROR_INVALID_ARG);
+    EXPECT_EQ(matrix_simd_set_level((MatrixSimdLevel)-1), CORE_ERROR_INVALID_ARG);
+    EXPECT_EQ(matrix_simd_get_level(), MATRIX_SIMD_SCALAR);
+}
+
+// ========== Kernels vs scalar reference ==========
+TEST_F(MatrixSimdTest, GivenEveryLevel_WhenRunElementwiseKernels_ThenMatchScalar) {
+    const MatrixSimdKernels* ref = matrix_simd_kernels_for(MATRIX_SIMD_SCALAR);
+    ASSERT_NE(ref, nullptr);
+
+    for (const MatrixSimdKernels* k : SupportedLevels()) {
+        // Lengths cover every vector tail; the offset makes the buffers unaligned.
+        for (int n = 0; n <= 67; ++n) {
+            for (int off = 0; off < 2; ++off) {
+                std::vector<double> a(n + off), b(n + off);
+                FillPattern(a, 0.1); FillPattern(b, 0.7);
+                std::vector<double> out(n + off, -1.0), out_ref(n + off, -1.0);
+
+                k->fill(n, 3.25, out.data() + off);
+                ref->fill(n, 3.25, out_ref.data() + off);
+                EXPECT_EQ(out, out_ref) << k->name << " fill n=" << n;
+
+                k->add(n, a.data() + off, b.data() + off, out.data() + off);
+                ref->add(n, a.data() + off, b.data() + off, out_ref.data() + off);
+                EXPECT_EQ(out, out_ref) << k->name << " add n=" << n;
+
+                // Fresh copies rather than assignments: GCC 12 flags the memmove in
+                // vector::operator= with -Wnonnull when a vector may be empty
+                std::vector<double> xs(a), ys(a);
+                k->scale(n, -1.75, xs.data() + off);
+                ref->scale(n, -1.75, ys.data() + off);
+                EXPECT_EQ(xs, ys) << k->name << " scale n=" << n;
+
+                std::vector<double> xa(b), ya(b);
+                k->axpy(n, 0.3, a.data() + off, xa.data() + off);
+                ref->axpy(n, 0.3, a.data() + off, ya.data() + off);
+                EXPECT_EQ(xa, ya) << k->name << " axpy n=" << n;
+            }
+        }
+    }
+}
+
+TEST_F(MatrixSimdTest, GivenEveryLevel_WhenRunGemmMicroKernel_ThenMatchesScalar) {
+    const MatrixSimdKernels* ref = matrix_simd_kernels_for(MATRIX_SIMD_SCALAR);
+    const int mr = MATRIX_GEMM_MR, nr = MATRIX_GEMM_NR, ldc = nr + 3;
+
+    for (const MatrixSimdKernels* k : SupportedLevels()) {
+        for (int kc : { 0, 1, 2, 7, 64, 257 }) {
+            std::vector<double> ap((size_t)mr * kc), bp((size_t)nr * kc);
+            FillPattern(ap, 0.4);
+            FillPattern(bp, 1.1);
+            std::vector<double> c((size_t)mr * ldc);
+            FillPattern(c, 2.0);
+            std::vector<double> r(c);
+
+            k->gemm_micro(kc, 0.75, ap.data(), bp.data(), c.data(), ldc);
+            ref->gemm_micro(kc, 0.75, ap.data(), bp.data(), r.data(), ldc);
+            for (size_t i = 0; i < c.size(); ++i) {
+                EXPECT_NEAR(c[i], r[i], 1e-13 * (kc + 1)) << k->name << " kc=" << kc;
+            }
+        }
+    }
+}
+
+TEST_F(MatrixSimdTest, GivenEveryLevel_WhenRunGemv_ThenMatchesScalar) {
+    const MatrixSimdKernels* ref = matrix_simd_kernels_for(MATRIX_SIMD_SCALAR);
+
+    for (const MatrixSimdKernels* k : SupportedLevels()) {
+        // Row counts cover the 4-row blocks and remainders, columns every vector tail.
+        for (int m : { 1, 3, 4, 5, 8, 11 }) {
+            for (int n = 0; n <= 19; ++n) {
+                const int lda = n + 1;
+                std::vector<double> A((size_t)m * lda), x(n), y(m);
+                FillPattern(A, 0.5);
+                FillPattern(x, 1.2);
+                FillPattern(y, 2.4);
+                std::vector<double> r(y);
+
+                for (double beta : { 0.0, 0.5 }) {
+                    k->gemv(m, n, 1.25, A.data(), lda, x.data(), beta, y.data());
+                    ref->gemv(m, n, 1.25, A.data(), lda, x.data(), beta, r.data());
+                    for (int i = 0; i < m; ++i) {
+                        EXPECT_NEAR(y[i], r[i], 1e-13) << k->name << " m=" << m << " n=" << n;
+                    }
+                }
+            }
+        }
+    }
+}
+
+TEST_F(MatrixSimdTest, GivenEveryLevel_WhenRunSgemm_ThenMatchesScalar) {
+    const MatrixSimdKernels* ref = matrix_simd_kernels_for(MATRIX_SIMD_SCALAR);
+
+    for (const MatrixSimdKernels* k : SupportedLevels()) {
+        // Rows cover the 4-row tiles and single leftovers; columns the 32/16/8-wide
+        // slabs and scalar tails of every level.
+        for (int m : { 1, 4, 7 }) {
+            for (int n : { 0, 3, 8, 17, 40, 53 }) {
+                for (int kd : { 0, 1, 9, 70 }) {
+                    const int lda = kd + 2, ldb = n + 1, ldc = n + 3;
+                    std::vector<float> A((size_t)m * lda), B((size_t)kd * ldb), C((size_t)m * ldc);
+                    for (size_t i = 0; i < A.size(); ++i) A[i] = (float)std::sin(0.3 + 0.37 * (double)i);
+                    for (size_t i = 0; i < B.size(); ++i) B[i] = (float)std::cos(1.1 + 0.53 * (double)i);
+                    for (size_t i = 0; i < C.size(); ++i) C[i] = (float)std::sin(2.0 + 0.11 * (double)i);
+                    std::vector<float> R(C);
+
+                    k->sgemm(m, n, kd, -0.75f, A.data(), lda, B.data(), ldb, C.data(), ldc);
+                    ref->sgemm(m, n, kd, -0.75f, A.data(), lda, B.data(), ldb, R.data(), ldc);
+                    for (size_t i = 0; i < C.size(); ++i) {
+                        EXPECT_NEAR(C[i], R[i], 2e-6f * (kd + 1)) << k->name << " " << m << "x" << n << "x" << kd;
+                    }
+                }
+            }
+        }
+    }
+}
+
+// ========== matrix_ops under each level ==========
+TEST_F(MatrixSimdTest, GivenEveryLevel_WhenMultiply_ThenResultsAgree) {
+    CoreErrorStatus err = CORE_ERROR_SUCCESS;
+    const int m = 37, n = 45, kk = 29;
+    Matrix* A = matrix_core_create(m, kk, &err); ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+    Matrix* B = matrix_core_create(kk, n, &err); ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+    Matrix* C = matrix_core_create(m, n, &err); ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+    Matrix* R = matrix_core_create(m, n, &err); ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+
+    std::vector<double> a((size_t)m * kk), b((size_t)kk * n);
+    FillPattern(a, 0.3);
+    FillPattern(b, 0.8);
+    for (size_t i = 0; i < a.size(); ++i) A->data[i] = a[i];
+    for (size_t i = 0; i < b.size(); ++i) B->data[i] = b[i];
+
+    ASSERT_EQ(matrix_simd_set_level(MATRIX_SIMD_SCALAR), CORE_ERROR_SUCCESS);
+    ASSERT_EQ(matrix_ops_multiply(R, A, B), CORE_ERROR_SUCCESS);
+
+    for (const MatrixSimdKernels* k : SupportedLevels()) {
+        ASSERT_EQ(matrix_simd_set_level(k->level), CORE_ERROR_SUCCESS);
+        ASSERT_EQ(matrix_ops_multiply(C, A, B), CORE_ERROR_SUCCESS);
+        for (int i = 0; i < m * n; ++i) EXPECT_NEAR(C->data[i], R->data[i], 1e-12) << k->name;
+    }
+
+    EXPECT_EQ(matrix_core_free(R), CORE_ERROR_SUCCESS);
+    EXPECT_EQ(matrix_core_free(C), CORE_ERROR_SUCCESS);
+    EXPECT_EQ(matrix_core_free(B), CORE_ERROR_SUCCESS);
+    EXPECT_EQ(matrix_core_free(A), CORE_ERROR_SUCCESS);
+}
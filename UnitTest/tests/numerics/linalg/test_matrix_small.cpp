@@ -0,0 +1,180 @@
+#include <gtest/gtest.h>
+#include <cmath>
+
+extern "C" {
+#include "matrix_small.h"
+#include "matrix_ops.h"
+#include "matrix_solve.h"
+#include "pade.h"
+#include "core_matrix.h"
+#include "core_error.h"
+}
+
+// ========== Helpers ==========
+static Matrix* Make(int rows, int cols, std::initializer_list<double> v) {
+    CoreErrorStatus err = CORE_ERROR_SUCCESS;
+    Matrix* m = matrix_core_create(rows, cols, &err);
+    int k = 0;
+    for (double x : v) { m->data[(k / cols) * m->ld + k % cols] = x; ++k; }
+    return m;
+}
+
+// exp(A) through the general Pade path: embed A in a 4x4 block-diagonal matrix.
+static void ReferenceExpm(const Matrix* A, Matrix* E) {
+    CoreErrorStatus err = CORE_ERROR_SUCCESS;
+    Matrix* big = matrix_core_create(4, 4, &err);
+    Matrix* ebig = matrix_core_create(4, 4, &err);
+    ASSERT_EQ(matrix_ops_set_zero(big), CORE_ERROR_SUCCESS);
+    ASSERT_EQ(matrix_ops_set_block(big, 0, 0, A), CORE_ERROR_SUCCESS);
+    ASSERT_EQ(pade_expm(big, ebig), CORE_ERROR_SUCCESS);
+    ASSERT_EQ(matrix_ops_get_block(ebig, 0, 0, E), CORE_ERROR_SUCCESS);
+    matrix_core_free(big);
+    matrix_core_free(ebig);
+}
+
+static void ExpectClose(const Matrix* a, const Matrix* b, double rel) {
+    double scale = 0.0;
+    for (int i = 0; i < b->rows; ++i)
+        for (int j = 0; j < b->cols; ++j) scale = std::fmax(scale, std::fabs(b->data[i * b->ld + j]));
+    for (int i = 0; i < a->rows; ++i)
+        for (int j = 0; j < a->cols; ++j)
+            EXPECT_NEAR(a->data[i * a->ld + j], b->data[i * b->ld + j], rel * scale) << "(" << i << "," << j << ")";
+}
+
+// ========== matrix_small_expm ==========
+TEST(MatrixSmall_Expm, GivenScalar_WhenExpm_ThenExp) {
+    Matrix* A = Make(1, 1, { -0.75 });
+    Matrix* E = Make(1, 1, { 0.0 });
+    int done = 0;
+    ASSERT_EQ(matrix_small_expm(A, E, &done), CORE_ERROR_SUCCESS);
+    EXPECT_EQ(done, 1);
+    EXPECT_DOUBLE_EQ(E->data[0], std::exp(-0.75));
+    matrix_core_free(A);
+    matrix_core_free(E);
+}
+
+TEST(MatrixSmall_Expm, GivenRotationGenerator_WhenExpm_ThenRotation) {
+    const double w = 2.5;   // needs squaring (||N||_1 = 2.5)
+    Matrix* A = Make(2, 2, { 0.3, -w, w, 0.3 });
+    Matrix* E = Make(2, 2, { 0, 0, 0, 0 });
+    int done = 0;
+    ASSERT_EQ(matrix_small_expm(A, E, &done), CORE_ERROR_SUCCESS);
+    ASSERT_EQ(done, 1);
+    const double s = std::exp(0.3);
+    EXPECT_NEAR(E->data[0], s * std::cos(w), 1e-14);
+    EXPECT_NEAR(E->data[1], -s * std::sin(w), 1e-14);
+    EXPECT_NEAR(E->data[2], s * std::sin(w), 1e-14);
+    EXPECT_NEAR(E->data[3], s * std::cos(w), 1e-14);
+    matrix_core_free(A);
+    matrix_core_free(E);
+}
+
+TEST(MatrixSmall_Expm, GivenJordanBlock_WhenExpm_ThenExact) {
+    // Defective (repeated eigenvalue): exp([[l, 1], [0, l]]) = e^l [[1, 1], [0, 1]]
+    Matrix* A = Make(2, 2, { -1.5, 1.0, 0.0, -1.5 });
+    int done = 0;
+    ASSERT_EQ(matrix_small_expm(A, A, &done), CORE_ERROR_SUCCESS);   // in place
+    ASSERT_EQ(done, 1);
+    const double e = std::exp(-1.5);
+    EXPECT_NEAR(A->data[0], e, 1e-16);
+    EXPECT_NEAR(A->data[1], e, 1e-16);
+    EXPECT_EQ(A->data[2], 0.0);
+    EXPECT_NEAR(A->data[3], e, 1e-16);
+    matrix_core_free(A);
+}
+
+TEST(MatrixSmall_Expm, Given3x3_WhenExpm_ThenMatchesPadePath) {
+    // ZOH block of a 2-state motor plus a general dense matrix
+    for (double ts : { 0.001, 0.01, 0.1, 0.5 }) {
+        Matrix* A = Make(3, 3, { 0, ts, 0,   0, -3.5 * ts, 12 * ts,   0, 0, 0 });
+        Matrix* E = Make(3, 3, { 0, 0, 0, 0, 0, 0, 0, 0, 0 });
+        Matrix* R = Make(3, 3, { 0, 0, 0, 0, 0, 0, 0, 0, 0 });
+        int done = 0;
+        ASSERT_EQ(matrix_small_expm(A, E, &done), CORE_ERROR_SUCCESS);
+        ASSERT_EQ(done, 1) << "ts=" << ts;
+        ReferenceExpm(A, R);
+        ExpectClose(E, R, 1e-14);
+        matrix_core_free(A); matrix_core_free(E); matrix_core_free(R);
+    }
+
+    Matrix* A = Make(3, 3, { 0.4, -1.1, 0.7,   0.9, -0.2, 1.3,   -0.6, 0.5, 0.1 });
+    Matrix* E = Make(3, 3, { 0, 0, 0, 0, 0, 0, 0, 0, 0 });
+    Matrix* R = Make(3, 3, { 0, 0, 0, 0, 0, 0, 0, 0, 0 });
+    int done = 0;
+    ASSERT_EQ(matrix_small_expm(A, E, &done), CORE_ERROR_SUCCESS);
+    ASSERT_EQ(done, 1);
+    ReferenceExpm(A, R);
+    ExpectClose(E, R, 1e-14);
+    matrix_core_free(A); matrix_core_free(E); matrix_core_free(R);
+}
+
+TEST(MatrixSmall_Expm, GivenLargeNormOrLargeSize_WhenExpm_ThenDeclinesAndKeepsResult) {
+    Matrix* A = Make(2, 2, { -100.0, 0.0, 0.0, 0.0 });
+    Matrix* E = Make(2, 2, { 7, 7, 7, 7 });
+    int done = 1;
+    ASSERT_EQ(matrix_small_expm(A, E, &done), CORE_ERROR_SUCCESS);
+    EXPECT_EQ(done, 0);
+    for (int k = 0; k < 4; ++k) EXPECT_EQ(E->data[k], 7.0);
+
+    // The Pade fallback still handles it
+    ASSERT_EQ(pade_expm(A, E), CORE_ERROR_SUCCESS);
+    EXPECT_NEAR(E->data[0], std::exp(-100.0), 1e-50);
+    EXPECT_NEAR(E->data[3], 1.0, 1e-15);
+
+    CoreErrorStatus err = CORE_ERROR_SUCCESS;
+    Matrix* B = matrix_core_create(4, 4, &err);
+    Matrix* F = matrix_core_create(4, 4, &err);
+    ASSERT_EQ(matrix_ops_set_zero(B), CORE_ERROR_SUCCESS);
+    ASSERT_EQ(matrix_small_expm(B, F, &done), CORE_ERROR_SUCCESS);
+    EXPECT_EQ(done, 0);
+
+    EXPECT_EQ(matrix_small_expm(A, F, &done), CORE_ERROR_DIMENSION);
+    EXPECT_EQ(matrix_small_expm(nullptr, E, &done), CORE_ERROR_NULL);
+
+    for (Matrix* m : { A, E, B, F }) matrix_core_free(m);
+}
+
+// ========== matrix_small_solve ==========
+TEST(MatrixSmall_Solve, GivenWellConditioned_WhenSolve_ThenMatchesLU) {
+    Matrix* A = Make(3, 3, { 4, -2, 1,   3, 6, -4,   2, 1, 8 });
+    Matrix* B = Make(3, 2, { 12, 1,   -25, 0,   32, -1 });
+    Matrix* X = Make(3, 2, { 0, 0, 0, 0, 0, 0 });
+    int done = 0;
+    ASSERT_EQ(matrix_small_solve(A, X, B, &done), CORE_ERROR_SUCCESS);
+    ASSERT_EQ(done, 1);
+
+    // Residual A*X - B
+    for (int c = 0; c < 2; ++c) {
+        for (int i = 0; i < 3; ++i) {
+            double r = -B->data[i * 2 + c];
+            for (int j = 0; j < 3; ++j) r += A->data[i * 3 + j] * X->data[j * 2 + c];
+            EXPECT_NEAR(r, 0.0, 1e-13);
+        }
+    }
+
+    // In place on the right-hand side
+    ASSERT_EQ(matrix_small_solve(A, B, B, &done), CORE_ERROR_SUCCESS);
+    ASSERT_EQ(done, 1);
+    for (int k = 0; k < 6; ++k) EXPECT_EQ(B->data[k], X->data[k]);
+
+    for (Matrix* m : { A, B, X }) matrix_core_free(m);
+}
+
+TEST(MatrixSmall_Solve, GivenSingularOrIllConditioned_WhenSolve_ThenDeclines) {
+    Matrix* S = Make(2, 2, { 1, 2, 2, 4 });
+    Matrix* H = Make(2, 2, { 1, 1, 1, 1 + 1e-9 });
+    Matrix* b = Make(2, 1, { 1, 2 });
+    Matrix* x = Make(2, 1, { 5, 5 });
+    int done = 1;
+
+    ASSERT_EQ(matrix_small_solve(S, x, b, &done), CORE_ERROR_SUCCESS);
+    EXPECT_EQ(done, 0);
+    EXPECT_EQ(x->data[0], 5.0);
+    EXPECT_EQ(matrix_solve_LU(S, x, b), CORE_ERROR_NUMERIC);
+
+    ASSERT_EQ(matrix_small_solve(H, x, b, &done), CORE_ERROR_SUCCESS);
+    EXPECT_EQ(done, 0);
+    EXPECT_EQ(matrix_solve_LU(H, x, b), CORE_ERROR_SUCCESS);   // LU fallback
+
+    for (Matrix* m : { S, H, b, x }) matrix_core_free(m);
+}
@@ -1,8 +1,12 @@
 #include <gtest/gtest.h>
+#include <cmath>
+#include <utility>
+#include <vector>
 
 extern "C" {
 #include "matrix_solve.h"
 #include "matrix_ops.h"
+#include "matrix_norm.h"
 #include "core_matrix.h"
 #include "core_error.h"
 }
@@ -104,3 +108,468 @@ TEST(MatrixSolve_LU, GivenDimensionMismatch_WhenSolve_ThenErrInvalidArg) {
     EXPECT_EQ(matrix_core_free(A), CORE_ERROR_SUCCESS);
 }
 
+
+// Row 2 becomes the first pivot and row 0 the second: a 3-cycle permutation
+// that has to be replayed on B as a sequence of swaps.
+TEST(MatrixSolve_LU, GivenCyclicPivoting_WhenSolve_ThenResidualIsZero) {
+    CoreErrorStatus err = CORE_ERROR_SUCCESS;
+    Matrix* A = matrix_core_create(3, 3, &err); ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+    Matrix* B = matrix_core_create(3, 1, &err); ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+    Matrix* X = matrix_core_create(3, 1, &err); ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+    Matrix* R = matrix_core_create(3, 1, &err); ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+
+    const double a[9] = { 1, 2, 0, 3, 1, 5, 6, 1, 2 };
+    const double b[3] = { 1, 2, 3 };
+    for (int i = 0; i < 9; ++i) A->data[i] = a[i];
+    for (int i = 0; i < 3; ++i) B->data[i] = b[i];
+
+    ASSERT_EQ(matrix_solve_LU(A, X, B), CORE_ERROR_SUCCESS);
+    ASSERT_EQ(matrix_ops_multiply(R, A, X), CORE_ERROR_SUCCESS);
+    for (int i = 0; i < 3; ++i) EXPECT_NEAR(R->data[i], b[i], 1e-12);
+
+    matrix_core_free(R);
+    matrix_core_free(X);
+    matrix_core_free(B);
+    matrix_core_free(A);
+}
+
+// ========== matrix_solve_LU_ws ==========
+TEST(MatrixSolve_LU_ws, GivenWorkspace_WhenSolve_ThenMatchesAllocatingSolve) {
+    CoreErrorStatus err = CORE_ERROR_SUCCESS;
+    const int n = 4, nrhs = 2;
+    Matrix* A = matrix_core_create(n, n, &err); ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+    Matrix* B = matrix_core_create(n, nrhs, &err); ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+    Matrix* X = matrix_core_create(n, nrhs, &err); ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+    Matrix* Xws = matrix_core_create(n, nrhs, &err); ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+    Matrix* LU = matrix_core_create(n, n, &err); ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+    int piv[n];
+
+    for (int i = 0; i < n * n; ++i) A->data[i] = (double)((i * 7) % 5) - 1.5 + (i % (n + 1) == 0 ? 4.0 : 0.0);
+    for (int i = 0; i < n * nrhs; ++i) B->data[i] = 0.5 * i - 1.0;
+
+    ASSERT_EQ(matrix_solve_LU(A, X, B), CORE_ERROR_SUCCESS);
+    ASSERT_EQ(matrix_solve_LU_ws(A, Xws, B, LU, piv), CORE_ERROR_SUCCESS);
+    for (int i = 0; i < n * nrhs; ++i) EXPECT_EQ(Xws->data[i], X->data[i]);
+
+    // B may be overwritten by its own solution.
+    ASSERT_EQ(matrix_solve_LU_ws(A, B, B, LU, piv), CORE_ERROR_SUCCESS);
+    for (int i = 0; i < n * nrhs; ++i) EXPECT_EQ(B->data[i], X->data[i]);
+
+    matrix_core_free(LU);
+    matrix_core_free(Xws);
+    matrix_core_free(X);
+    matrix_core_free(B);
+    matrix_core_free(A);
+}
+
+TEST(MatrixSolve_LU_ws, GivenWorkspace_WhenSolve_ThenFactorsReconstructPermutedA) {
+    // Layout contract shared by every backend: unit-lower L and U packed in
+    // LU_ws, piv[k] = row swapped with k at step k, and P * A = L * U.
+    CoreErrorStatus err = CORE_ERROR_SUCCESS;
+    const int n = 6;
+    Matrix* A = matrix_core_create(n, n, &err); ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+    Matrix* B = matrix_core_create(n, 1, &err); ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+    Matrix* X = matrix_core_create(n, 1, &err); ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+    Matrix* LU = matrix_core_create(n, n, &err); ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+    int piv[n];
+
+    for (int i = 0; i < n * n; ++i) A->data[i] = std::sin(0.7 * i + 0.2);
+    for (int i = 0; i < n; ++i) B->data[i] = 1.0;
+    ASSERT_EQ(matrix_solve_LU_ws(A, X, B, LU, piv), CORE_ERROR_SUCCESS);
+
+    double PA[n][n];
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < n; ++j) PA[i][j] = A->data[i * n + j];
+    }
+    for (int k = 0; k < n; ++k) {
+        ASSERT_GE(piv[k], k);
+        ASSERT_LT(piv[k], n);
+        for (int j = 0; j < n; ++j) std::swap(PA[k][j], PA[piv[k]][j]);
+    }
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < n; ++j) {
+            double s = 0.0;
+            for (int k = 0; k <= i && k <= j; ++k) {
+                const double l = (k == i) ? 1.0 : LU->data[i * n + k];
+                s += l * LU->data[k * n + j];
+            }
+            EXPECT_NEAR(s, PA[i][j], 1e-13) << "(" << i << "," << j << ")";
+        }
+    }
+
+    matrix_core_free(LU);
+    matrix_core_free(X);
+    matrix_core_free(B);
+    matrix_core_free(A);
+}
+
+TEST(MatrixSolve_LU_ws, GivenLargeMatrix_WhenSolve_ThenRecursiveFactorsReconstructPermutedA) {
+    // Same layout contract as above at n = 97, which goes through several
+    // levels of the recursive factorization.
+    CoreErrorStatus err = CORE_ERROR_SUCCESS;
+    const int n = 97;
+    Matrix* A = matrix_core_create(n, n, &err); ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+    Matrix* B = matrix_core_create(n, 1, &err); ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+    Matrix* X = matrix_core_create(n, 1, &err); ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+    Matrix* LU = matrix_core_create(n, n, &err); ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+    std::vector<int> piv(n);
+
+    for (int i = 0; i < n * n; ++i) A->data[i] = std::sin(0.7 * i + 0.2);
+    for (int i = 0; i < n; ++i) B->data[i] = 1.0;
+    ASSERT_EQ(matrix_solve_LU_ws(A, X, B, LU, piv.data()), CORE_ERROR_SUCCESS);
+
+    std::vector<double> PA(A->data, A->data + (size_t)n * n);
+    for (int k = 0; k < n; ++k) {
+        ASSERT_GE(piv[k], k);
+        ASSERT_LT(piv[k], n);
+        for (int j = 0; j < n; ++j) std::swap(PA[k * n + j], PA[piv[k] * n + j]);
+    }
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < n; ++j) {
+            double s = 0.0;
+            for (int k = 0; k <= i && k <= j; ++k) {
+                const double l = (k == i) ? 1.0 : LU->data[i * n + k];
+                ASSERT_LE(std::fabs(l), 1.0);   // partial pivoting bounds L
+                s += l * LU->data[k * n + j];
+            }
+            EXPECT_NEAR(s, PA[i * n + j], 1e-12) << "(" << i << "," << j << ")";
+        }
+    }
+
+    matrix_core_free(LU);
+    matrix_core_free(X);
+    matrix_core_free(B);
+    matrix_core_free(A);
+}
+
+TEST(MatrixSolve_LU, GivenLargeSystemWithManyRhs_WhenSolve_ThenResidualIsSmall) {
+    CoreErrorStatus err = CORE_ERROR_SUCCESS;
+    const int n = 150, nrhs = 40;
+    Matrix* A = matrix_core_create(n, n, &err); ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+    Matrix* B = matrix_core_create(n, nrhs, &err); ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+    Matrix* X = matrix_core_create(n, nrhs, &err); ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+    Matrix* R = matrix_core_create(n, nrhs, &err); ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+
+    for (int i = 0; i < n * n; ++i) A->data[i] = std::sin(1.3 * i) + std::cos(0.01 * i * i);
+    for (int i = 0; i < n * nrhs; ++i) B->data[i] = std::cos(0.37 * i);
+
+    ASSERT_EQ(matrix_solve_LU(A, X, B), CORE_ERROR_SUCCESS);
+    ASSERT_EQ(matrix_ops_multiply(R, A, X), CORE_ERROR_SUCCESS);
+    double worst = 0.0;
+    for (int i = 0; i < n * nrhs; ++i) worst = std::fmax(worst, std::fabs(R->data[i] - B->data[i]));
+    EXPECT_LT(worst, 1e-9);
+
+    matrix_core_free(R);
+    matrix_core_free(X);
+    matrix_core_free(B);
+    matrix_core_free(A);
+}
+
+TEST(MatrixSolve_LU, GivenLargeSingularMatrix_WhenSolve_ThenErrNumeric) {
+    // A zero column stays exactly zero under elimination, so the zero pivot
+    // is found at step 70, deep inside the recursive factorization.
+    CoreErrorStatus err = CORE_ERROR_SUCCESS;
+    const int n = 90;
+    Matrix* A = matrix_core_create(n, n, &err); ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+    Matrix* B = matrix_core_create(n, 1, &err); ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+    Matrix* X = matrix_core_create(n, 1, &err); ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < n; ++j) A->data[i * n + j] = (i == j ? 3.0 : 0.0) + 1.0 / (1.0 + i + 2 * j);
+        B->data[i] = 1.0;
+    }
+    for (int i = 0; i < n; ++i) A->data[i * n + 70] = 0.0;
+
+    EXPECT_EQ(matrix_solve_LU(A, X, B), CORE_ERROR_NUMERIC);
+
+    matrix_core_free(X);
+    matrix_core_free(B);
+    matrix_core_free(A);
+}
+
+TEST(MatrixSolve_LU_ws, GivenBadWorkspace_WhenSolve_ThenReturnsError) {
+    CoreErrorStatus err = CORE_ERROR_SUCCESS;
+    Matrix* A = matrix_core_create(2, 2, &err); ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+    Matrix* B = matrix_core_create(2, 1, &err); ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+    Matrix* X = matrix_core_create(2, 1, &err); ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+    Matrix* LU = matrix_core_create(3, 3, &err); ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+    int piv[3];
+
+    EXPECT_EQ(matrix_solve_LU_ws(A, X, B, nullptr, piv), CORE_ERROR_NULL);
+    EXPECT_EQ(matrix_solve_LU_ws(A, X, B, LU, nullptr), CORE_ERROR_NULL);
+    EXPECT_EQ(matrix_solve_LU_ws(A, X, B, LU, piv), CORE_ERROR_DIMENSION);
+
+    matrix_core_free(LU);
+    matrix_core_free(X);
+    matrix_core_free(B);
+    matrix_core_free(A);
+}
+
+TEST(MatrixSolve_LU, GivenPaddedMatrices_WhenSolve_ThenMatchesUnpadded) {
+    CoreErrorStatus err = CORE_ERROR_SUCCESS;
+    const int n = 5, nrhs = 3;
+    Matrix* A = matrix_core_create(n, n, &err);
+    Matrix* B = matrix_core_create(n, nrhs, &err);
+    Matrix* X = matrix_core_create(n, nrhs, &err);
+    Matrix* Ap = matrix_core_create_padded(n, n, &err);
+    Matrix* Bp = matrix_core_create_padded(n, nrhs, &err);
+    Matrix* Xp = matrix_core_create_padded(n, nrhs, &err);
+    ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < n; ++j) {
+            const double v = (i == j ? 6.0 : 0.0) + 0.3 * ((i * 3 + j) % 7) - 1.0;
+            ASSERT_EQ(matrix_ops_set(A, i, j, v), CORE_ERROR_SUCCESS);
+            ASSERT_EQ(matrix_ops_set(Ap, i, j, v), CORE_ERROR_SUCCESS);
+        }
+        for (int j = 0; j < nrhs; ++j) {
+            ASSERT_EQ(matrix_ops_set(B, i, j, i - 2.0 * j), CORE_ERROR_SUCCESS);
+            ASSERT_EQ(matrix_ops_set(Bp, i, j, i - 2.0 * j), CORE_ERROR_SUCCESS);
+        }
+    }
+
+    ASSERT_EQ(matrix_solve_LU(A, X, B), CORE_ERROR_SUCCESS);
+    ASSERT_EQ(matrix_solve_LU(Ap, Xp, Bp), CORE_ERROR_SUCCESS);
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < nrhs; ++j) {
+            EXPECT_EQ(matrix_ops_get(Xp, i, j, &err), matrix_ops_get(X, i, j, &err));
+        }
+    }
+
+    for (Matrix* m : { A, B, X, Ap, Bp, Xp }) matrix_core_free(m);
+}
+
+TEST(MatrixSolve_LU, GivenBlockViews_WhenSolve_ThenMatchesCopies) {
+    CoreErrorStatus err = CORE_ERROR_SUCCESS;
+    const int n = 4;
+    // [A | b] stored side by side; solve straight from the augmented matrix.
+    Matrix* Aug = matrix_core_create(n, n + 1, &err);
+    Matrix* A = matrix_core_create(n, n, &err);
+    Matrix* b = matrix_core_create(n, 1, &err);
+    Matrix* x = matrix_core_create(n, 1, &err);
+    Matrix* Xs = matrix_core_create(n, 3, &err);
+    ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < n; ++j) {
+            ASSERT_EQ(matrix_ops_set(Aug, i, j, (i == j ? 5.0 : 0.0) + 0.25 * ((i + 2 * j) % 5)), CORE_ERROR_SUCCESS);
+        }
+        ASSERT_EQ(matrix_ops_set(Aug, i, n, 1.0 - i), CORE_ERROR_SUCCESS);
+    }
+    ASSERT_EQ(matrix_ops_get_block(Aug, 0, 0, A), CORE_ERROR_SUCCESS);
+    ASSERT_EQ(matrix_ops_get_block(Aug, 0, n, b), CORE_ERROR_SUCCESS);
+
+    MatrixView vA, vb, vx;
+    ASSERT_EQ(matrix_view_block(&vA, Aug, 0, 0, n, n), CORE_ERROR_SUCCESS);
+    ASSERT_EQ(matrix_view_block(&vb, Aug, 0, n, n, 1), CORE_ERROR_SUCCESS);
+    ASSERT_EQ(matrix_view_block(&vx, Xs, 0, 1, n, 1), CORE_ERROR_SUCCESS);
+
+    ASSERT_EQ(matrix_solve_LU(A, x, b), CORE_ERROR_SUCCESS);
+    ASSERT_EQ(matrix_solve_LU(&vA, &vx, &vb), CORE_ERROR_SUCCESS);
+    for (int i = 0; i < n; ++i) {
+        EXPECT_EQ(matrix_ops_get(Xs, i, 1, &err), matrix_ops_get(x, i, 0, &err));
+    }
+
+    for (Matrix* m : { Aug, A, b, x, Xs }) matrix_core_free(m);
+}
+
+// ========== LUFactor ==========
+TEST(MatrixSolve_LUFactor, GivenFactoredMatrix_WhenSolvePlainAndTransposed_ThenResidualsVanish) {
+    CoreErrorStatus err = CORE_ERROR_SUCCESS;
+    const int n = 70, nrhs = 3;
+    Matrix* A = matrix_core_create(n, n, &err); ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+    Matrix* At = matrix_core_create(n, n, &err); ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+    Matrix* LU = matrix_core_create(n, n, &err); ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+    Matrix* B = matrix_core_create(n, nrhs, &err); ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+    Matrix* X = matrix_core_create(n, nrhs, &err); ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+    Matrix* R = matrix_core_create(n, nrhs, &err); ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+    std::vector<int> piv(n);
+
+    for (int i = 0; i < n * n; ++i) A->data[i] = std::sin(1.3 * i) + std::cos(0.01 * i * i);
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < n; ++j) At->data[j * n + i] = A->data[i * n + j];
+    }
+
+    LUFactor f;
+    ASSERT_EQ(matrix_lu_init(&f, LU, piv.data()), CORE_ERROR_SUCCESS);
+    ASSERT_EQ(matrix_lu_factor(&f, A), CORE_ERROR_SUCCESS);
+
+    // Several right-hand sides against the same factors, solved in place
+    for (int round = 0; round < 3; ++round) {
+        for (int t = 0; t < 2; ++t) {
+            for (int i = 0; i < n * nrhs; ++i) B->data[i] = std::cos(0.37 * i + round);
+            ASSERT_EQ(matrix_ops_copy(X, B), CORE_ERROR_SUCCESS);
+            ASSERT_EQ(matrix_lu_solve(&f, (MatrixTranspose)t, X, X), CORE_ERROR_SUCCESS);
+            ASSERT_EQ(matrix_ops_multiply(R, t ? At : A, X), CORE_ERROR_SUCCESS);
+            for (int i = 0; i < n * nrhs; ++i) {
+                EXPECT_NEAR(R->data[i], B->data[i], 1e-9) << "round " << round << " trans " << t;
+            }
+        }
+    }
+
+    for (Matrix* m : { A, At, LU, B, X, R }) matrix_core_free(m);
+}
+
+TEST(MatrixSolve_LUFactor, GivenPivotedMatrix_WhenDet_ThenMatchesCofactorExpansion) {
+    CoreErrorStatus err = CORE_ERROR_SUCCESS;
+    Matrix* A = matrix_core_create(3, 3, &err); ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+    Matrix* LU = matrix_core_create(3, 3, &err); ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+    int piv[3];
+
+    // det = 0*(1*1 - 0*0) - 2*(1*1 - 0*3) + 1*(1*0 - 1*3) = -5, needs row swaps
+    const double a[9] = { 0, 2, 1,  1, 1, 0,  3, 0, 1 };
+    for (int i = 0; i < 9; ++i) A->data[i] = a[i];
+
+    LUFactor f;
+    double det = 0.0;
+    ASSERT_EQ(matrix_lu_init(&f, LU, piv), CORE_ERROR_SUCCESS);
+    EXPECT_EQ(matrix_lu_det(&f, &det), CORE_ERROR_INVALID_ARG);   // not factored yet
+    ASSERT_EQ(matrix_lu_factor(&f, A), CORE_ERROR_SUCCESS);
+    ASSERT_EQ(matrix_lu_det(&f, &det), CORE_ERROR_SUCCESS);
+    EXPECT_NEAR(det, -5.0, 1e-14);
+
+    matrix_core_free(LU);
+    matrix_core_free(A);
+}
+
+TEST(MatrixSolve_LUFactor, GivenKnownConditioning_WhenRcond_ThenEstimateIsTight) {
+    CoreErrorStatus err = CORE_ERROR_SUCCESS;
+    const int n = 30;
+    Matrix* A = matrix_core_create(n, n, &err); ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+    Matrix* LU = matrix_core_create(n, n, &err); ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+    Matrix* I = matrix_core_create(n, n, &err); ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+    Matrix* Ainv = matrix_core_create(n, n, &err); ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+    std::vector<int> piv(n);
+    std::vector<double> work(2 * n);
+    LUFactor f;
+    double rcond = -1.0;
+    ASSERT_EQ(matrix_lu_init(&f, LU, piv.data()), CORE_ERROR_SUCCESS);
+
+    // Diagonal: ||A||_1 = 1, ||A^-1||_1 = 1e6, found exactly
+    ASSERT_EQ(matrix_ops_fill(A, 0.0), CORE_ERROR_SUCCESS);
+    for (int i = 0; i < n; ++i) A->data[i * n + i] = (i == 17) ? 1e-6 : 1.0;
+    ASSERT_EQ(matrix_lu_factor(&f, A), CORE_ERROR_SUCCESS);
+    ASSERT_EQ(matrix_lu_rcond(&f, work.data(), &rcond), CORE_ERROR_SUCCESS);
+    EXPECT_NEAR(rcond, 1e-6, 1e-18);
+
+    // Dense: the estimate bounds ||A^-1||_1 from below, so rcond from above
+    for (int i = 0; i < n * n; ++i) A->data[i] = std::sin(1.1 * i) + std::cos(0.02 * i * i);
+    ASSERT_EQ(matrix_ops_set_identity(I), CORE_ERROR_SUCCESS);
+    ASSERT_EQ(matrix_solve_LU(A, Ainv, I), CORE_ERROR_SUCCESS);
+    double anorm = 0.0, ainvnorm = 0.0;
+    ASSERT_EQ(matrix_norm_1(A, &anorm), CORE_ERROR_SUCCESS);
+    ASSERT_EQ(matrix_norm_1(Ainv, &ainvnorm), CORE_ERROR_SUCCESS);
+    const double exact = 1.0 / (anorm * ainvnorm);
+
+    ASSERT_EQ(matrix_lu_factor(&f, A), CORE_ERROR_SUCCESS);
+    ASSERT_EQ(matrix_lu_rcond(&f, work.data(), &rcond), CORE_ERROR_SUCCESS);
+    EXPECT_GE(rcond, exact * (1.0 - 1e-12));
+    EXPECT_LE(rcond, 3.0 * exact);
+
+    for (Matrix* m : { A, LU, I, Ainv }) matrix_core_free(m);
+}
+
+TEST(MatrixSolve_LUFactor, GivenSingularOrUnfactored_WhenUsed_ThenReturnsError) {
+    CoreErrorStatus err = CORE_ERROR_SUCCESS;
+    Matrix* A = matrix_core_create(4, 4, &err); ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+    Matrix* LU = matrix_core_create(4, 4, &err); ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+    Matrix* LU2 = matrix_core_create(4, 3, &err); ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+    Matrix* X = matrix_core_create(4, 1, &err); ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+    Matrix* Y = matrix_core_create(3, 1, &err); ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+    int piv[4];
+    LUFactor f;
+
+    EXPECT_EQ(matrix_lu_init(&f, LU, nullptr), CORE_ERROR_NULL);
+    EXPECT_EQ(matrix_lu_init(&f, LU2, piv), CORE_ERROR_INVALID_ARG);
+    ASSERT_EQ(matrix_lu_init(&f, LU, piv), CORE_ERROR_SUCCESS);
+    EXPECT_EQ(matrix_lu_solve(&f, MATRIX_NO_TRANS, X, X), CORE_ERROR_INVALID_ARG);
+
+    ASSERT_EQ(matrix_ops_fill(A, 1.0), CORE_ERROR_SUCCESS);   // rank one
+    EXPECT_EQ(matrix_lu_factor(&f, A), CORE_ERROR_NUMERIC);
+    EXPECT_EQ(f.factored, 0);
+
+    ASSERT_EQ(matrix_ops_set_identity(A), CORE_ERROR_SUCCESS);
+    ASSERT_EQ(matrix_lu_factor(&f, A), CORE_ERROR_SUCCESS);
+    EXPECT_EQ(matrix_lu_solve(&f, MATRIX_NO_TRANS, Y, Y), CORE_ERROR_DIMENSION);
+
+    for (Matrix* m : { A, LU, LU2, X, Y }) matrix_core_free(m);
+}
+
+// ========== matrix_solve_LU_mixed ==========
+TEST(MatrixSolve_LUMixed, GivenModeratelyConditionedSystem_WhenSolve_ThenRefinesToDoubleAccuracy) {
+    CoreErrorStatus err = CORE_ERROR_SUCCESS;
+    const int n = 150, nrhs = 5;
+    Matrix* A = matrix_core_create(n, n, &err); ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+    Matrix* B = matrix_core_create(n, nrhs, &err); ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+    Matrix* X = matrix_core_create(n, nrhs, &err); ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+    Matrix* Xref = matrix_core_create(n, nrhs, &err); ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+    for (int i = 0; i < n * n; ++i) A->data[i] = std::sin(1.3 * i) + std::cos(0.01 * i * i);
+    for (int i = 0; i < n * nrhs; ++i) B->data[i] = std::cos(0.37 * i);
+
+    int iter = -2;
+    ASSERT_EQ(matrix_solve_LU_mixed(A, X, B, MATRIX_SOLVE_MIXED_MAX_ITER, &iter), CORE_ERROR_SUCCESS);
+    EXPECT_GE(iter, 1);   // float factors alone are not accurate enough
+    EXPECT_LE(iter, MATRIX_SOLVE_MIXED_MAX_ITER);
+
+    ASSERT_EQ(matrix_solve_LU(A, Xref, B), CORE_ERROR_SUCCESS);
+    double worst = 0.0, scale = 0.0;
+    for (int i = 0; i < n * nrhs; ++i) {
+        worst = std::fmax(worst, std::fabs(X->data[i] - Xref->data[i]));
+        scale = std::fmax(scale, std::fabs(Xref->data[i]));
+    }
+    EXPECT_LT(worst, 1e-11 * scale);
+
+    for (Matrix* m : { A, B, X, Xref }) matrix_core_free(m);
+}
+
+TEST(MatrixSolve_LUMixed, GivenNoConvergence_WhenSolve_ThenFallsBackToDoubleLU) {
+    CoreErrorStatus err = CORE_ERROR_SUCCESS;
+    const int n = 60;
+    Matrix* A = matrix_core_create(n, n, &err); ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+    Matrix* B = matrix_core_create(n, 2, &err); ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+    Matrix* X = matrix_core_create(n, 2, &err); ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+    Matrix* Xref = matrix_core_create(n, 2, &err); ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+    for (int i = 0; i < n * n; ++i) A->data[i] = std::sin(1.1 * i) + std::cos(0.02 * i * i);
+    for (int i = 0; i < n * 2; ++i) B->data[i] = 1.0 + 0.1 * i;
+    ASSERT_EQ(matrix_solve_LU(A, Xref, B), CORE_ERROR_SUCCESS);
+
+    // No refinement sweep allowed: the float solution fails the test and the
+    // double LU takes over, giving exactly its result
+    int iter = 0;
+    ASSERT_EQ(matrix_solve_LU_mixed(A, X, B, 0, &iter), CORE_ERROR_SUCCESS);
+    EXPECT_EQ(iter, -1);
+    for (int i = 0; i < n * 2; ++i) EXPECT_EQ(X->data[i], Xref->data[i]);
+
+    // Hilbert matrix: cond ~ 1e17 is far beyond float, refinement cannot converge
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < n; ++j) A->data[i * n + j] = 1.0 / (1.0 + i + j);
+    }
+    ASSERT_EQ(matrix_solve_LU(A, Xref, B), CORE_ERROR_SUCCESS);
+    ASSERT_EQ(matrix_solve_LU_mixed(A, X, B, MATRIX_SOLVE_MIXED_MAX_ITER, &iter), CORE_ERROR_SUCCESS);
+    EXPECT_EQ(iter, -1);
+    for (int i = 0; i < n * 2; ++i) EXPECT_EQ(X->data[i], Xref->data[i]);
+
+    // Entries beyond float range cannot be rounded to float at all
+    for (int i = 0; i < n * n; ++i) A->data[i] = 1e300 * ((i % (n + 1) == 0) ? 4.0 : std::sin(0.3 * i));
+    ASSERT_EQ(matrix_solve_LU(A, Xref, B), CORE_ERROR_SUCCESS);
+    ASSERT_EQ(matrix_solve_LU_mixed(A, X, B, MATRIX_SOLVE_MIXED_MAX_ITER, &iter), CORE_ERROR_SUCCESS);
+    EXPECT_EQ(iter, -1);
+    for (int i = 0; i < n * 2; ++i) EXPECT_EQ(X->data[i], Xref->data[i]);
+
+    for (Matrix* m : { A, B, X, Xref }) matrix_core_free(m);
+}
+
+TEST(MatrixSolve_LUMixed, GivenBadArguments_WhenSolve_ThenReturnsError) {
+    CoreErrorStatus err = CORE_ERROR_SUCCESS;
+    Matrix* A = matrix_core_create(8, 8, &err); ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+    Matrix* B = matrix_core_create(8, 1, &err); ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+    Matrix* X = matrix_core_create(8, 1, &err); ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+    ASSERT_EQ(matrix_ops_fill(A, 1.0), CORE_ERROR_SUCCESS);
+    ASSERT_EQ(matrix_ops_fill(B, 1.0), CORE_ERROR_SUCCESS);
+
+    EXPECT_EQ(matrix_solve_LU_mixed(nullptr, X, B, 5, nullptr), CORE_ERROR_NULL);
+    EXPECT_EQ(matrix_solve_LU_mixed(A, X, B, -1, nullptr), CORE_ERROR_INVALID_ARG);
+    EXPECT_EQ(matrix_solve_LU_mixed(A, B, B, 5, nullptr), CORE_ERROR_INVALID_ARG);   // X aliases B
+    EXPECT_EQ(matrix_solve_LU_mixed(A, X, B, 5, nullptr), CORE_ERROR_NUMERIC);       // singular in double too
+
+    for (Matrix* m : { A, B, X }) matrix_core_free(m);
+}
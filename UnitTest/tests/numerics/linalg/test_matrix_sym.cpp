@@ -0,0 +1,213 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <vector>
+
+extern "C" {
+#include "matrix_sym.h"
+#include "matrix_ops.h"
+#include "core_matrix.h"
+#include "core_error.h"
+}
+
+// ========== Helpers ==========
+
+// Symmetric n x n matrix; spd adds a dominant diagonal. The strictly upper
+// triangle is set to garbage since the factorizations must not read it.
+static Matrix* MakeSymmetric(int n, bool spd, double seed) {
+    CoreErrorStatus err = CORE_ERROR_SUCCESS;
+    Matrix* A = matrix_core_create(n, n, &err);
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j <= i; ++j) {
+            A->data[i * n + j] = std::sin(seed + 0.37 * i * j + 1.1 * (i + j)) + ((spd && i == j) ? n : 0.0);
+        }
+        for (int j = i + 1; j < n; ++j) A->data[i * n + j] = 1e30;
+    }
+    return A;
+}
+
+static double SymAt(const Matrix* A, int i, int j) {
+    return (j <= i) ? A->data[i * A->ld + j] : A->data[j * A->ld + i];
+}
+
+// max |A X - B| with A read from its lower triangle
+static double SymResidual(const Matrix* A, const Matrix* X, const Matrix* B) {
+    const int n = A->rows;
+    double worst = 0.0;
+    for (int i = 0; i < n; ++i) {
+        for (int c = 0; c < X->cols; ++c) {
+            double s = 0.0;
+            for (int p = 0; p < n; ++p) s += SymAt(A, i, p) * X->data[p * X->ld + c];
+            worst = std::fmax(worst, std::fabs(s - B->data[i * B->ld + c]));
+        }
+    }
+    return worst;
+}
+
+// Backward error |A X - B| / (|A| |X|), the bound a stable solver meets
+// regardless of conditioning
+static double SymBackwardError(const Matrix* A, const Matrix* X, const Matrix* B) {
+    const int n = A->rows;
+    double anorm = 0.0, xnorm = 0.0;
+    for (int i = 0; i < n; ++i) {
+        double s = 0.0;
+        for (int j = 0; j < n; ++j) s += std::fabs(SymAt(A, i, j));
+        anorm = std::fmax(anorm, s);
+    }
+    for (int i = 0; i < n; ++i) {
+        for (int c = 0; c < X->cols; ++c) xnorm = std::fmax(xnorm, std::fabs(X->data[i * X->ld + c]));
+    }
+    return SymResidual(A, X, B) / (anorm * xnorm);
+}
+
+// ========== matrix_syrk_compute ==========
+TEST(MatrixSym_Syrk, GivenEachTriangleAndTransform_WhenUpdate_ThenMatchesReferenceAndOtherTriangleUntouched) {
+    for (int n : { 7, 90 }) {
+        const int k = 13, ldc = n + 2;
+        for (int lower = 0; lower < 2; ++lower) {
+            for (int trans = 0; trans < 2; ++trans) {
+                const int lda = (trans ? n : k) + 1;
+                std::vector<double> A((size_t)(trans ? k : n) * lda), C((size_t)n * ldc);
+                for (size_t i = 0; i < A.size(); ++i) A[i] = std::sin(0.3 * (double)i);
+                for (size_t i = 0; i < C.size(); ++i) C[i] = std::cos(0.7 * (double)i);
+                const std::vector<double> C0 = C;
+
+                ASSERT_EQ(matrix_syrk_compute(lower ? MATRIX_LOWER : MATRIX_UPPER, (MatrixTranspose)trans,
+                    n, k, -0.5, A.data(), lda, 2.0, C.data(), ldc), CORE_ERROR_SUCCESS);
+
+                for (int i = 0; i < n; ++i) {
+                    for (int j = 0; j < n; ++j) {
+                        const size_t ij = (size_t)i * ldc + j;
+                        if (lower ? (j > i) : (j < i)) {
+                            EXPECT_EQ(C[ij], C0[ij]);
+                            continue;
+                        }
+                        double s = 0.0;
+                        for (int p = 0; p < k; ++p) {
+                            s += (trans ? A[(size_t)p * lda + i] : A[(size_t)i * lda + p])
+                               * (trans ? A[(size_t)p * lda + j] : A[(size_t)j * lda + p]);
+                        }
+                        EXPECT_NEAR(C[ij], -0.5 * s + 2.0 * C0[ij], 1e-12) << n << " " << lower << trans;
+                    }
+                }
+            }
+        }
+    }
+}
+
+// ========== matrix_chol ==========
+TEST(MatrixSym_Cholesky, GivenSpdMatrix_WhenFactorAndSolve_ThenReconstructsAndSolves) {
+    // 9 stays in the leaf, 150 recurses through TRSM and SYRK
+    for (int n : { 9, 150 }) {
+        CoreErrorStatus err = CORE_ERROR_SUCCESS;
+        Matrix* A = MakeSymmetric(n, true, 0.4);
+        Matrix* L = matrix_core_create(n, n, &err); ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+        Matrix* B = matrix_core_create(n, 4, &err); ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+        Matrix* X = matrix_core_create(n, 4, &err); ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+        for (int i = 0; i < n * 4; ++i) B->data[i] = std::cos(0.5 * i);
+
+        ASSERT_EQ(matrix_ops_copy(L, A), CORE_ERROR_SUCCESS);
+        ASSERT_EQ(matrix_chol_factor(L), CORE_ERROR_SUCCESS);
+        for (int i = 0; i < n; ++i) {
+            for (int j = 0; j < n; ++j) {
+                if (j > i) {
+                    EXPECT_EQ(L->data[i * n + j], 1e30);   // upper triangle untouched
+                    continue;
+                }
+                double s = 0.0;
+                for (int p = 0; p <= j; ++p) s += L->data[i * n + p] * L->data[j * n + p];
+                EXPECT_NEAR(s, A->data[i * n + j], 1e-11) << "n=" << n;
+            }
+        }
+
+        ASSERT_EQ(matrix_chol_solve(L, X, B), CORE_ERROR_SUCCESS);
+        EXPECT_LT(SymResidual(A, X, B), 1e-11) << "n=" << n;
+
+        matrix_core_free(X);
+        matrix_core_free(B);
+        matrix_core_free(L);
+        matrix_core_free(A);
+    }
+}
+
+TEST(MatrixSym_Cholesky, GivenIndefiniteMatrix_WhenFactor_ThenErrNumeric) {
+    Matrix* A = MakeSymmetric(60, true, 0.1);
+    A->data[45 * 60 + 45] = -100.0;
+    EXPECT_EQ(matrix_chol_factor(A), CORE_ERROR_NUMERIC);
+    EXPECT_EQ(matrix_chol_factor(nullptr), CORE_ERROR_NULL);
+    matrix_core_free(A);
+}
+
+// ========== matrix_ldlt ==========
+TEST(MatrixSym_Ldlt, GivenIndefiniteMatrix_WhenFactorAndSolve_ThenResidualVanishes) {
+    // 10 uses the unblocked kernel only; 200 runs several panels first
+    for (int n : { 10, 200 }) {
+        CoreErrorStatus err = CORE_ERROR_SUCCESS;
+        Matrix* A = MakeSymmetric(n, false, 0.9);
+        Matrix* LD = matrix_core_create(n, n, &err); ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+        Matrix* B = matrix_core_create(n, 3, &err); ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+        Matrix* X = matrix_core_create(n, 3, &err); ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+        std::vector<int> piv(n);
+        std::vector<double> work(MATRIX_LDLT_WORK(n));
+        for (int i = 0; i < n * 3; ++i) B->data[i] = std::cos(0.21 * i);
+
+        ASSERT_EQ(matrix_ops_copy(LD, A), CORE_ERROR_SUCCESS);
+        ASSERT_EQ(matrix_ldlt_factor(LD, piv.data(), work.data()), CORE_ERROR_SUCCESS);
+        for (int i = 0; i < n; ++i) {
+            for (int j = i + 1; j < n; ++j) ASSERT_EQ(LD->data[i * n + j], 1e30);
+        }
+
+        ASSERT_EQ(matrix_ops_copy(X, B), CORE_ERROR_SUCCESS);
+        ASSERT_EQ(matrix_ldlt_solve(LD, piv.data(), X, X), CORE_ERROR_SUCCESS);
+        EXPECT_LT(SymBackwardError(A, X, B), 1e-14) << "n=" << n;
+
+        matrix_core_free(X);
+        matrix_core_free(B);
+        matrix_core_free(LD);
+        matrix_core_free(A);
+    }
+}
+
+TEST(MatrixSym_Ldlt, GivenZeroDiagonal_WhenFactor_ThenUsesTwoByTwoPivots) {
+    // A zero diagonal rules out every 1x1 pivot; 150 > MATRIX_LDLT_NB so the
+    // 2x2 path is taken both in the panels and in the unblocked tail.
+    for (int n : { 6, 150 }) {
+        CoreErrorStatus err = CORE_ERROR_SUCCESS;
+        Matrix* A = MakeSymmetric(n, false, 2.3);
+        for (int i = 0; i < n; ++i) A->data[i * n + i] = 0.0;
+        Matrix* LD = matrix_core_create(n, n, &err); ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+        Matrix* B = matrix_core_create(n, 1, &err); ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+        Matrix* X = matrix_core_create(n, 1, &err); ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+        std::vector<int> piv(n);
+        std::vector<double> work(MATRIX_LDLT_WORK(n));
+        for (int i = 0; i < n; ++i) B->data[i] = 1.0 + i;
+
+        ASSERT_EQ(matrix_ops_copy(LD, A), CORE_ERROR_SUCCESS);
+        ASSERT_EQ(matrix_ldlt_factor(LD, piv.data(), work.data()), CORE_ERROR_SUCCESS);
+        EXPECT_LT(piv[0], 0);
+        EXPECT_EQ(piv[0], piv[1]);
+
+        ASSERT_EQ(matrix_ldlt_solve(LD, piv.data(), X, B), CORE_ERROR_SUCCESS);
+        EXPECT_LT(SymBackwardError(A, X, B), 1e-14) << "n=" << n;
+
+        matrix_core_free(X);
+        matrix_core_free(B);
+        matrix_core_free(LD);
+        matrix_core_free(A);
+    }
+}
+
+TEST(MatrixSym_Ldlt, GivenSingularOrBadArguments_WhenFactor_ThenReturnsError) {
+    CoreErrorStatus err = CORE_ERROR_SUCCESS;
+    Matrix* A = matrix_core_create(3, 3, &err); ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+    Matrix* R = matrix_core_create(3, 2, &err); ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+    int piv[3];
+    std::vector<double> work(MATRIX_LDLT_WORK(3));
+
+    ASSERT_EQ(matrix_ops_fill(A, 0.0), CORE_ERROR_SUCCESS);
+    EXPECT_EQ(matrix_ldlt_factor(A, piv, work.data()), CORE_ERROR_NUMERIC);
+    EXPECT_EQ(matrix_ldlt_factor(A, piv, nullptr), CORE_ERROR_NULL);
+    EXPECT_EQ(matrix_ldlt_factor(R, piv, work.data()), CORE_ERROR_INVALID_ARG);
+
+    matrix_core_free(R);
+    matrix_core_free(A);
+}
@@ -0,0 +1,120 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <vector>
+
+extern "C" {
+#include "matrix_trsm.h"
+#include "core_error.h"
+}
+
+// ========== Helpers ==========
+
+// Row-major t x t triangle with a dominant diagonal; the unreferenced triangle
+// is filled with garbage so reading it would show up in the residual.
+static std::vector<double> MakeTriangle(int t, int ldt, bool lower) {
+    std::vector<double> T((size_t)t * ldt, 1e30);
+    for (int i = 0; i < t; ++i) {
+        for (int j = 0; j < t; ++j) {
+            if (lower ? (j <= i) : (j >= i)) {
+                T[(size_t)i * ldt + j] = (i == j) ? 2.0 + std::cos(0.3 * i) : 0.5 * std::sin(0.7 * i + 1.3 * j) / std::sqrt((double)t);
+            }
+        }
+    }
+    return T;
+}
+
+// op(T)(i, j) honouring uplo and unit diagonal
+static double OpT(const std::vector<double>& T, int ldt, bool lower, bool trans, bool unit, int i, int j) {
+    const int r = trans ? j : i, c = trans ? i : j;
+    if (lower ? (c > r) : (c < r)) return 0.0;
+    if (r == c && unit) return 1.0;
+    return T[(size_t)r * ldt + c];
+}
+
+// max |op(T) X - alpha B| (left) or |X op(T) - alpha B| (right)
+static double Residual(bool left, bool lower, bool trans, bool unit, int m, int n, double alpha,
+    const std::vector<double>& T, int ldt, const std::vector<double>& X, const std::vector<double>& B, int ldb)
+{
+    const int t = left ? m : n;
+    double worst = 0.0;
+    for (int i = 0; i < m; ++i) {
+        for (int j = 0; j < n; ++j) {
+            double s = 0.0;
+            for (int p = 0; p < t; ++p) {
+                s += left ? OpT(T, ldt, lower, trans, unit, i, p) * X[(size_t)p * ldb + j]
+                          : X[(size_t)i * ldb + p] * OpT(T, ldt, lower, trans, unit, p, j);
+            }
+            worst = std::fmax(worst, std::fabs(s - alpha * B[(size_t)i * ldb + j]));
+        }
+    }
+    return worst;
+}
+
+// ========== matrix_trsm_compute ==========
+TEST(MatrixTrsm_Compute, GivenEveryVariant_WhenSolve_ThenResidualVanishes) {
+    // 5 x 3 stays in the leaf; 100 x 70 recurses on either side
+    const int shapes[2][2] = { { 5, 3 }, { 100, 70 } };
+    for (const auto& shape : shapes) {
+        const int m = shape[0], n = shape[1], ldb = n + 3;
+        for (int left = 0; left < 2; ++left) {
+            const int t = left ? m : n, ldt = t + 1;
+            for (int lower = 0; lower < 2; ++lower) {
+                const std::vector<double> T = MakeTriangle(t, ldt, lower != 0);
+                for (int trans = 0; trans < 2; ++trans) {
+                    for (int unit = 0; unit < 2; ++unit) {
+                        std::vector<double> B((size_t)m * ldb);
+                        for (size_t i = 0; i < B.size(); ++i) B[i] = std::cos(0.11 * (double)i);
+                        std::vector<double> X = B;
+                        ASSERT_EQ(matrix_trsm_compute(left ? MATRIX_SIDE_LEFT : MATRIX_SIDE_RIGHT,
+                            lower ? MATRIX_LOWER : MATRIX_UPPER, (MatrixTranspose)trans,
+                            unit ? MATRIX_UNIT : MATRIX_NON_UNIT, m, n, -1.5,
+                            T.data(), ldt, X.data(), ldb), CORE_ERROR_SUCCESS);
+                        EXPECT_LT(Residual(left, lower, trans, unit, m, n, -1.5, T, ldt, X, B, ldb), 1e-12)
+                            << m << "x" << n << " left=" << left << " lower=" << lower
+                            << " trans=" << trans << " unit=" << unit;
+                    }
+                }
+            }
+        }
+    }
+}
+
+TEST(MatrixTrsm_Compute, GivenZeroAlpha_WhenSolve_ThenBIsZeroedWithoutReadingT) {
+    double B[6] = { 1, 2, 3, 4, 5, 6 };
+    double T[4] = { 0, 0, 0, 0 };   // singular, but alpha == 0 never looks at it
+    ASSERT_EQ(matrix_trsm_compute(MATRIX_SIDE_LEFT, MATRIX_LOWER, MATRIX_NO_TRANS, MATRIX_NON_UNIT,
+        2, 3, 0.0, T, 2, B, 3), CORE_ERROR_SUCCESS);
+    for (double v : B) EXPECT_EQ(v, 0.0);
+}
+
+TEST(MatrixTrsm_Compute, GivenZeroOnDiagonal_WhenSolve_ThenErrNumericAndBUntouched) {
+    const int t = 40;
+    std::vector<double> T = MakeTriangle(t, t, false);
+    T[(size_t)33 * t + 33] = 0.0;
+    std::vector<double> B(t, 1.0);
+
+    EXPECT_EQ(matrix_trsm_compute(MATRIX_SIDE_LEFT, MATRIX_UPPER, MATRIX_NO_TRANS, MATRIX_NON_UNIT,
+        t, 1, 1.0, T.data(), t, B.data(), 1), CORE_ERROR_NUMERIC);
+    for (double v : B) EXPECT_EQ(v, 1.0);
+
+    // With a unit diagonal the zero is never read
+    EXPECT_EQ(matrix_trsm_compute(MATRIX_SIDE_LEFT, MATRIX_UPPER, MATRIX_NO_TRANS, MATRIX_UNIT,
+        t, 1, 1.0, T.data(), t, B.data(), 1), CORE_ERROR_SUCCESS);
+}
+
+TEST(MatrixTrsm_Compute, GivenInvalidArguments_WhenSolve_ThenReturnsError) {
+    double T[4] = { 1, 0, 0, 1 };
+    double B[4] = { 1, 2, 3, 4 };
+    EXPECT_EQ(matrix_trsm_compute(MATRIX_SIDE_LEFT, MATRIX_LOWER, MATRIX_NO_TRANS, MATRIX_UNIT,
+        2, 2, 1.0, nullptr, 2, B, 2), CORE_ERROR_NULL);
+    EXPECT_EQ(matrix_trsm_compute(MATRIX_SIDE_LEFT, MATRIX_LOWER, MATRIX_NO_TRANS, MATRIX_UNIT,
+        2, 2, 1.0, T, 1, B, 2), CORE_ERROR_INVALID_ARG);
+    EXPECT_EQ(matrix_trsm_compute(MATRIX_SIDE_RIGHT, MATRIX_LOWER, MATRIX_NO_TRANS, MATRIX_UNIT,
+        2, 2, 1.0, T, 2, B, 1), CORE_ERROR_INVALID_ARG);
+    EXPECT_EQ(matrix_trsm_compute((MatrixSide)2, MATRIX_LOWER, MATRIX_NO_TRANS, MATRIX_UNIT,
+        2, 2, 1.0, T, 2, B, 2), CORE_ERROR_INVALID_ARG);
+    EXPECT_EQ(matrix_trsm_compute(MATRIX_SIDE_LEFT, MATRIX_LOWER, MATRIX_NO_TRANS, MATRIX_UNIT,
+        -1, 2, 1.0, T, 2, B, 2), CORE_ERROR_INVALID_ARG);
+    EXPECT_EQ(matrix_trsm_compute(MATRIX_SIDE_LEFT, MATRIX_LOWER, MATRIX_NO_TRANS, MATRIX_UNIT,
+        0, 2, 1.0, nullptr, 2, nullptr, 2), CORE_ERROR_SUCCESS);
+}
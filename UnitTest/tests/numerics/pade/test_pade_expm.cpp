@@ -9,6 +9,8 @@ extern "C" {
 
 #include <cmath>
 
+#include "test_utils.h"
+
 TEST(PadeExpm, ZeroMatrixReturnsIdentity) {
     CoreErrorStatus err = CORE_ERROR_SUCCESS;
     Matrix* A = matrix_core_create_square(2, &err);
@@ -109,3 +111,198 @@ TEST(PadeExpm, NonSquareMatrixReturnsDimensionError) {
     EXPECT_EQ(matrix_core_free(R), CORE_ERROR_SUCCESS);
 }
 
+
+// ========== pade_expm_ws ==========
+TEST(PadeExpmWs, GivenReusedWorkspace_WhenExpm_ThenBitIdenticalToPadeExpm) {
+    CoreErrorStatus err = CORE_ERROR_SUCCESS;
+    const int n = 5;
+    Matrix* A = matrix_core_create_square(n, &err); ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+    Matrix* R = matrix_core_create_square(n, &err); ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+    Matrix* Rws = matrix_core_create_square(n, &err); ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+
+    ExpmWorkspace ws;
+    ASSERT_EQ(pade_expm_workspace_init(&ws, n), CORE_ERROR_SUCCESS);
+
+    // Norms from tiny to large cover every Pade order and both squaring parities.
+    for (double mag : { 1e-3, 0.2, 1.0, 3.0, 9.0, 40.0, 150.0 }) {
+        for (int i = 0; i < n * n; ++i) A->data[i] = mag * std::sin(0.7 * i + 0.3) / n;
+
+        ASSERT_EQ(pade_expm(A, R), CORE_ERROR_SUCCESS);
+        ASSERT_EQ(pade_expm_ws(A, &ws, Rws), CORE_ERROR_SUCCESS);
+        for (int i = 0; i < n * n; ++i) EXPECT_EQ(Rws->data[i], R->data[i]) << "mag=" << mag;
+    }
+
+    EXPECT_EQ(pade_expm_workspace_free(&ws), CORE_ERROR_SUCCESS);
+    EXPECT_EQ(ws.n, 0);
+    EXPECT_EQ(ws.As, nullptr);
+    EXPECT_EQ(matrix_core_free(A), CORE_ERROR_SUCCESS);
+    EXPECT_EQ(matrix_core_free(R), CORE_ERROR_SUCCESS);
+    EXPECT_EQ(matrix_core_free(Rws), CORE_ERROR_SUCCESS);
+}
+
+TEST(PadeExpmWs, GivenWorkspaceOfOtherSize_WhenExpm_ThenDimensionError) {
+    CoreErrorStatus err = CORE_ERROR_SUCCESS;
+    Matrix* A = matrix_core_create_square(2, &err); ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+    Matrix* R = matrix_core_create_square(2, &err); ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+    EXPECT_EQ(matrix_ops_set_zero(A), CORE_ERROR_SUCCESS);
+
+    ExpmWorkspace ws;
+    ASSERT_EQ(pade_expm_workspace_init(&ws, 3), CORE_ERROR_SUCCESS);
+    EXPECT_EQ(pade_expm_ws(A, &ws, R), CORE_ERROR_DIMENSION);
+    EXPECT_EQ(pade_expm_ws(nullptr, &ws, R), CORE_ERROR_NULL);
+    EXPECT_EQ(pade_expm_ws(A, nullptr, R), CORE_ERROR_NULL);
+    EXPECT_EQ(pade_expm_workspace_free(&ws), CORE_ERROR_SUCCESS);
+
+    EXPECT_EQ(pade_expm_workspace_init(&ws, 0), CORE_ERROR_INVALID_ARG);
+    EXPECT_EQ(pade_expm_workspace_init(nullptr, 2), CORE_ERROR_NULL);
+
+    EXPECT_EQ(matrix_core_free(A), CORE_ERROR_SUCCESS);
+    EXPECT_EQ(matrix_core_free(R), CORE_ERROR_SUCCESS);
+}
+
+TEST(PadeExpmWs, GivenWorkspaceInCallerArena_WhenExpm_ThenMatchesPadeExpm) {
+    CoreErrorStatus err = CORE_ERROR_SUCCESS;
+    const int n = 3;
+    Matrix* A = matrix_core_create_square(n, &err); ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+    Matrix* R = matrix_core_create_square(n, &err); ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+    for (int i = 0; i < n * n; ++i) A->data[i] = 0.4 * (i % 4) - 0.7;
+
+    MatrixArena arena;
+    ASSERT_EQ(matrix_arena_init(&arena, pade_expm_workspace_bytes(n) + matrix_core_bytes_in(n, n)),
+        CORE_ERROR_SUCCESS);
+    ExpmWorkspace ws;
+    ASSERT_EQ(pade_expm_workspace_init_in(&ws, n, &arena), CORE_ERROR_SUCCESS);
+    Matrix* Rws = matrix_core_create_in(&arena, n, n, &err);
+    ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+    EXPECT_EQ(arena.current, arena.head);  // workspace + result fit the single block
+
+    ASSERT_EQ(pade_expm(A, R), CORE_ERROR_SUCCESS);
+    ASSERT_EQ(pade_expm_ws(A, &ws, Rws), CORE_ERROR_SUCCESS);
+    for (int i = 0; i < n * n; ++i) EXPECT_EQ(Rws->data[i], R->data[i]);
+
+    EXPECT_EQ(matrix_arena_destroy(&arena), CORE_ERROR_SUCCESS);
+    EXPECT_EQ(matrix_core_free(A), CORE_ERROR_SUCCESS);
+    EXPECT_EQ(matrix_core_free(R), CORE_ERROR_SUCCESS);
+}
+
+TEST(PadeExpmWs, GivenNonNormalMatrix_WhenExpm_ThenAccurateAndStatsReportChoice) {
+    CoreErrorStatus err = CORE_ERROR_SUCCESS;
+    const int n = 8;
+    const double off = 1e3;
+    Matrix* A = matrix_core_create_square(n, &err); ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+    Matrix* R = matrix_core_create_square(n, &err); ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+    ASSERT_EQ(matrix_ops_set_zero(A), CORE_ERROR_SUCCESS);
+    for (int b = 0; b < n; b += 2) {
+        A->data[b * n + b] = -0.1 * (b + 1);
+        A->data[(b + 1) * n + b + 1] = -0.2 * (b + 1);
+        A->data[b * n + b + 1] = off;
+    }
+
+    ExpmWorkspace ws;
+    ASSERT_EQ(pade_expm_workspace_init(&ws, n), CORE_ERROR_SUCCESS);
+    ASSERT_EQ(pade_expm_ws(A, &ws, R), CORE_ERROR_SUCCESS);
+
+    // exp([[a, c], [0, d]]) = [[e^a, c (e^a - e^d) / (a - d)], [0, e^d]]
+    for (int b = 0; b < n; b += 2) {
+        const double a = -0.1 * (b + 1), d = -0.2 * (b + 1);
+        const double c = off * (std::exp(a) - std::exp(d)) / (a - d);
+        EXPECT_NEAR(R->data[b * n + b], std::exp(a), 1e-15);
+        EXPECT_NEAR(R->data[(b + 1) * n + b + 1], std::exp(d), 1e-15);
+        EXPECT_NEAR(R->data[b * n + b + 1], c, 1e-14 * std::fabs(c));
+    }
+
+    // m = 13 with A^2, A^4, A^6, three Pade products and s squarings; the
+    // ||A||_1 criterion alone would have squared 9 times
+    EXPECT_EQ(ws.stats.m, 13);
+    EXPECT_LE(ws.stats.s, 2);
+    EXPECT_EQ(ws.stats.products, 6 + ws.stats.s);
+
+    // The n <= 3 closed form reports no Pade work
+    ExpmWorkspace ws2;
+    ASSERT_EQ(pade_expm_workspace_init(&ws2, 2), CORE_ERROR_SUCCESS);
+    Matrix* A2 = matrix_core_create_square(2, &err); ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+    ASSERT_EQ(matrix_ops_set_zero(A2), CORE_ERROR_SUCCESS);
+    ASSERT_EQ(pade_expm_ws(A2, &ws2, A2), CORE_ERROR_SUCCESS);
+    EXPECT_EQ(ws2.stats.m, 0);
+    EXPECT_EQ(ws2.stats.products, 0);
+
+    EXPECT_EQ(pade_expm_workspace_free(&ws2), CORE_ERROR_SUCCESS);
+    EXPECT_EQ(pade_expm_workspace_free(&ws), CORE_ERROR_SUCCESS);
+    EXPECT_EQ(matrix_core_free(A2), CORE_ERROR_SUCCESS);
+    EXPECT_EQ(matrix_core_free(A), CORE_ERROR_SUCCESS);
+    EXPECT_EQ(matrix_core_free(R), CORE_ERROR_SUCCESS);
+}
+
+TEST(PadeExpmBlock, GivenCouplingBlock_WhenBlockExpm_ThenMatchesAugmentedExponential) {
+    CoreErrorStatus err = CORE_ERROR_SUCCESS;
+    const int n = 6, k = 3, N = n + k;
+    Matrix* A = matrix_core_create(n, n, &err);
+    Matrix* B = matrix_core_create(n, k, &err);
+    Matrix* W = matrix_core_create(n, k, &err);
+    Matrix* E = matrix_core_create(n, n, &err);
+    Matrix* F = matrix_core_create(n, k, &err);
+    Matrix* M = matrix_core_create(N, N, &err);
+    Matrix* R = matrix_core_create(N, N, &err);
+    ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+    ExpmWorkspace ws;
+    ASSERT_EQ(pade_expm_workspace_init(&ws, n), CORE_ERROR_SUCCESS);
+
+    // From m = 3 without squaring up to m = 13 with several squarings
+    for (double scale : { 1e-3, 0.3, 2.0, 40.0 }) {
+        FillTestMatrix(A, 0.4, scale);
+        ASSERT_EQ(matrix_ops_set_zero(M), CORE_ERROR_SUCCESS);
+        for (int i = 0; i < n; ++i) {
+            for (int j = 0; j < n; ++j) M->data[i * N + j] = A->data[i * n + j];
+            for (int j = 0; j < k; ++j) M->data[i * N + n + j] = 5.0 * std::cos(0.3 * i + j);
+        }
+        ASSERT_EQ(pade_expm(M, R), CORE_ERROR_SUCCESS);
+
+        ASSERT_EQ(matrix_ops_copy(ws.As, A), CORE_ERROR_SUCCESS);
+        for (int i = 0; i < n; ++i)
+            for (int j = 0; j < k; ++j) B->data[i * k + j] = M->data[i * N + n + j];
+        ASSERT_EQ(pade_expm_block_ws_inplace(&ws, B, W, E, F), CORE_ERROR_SUCCESS);
+
+        double ref = 0.0;
+        for (int i = 0; i < n; ++i)
+            for (int j = 0; j < N; ++j) ref = std::fmax(ref, std::fabs(R->data[i * N + j]));
+        for (int i = 0; i < n; ++i) {
+            for (int j = 0; j < n; ++j)
+                EXPECT_NEAR(E->data[i * n + j], R->data[i * N + j], 1e-13 * ref) << "scale=" << scale;
+            for (int j = 0; j < k; ++j)
+                EXPECT_NEAR(F->data[i * k + j], R->data[i * N + n + j], 1e-13 * ref) << "scale=" << scale;
+        }
+        if (scale >= 40.0) {
+            EXPECT_EQ(ws.stats.m, 13);
+            EXPECT_GT(ws.stats.s, 0);
+        }
+    }
+
+    EXPECT_EQ(pade_expm_workspace_free(&ws), CORE_ERROR_SUCCESS);
+    matrix_core_free(A); matrix_core_free(B); matrix_core_free(W);
+    matrix_core_free(E); matrix_core_free(F); matrix_core_free(M); matrix_core_free(R);
+}
+
+TEST(PadeExpmBlock, GivenMismatchedBlocks_WhenBlockExpm_ThenReturnsError) {
+    CoreErrorStatus err = CORE_ERROR_SUCCESS;
+    const int n = 4;
+    Matrix* E = matrix_core_create(n, n, &err);
+    Matrix* B = matrix_core_create(n, 2, &err);
+    Matrix* W = matrix_core_create(n, 2, &err);
+    Matrix* F = matrix_core_create(n, 2, &err);
+    Matrix* F3 = matrix_core_create(n, 3, &err);
+    Matrix* Bn = matrix_core_create(n + 1, 2, &err);
+    ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+    ExpmWorkspace ws;
+    ASSERT_EQ(pade_expm_workspace_init(&ws, n), CORE_ERROR_SUCCESS);
+
+    EXPECT_EQ(pade_expm_block_ws_inplace(nullptr, B, W, E, F), CORE_ERROR_NULL);
+    EXPECT_EQ(pade_expm_block_ws_inplace(&ws, nullptr, W, E, F), CORE_ERROR_NULL);
+    EXPECT_EQ(pade_expm_block_ws_inplace(&ws, B, W, E, nullptr), CORE_ERROR_NULL);
+    EXPECT_EQ(pade_expm_block_ws_inplace(&ws, B, W, E, F3), CORE_ERROR_DIMENSION);
+    EXPECT_EQ(pade_expm_block_ws_inplace(&ws, Bn, W, E, F), CORE_ERROR_DIMENSION);
+    EXPECT_EQ(pade_expm_block_ws_inplace(&ws, B, W, B, F), CORE_ERROR_DIMENSION);
+
+    EXPECT_EQ(pade_expm_workspace_free(&ws), CORE_ERROR_SUCCESS);
+    matrix_core_free(E); matrix_core_free(B); matrix_core_free(W);
+    matrix_core_free(F); matrix_core_free(F3); matrix_core_free(Bn);
+}
@@ -1,10 +1,12 @@
 #include <gtest/gtest.h>
 #include <cmath>
 #include <limits>
+#include <vector>
 
 extern "C" {
 #include "core_matrix.h"
 #include "matrix_ops.h"
+#include "matrix_norm.h"
 #include "pade_scaling.h"
 }
 
@@ -67,6 +69,172 @@ TEST(PadeChooseScalingAndOrder, ReturnsErrorOnInvalidInputs) {
     EXPECT_EQ(pade_choose_scaling_and_order(1.0, &s, nullptr), CORE_ERROR_NULL);
 }
 
+// ==============================
+// Tests for pade_select_scaling
+// ==============================
+
+// Block-diagonal 2x2 upper triangles [[-0.1k, off], [0, -0.2k]]: ||A||_1 grows
+// with off but ||A^k||^(1/k) stays small.
+static void FillNonNormal(Matrix* A, double off) {
+    const int n = A->rows;
+    ASSERT_EQ(matrix_ops_set_zero(A), CORE_ERROR_SUCCESS);
+    for (int b = 0; b + 1 < n; b += 2) {
+        A->data[b * n + b] = -0.1 * (b + 1);
+        A->data[(b + 1) * n + b + 1] = -0.2 * (b + 1);
+        A->data[b * n + b + 1] = off;
+    }
+}
+
+TEST(PadeSelectScaling, GivenNonNormalMatrix_WhenSelect_ThenFewerSquaringsAndScaledPowers) {
+    CoreErrorStatus err = CORE_ERROR_SUCCESS;
+    const int n = 8;
+    Matrix* A = matrix_core_create_square(n, &err); ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+    Matrix* A2 = matrix_core_create_square(n, &err); ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+    Matrix* A4 = matrix_core_create_square(n, &err); ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+    Matrix* A6 = matrix_core_create_square(n, &err); ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+    Matrix* ref = matrix_core_create_square(n, &err); ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+    std::vector<double> work(PADE_SCALING_WORK(n));
+    FillNonNormal(A, 1e3);
+
+    double norm1 = 0.0;
+    ASSERT_EQ(matrix_norm_1(A, &norm1), CORE_ERROR_SUCCESS);
+    int s_norm = 0, m_norm = 0;
+    ASSERT_EQ(pade_choose_scaling_and_order(norm1, &s_norm, &m_norm), CORE_ERROR_SUCCESS);
+
+    PadeScaling sel;
+    ASSERT_EQ(pade_select_scaling(A, A2, A4, A6, work.data(), &sel), CORE_ERROR_SUCCESS);
+    EXPECT_EQ(sel.m, 13);
+    EXPECT_EQ(sel.max_power, 6);
+    EXPECT_EQ(sel.products, 3);
+    EXPECT_EQ(sel.ell, 0);
+    EXPECT_LE(sel.s + 6, s_norm);   // the norm-only choice squares 9 times
+
+    // The buffers hold the powers of 2^-s A
+    ASSERT_EQ(matrix_scale_down_pow2(A, sel.s, A), CORE_ERROR_SUCCESS);
+    ASSERT_EQ(matrix_ops_multiply(ref, A, A), CORE_ERROR_SUCCESS);
+    for (int i = 0; i < n * n; ++i) EXPECT_EQ(A2->data[i], ref->data[i]);
+    ASSERT_EQ(matrix_ops_multiply(ref, A2, A2), CORE_ERROR_SUCCESS);
+    for (int i = 0; i < n * n; ++i) EXPECT_EQ(A4->data[i], ref->data[i]);
+
+    for (Matrix* M : { A, A2, A4, A6, ref }) EXPECT_EQ(matrix_core_free(M), CORE_ERROR_SUCCESS);
+}
+
+TEST(PadeSelectScaling, GivenSmallOrNilpotentMatrix_WhenSelect_ThenOrderAndEllFollowBackwardError) {
+    CoreErrorStatus err = CORE_ERROR_SUCCESS;
+    Matrix* A = matrix_core_create_square(2, &err); ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+    Matrix* P[3];
+    for (Matrix*& M : P) { M = matrix_core_create_square(2, &err); ASSERT_EQ(err, CORE_ERROR_SUCCESS); }
+    double work[PADE_SCALING_WORK(2)];
+    PadeScaling sel;
+
+    // Tiny norm: m = 3 after forming A^2 only
+    const double small[4] = { 1e-3, 2e-3, -1e-3, 0.0 };
+    for (int i = 0; i < 4; ++i) A->data[i] = small[i];
+    ASSERT_EQ(pade_select_scaling(A, P[0], P[1], P[2], work, &sel), CORE_ERROR_SUCCESS);
+    EXPECT_EQ(sel.m, 3);
+    EXPECT_EQ(sel.s, 0);
+    EXPECT_EQ(sel.products, 1);
+
+    // A = x [[1, 1], [-1, -1]] has A^2 = 0, so every d_k vanishes; only the
+    // backward-error bound on |A|^(2m+1) asks for squarings
+    for (int i = 0; i < 4; ++i) A->data[i] = (i < 2) ? 100.0 : -100.0;
+    ASSERT_EQ(pade_select_scaling(A, P[0], P[1], P[2], work, &sel), CORE_ERROR_SUCCESS);
+    EXPECT_EQ(sel.m, 13);
+    EXPECT_GT(sel.ell, 0);
+    EXPECT_EQ(sel.s, sel.ell);
+
+    EXPECT_EQ(matrix_core_free(A), CORE_ERROR_SUCCESS);
+    for (Matrix* M : P) EXPECT_EQ(matrix_core_free(M), CORE_ERROR_SUCCESS);
+}
+
+TEST(PadeSelectScaling, GivenLargeOrderWithTransientPowers_WhenSelect_ThenNormEstimatesSaveSquarings) {
+    // 3 x 3 blocks 0.5 I + N with N = 1e3 on the superdiagonal and N^3 = 0:
+    // ||A^8||, ||A^10|| are far below their bounds from ||A^4||, ||A^6||
+    // (exact d_k give s = 1, the bounds s = 3). Only orders from
+    // PADE_NORMEST_MIN_N on estimate the powers.
+    for (int n : { PADE_NORMEST_MIN_N - 2, PADE_NORMEST_MIN_N + 1 }) {
+        CoreErrorStatus err = CORE_ERROR_SUCCESS;
+        Matrix* A = matrix_core_create_square(n, &err); ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+        Matrix* P[3];
+        for (Matrix*& M : P) { M = matrix_core_create_square(n, &err); ASSERT_EQ(err, CORE_ERROR_SUCCESS); }
+        ASSERT_EQ(matrix_ops_set_zero(A), CORE_ERROR_SUCCESS);
+        for (int i = 0; i < n; ++i) {
+            A->data[i * n + i] = 0.5;
+            if (i % 3 != 2 && i + 1 < n) A->data[i * n + i + 1] = 1e3;
+        }
+        std::vector<double> work(PADE_SCALING_WORK(n));
+
+        PadeScaling sel;
+        ASSERT_EQ(pade_select_scaling(A, P[0], P[1], P[2], work.data(), &sel), CORE_ERROR_SUCCESS);
+        EXPECT_EQ(sel.m, 13);
+        EXPECT_EQ(sel.products, 3);
+        EXPECT_EQ(sel.s, n >= PADE_NORMEST_MIN_N ? 1 : 3) << "n=" << n;
+
+        EXPECT_EQ(matrix_core_free(A), CORE_ERROR_SUCCESS);
+        for (Matrix* M : P) EXPECT_EQ(matrix_core_free(M), CORE_ERROR_SUCCESS);
+    }
+}
+
+TEST(PadeSelectScaling, GivenNormProfile_WhenSelectForStep_ThenNoLaterThanDirectSelection) {
+    CoreErrorStatus err = CORE_ERROR_SUCCESS;
+    const int n = 8;
+    Matrix* A = matrix_core_create_square(n, &err); ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+    Matrix* tA = matrix_core_create_square(n, &err); ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+    Matrix* P[3];
+    for (Matrix*& M : P) { M = matrix_core_create_square(n, &err); ASSERT_EQ(err, CORE_ERROR_SUCCESS); }
+    std::vector<double> work(PADE_SCALING_WORK(n));
+    FillNonNormal(A, 30.0);
+
+    PadeNormProfile profile;
+    ASSERT_EQ(matrix_ops_multiply(P[0], A, A), CORE_ERROR_SUCCESS);
+    ASSERT_EQ(matrix_ops_multiply(P[1], P[0], P[0]), CORE_ERROR_SUCCESS);
+    ASSERT_EQ(matrix_ops_multiply(P[2], P[1], P[0]), CORE_ERROR_SUCCESS);
+    ASSERT_EQ(pade_norm_profile(A, P[0], P[1], P[2], work.data(), &profile), CORE_ERROR_SUCCESS);
+
+    // Every d_k is exact in the profile, so its choice never needs more
+    for (double t : { 1e-4, -0.003, 0.02, 0.1, 0.7, 3.0, -40.0, 900.0 }) {
+        ASSERT_EQ(matrix_ops_copy(tA, A), CORE_ERROR_SUCCESS);
+        ASSERT_EQ(matrix_ops_scale(tA, t), CORE_ERROR_SUCCESS);
+        PadeScaling ref, sel;
+        ASSERT_EQ(pade_select_scaling(tA, P[0], P[1], P[2], work.data(), &ref), CORE_ERROR_SUCCESS);
+        ASSERT_EQ(pade_select_scaling_for_step(&profile, t, &sel), CORE_ERROR_SUCCESS);
+        EXPECT_LE(sel.m, ref.m) << "t=" << t;
+        EXPECT_LE(sel.s, ref.s) << "t=" << t;
+        EXPECT_EQ(sel.products, 0);
+        EXPECT_EQ(sel.max_power, sel.m == 3 ? 2 : sel.m == 5 ? 4 : 6);
+    }
+
+    PadeScaling sel;
+    ASSERT_EQ(pade_select_scaling_for_step(&profile, 0.0, &sel), CORE_ERROR_SUCCESS);
+    EXPECT_EQ(sel.m, 3);
+    EXPECT_EQ(sel.s, 0);
+    EXPECT_EQ(pade_select_scaling_for_step(&profile, std::numeric_limits<double>::infinity(), &sel),
+        CORE_ERROR_INVALID_ARG);
+    EXPECT_EQ(pade_select_scaling_for_step(nullptr, 1.0, &sel), CORE_ERROR_NULL);
+
+    EXPECT_EQ(matrix_core_free(A), CORE_ERROR_SUCCESS);
+    EXPECT_EQ(matrix_core_free(tA), CORE_ERROR_SUCCESS);
+    for (Matrix* M : P) EXPECT_EQ(matrix_core_free(M), CORE_ERROR_SUCCESS);
+}
+
+TEST(PadeSelectScaling, GivenInvalidInputs_WhenSelect_ThenReturnsError) {
+    CoreErrorStatus err = CORE_ERROR_SUCCESS;
+    Matrix* A = matrix_core_create_square(2, &err); ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+    Matrix* R = matrix_core_create(2, 3, &err); ASSERT_EQ(err, CORE_ERROR_SUCCESS);
+    double work[PADE_SCALING_WORK(2)];
+    PadeScaling sel;
+
+    ASSERT_EQ(matrix_ops_set_zero(A), CORE_ERROR_SUCCESS);
+    A->data[1] = std::numeric_limits<double>::infinity();
+    EXPECT_EQ(pade_select_scaling(A, A, A, A, work, &sel), CORE_ERROR_INVALID_ARG);
+    EXPECT_EQ(pade_select_scaling(R, A, A, A, work, &sel), CORE_ERROR_DIMENSION);
+    EXPECT_EQ(pade_select_scaling(A, A, A, A, nullptr, &sel), CORE_ERROR_NULL);
+    EXPECT_EQ(pade_select_scaling(A, A, A, A, work, nullptr), CORE_ERROR_NULL);
+
+    EXPECT_EQ(matrix_core_free(A), CORE_ERROR_SUCCESS);
+    EXPECT_EQ(matrix_core_free(R), CORE_ERROR_SUCCESS);
+}
+
 // ==============================
 // Tests for matrix_scale_down_pow2
 // ==============================
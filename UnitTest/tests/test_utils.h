@@ -0,0 +1,39 @@
+#pragma once
+
+// Deterministic test data shared by the unit tests. Every generator is a
+// smooth function of the indices, so results are reproducible across runs
+// and platforms without a random number generator.
+
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+extern "C" {
+#include "core_matrix.h"
+#include "core_error.h"
+}
+
+// M(i, j) = scale * sin(seed + 0.37 ij + 1.3 i - 0.7 j); honors M->ld, so
+// views and padded matrices can be filled too.
+inline void FillTestMatrix(Matrix* M, double seed, double scale = 1.0) {
+    for (int i = 0; i < M->rows; ++i) {
+        for (int j = 0; j < M->cols; ++j) {
+            M->data[(size_t)i * M->ld + j] = scale * std::sin(seed + 0.37 * i * j + 1.3 * i - 0.7 * j);
+        }
+    }
+}
+
+// New rows x cols matrix filled by FillTestMatrix(). The caller frees it.
+inline Matrix* MakeTestMatrix(int rows, int cols, double seed, double scale = 1.0) {
+    CoreErrorStatus err = CORE_ERROR_SUCCESS;
+    Matrix* M = matrix_core_create(rows, cols, &err);
+    if (M) FillTestMatrix(M, seed, scale);
+    return M;
+}
+
+// Flat buffer pattern for the raw-pointer kernels (GEMM, SIMD).
+inline void FillPattern(std::vector<double>& v, double seed) {
+    for (size_t i = 0; i < v.size(); ++i) {
+        v[i] = std::sin(seed + 0.37 * (double)i) + 0.01 * (double)(i % 7);
+    }
+}